@@ -189,6 +189,26 @@ TEST(EU4ToVic2_ConfigurationTests, CK2ExportDirectoryCanBeSet)
 }
 
 
+TEST(EU4ToVic2_ConfigurationTests, BinaryTokensPathDefaultsToTokensFile)
+{
+	Configuration testConfiguration;
+	std::stringstream input("");
+	testConfiguration.instantiate(input, fakeDoesFolderExist, fakeDoesFileExist);
+
+	ASSERT_EQ(testConfiguration.getBinaryTokensPath(), "eu4tokens.txt");
+}
+
+
+TEST(EU4ToVic2_ConfigurationTests, BinaryTokensPathCanBeSet)
+{
+	Configuration testConfiguration;
+	std::stringstream input("binaryTokensFile = \"C:\\tokens\\eu4.txt\"");
+	testConfiguration.instantiate(input, fakeDoesFolderExist, fakeDoesFileExist);
+
+	ASSERT_EQ(testConfiguration.getBinaryTokensPath(), "C:\\tokens\\eu4.txt");
+}
+
+
 TEST(EU4ToVic2_ConfigurationTests, Vic2PathDefaultsBlank)
 {
 	Configuration testConfiguration;
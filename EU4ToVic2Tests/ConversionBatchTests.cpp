@@ -0,0 +1,153 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/ConversionBatch.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+
+class ConversionBatchTests: public ::testing::Test
+{
+	protected:
+		void SetUp() override
+		{
+			batchFileName = (std::filesystem::temp_directory_path() / ("ConversionBatchTests_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".txt")).string();
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove(batchFileName);
+		}
+
+		void writeBatchFile(const std::string& contents)
+		{
+			std::ofstream batchFile(batchFileName, std::ios::binary | std::ios::trunc);
+			batchFile << contents;
+		}
+
+		std::string batchFileName;
+};
+
+
+TEST_F(ConversionBatchTests, eachLineIsAJob)
+{
+	writeBatchFile("saves/first.eu4\nsaves/second.eu4\n");
+
+	const auto jobs = readBatchFile(batchFileName);
+
+	ASSERT_EQ(jobs.size(), 2);
+	ASSERT_EQ(jobs[0].EU4SaveFileName, "saves/first.eu4");
+	ASSERT_EQ(jobs[0].outputName, "");
+	ASSERT_EQ(jobs[1].EU4SaveFileName, "saves/second.eu4");
+}
+
+
+TEST_F(ConversionBatchTests, windowsLineEndsAreDropped)
+{
+	writeBatchFile("saves/first.eu4\r\nsaves/second.eu4\toutput\r\n");
+
+	const auto jobs = readBatchFile(batchFileName);
+
+	ASSERT_EQ(jobs.size(), 2);
+	ASSERT_EQ(jobs[0].EU4SaveFileName, "saves/first.eu4");
+	ASSERT_EQ(jobs[1].EU4SaveFileName, "saves/second.eu4");
+	ASSERT_EQ(jobs[1].outputName, "output");
+}
+
+
+TEST_F(ConversionBatchTests, blankLinesAreSkipped)
+{
+	writeBatchFile("\nsaves/first.eu4\n\r\n\nsaves/second.eu4");
+
+	const auto jobs = readBatchFile(batchFileName);
+
+	ASSERT_EQ(jobs.size(), 2);
+	ASSERT_EQ(jobs[0].EU4SaveFileName, "saves/first.eu4");
+	ASSERT_EQ(jobs[1].EU4SaveFileName, "saves/second.eu4");
+}
+
+
+TEST_F(ConversionBatchTests, outputNameFollowsATab)
+{
+	writeBatchFile("saves/my save.eu4\tmy output\n");
+
+	const auto jobs = readBatchFile(batchFileName);
+
+	ASSERT_EQ(jobs.size(), 1);
+	ASSERT_EQ(jobs[0].EU4SaveFileName, "saves/my save.eu4");
+	ASSERT_EQ(jobs[0].outputName, "my output");
+}
+
+
+TEST_F(ConversionBatchTests, missingBatchFileThrowsException)
+{
+	ASSERT_THROW(readBatchFile(batchFileName), std::runtime_error);
+}
+
+
+TEST_F(ConversionBatchTests, failedJobDoesNotStopTheBatch)
+{
+	const std::vector<ConversionJob> jobs{ { "first.eu4", "" }, { "broken.eu4", "" }, { "third.eu4", "" } };
+
+	std::vector<std::string> ran;
+	const auto failures = runConversionBatch(jobs, [&ran](const ConversionJob& job) {
+		ran.push_back(job.EU4SaveFileName);
+		if (job.EU4SaveFileName == "broken.eu4")
+		{
+			throw std::runtime_error("Could not open save! Exiting!");
+		}
+	});
+
+	ASSERT_EQ(failures, 1);
+	ASSERT_EQ(ran, std::vector<std::string>({ "first.eu4", "broken.eu4", "third.eu4" }));
+}
+
+
+TEST_F(ConversionBatchTests, failedJobDoesNotStopAParallelBatch)
+{
+	const std::vector<ConversionJob> jobs{ { "first.eu4", "" }, { "broken.eu4", "" }, { "third.eu4", "" }, { "broken.eu4", "" } };
+
+	std::mutex ranMutex;
+	std::vector<std::string> ran;
+	const auto failures = runConversionBatch(jobs, [&ranMutex, &ran](const ConversionJob& job) {
+		{
+			std::lock_guard<std::mutex> lock(ranMutex);
+			ran.push_back(job.EU4SaveFileName);
+		}
+		if (job.EU4SaveFileName == "broken.eu4")
+		{
+			throw std::runtime_error("Could not open save! Exiting!");
+		}
+	}, 2);
+
+	std::sort(ran.begin(), ran.end());
+	ASSERT_EQ(failures, 2);
+	ASSERT_EQ(ran, std::vector<std::string>({ "broken.eu4", "broken.eu4", "first.eu4", "third.eu4" }));
+}
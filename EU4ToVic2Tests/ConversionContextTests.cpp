@@ -0,0 +1,105 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/ConversionContext.h"
+#include <thread>
+
+
+
+namespace
+{
+struct Counter
+{
+	int value = 0;
+};
+}
+
+
+TEST(ConversionContextTests, currentIsTheDefaultWhenNothingIsBound)
+{
+	ASSERT_EQ(&ConversionContext::current(), &ConversionContext::current());
+	ASSERT_EQ(&theConfiguration(), &ConversionContext::current().getConfiguration());
+}
+
+
+TEST(ConversionContextTests, scopeBindsItsContextUntilItEnds)
+{
+	auto& defaultContext = ConversionContext::current();
+	ConversionContext outer;
+	ConversionContext inner;
+	{
+		ConversionContext::Scope outerScope(outer);
+		ASSERT_EQ(&ConversionContext::current(), &outer);
+		{
+			ConversionContext::Scope innerScope(inner);
+			ASSERT_EQ(&ConversionContext::current(), &inner);
+			ASSERT_EQ(&theConfiguration(), &inner.getConfiguration());
+		}
+		ASSERT_EQ(&ConversionContext::current(), &outer);
+	}
+	ASSERT_EQ(&ConversionContext::current(), &defaultContext);
+}
+
+
+TEST(ConversionContextTests, scopeOnlyBindsItsOwnThread)
+{
+	ConversionContext context;
+	ConversionContext::Scope scope(context);
+
+	ConversionContext* otherThreadContext = nullptr;
+	std::thread other([&otherThreadContext]() { otherThreadContext = &ConversionContext::current(); });
+	other.join();
+
+	ASSERT_NE(otherThreadContext, &context);
+}
+
+
+TEST(ConversionContextTests, stateIsMadeOncePerContext)
+{
+	ConversionContext first;
+	ConversionContext second;
+	int made = 0;
+	const auto makeCounter = [&made]() { made++; return new Counter; };
+
+	first.getState<Counter>(makeCounter).value = 3;
+	first.getState<Counter>(makeCounter).value++;
+
+	ASSERT_EQ(first.getState<Counter>(makeCounter).value, 4);
+	ASSERT_EQ(second.getState<Counter>(makeCounter).value, 0);
+	ASSERT_EQ(made, 2);
+}
+
+
+TEST(ConversionContextTests, everyContextDrawsTheSameRandomSequence)
+{
+	ConversionContext first;
+	ConversionContext second;
+	for (int i = 0; i < 100; i++)
+	{
+		const auto fraction = first.getRandomFraction();
+		ASSERT_EQ(fraction, second.getRandomFraction());
+		ASSERT_GE(fraction, 0.0);
+		ASSERT_LT(fraction, 1.0);
+	}
+}
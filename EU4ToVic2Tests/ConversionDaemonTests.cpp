@@ -0,0 +1,211 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/ConversionDaemon.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+
+
+namespace
+{
+const std::string socketPath = "conversionDaemonTest.sock";
+
+
+// sends the request and returns the daemon's reply lines, once it has closed the connection
+std::vector<std::string> sendRequest(const std::string& request)
+{
+	const auto client = socket(AF_UNIX, SOCK_STREAM, 0);
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+	if (connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		throw std::runtime_error("Could not connect to the daemon");
+	}
+	send(client, request.data(), static_cast<int>(request.size()), 0);
+
+	std::string replies;
+	char chunk[256];
+	for (auto received = recv(client, chunk, sizeof(chunk), 0); received > 0; received = recv(client, chunk, sizeof(chunk), 0))
+	{
+		replies.append(chunk, received);
+	}
+#ifdef _WIN32
+	closesocket(client);
+#else
+	close(client);
+#endif
+
+	std::vector<std::string> lines;
+	for (auto newline = replies.find('\n'); newline != std::string::npos; newline = replies.find('\n'))
+	{
+		lines.push_back(replies.substr(0, newline));
+		replies.erase(0, newline + 1);
+	}
+	return lines;
+}
+
+
+std::string firstField(const std::string& line)
+{
+	return line.substr(0, line.find('\t'));
+}
+
+
+std::string lastField(const std::string& line)
+{
+	return line.substr(line.rfind('\t') + 1);
+}
+}
+
+
+TEST(ConversionDaemonTests, jobIsPassedToRunner)
+{
+	std::vector<ConversionJob> jobs;
+	ConversionDaemon daemon(socketPath, [&jobs](const ConversionJob& job, const ConversionDaemon::ProgressReporter& reportProgress) {
+		jobs.push_back(job);
+	});
+	std::thread server([&daemon]() { daemon.run(); });
+
+	sendRequest("convert\tsaves/test.eu4\ttestOutput\nmax_literacy = 0.5\npopShaping = 2\n\n");
+	sendRequest("shutdown\n");
+	server.join();
+
+	ASSERT_EQ(jobs.size(), 1);
+	ASSERT_EQ(jobs[0].EU4SaveFileName, "saves/test.eu4");
+	ASSERT_EQ(jobs[0].outputName, "testOutput");
+	ASSERT_EQ(jobs[0].configurationOverrides, "max_literacy = 0.5\npopShaping = 2\n");
+}
+
+
+TEST(ConversionDaemonTests, progressAndCompletionAreReported)
+{
+	ConversionDaemon daemon(socketPath, [](const ConversionJob& job, const ConversionDaemon::ProgressReporter& reportProgress) {
+		reportProgress("first stage");
+		reportProgress("second stage");
+	});
+	std::thread server([&daemon]() { daemon.run(); });
+
+	const auto replies = sendRequest("convert\ttest.eu4\n\n");
+	sendRequest("shutdown\n");
+	server.join();
+
+	ASSERT_EQ(replies.size(), 4);
+	ASSERT_EQ(replies[0], "accepted");
+	ASSERT_EQ(firstField(replies[1]), "progress");
+	ASSERT_EQ(lastField(replies[1]), "first stage");
+	ASSERT_EQ(firstField(replies[2]), "progress");
+	ASSERT_EQ(lastField(replies[2]), "second stage");
+	ASSERT_EQ(firstField(replies[3]), "done");
+	ASSERT_GE(std::stod(lastField(replies[3])), 0.0);
+}
+
+
+TEST(ConversionDaemonTests, failedJobIsReportedAndDaemonKeepsServing)
+{
+	int runs = 0;
+	ConversionDaemon daemon(socketPath, [&runs](const ConversionJob& job, const ConversionDaemon::ProgressReporter& reportProgress) {
+		runs++;
+		if (job.EU4SaveFileName == "bad.eu4")
+		{
+			throw std::runtime_error("bad save");
+		}
+	});
+	std::thread server([&daemon]() { daemon.run(); });
+
+	const auto failedReplies = sendRequest("convert\tbad.eu4\n\n");
+	const auto goodReplies = sendRequest("convert\tgood.eu4\n\n");
+	sendRequest("shutdown\n");
+	server.join();
+
+	ASSERT_EQ(runs, 2);
+	ASSERT_EQ(failedReplies.size(), 2);
+	ASSERT_EQ(firstField(failedReplies[1]), "failed");
+	ASSERT_EQ(lastField(failedReplies[1]), "bad save");
+	ASSERT_EQ(goodReplies.size(), 2);
+	ASSERT_EQ(firstField(goodReplies[1]), "done");
+}
+
+
+TEST(ConversionDaemonTests, unknownRequestIsRefused)
+{
+	int runs = 0;
+	ConversionDaemon daemon(socketPath, [&runs](const ConversionJob& job, const ConversionDaemon::ProgressReporter& reportProgress) {
+		runs++;
+	});
+	std::thread server([&daemon]() { daemon.run(); });
+
+	const auto replies = sendRequest("explode\n");
+	const auto shutdownReplies = sendRequest("shutdown\n");
+	server.join();
+
+	ASSERT_EQ(runs, 0);
+	ASSERT_EQ(replies.size(), 1);
+	ASSERT_EQ(firstField(replies[0]), "failed");
+	ASSERT_EQ(shutdownReplies.size(), 1);
+	ASSERT_EQ(shutdownReplies[0], "bye");
+}
+
+
+TEST(ConversionDaemonTests, parallelJobsRunAtTheSameTime)
+{
+	std::mutex mutex;
+	std::condition_variable started;
+	int running = 0;
+	bool overlapped = false;
+	ConversionDaemon daemon(socketPath, [&](const ConversionJob& job, const ConversionDaemon::ProgressReporter& reportProgress) {
+		std::unique_lock<std::mutex> lock(mutex);
+		running++;
+		started.notify_all();
+		overlapped |= started.wait_for(lock, std::chrono::seconds(5), [&running]() { return running == 2; });
+	}, 2);
+	std::thread server([&daemon]() { daemon.run(); });
+
+	std::vector<std::string> firstReplies;
+	std::thread firstClient([&firstReplies]() { firstReplies = sendRequest("convert\tfirst.eu4\n\n"); });
+	const auto secondReplies = sendRequest("convert\tsecond.eu4\n\n");
+	firstClient.join();
+	sendRequest("shutdown\n");
+	server.join();
+
+	ASSERT_TRUE(overlapped);
+	ASSERT_EQ(firstField(firstReplies.back()), "done");
+	ASSERT_EQ(firstField(secondReplies.back()), "done");
+}
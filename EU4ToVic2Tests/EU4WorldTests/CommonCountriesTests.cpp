@@ -0,0 +1,142 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/EU4World/CommonCountries.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+
+namespace
+{
+
+// a game folder of its own for each test, with common/country_tags and common/countries
+class EU4World_CommonCountriesTests: public ::testing::Test
+{
+	protected:
+		void SetUp() override
+		{
+			folder = std::filesystem::temp_directory_path() / ("CommonCountriesTests_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+			std::filesystem::remove_all(folder);
+			std::filesystem::create_directories(folder / "common" / "country_tags");
+			std::filesystem::create_directories(folder / "common" / "countries");
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(folder);
+		}
+
+		std::string writeFile(const std::string& name, const std::string& contents)
+		{
+			const auto path = (folder / "common" / name).string();
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file << contents;
+			return path;
+		}
+
+		std::pair<std::string, std::string> getTagFile(const std::string& name) const
+		{
+			return { (folder / "common" / "country_tags" / name).string(), folder.string() };
+		}
+
+		std::filesystem::path folder;
+};
+
+}
+
+
+
+TEST_F(EU4World_CommonCountriesTests, countriesAreReadWithTheirFileNames)
+{
+	writeFile("country_tags/00_countries.txt", "# a comment line\nSWE = \"countries/Sweden.txt\"\nFRA = \"countries/France.txt\" # trailing comment\n");
+	writeFile("countries/Sweden.txt", "graphical_culture = westerngfx\n");
+	writeFile("countries/France.txt", "graphical_culture = westerngfx\n");
+
+	EU4::CommonCountries theCountries({ getTagFile("00_countries.txt") });
+
+	ASSERT_EQ(theCountries.getCountries().size(), 2);
+	ASSERT_EQ(theCountries.getCountries()[0].tag, "SWE");
+	ASSERT_EQ(theCountries.getCountries()[0].fileName, "Sweden.txt");
+	ASSERT_EQ(theCountries.getCountries()[1].tag, "FRA");
+	ASSERT_EQ(theCountries.getCountries()[1].fileName, "France.txt");
+}
+
+
+TEST_F(EU4World_CommonCountriesTests, mapColorsAreReadFromCountryFiles)
+{
+	writeFile("country_tags/00_countries.txt", "SWE = \"countries/Sweden.txt\"\nFRA = \"countries/France.txt\"\n");
+	writeFile("countries/Sweden.txt", "graphical_culture = westerngfx\ncolor = { 10 20 30 }\n");
+	writeFile("countries/France.txt", "graphical_culture = westerngfx\n");
+
+	EU4::CommonCountries theCountries({ getTagFile("00_countries.txt") });
+
+	ASSERT_TRUE(theCountries.getCountries()[0].mapColor);
+	int r, g, b;
+	theCountries.getCountries()[0].mapColor->GetRGB(r, g, b);
+	ASSERT_EQ(r, 10);
+	ASSERT_EQ(g, 20);
+	ASSERT_EQ(b, 30);
+	ASSERT_FALSE(theCountries.getCountries()[1].mapColor);
+}
+
+
+TEST_F(EU4World_CommonCountriesTests, missingCountryFilesAreSkippedButStillWatched)
+{
+	writeFile("country_tags/00_countries.txt", "SWE = \"countries/Sweden.txt\"\nFRA = \"countries/France.txt\"\n");
+	writeFile("countries/France.txt", "graphical_culture = westerngfx\n");
+
+	EU4::CommonCountries theCountries({ getTagFile("00_countries.txt") });
+
+	ASSERT_EQ(theCountries.getCountries().size(), 1);
+	ASSERT_EQ(theCountries.getCountries()[0].tag, "FRA");
+	ASSERT_EQ(theCountries.getCountryFiles().size(), 2);
+	ASSERT_EQ(theCountries.getCountryFiles()[0], folder.string() + "/common/countries/Sweden.txt");
+}
+
+
+TEST_F(EU4World_CommonCountriesTests, countriesReadBackFromASnapshot)
+{
+	writeFile("country_tags/00_countries.txt", "SWE = \"countries/Sweden.txt\"\nFRA = \"countries/France.txt\"\n");
+	writeFile("countries/Sweden.txt", "color = { 10 20 30 }\n");
+	writeFile("countries/France.txt", "graphical_culture = westerngfx\n");
+	EU4::CommonCountries theCountries({ getTagFile("00_countries.txt") });
+
+	std::ostringstream output;
+	parsing::SnapshotWriter writer(output, 1, 1);
+	theCountries.writeSnapshot(writer);
+	const auto data = output.str();
+	parsing::SnapshotReader reader(data, 1, 1);
+	EU4::CommonCountries readCountries(reader);
+
+	ASSERT_TRUE(reader.atEnd());
+	ASSERT_EQ(readCountries.getCountries().size(), 2);
+	ASSERT_EQ(readCountries.getCountries()[0].tag, "SWE");
+	ASSERT_EQ(readCountries.getCountries()[0].fileName, "Sweden.txt");
+	ASSERT_TRUE(readCountries.getCountries()[0].mapColor);
+	ASSERT_FALSE(readCountries.getCountries()[1].mapColor);
+	ASSERT_EQ(readCountries.getCountryFiles(), theCountries.getCountryFiles());
+}
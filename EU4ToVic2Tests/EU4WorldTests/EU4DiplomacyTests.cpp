@@ -0,0 +1,70 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/EU4World/EU4Diplomacy.h"
+#include <string>
+
+
+
+TEST(EU4World_EU4DiplomacyTests, agreementTakesItsPartiesAndStartDate)
+{
+	std::string input = "={ first=\"SWE\" second=\"FIN\" start_date=1500.1.2 }";
+	parsing::Tokenizer tokenizer(input);
+
+	const EU4Agreement agreement("alliance", tokenizer);
+	ASSERT_EQ(agreement.type, "alliance");
+	ASSERT_EQ(agreement.country1, "SWE");
+	ASSERT_EQ(agreement.country2, "FIN");
+	ASSERT_EQ(agreement.startDate, date("1500.1.2"));
+}
+
+
+TEST(EU4World_EU4DiplomacyTests, subjectTypeReplacesTheAgreementKey)
+{
+	std::string input = "={ first=\"SWE\" second=\"FIN\" subject_type=\"daimyo_vassal\" }";
+	parsing::Tokenizer tokenizer(input);
+
+	const EU4Agreement agreement("dependency", tokenizer);
+	ASSERT_EQ(agreement.type, "vassal");
+}
+
+
+TEST(EU4World_EU4DiplomacyTests, agreementsAreGroupedByKind)
+{
+	std::string input = "={\n";
+	input += "\talliance={ first=\"SWE\" second=\"DAN\" }\n";
+	input += "\tdependency={ first=\"SWE\" second=\"FIN\" subject_type=\"personal_union\" }\n";
+	input += "\tcasus_belli={ first=\"SWE\" second=\"NOR\" }\n";
+	input += "\troyal_marriage={ first=\"SWE\" second=\"POL\" }\n";
+	input += "}";
+	parsing::Tokenizer tokenizer(input);
+
+	const EU4Diplomacy diplomacy(tokenizer);
+	const auto agreements = diplomacy.getAgreements();
+	ASSERT_EQ(agreements.size(), 3);
+	ASSERT_EQ(agreements[0].type, "royal_marriage");
+	ASSERT_EQ(agreements[1].type, "alliance");
+	ASSERT_EQ(agreements[2].type, "union");
+	ASSERT_EQ(agreements[2].country2, "FIN");
+}
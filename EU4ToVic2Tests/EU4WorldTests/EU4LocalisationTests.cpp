@@ -0,0 +1,141 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/EU4World/EU4Localisation.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+
+
+namespace
+{
+
+// a folder of localisation files of its own for each test
+class EU4World_EU4LocalisationTests: public ::testing::Test
+{
+	protected:
+		void SetUp() override
+		{
+			folder = std::filesystem::temp_directory_path() / ("EU4LocalisationTests_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+			std::filesystem::remove_all(folder);
+			std::filesystem::create_directories(folder);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(folder);
+		}
+
+		std::string writeFile(const std::string& name, const std::string& contents)
+		{
+			const auto path = (folder / name).string();
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file << contents;
+			return path;
+		}
+
+		std::filesystem::path folder;
+};
+
+}
+
+
+
+TEST_F(EU4World_EU4LocalisationTests, textsAreReadInTheFilesLanguage)
+{
+	const auto fileName = writeFile("countries_l_english.yml", "\xEF\xBB\xBFl_english:\n SWE:0 \"Sweden\"\n SWE_ADJ:0 \"Swedish\"\n");
+
+	EU4Localisation theLocalisation;
+	theLocalisation.ReadFromFile(fileName);
+
+	ASSERT_EQ(theLocalisation.GetText("SWE", "english"), "Sweden");
+	ASSERT_EQ(theLocalisation.GetText("SWE_ADJ", "english"), "Swedish");
+	ASSERT_EQ(theLocalisation.GetText("SWE", "french"), "");
+}
+
+
+TEST_F(EU4World_EU4LocalisationTests, lastLineIsReadWithoutANewline)
+{
+	const auto fileName = writeFile("countries_l_english.yml", "l_english:\r\n SWE:0 \"Sweden\"\r\n FRA:0 \"France\"");
+
+	EU4Localisation theLocalisation;
+	theLocalisation.ReadFromFile(fileName);
+
+	ASSERT_EQ(theLocalisation.GetText("SWE", "english"), "Sweden");
+	ASSERT_EQ(theLocalisation.GetText("FRA", "english"), "France");
+}
+
+
+TEST_F(EU4World_EU4LocalisationTests, filesWithoutALanguageAreIgnored)
+{
+	const auto fileName = writeFile("countries.yml", " SWE:0 \"Sweden\"\n");
+
+	EU4Localisation theLocalisation;
+	theLocalisation.ReadFromFile(fileName);
+
+	ASSERT_TRUE(theLocalisation.GetTextInEachLanguage("SWE").empty());
+}
+
+
+TEST_F(EU4World_EU4LocalisationTests, keysTurnedDownByTheFilterAreSkipped)
+{
+	const auto fileName = writeFile("countries_l_english.yml", "l_english:\n SWE:0 \"Sweden\"\n swedish:0 \"Swedish\"\n");
+
+	EU4Localisation theLocalisation;
+	theLocalisation.ReadFromFile(fileName, [](std::string_view key) { return key == "SWE"; });
+
+	ASSERT_EQ(theLocalisation.GetText("SWE", "english"), "Sweden");
+	ASSERT_TRUE(theLocalisation.GetTextInEachLanguage("swedish").empty());
+}
+
+
+TEST_F(EU4World_EU4LocalisationTests, laterFilesReplaceEarlierOnesWhenReadTogether)
+{
+	std::vector<std::string> fileNames;
+	for (int i = 0; i < 20; i++)
+	{
+		fileNames.push_back(writeFile("countries_" + std::to_string(i) + "_l_english.yml", "l_english:\n SWE:0 \"Sweden " + std::to_string(i) + "\"\n"));
+	}
+	fileNames.push_back(writeFile("countries_l_french.yml", "l_french:\n SWE:0 \"Suede\"\n"));
+
+	EU4Localisation theLocalisation;
+	parsing::WorkerPool pool(4);
+	theLocalisation.ReadFromFiles(fileNames, {}, pool);
+
+	ASSERT_EQ(theLocalisation.GetText("SWE", "english"), "Sweden 19");
+	ASSERT_EQ(theLocalisation.GetText("SWE", "french"), "Suede");
+}
+
+
+TEST_F(EU4World_EU4LocalisationTests, missingFilesAreSkipped)
+{
+	const auto fileName = writeFile("countries_l_english.yml", "l_english:\n SWE:0 \"Sweden\"\n");
+
+	EU4Localisation theLocalisation;
+	parsing::WorkerPool pool(2);
+	theLocalisation.ReadFromFiles({ (folder / "missing_l_english.yml").string(), fileName }, {}, pool);
+
+	ASSERT_EQ(theLocalisation.GetText("SWE", "english"), "Sweden");
+}
@@ -0,0 +1,67 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/EU4World/MapAreaData.h"
+#include <string>
+
+
+
+TEST(EU4World_MapAreaDataTests, countryStatesAreReadFromEachArea)
+{
+	std::string input = "{\n";
+	input += "\tfinland_area={\n";
+	input += "\t\tstate={\n";
+	input += "\t\t\tarea=finland_area\n";
+	input += "\t\t\tcountry_state={ prosperity=12.500 country=\"SWE\" }\n";
+	input += "\t\t\tcountry_state={ country=\"RUS\" }\n";
+	input += "\t\t}\n";
+	input += "\t\tinvestments={ tag=\"SWE\" }\n";
+	input += "\t}\n";
+	input += "\tsvealand_area={ state={ country_state={ prosperity=100.000 country=\"SWE\" } } }\n";
+	input += "\tempty_area={ }\n";
+	input += "}";
+	parsing::Tokenizer tokenizer(input);
+
+	const EU4::MapAreaData mapAreaData(tokenizer);
+	const auto& countryStates = mapAreaData.getCountryStates();
+	ASSERT_EQ(countryStates.size(), 3);
+	ASSERT_EQ(countryStates[0].area, "finland_area");
+	ASSERT_EQ(countryStates[0].tag, "SWE");
+	ASSERT_EQ(countryStates[0].prosperity, 12.5);
+	ASSERT_EQ(countryStates[1].tag, "RUS");
+	ASSERT_EQ(countryStates[1].prosperity, 0.0);
+	ASSERT_EQ(countryStates[2].area, "svealand_area");
+	ASSERT_EQ(countryStates[2].prosperity, 100.0);
+}
+
+
+TEST(EU4World_MapAreaDataTests, onlyTheFirstStateOfAnAreaCounts)
+{
+	std::string input = "={ finland_area={ state={ country_state={ country=\"SWE\" } } state={ country_state={ country=\"RUS\" } } } }";
+	parsing::Tokenizer tokenizer(input);
+
+	const EU4::MapAreaData mapAreaData(tokenizer);
+	ASSERT_EQ(mapAreaData.getCountryStates().size(), 1);
+	ASSERT_EQ(mapAreaData.getCountryStates()[0].tag, "SWE");
+}
@@ -24,6 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "gtest/gtest.h"
 #include "../EU4toV2/Source/EU4World/Provinces/ProvinceBuildings.h"
 #include <sstream>
+#include <string>
 
 
 
@@ -68,4 +69,14 @@ TEST(EU4World_BuildingsTests, matchingBuildingReturnsTrue)
 
 	EU4::ProvinceBuildings theBuildings(input);
 	ASSERT_TRUE(theBuildings.hasBuilding("theBuilding"));
-}
\ No newline at end of file
+}
+
+TEST(EU4World_BuildingsTests, buildingsCanBeReadFromATokenizer)
+{
+	std::string input = "={\n\ttheBuilding=yes\n\tanotherBuilding=yes\n}";
+	parsing::Tokenizer tokenizer(input);
+
+	EU4::ProvinceBuildings theBuildings(tokenizer);
+	ASSERT_EQ(theBuildings.getBuildings().size(), 2);
+	ASSERT_TRUE(theBuildings.hasBuilding("anotherBuilding"));
+}
@@ -375,7 +375,7 @@ TEST(EU4World_ProvinceHistoryTests, noCultureOrReligionChangeGivesEasyPopRatios)
 	input << "}";
 	EU4::ProvinceHistory theHistory(input);
 
-	std::vector<EU4::PopRatio> ratios = theHistory.getPopRatios();
+	const auto& ratios = theHistory.getPopRatios();
 
 	ASSERT_EQ(ratios.size(), 1);
 	ASSERT_EQ(ratios[0].getCulture(), "theCulture");
@@ -399,7 +399,7 @@ TEST(EU4World_ProvinceHistoryTests, endCultureOrReligionChangeGivesSimpleChanged
 	input << "}";
 	EU4::ProvinceHistory theHistory(input);
 
-	std::vector<EU4::PopRatio> ratios = theHistory.getPopRatios();
+	const auto& ratios = theHistory.getPopRatios();
 
 	ASSERT_EQ(ratios.size(), 2);
 	ASSERT_EQ(ratios[0].getCulture(), "theCulture");
@@ -428,7 +428,7 @@ TEST(EU4World_ProvinceHistoryTests, pastCultureOrReligionChangeGivesDecayedRatio
 	input << "}";
 	EU4::ProvinceHistory theHistory(input);
 
-	std::vector<EU4::PopRatio> ratios = theHistory.getPopRatios();
+	const auto& ratios = theHistory.getPopRatios();
 
 	ASSERT_EQ(ratios.size(), 2);
 	ASSERT_EQ(ratios[0].getCulture(), "theCulture");
@@ -459,7 +459,7 @@ TEST(EU4World_ProvinceHistoryTests, multipleCultureOrReligionChangeGivesComplexR
 	input << "}";
 	EU4::ProvinceHistory theHistory(input);
 
-	std::vector<EU4::PopRatio> ratios = theHistory.getPopRatios();
+	const auto& ratios = theHistory.getPopRatios();
 
 	ASSERT_EQ(ratios.size(), 3);
 	ASSERT_EQ(ratios[0].getCulture(), "theCulture");
@@ -24,6 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "gtest/gtest.h"
 #include "../EU4toV2/Source/EU4World/Provinces/ProvinceModifier.h"
 #include <sstream>
+#include <string>
 
 
 
@@ -46,4 +47,13 @@ TEST(EU4World_ProvinceModiferTests, modifierCanBeSet)
 
 	EU4::ProvinceModifier theModifier(input);
 	ASSERT_EQ(theModifier.getModifier(), "theModifier");
-}
\ No newline at end of file
+}
+
+TEST(EU4World_ProvinceModiferTests, modifierCanBeReadFromATokenizer)
+{
+	std::string input = "={\n\tmodifier=\"theModifier\"\n\tdate=1444.11.11\n}";
+	parsing::Tokenizer tokenizer(input);
+
+	EU4::ProvinceModifier theModifier(tokenizer);
+	ASSERT_EQ(theModifier.getModifier(), "theModifier");
+}
@@ -25,6 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../EU4toV2/Source/EU4World/Provinces/Provinces.h"
 #include "../EU4toV2/Source/Mappers/ProvinceMappings/ProvinceMapper.h"
 #include <sstream>
+#include <string>
 
 
 
@@ -103,6 +104,85 @@ TEST(EU4World_ProvincesTests, canGetProvince)
 	ASSERT_EQ(theProvinces.getProvince(1).getNum(), 1);
 }
 
+TEST(EU4World_ProvincesTests, provincesAreTheSameForAnyThreadCount)
+{
+	std::string input = "={\n";
+	for (int i = 1; i <= 50; i++)
+	{
+		input += "-" + std::to_string(i) + "={ name=\"Province" + std::to_string(i) + "\" owner=SWE ";
+		input += "base_tax=" + std::to_string(i % 7) + " base_production=" + std::to_string(i % 5) + " }\n";
+	}
+	input += "}";
+
+	std::stringstream buildingsInput;
+	EU4::Buildings buildings(buildingsInput);
+
+	std::stringstream modifiersInput;
+	EU4::Modifiers modifiers(modifiersInput);
+
+	parsing::Tokenizer sequentialTokenizer(input);
+	parsing::WorkerPool sequentialPool(0);
+	EU4::Provinces sequentialProvinces(sequentialTokenizer, buildings, modifiers, sequentialPool);
+	parsing::Tokenizer parallelTokenizer(input);
+	parsing::WorkerPool parallelPool(4);
+	EU4::Provinces parallelProvinces(parallelTokenizer, buildings, modifiers, parallelPool);
+
+	ASSERT_EQ(sequentialProvinces.getAllProvinces().size(), 50);
+	ASSERT_EQ(parallelProvinces.getAllProvinces().size(), 50);
+	for (int i = 1; i <= 50; i++)
+	{
+		ASSERT_EQ(parallelProvinces.getProvince(i).getName(), sequentialProvinces.getProvince(i).getName());
+		ASSERT_EQ(parallelProvinces.getProvince(i).getTotalWeight(), sequentialProvinces.getProvince(i).getTotalWeight());
+	}
+}
+
+
+TEST(EU4World_ProvincesTests, provincesReadBackFromASnapshot)
+{
+	std::string input = "={\n";
+	input += "-1={ name=\"Stockholm\" owner=SWE controller=DAN cores={ SWE NOR } culture=swedish religion=catholic ";
+	input += "base_tax=5 base_production=3 base_manpower=2 trade_goods=grain buildings={ temple=yes } ";
+	input += "history={ 1500.1.1={ owner=SWE culture=danish } } }\n";
+	input += "-2={ name=\"Uppland\" }\n";
+	input += "}";
+
+	std::stringstream buildingsInput;
+	EU4::Buildings buildings(buildingsInput);
+
+	std::stringstream modifiersInput;
+	EU4::Modifiers modifiers(modifiersInput);
+
+	parsing::Tokenizer tokenizer(input);
+	parsing::WorkerPool pool(0);
+	EU4::Provinces parsedProvinces(tokenizer, buildings, modifiers, pool);
+
+	std::stringstream output;
+	parsing::SnapshotWriter writer(output, 1, 2);
+	parsedProvinces.writeSnapshot(writer);
+	const auto snapshotText = output.str();
+	parsing::SnapshotReader reader(snapshotText, 1, 2);
+	EU4::Provinces snapshotProvinces(reader);
+
+	ASSERT_TRUE(reader.atEnd());
+	ASSERT_EQ(snapshotProvinces.getAllProvinces().size(), 2);
+	for (int i = 1; i <= 2; i++)
+	{
+		const auto& parsedProvince = parsedProvinces.getProvince(i);
+		const auto& snapshotProvince = snapshotProvinces.getProvince(i);
+		ASSERT_EQ(snapshotProvince.getName(), parsedProvince.getName());
+		ASSERT_EQ(snapshotProvince.getOwnerString(), parsedProvince.getOwnerString());
+		ASSERT_EQ(snapshotProvince.getControllerString(), parsedProvince.getControllerString());
+		ASSERT_EQ(snapshotProvince.getCores(), parsedProvince.getCores());
+		ASSERT_EQ(snapshotProvince.getTradeGoods(), parsedProvince.getTradeGoods());
+		ASSERT_EQ(snapshotProvince.getBaseTax(), parsedProvince.getBaseTax());
+		ASSERT_EQ(snapshotProvince.getTotalWeight(), parsedProvince.getTotalWeight());
+		ASSERT_EQ(snapshotProvince.hasBuilding("temple"), parsedProvince.hasBuilding("temple"));
+		ASSERT_EQ(snapshotProvince.getFirstOwnedDate(), parsedProvince.getFirstOwnedDate());
+		ASSERT_EQ(snapshotProvince.getPopRatios().size(), parsedProvince.getPopRatios().size());
+	}
+}
+
+
 /* No longet tested, as it requires file I/O
 TEST(EU4World_ProvincesTests, checkAllProvincesMappedNotesMissingProvince)
 {
@@ -24,6 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "gtest/gtest.h"
 #include "../EU4toV2/Source/EU4World/Regions/Regions.h"
 #include "../EU4toV2/Source/EU4World/Regions/Areas.h"
+#include "../EU4toV2/Source/Parsing/Snapshot.h"
 #include <sstream>
 
 
@@ -113,4 +114,138 @@ TEST(EU4World_RegionsTests, newStyleAreasProvideProvinces)
 	EU4::Regions theRegions(theAreas, regionsInput);
 
 	ASSERT_TRUE(theRegions.provinceInRegion(1, "test_region"));
+}
+
+
+TEST(EU4World_RegionsTests, newStyleAreasAreRegionsToo)
+{
+	std::stringstream regionsInput;
+	regionsInput << "test_region = {\n";
+	regionsInput << "\tareas = {\n";
+	regionsInput << "\t\ttest_area\n";
+	regionsInput << "\t}\n";
+	regionsInput << "}";
+
+	std::stringstream areasInput;
+	areasInput << "test_area = {\n";
+	areasInput << "\t1 2 3\n";
+	areasInput << "}\n";
+	areasInput << "other_area = {\n";
+	areasInput << "\t4\n";
+	areasInput << "}";
+	EU4::areas theAreas(areasInput);
+
+	EU4::Regions theRegions(theAreas, regionsInput);
+
+	ASSERT_TRUE(theRegions.provinceInRegion(4, "other_area"));
+	ASSERT_FALSE(theRegions.provinceInRegion(4, "test_region"));
+	ASSERT_FALSE(theRegions.provinceInRegion(1, "missing_region"));
+}
+
+
+TEST(EU4World_RegionsTests, provincesInTwoAreasAreInBothAreasRegions)
+{
+	std::stringstream regionsInput;
+	regionsInput << "first_region = {\n";
+	regionsInput << "\tareas = {\n";
+	regionsInput << "\t\tfirst_area\n";
+	regionsInput << "\t}\n";
+	regionsInput << "}\n";
+	regionsInput << "second_region = {\n";
+	regionsInput << "\tareas = {\n";
+	regionsInput << "\t\tsecond_area\n";
+	regionsInput << "\t}\n";
+	regionsInput << "}";
+
+	std::stringstream areasInput;
+	areasInput << "first_area = {\n";
+	areasInput << "\t1 2\n";
+	areasInput << "}\n";
+	areasInput << "second_area = {\n";
+	areasInput << "\t2 3\n";
+	areasInput << "}";
+	EU4::areas theAreas(areasInput);
+
+	EU4::Regions theRegions(theAreas, regionsInput);
+
+	ASSERT_TRUE(theRegions.provinceInRegion(2, "first_region"));
+	ASSERT_TRUE(theRegions.provinceInRegion(2, "second_region"));
+	ASSERT_FALSE(theRegions.provinceInRegion(3, "first_region"));
+}
+
+
+TEST(EU4World_RegionsTests, regionsSurviveASnapshot)
+{
+	std::stringstream regionsInput;
+	regionsInput << "test_region = {\n";
+	regionsInput << "\tareas = {\n";
+	regionsInput << "\t\ttest_area\n";
+	regionsInput << "\t}\n";
+	regionsInput << "}";
+
+	std::stringstream areasInput;
+	areasInput << "test_area = {\n";
+	areasInput << "\t1 2 3\n";
+	areasInput << "}";
+	EU4::areas theAreas(areasInput);
+
+	std::ostringstream output;
+	{
+		parsing::SnapshotWriter snapshot(output, 1, 1);
+		EU4::Regions(theAreas, regionsInput).writeSnapshot(snapshot);
+	}
+	const auto contents = output.str();
+	parsing::SnapshotReader snapshot(contents, 1, 1);
+	EU4::Regions theRegions(theAreas, snapshot);
+
+	ASSERT_TRUE(theRegions.provinceInRegion(3, "test_region"));
+	ASSERT_FALSE(theRegions.provinceInRegion(4, "test_region"));
+}
+
+
+TEST(EU4World_RegionsTests, regionsCanBeAskedAboutByIndex)
+{
+	std::stringstream regionsInput;
+	regionsInput << "test_region = {\n";
+	regionsInput << "\tareas = {\n";
+	regionsInput << "\t\ttest_area\n";
+	regionsInput << "\t}\n";
+	regionsInput << "}";
+
+	std::stringstream areasInput;
+	areasInput << "test_area = {\n";
+	areasInput << "\t1 2 3\n";
+	areasInput << "}";
+	EU4::areas theAreas(areasInput);
+
+	EU4::Regions theRegions(theAreas, regionsInput);
+
+	const auto index = theRegions.getRegionIndex("test_region");
+	ASSERT_TRUE(index);
+	ASSERT_TRUE(theRegions.provinceInRegion(1, *index));
+	ASSERT_FALSE(theRegions.provinceInRegion(4, *index));
+	ASSERT_TRUE(theRegions.getRegionIndex("test_area"));
+	ASSERT_FALSE(theRegions.getRegionIndex("missing_region"));
+	ASSERT_FALSE(theRegions.provinceInRegion(1, *index + 100));
+}
+
+
+TEST(EU4World_RegionsTests, regionsWithoutAnyAreasHoldNoProvinces)
+{
+	std::stringstream regionsInput;
+	regionsInput << "test_region = {\n";
+	regionsInput << "\tareas = {\n";
+	regionsInput << "\t\ttest_area\n";
+	regionsInput << "\t}\n";
+	regionsInput << "}";
+
+	std::stringstream areasInput;
+	EU4::areas theAreas(areasInput);
+
+	EU4::Regions theRegions(theAreas, regionsInput);
+
+	const auto index = theRegions.getRegionIndex("test_region");
+	ASSERT_TRUE(index);
+	ASSERT_FALSE(theRegions.provinceInRegion(1, *index));
+	ASSERT_FALSE(theRegions.provinceInRegion(1, "test_region"));
 }
\ No newline at end of file
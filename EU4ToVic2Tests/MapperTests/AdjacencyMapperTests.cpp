@@ -0,0 +1,115 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Mappers/AdjacencyMapper.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+// adjacencies.bin for the given provinces' neighbors, each record recordWords long with the neighbor second
+std::string makeAdjacencies(const std::vector<std::vector<uint32_t>>& provinces, size_t recordWords)
+{
+	std::string contents;
+	const auto addWord = [&contents](uint32_t word) {
+		contents.append(reinterpret_cast<const char*>(&word), sizeof(word));
+	};
+	for (const auto& neighbors: provinces)
+	{
+		addWord(static_cast<uint32_t>(neighbors.size()));
+		for (const auto neighbor: neighbors)
+		{
+			addWord(0);
+			addWord(neighbor);
+			for (size_t word = 2; word < recordWords; word++)
+			{
+				addWord(77);
+			}
+		}
+	}
+	return contents;
+}
+
+
+std::vector<int> getNeighbors(const mappers::adjacencyMapper& theMapper, int province)
+{
+	const auto adjacencies = theMapper.getAdjacencies(province);
+	return std::vector<int>(adjacencies.begin(), adjacencies.end());
+}
+
+}
+
+
+
+TEST(Mappers_AdjacencyMapperTests, vanillaAdjacenciesCanBeRead)
+{
+	const mappers::adjacencyMapper theMapper(makeAdjacencies({ { 1 }, { 0, 2 }, { 1 } }, 5), "vanilla");
+
+	ASSERT_EQ(getNeighbors(theMapper, 0), std::vector<int>({ 1 }));
+	ASSERT_EQ(getNeighbors(theMapper, 1), std::vector<int>({ 0, 2 }));
+	ASSERT_EQ(getNeighbors(theMapper, 2), std::vector<int>({ 1 }));
+}
+
+
+TEST(Mappers_AdjacencyMapperTests, AHDAdjacenciesCanBeRead)
+{
+	const mappers::adjacencyMapper theMapper(makeAdjacencies({ {}, { 2, 3 } }, 7), "AHD");
+
+	ASSERT_TRUE(theMapper.getAdjacencies(0).empty());
+	ASSERT_EQ(getNeighbors(theMapper, 1), std::vector<int>({ 2, 3 }));
+}
+
+
+TEST(Mappers_AdjacencyMapperTests, HODAdjacenciesCanBeRead)
+{
+	const mappers::adjacencyMapper theMapper(makeAdjacencies({ { 4 }, { 5, 6, 7 } }, 9), "HOD");
+
+	ASSERT_EQ(getNeighbors(theMapper, 0), std::vector<int>({ 4 }));
+	ASSERT_EQ(getNeighbors(theMapper, 1), std::vector<int>({ 5, 6, 7 }));
+}
+
+
+TEST(Mappers_AdjacencyMapperTests, provincesOutsideTheGraphHaveNoNeighbors)
+{
+	const mappers::adjacencyMapper theMapper(makeAdjacencies({ { 1 }, { 0 } }, 9), "HOD");
+
+	ASSERT_TRUE(theMapper.getAdjacencies(-1).empty());
+	ASSERT_TRUE(theMapper.getAdjacencies(2).empty());
+}
+
+
+TEST(Mappers_AdjacencyMapperTests, truncatedProvincesAreDropped)
+{
+	auto contents = makeAdjacencies({ { 1 }, { 0, 2 } }, 9);
+	contents.resize(contents.size() - 1);
+
+	const mappers::adjacencyMapper theMapper(contents, "HOD");
+
+	ASSERT_EQ(getNeighbors(theMapper, 0), std::vector<int>({ 1 }));
+	ASSERT_TRUE(theMapper.getAdjacencies(1).empty());
+}
\ No newline at end of file
@@ -174,7 +174,8 @@ TEST(Mappers_CultureMapperTests, regionDistinguisherWrongNoMatch)
 	mappers::CultureMapper theMapper(input);
 
 	mockRegions regions;
-	EXPECT_CALL(regions, provinceInRegion(42, "theRegion")).WillOnce(testing::Return(false));
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(false));
 
 	std::optional<std::string> match = theMapper.cultureMatch(regions, "sourceCulture", "", 42, "");
 	ASSERT_FALSE(match);
@@ -193,7 +194,8 @@ TEST(Mappers_CultureMapperTests, regionDistinguisherRightMatch)
 	mappers::CultureMapper theMapper(input);
 
 	mockRegions regions;
-	EXPECT_CALL(regions, provinceInRegion(42, "theRegion")).WillOnce(testing::Return(true));
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(true));
 
 	std::optional<std::string> match = theMapper.cultureMatch(regions, "sourceCulture", "", 42, "");
 	ASSERT_TRUE(match);
@@ -214,4 +216,141 @@ TEST(Mappers_CultureMapperTests, multipleSourceCulturesMatch)
 	mockRegions regions;
 	std::optional<std::string> match = theMapper.cultureMatch(regions, "sourceCulture2", "", -1, "");
 	ASSERT_TRUE(match);
+}
+
+
+TEST(Mappers_CultureMapperTests, firstMatchingLinkWins)
+{
+	std::stringstream input;
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = ownerCulture\n";
+	input << "\towner = OWN\n";
+	input << "}\n";
+	input << "link = {\n";
+	input << "\teu4 = otherCulture\n";
+	input << "\tvic2 = otherDestination\n";
+	input << "}\n";
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = fallbackCulture\n";
+	input << "}";
+
+	mappers::CultureMapper theMapper(input);
+
+	mockRegions regions;
+	ASSERT_EQ(*theMapper.cultureMatch(regions, "sourceCulture", "", -1, "OWN"), "ownerCulture");
+	ASSERT_EQ(*theMapper.cultureMatch(regions, "sourceCulture", "", -1, "NOT"), "fallbackCulture");
+}
+
+
+TEST(Mappers_CultureMapperTests, symbolsMatchLikeNames)
+{
+	std::stringstream input;
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = destinationCulture\n";
+	input << "\treligion = theReligion\n";
+	input << "\towner = OWN\n";
+	input << "}";
+
+	mappers::CultureMapper theMapper(input);
+
+	mockRegions regions;
+	std::optional<std::string> match = theMapper.cultureMatch(
+		regions,
+		parsing::CultureSymbol("sourceCulture"),
+		parsing::ReligionSymbol("theReligion"),
+		-1,
+		parsing::TagSymbol("OWN")
+	);
+	ASSERT_EQ(*match, "destinationCulture");
+	ASSERT_FALSE(theMapper.cultureMatch(regions, parsing::CultureSymbol("sourceCulture"), parsing::ReligionSymbol(), -1, parsing::TagSymbol("OWN")));
+}
+
+
+TEST(Mappers_CultureMapperTests, answersAreRememberedForTheSameRegions)
+{
+	std::stringstream input;
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = destinationCulture\n";
+	input << "\tregion = theRegion";
+	input << "}";
+
+	mappers::CultureMapper theMapper(input);
+
+	mockRegions regions;
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(true));
+	ASSERT_TRUE(theMapper.cultureMatch(regions, "sourceCulture", "", 42, ""));
+	ASSERT_TRUE(theMapper.cultureMatch(regions, "sourceCulture", "", 42, ""));
+
+	mockRegions otherRegions;
+	EXPECT_CALL(otherRegions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(otherRegions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(false));
+	ASSERT_FALSE(theMapper.cultureMatch(otherRegions, "sourceCulture", "", 42, ""));
+}
+
+
+TEST(Mappers_CultureMapperTests, answersAreForgottenForNewRegionsAtTheSameAddress)
+{
+	std::stringstream input;
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = destinationCulture\n";
+	input << "\tregion = theRegion";
+	input << "}";
+
+	mappers::CultureMapper theMapper(input);
+
+	std::optional<mockRegions> regions;
+	regions.emplace();
+	EXPECT_CALL(*regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(*regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(true));
+	ASSERT_TRUE(theMapper.cultureMatch(*regions, "sourceCulture", "", 42, ""));
+
+	regions.reset();
+	regions.emplace();
+	EXPECT_CALL(*regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(*regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(false));
+	ASSERT_FALSE(theMapper.cultureMatch(*regions, "sourceCulture", "", 42, ""));
+}
+
+
+TEST(Mappers_CultureMapperTests, regionNamesAreLookedUpOncePerRegions)
+{
+	std::stringstream input;
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = destinationCulture\n";
+	input << "\tregion = theRegion";
+	input << "}";
+
+	mappers::CultureMapper theMapper(input);
+
+	mockRegions regions;
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::optional<size_t>(3)));
+	EXPECT_CALL(regions, provinceInRegion(42, size_t(3))).WillOnce(testing::Return(true));
+	EXPECT_CALL(regions, provinceInRegion(43, size_t(3))).WillOnce(testing::Return(false));
+	ASSERT_TRUE(theMapper.cultureMatch(regions, "sourceCulture", "", 42, ""));
+	ASSERT_FALSE(theMapper.cultureMatch(regions, "sourceCulture", "", 43, ""));
+}
+
+
+TEST(Mappers_CultureMapperTests, unknownRegionNeverMatches)
+{
+	std::stringstream input;
+	input << "link = {\n";
+	input << "\teu4 = sourceCulture\n";
+	input << "\tvic2 = destinationCulture\n";
+	input << "\tregion = theRegion";
+	input << "}";
+
+	mappers::CultureMapper theMapper(input);
+
+	mockRegions regions;
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillOnce(testing::Return(std::nullopt));
+	EXPECT_CALL(regions, provinceInRegion(testing::_, testing::An<size_t>())).Times(0);
+	ASSERT_FALSE(theMapper.cultureMatch(regions, "sourceCulture", "", 42, ""));
 }
\ No newline at end of file
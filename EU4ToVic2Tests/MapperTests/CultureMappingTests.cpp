@@ -140,7 +140,8 @@ TEST(Mappers_CultureMappingTests, regionDistinguisherWrongNoMatch)
 	mappers::cultureMapping theMapping("sourceCulture", "destCulture", distinguishers);
 
 	mockRegions regions;
-	EXPECT_CALL(regions, provinceInRegion(42, "theRegion")).WillOnce(testing::Return(false));
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillRepeatedly(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(false));
 
 	std::optional<std::string> match = theMapping.cultureMatch(regions, "sourceCulture", "", 42, "");
 	ASSERT_FALSE(match);
@@ -155,7 +156,8 @@ TEST(Mappers_CultureMappingTests, regionDistinguisherRightMatch)
 	mappers::cultureMapping theMapping("sourceCulture", "destCulture", distinguishers);
 
 	mockRegions regions;
-	EXPECT_CALL(regions, provinceInRegion(42, "theRegion")).WillOnce(testing::Return(true));
+	EXPECT_CALL(regions, getRegionIndex("theRegion")).WillRepeatedly(testing::Return(std::optional<size_t>(0)));
+	EXPECT_CALL(regions, provinceInRegion(42, size_t(0))).WillOnce(testing::Return(true));
 
 	std::optional<std::string> match = theMapping.cultureMatch(regions, "sourceCulture", "", 42, "");
 	ASSERT_TRUE(match);
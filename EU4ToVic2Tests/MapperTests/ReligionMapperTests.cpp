@@ -73,4 +73,16 @@ TEST(Mappers_ReligionMapperTests, correctRuleMatches)
 
 	std::optional<std::string> vic2Religion = theMapper.getVic2Religion("eu4Religion2");
 	ASSERT_EQ(vic2Religion, "vic2Religion2");
+}
+
+
+TEST(Mappers_ReligionMapperTests, vic2ReligionCanBeFoundBySymbol)
+{
+	std::stringstream input;
+	input << "link = { v2 = vic2Religion eu4 = eu4Religion }";
+
+	mappers::ReligionMapper theMapper(input);
+
+	std::optional<std::string> vic2Religion = theMapper.getVic2Religion(parsing::ReligionSymbol("eu4Religion"));
+	ASSERT_EQ(vic2Religion, "vic2Religion");
 }
\ No newline at end of file
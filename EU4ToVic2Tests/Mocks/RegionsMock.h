@@ -29,5 +29,6 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 class mockRegions: public EU4::Regions
 {
 	public:
-		MOCK_CONST_METHOD2(provinceInRegion, bool(int province, const std::string& regionName));
+		MOCK_CONST_METHOD1(getRegionIndex, std::optional<size_t>(const std::string& regionName));
+		MOCK_CONST_METHOD2(provinceInRegion, bool(int province, size_t regionIndex));
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/Arena.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+class Counted
+{
+	public:
+		explicit Counted(int& _destroyed): destroyed(_destroyed) {}
+		~Counted() { destroyed++; }
+
+	private:
+		int& destroyed;
+};
+
+}
+
+
+TEST(Parsing_ArenaTests, allocationsAreAlignedAndCounted)
+{
+	parsing::Arena arena;
+
+	const auto first = arena.allocate(3, 1);
+	const auto second = arena.allocate(sizeof(double), alignof(double));
+	const auto third = arena.allocate(64, 32);
+
+	ASSERT_NE(first, second);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(double), 0);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(third) % 32, 0);
+	ASSERT_EQ(arena.getAllocations(), 3);
+	ASSERT_EQ(arena.getBytes(), 3 + sizeof(double) + 64);
+	ASSERT_EQ(arena.getChunkCount(), 1);
+}
+
+
+TEST(Parsing_ArenaTests, largeAllocationsGetAChunkOfTheirOwn)
+{
+	parsing::Arena arena;
+
+	arena.allocate(10, 1);
+	arena.allocate(100000, 8);
+
+	ASSERT_EQ(arena.getChunkCount(), 2);
+}
+
+
+TEST(Parsing_ArenaTests, containersUseTheArenaInScope)
+{
+	parsing::Arena arena;
+	{
+		parsing::ArenaScope scope(arena);
+		std::pmr::vector<int> numbers(parsing::getCurrentResource());
+		numbers.push_back(1);
+		ASSERT_EQ(numbers.get_allocator().resource(), &arena);
+	}
+
+	ASSERT_EQ(arena.getAllocations(), 1);
+	ASSERT_EQ(parsing::getCurrentResource(), std::pmr::get_default_resource());
+}
+
+
+TEST(Parsing_ArenaTests, scopesNest)
+{
+	parsing::Arena outerArena;
+	parsing::Arena innerArena;
+
+	parsing::ArenaScope outerScope(outerArena);
+	{
+		parsing::ArenaScope innerScope(innerArena);
+		ASSERT_EQ(parsing::getCurrentResource(), &innerArena);
+	}
+	ASSERT_EQ(parsing::getCurrentResource(), &outerArena);
+}
+
+
+TEST(Parsing_ArenaTests, arenaObjectsAreDestroyedButNotFreedOneByOne)
+{
+	int destroyed = 0;
+	parsing::Arena arena;
+	{
+		parsing::ArenaScope scope(arena);
+		auto unique = parsing::makeArenaPtr<Counted>(destroyed);
+		auto shared = parsing::makeArenaShared<Counted>(destroyed);
+	}
+
+	ASSERT_EQ(destroyed, 2);
+	ASSERT_EQ(arena.getAllocations(), 2);
+}
+
+
+TEST(Parsing_ArenaTests, objectsWithoutAnArenaGoToTheHeap)
+{
+	int destroyed = 0;
+	const auto heapObjectsBefore = parsing::Arena::getCounters().heapObjects;
+	{
+		auto unique = parsing::makeArenaPtr<Counted>(destroyed);
+		auto shared = parsing::makeArenaShared<Counted>(destroyed);
+	}
+
+	ASSERT_EQ(destroyed, 2);
+	ASSERT_EQ(parsing::Arena::getCounters().heapObjects, heapObjectsBefore + 2);
+}
+
+
+TEST(Parsing_ArenaTests, countersIncludeFinishedScopes)
+{
+	const auto before = parsing::Arena::getCounters();
+	parsing::Arena arena;
+	{
+		parsing::ArenaScope scope(arena);
+		std::pmr::vector<std::string> strings(parsing::getCurrentResource());
+		strings.reserve(4);
+	}
+
+	const auto after = parsing::Arena::getCounters();
+	ASSERT_EQ(after.allocations, before.allocations + 1);
+	ASSERT_EQ(after.bytes, before.bytes + 4 * sizeof(std::string));
+	ASSERT_EQ(after.chunks, before.chunks + 1);
+}
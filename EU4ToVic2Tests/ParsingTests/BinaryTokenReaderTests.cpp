@@ -0,0 +1,221 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/BinaryTokenReader.h"
+#include "../EU4toV2/Source/Parsing/BinaryTokenTable.h"
+#include "../EU4toV2/Source/Parsing/BufferParser.h"
+#include "../EU4toV2/Source/Parsing/ParsingHelpers.h"
+#include "../EU4toV2/Source/Parsing/Tokenizer.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+
+
+namespace
+{
+
+parsing::BinaryTokenTable makeTokens()
+{
+	std::stringstream input("0x284d date\n0x2dc0 owner\n0x2c69 provinces\n0x2b2e history");
+	return parsing::BinaryTokenTable(input);
+}
+
+// 1444.11.11, as hours since 5000 BC
+const std::string startDate("\x0c\x00\x10\x77\x5d\x03", 6);
+
+}
+
+
+
+TEST(Parsing_BinaryTokenReaderTests, binarySavesAreRecognised)
+{
+	ASSERT_TRUE(parsing::BinaryTokenReader::isBinarySave("EU4binM\x4d\x28"));
+	ASSERT_FALSE(parsing::BinaryTokenReader::isBinarySave("EU4txt"));
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, namedTokensAndStringsAreRead)
+{
+	const std::string input("EU4bin\xc0\x2d\x01\x00\x17\x00\x03\x00SWE", 17);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "owner");
+	ASSERT_EQ(*tokenizer.getNextToken(), "=");
+	ASSERT_EQ(*tokenizer.getNextToken(), "SWE");
+	ASSERT_FALSE(tokenizer.getNextToken());
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, stringsPointIntoTheSave)
+{
+	const std::string input("\x0f\x00\x06\x00Sweden", 10);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	const auto token = tokenizer.getNextToken();
+
+	ASSERT_EQ(*token, "Sweden");
+	ASSERT_EQ(token->data(), input.data() + 4);
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, numbersAreWrittenOut)
+{
+	const std::string input(
+		"\x0c\x00\xfb\xff\xff\xff"
+		"\x14\x00\x07\x00\x00\x00"
+		"\x0d\x00\xf4\x01\x00\x00"
+		"\x67\x01\x00\x40\x01\x00\x00\x00\x00\x00"
+		"\x0e\x00\x01"
+		"\x0e\x00\x00",
+		34
+	);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "-5");
+	ASSERT_EQ(*tokenizer.getNextToken(), "7");
+	ASSERT_EQ(*tokenizer.getNextToken(), "0.500");
+	ASSERT_EQ(*tokenizer.getNextToken(), "2.50000");
+	ASSERT_EQ(*tokenizer.getNextToken(), "yes");
+	ASSERT_EQ(*tokenizer.getNextToken(), "no");
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, blocksAreSkippedWhole)
+{
+	const std::string input("\x69\x2c\x01\x00\x03\x00\x0c\x00\x01\x00\x00\x00\x04\x00\xc0\x2d", 16);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "provinces");
+	ASSERT_EQ(tokenizer.getItemText().size(), 12);
+	ASSERT_EQ(*tokenizer.getNextToken(), "owner");
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, datesAreReadByTheirKeys)
+{
+	const auto input = std::string("\x4d\x28\x01\x00", 4) + startDate;
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "date");
+	ASSERT_EQ(*tokenizer.peekToken(), "=");
+	ASSERT_EQ(parsing::getDate(tokenizer), date(1444, 11, 11));
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, integersStayNumbers)
+{
+	const auto input = std::string("\xc0\x2d\x01\x00", 4) + startDate;
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "owner");
+	ASSERT_EQ(parsing::getInt(tokenizer), 56456976);
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, itemScriptWritesDateFieldsAsDates)
+{
+	const auto input = std::string("\x4d\x28\x01\x00", 4) + startDate + std::string("\xc0\x2d\x01\x00", 4) + startDate;
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	tokenizer.getNextToken();
+	ASSERT_EQ(tokenizer.getItemScript(), "= 1444.11.11 ");
+	tokenizer.getNextToken();
+	ASSERT_EQ(tokenizer.getItemScript(), "= 56456976 ");
+	ASSERT_TRUE(tokenizer.atEnd());
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, itemScriptWritesHistoryKeysAsDates)
+{
+	const auto input =
+		std::string("\x2e\x2b\x01\x00\x03\x00", 6) +
+		startDate +
+		std::string("\x01\x00\x03\x00\xc0\x2d\x01\x00\x0f\x00\x03\x00SWE\x04\x00\x04\x00", 19);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	tokenizer.getNextToken();
+	ASSERT_EQ(tokenizer.getItemScript(), "= { 1444.11.11 = { owner = \"SWE\" }\n}\n");
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, streamReadersGetTheItemAsText)
+{
+	const auto input = std::string("\x4d\x28\x01\x00", 4) + startDate + std::string("\xc0\x2d", 2);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	tokenizer.getNextToken();
+	std::string itemText;
+	parsing::readFromStream(tokenizer, [&itemText](std::istream& theStream) {
+		std::getline(theStream, itemText);
+	});
+
+	ASSERT_EQ(itemText, "= 1444.11.11 ");
+	ASSERT_EQ(*tokenizer.getNextToken(), "owner");
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, unknownIdsAreReadAsPlaceholdersAndCounted)
+{
+	const std::string input("\x34\x12\x34\x12\x35\x12", 6);
+	const auto tokens = makeTokens();
+	{
+		parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+		ASSERT_EQ(*tokenizer.getNextToken(), "__unknown_0x1234");
+		ASSERT_EQ(*tokenizer.getNextToken(), "__unknown_0x1234");
+		ASSERT_EQ(*tokenizer.getNextToken(), "__unknown_0x1235");
+	}
+
+	ASSERT_EQ(tokens.getMissingIdCount(), 2);
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, truncatedValuesThrowException)
+{
+	const std::string input("\x0c\x00\x01\x00", 4);
+	const auto tokens = makeTokens();
+	parsing::Tokenizer tokenizer(input, parsing::TokenizerSettings{ nullptr, &tokens });
+
+	ASSERT_THROW(tokenizer.getNextToken(), std::runtime_error);
+}
+
+
+TEST(Parsing_BinaryTokenReaderTests, datesAreDecodedFromHours)
+{
+	const auto theDate = parsing::decodeBinaryDate(56456976);
+
+	ASSERT_EQ(theDate.year, 1444);
+	ASSERT_EQ(theDate.month, 11);
+	ASSERT_EQ(theDate.day, 11);
+}
@@ -0,0 +1,89 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/BinaryTokenTable.h"
+#include <sstream>
+
+
+
+TEST(Parsing_BinaryTokenTableTests, unknownIdsHaveNoName)
+{
+	const parsing::BinaryTokenTable tokens;
+
+	ASSERT_EQ(tokens.getName(0x284d), "");
+}
+
+
+TEST(Parsing_BinaryTokenTableTests, hexIdsCanBeRead)
+{
+	std::stringstream input("0x284d date\n0x2dc0 owner");
+	const parsing::BinaryTokenTable tokens(input);
+
+	ASSERT_EQ(tokens.getName(0x284d), "date");
+	ASSERT_EQ(tokens.getName(0x2dc0), "owner");
+	ASSERT_EQ(tokens.size(), 2);
+}
+
+
+TEST(Parsing_BinaryTokenTableTests, decimalIdsCanBeRead)
+{
+	std::stringstream input("10317 date");
+	const parsing::BinaryTokenTable tokens(input);
+
+	ASSERT_EQ(tokens.getName(0x284d), "date");
+}
+
+
+TEST(Parsing_BinaryTokenTableTests, namesMayComeBeforeIds)
+{
+	std::stringstream input("date 0x284d");
+	const parsing::BinaryTokenTable tokens(input);
+
+	ASSERT_EQ(tokens.getName(0x284d), "date");
+}
+
+
+TEST(Parsing_BinaryTokenTableTests, commentsAndBlankLinesAreSkipped)
+{
+	std::stringstream input("# EU4 tokens\n\n0x284d date # the save date\n");
+	const parsing::BinaryTokenTable tokens(input);
+
+	ASSERT_EQ(tokens.getName(0x284d), "date");
+	ASSERT_EQ(tokens.size(), 1);
+}
+
+
+TEST(Parsing_BinaryTokenTableTests, idsLargerThanSixteenBitsAreIgnored)
+{
+	std::stringstream input("0x10000 date");
+	const parsing::BinaryTokenTable tokens(input);
+
+	ASSERT_EQ(tokens.size(), 0);
+}
+
+
+TEST(Parsing_BinaryTokenTableTests, missingFileThrowsException)
+{
+	ASSERT_THROW(parsing::BinaryTokenTable tokens("missingTokens.txt"), std::runtime_error);
+}
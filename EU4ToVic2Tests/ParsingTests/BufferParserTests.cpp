@@ -0,0 +1,243 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/ConversionContext.h"
+#include "../EU4toV2/Source/Parsing/BufferParser.h"
+#include "../EU4toV2/Source/Parsing/ParsingHelpers.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+
+TEST(Parsing_BufferParserTests, exactKeywordsAreDispatched)
+{
+	std::string input = "={ owner = SWE controller = DAN }";
+	parsing::Tokenizer tokenizer(input);
+
+	std::string owner;
+	std::string controller;
+	parsing::BufferParser parser;
+	parser.registerKeyword("owner", [&owner](std::string_view unused, parsing::Tokenizer& tokenizer) {
+		owner = parsing::getString(tokenizer);
+	});
+	parser.registerKeyword("controller", [&controller](std::string_view unused, parsing::Tokenizer& tokenizer) {
+		controller = parsing::getString(tokenizer);
+	});
+	parser.parseBuffer(tokenizer);
+
+	ASSERT_EQ(owner, "SWE");
+	ASSERT_EQ(controller, "DAN");
+}
+
+
+TEST(Parsing_BufferParserTests, patternsMatchWholeTokens)
+{
+	std::string input = "={ -1 = { } -22 = { } abc = { } }";
+	parsing::Tokenizer tokenizer(input);
+
+	std::vector<std::string> keys;
+	parsing::BufferParser parser;
+	parser.registerPattern(std::regex("-[0-9]+"), [&keys](std::string_view key, parsing::Tokenizer& tokenizer) {
+		keys.push_back(std::string(key));
+		parsing::ignoreItem(key, tokenizer);
+	});
+	parser.registerPattern(std::regex("[a-z]+"), parsing::ignoreItem);
+	parser.parseBuffer(tokenizer);
+
+	ASSERT_EQ(keys.size(), 2);
+	ASSERT_EQ(keys[0], "-1");
+	ASSERT_EQ(keys[1], "-22");
+}
+
+
+TEST(Parsing_BufferParserTests, exactKeywordsTakePrecedenceOverPatterns)
+{
+	std::string input = "={ owner = SWE }";
+	parsing::Tokenizer tokenizer(input);
+
+	std::string owner;
+	parsing::BufferParser parser;
+	parser.registerPattern(std::regex("[a-z]+"), parsing::ignoreItem);
+	parser.registerKeyword("owner", [&owner](std::string_view unused, parsing::Tokenizer& tokenizer) {
+		owner = parsing::getString(tokenizer);
+	});
+	parser.parseBuffer(tokenizer);
+
+	ASSERT_EQ(owner, "SWE");
+}
+
+
+TEST(Parsing_BufferParserTests, parsingStopsAtTheClosingBrace)
+{
+	std::string input = "={ a = b } after";
+	parsing::Tokenizer tokenizer(input);
+
+	parsing::BufferParser parser;
+	parser.parseBuffer(tokenizer);
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "after");
+}
+
+
+TEST(Parsing_BufferParserTests, streamHandlersResumeWhereTheyStopped)
+{
+	std::string input = "={ history = { owner = SWE } after = yes }";
+	parsing::Tokenizer tokenizer(input);
+
+	std::string history;
+	auto sawAfter = false;
+	parsing::BufferParser parser;
+	parser.registerKeyword("history", parsing::streamHandler([&history](const std::string& unused, std::istream& theStream) {
+		char character;
+		while (theStream.get(character))
+		{
+			history += character;
+			if (character == '}')
+			{
+				break;
+			}
+		}
+	}));
+	parser.registerKeyword("after", [&sawAfter](std::string_view unused, parsing::Tokenizer& tokenizer) {
+		sawAfter = (parsing::getString(tokenizer) == "yes");
+	});
+	parser.parseBuffer(tokenizer);
+
+	ASSERT_EQ(history, " = { owner = SWE }");
+	ASSERT_TRUE(sawAfter);
+}
+
+
+TEST(Parsing_BufferParserTests, sectionsMergeInFileOrder)
+{
+	std::string input = "EU4txt date = 1444.11.11 first = { a = 1 } middle = { } second = { b = 2 } last = x";
+	parsing::Tokenizer tokenizer(input);
+
+	std::vector<std::string> events;
+	parsing::BufferParser parser;
+	parser.registerKeyword("date", [&events](std::string_view key, parsing::Tokenizer& tokenizer) {
+		events.push_back("date " + std::string(parsing::getString(tokenizer)));
+	});
+	parser.registerKeyword("last", [&events](std::string_view key, parsing::Tokenizer& tokenizer) {
+		events.push_back("last " + std::string(parsing::getString(tokenizer)));
+	});
+	const auto section = [&events](std::string_view key, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		const auto text = std::string(key) + " " + std::string(tokenizer.getItemText());
+		return [&events, text]() { events.push_back(text); };
+	};
+	parser.registerSection("first", section);
+	parser.registerSection("second", section);
+	parsing::WorkerPool pool(2);
+	parser.parseSections(tokenizer, pool);
+
+	const std::vector<std::string> expected{ "date 1444.11.11", "last x", "first = { a = 1 }", "second = { b = 2 }" };
+	ASSERT_EQ(events, expected);
+}
+
+
+TEST(Parsing_BufferParserTests, sectionErrorsReachTheCaller)
+{
+	std::string input = "broken = { }";
+	parsing::Tokenizer tokenizer(input);
+
+	parsing::BufferParser parser;
+	parser.registerSection("broken", [](std::string_view key, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		throw std::runtime_error("broken section");
+	});
+
+	parsing::WorkerPool pool(2);
+	ASSERT_THROW(parser.parseSections(tokenizer, pool), std::runtime_error);
+}
+
+
+TEST(Parsing_BufferParserTests, sectionsRunInTheCallersContext)
+{
+	std::string input = "first = { } second = { }";
+	parsing::Tokenizer tokenizer(input);
+
+	ConversionContext context;
+	ConversionContext::Scope contextScope(context);
+	std::vector<ConversionContext*> seenContexts;
+	parsing::BufferParser parser;
+	const auto section = [&seenContexts](std::string_view key, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		auto seenContext = &ConversionContext::current();
+		return [&seenContexts, seenContext]() { seenContexts.push_back(seenContext); };
+	};
+	parser.registerSection("first", section);
+	parser.registerSection("second", section);
+	parsing::WorkerPool pool(2);
+	parser.parseSections(tokenizer, pool);
+
+	const std::vector<ConversionContext*> expected{ &context, &context };
+	ASSERT_EQ(seenContexts, expected);
+}
+
+
+TEST(Parsing_BufferParserTests, unregisteredSectionsAreSkippedWhole)
+{
+	std::string input = "skipped = { date = 1.1.1 { last = y } } \"quoted key\" = { } dotted.key = 3 date = 1444.11.11";
+	parsing::Tokenizer tokenizer(input);
+
+	std::vector<std::string> events;
+	parsing::BufferParser parser;
+	parser.registerKeyword("date", [&events](std::string_view key, parsing::Tokenizer& tokenizer) {
+		events.push_back("date " + std::string(parsing::getString(tokenizer)));
+	});
+	parser.registerKeyword("last", [&events](std::string_view key, parsing::Tokenizer& tokenizer) {
+		events.push_back("last " + std::string(parsing::getString(tokenizer)));
+	});
+	parsing::WorkerPool pool(2);
+	parser.parseSections(tokenizer, pool);
+
+	const std::vector<std::string> expected{ "date 1444.11.11" };
+	ASSERT_EQ(events, expected);
+}
+
+
+TEST(Parsing_BufferParserTests, sectionsCanWaitForWorkOnTheSamePool)
+{
+	std::string input = "first = { } second = { } third = { }";
+	parsing::Tokenizer tokenizer(input);
+
+	parsing::WorkerPool pool(1);
+	std::atomic<int> parts = 0;
+	parsing::BufferParser parser;
+	const auto section = [&pool, &parts](std::string_view key, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		std::vector<std::future<void>> results;
+		for (auto i = 0; i < 3; i++)
+		{
+			results.push_back(pool.submit([&parts]() { parts++; }));
+		}
+		pool.waitAll(results);
+		return []() {};
+	};
+	parser.registerSection("first", section);
+	parser.registerSection("second", section);
+	parser.registerSection("third", section);
+	parser.parseSections(tokenizer, pool);
+
+	ASSERT_EQ(parts, 9);
+}
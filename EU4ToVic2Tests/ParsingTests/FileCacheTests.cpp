@@ -0,0 +1,217 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/FileCache.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+// a folder of its own for each test, holding both the cached files and the cache
+class Parsing_FileCacheTests: public ::testing::Test
+{
+	protected:
+		void SetUp() override
+		{
+			folder = std::filesystem::temp_directory_path() / ("FileCacheTests_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+			std::filesystem::remove_all(folder);
+			std::filesystem::create_directories(folder / "game");
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(folder);
+		}
+
+		std::string writeFile(const std::string& name, const std::string& contents)
+		{
+			const auto path = (folder / "game" / name).string();
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file << contents;
+			return path;
+		}
+
+		parsing::FileCache getCache() const
+		{
+			return parsing::FileCache((folder / "cache").string());
+		}
+
+		void storeNumber(const std::vector<std::string>& files, int number, const std::vector<std::string>& otherFiles = {})
+		{
+			getCache().store("numbers", files, [number](parsing::SnapshotWriter& snapshot) { snapshot.write(number); }, otherFiles);
+		}
+
+		std::optional<int> loadNumber(const std::vector<std::string>& files)
+		{
+			std::optional<int> number;
+			if (!getCache().load("numbers", files, [&number](parsing::SnapshotReader& snapshot) { number = snapshot.read<int>(); }))
+			{
+				return std::nullopt;
+			}
+			return number;
+		}
+
+		std::filesystem::path folder;
+};
+
+
+struct CachedText
+{
+	explicit CachedText(std::string _text): text(std::move(_text)) {}
+	explicit CachedText(parsing::SnapshotReader& snapshot) { snapshot.read(text); }
+	void writeSnapshot(parsing::SnapshotWriter& snapshot) const { snapshot.write(text); }
+
+	std::string text;
+};
+
+}
+
+
+TEST_F(Parsing_FileCacheTests, nothingIsFoundBeforeAnythingIsStored)
+{
+	const auto file = writeFile("a.txt", "a = 1");
+
+	ASSERT_EQ(loadNumber({ file }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, storedEntriesAreFoundWhileTheirFilesAreUnchanged)
+{
+	const auto first = writeFile("a.txt", "a = 1");
+	const auto second = writeFile("b.txt", "b = 2");
+	storeNumber({ first, second }, 42);
+
+	ASSERT_EQ(loadNumber({ first, second }), 42);
+}
+
+
+TEST_F(Parsing_FileCacheTests, changedFilesMakeEntriesMisses)
+{
+	const auto file = writeFile("a.txt", "a = 1");
+	storeNumber({ file }, 42);
+	writeFile("a.txt", "a = 12");
+
+	ASSERT_EQ(loadNumber({ file }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, sameSizedChangesWithNewTimesAreMisses)
+{
+	const auto file = writeFile("a.txt", "a = 1");
+	storeNumber({ file }, 42);
+	writeFile("a.txt", "a = 2");
+	std::filesystem::last_write_time(file, std::filesystem::last_write_time(file) + std::chrono::hours(1));
+
+	ASSERT_EQ(loadNumber({ file }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, filesTouchedButUnchangedAreStillHits)
+{
+	const auto file = writeFile("a.txt", "a = 1");
+	storeNumber({ file }, 42);
+	std::filesystem::last_write_time(file, std::filesystem::last_write_time(file) + std::chrono::hours(1));
+
+	ASSERT_EQ(loadNumber({ file }), 42);
+}
+
+
+TEST_F(Parsing_FileCacheTests, missingFilesAppearingMakeEntriesMisses)
+{
+	const auto present = writeFile("a.txt", "a = 1");
+	const auto missing = (folder / "game" / "b.txt").string();
+	storeNumber({ present, missing }, 42);
+	ASSERT_EQ(loadNumber({ present, missing }), 42);
+
+	writeFile("b.txt", "b = 2");
+	ASSERT_EQ(loadNumber({ present, missing }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, theOrderOfTheFilesMatters)
+{
+	const auto first = writeFile("a.txt", "a = 1");
+	const auto second = writeFile("b.txt", "b = 2");
+	storeNumber({ first, second }, 42);
+
+	ASSERT_EQ(loadNumber({ second, first }), std::nullopt);
+	ASSERT_EQ(loadNumber({ first }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, otherFilesAreCheckedToo)
+{
+	const auto listed = writeFile("a.txt", "file = b.txt");
+	const auto named = writeFile("b.txt", "b = 2");
+	storeNumber({ listed }, 42, { named });
+	ASSERT_EQ(loadNumber({ listed }), 42);
+
+	writeFile("b.txt", "b = 22");
+	ASSERT_EQ(loadNumber({ listed }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, damagedEntriesAreMisses)
+{
+	const auto file = writeFile("a.txt", "a = 1");
+	storeNumber({ file }, 42);
+	const auto entry = folder / "cache" / "numbers.cache";
+	std::filesystem::resize_file(entry, std::filesystem::file_size(entry) - 2);
+
+	ASSERT_EQ(loadNumber({ file }), std::nullopt);
+}
+
+
+TEST_F(Parsing_FileCacheTests, getOnlyParsesOnAMiss)
+{
+	const auto file = writeFile("a.txt", "a = 1");
+	auto parses = 0;
+	const auto parse = [&parses]() {
+		parses++;
+		return CachedText("parsed");
+	};
+
+	ASSERT_EQ(getCache().get<CachedText>("text", { file }, parse).text, "parsed");
+	ASSERT_EQ(getCache().get<CachedText>("text", { file }, parse).text, "parsed");
+	ASSERT_EQ(parses, 1);
+
+	writeFile("a.txt", "a = 2 b = 3");
+	getCache().get<CachedText>("text", { file }, parse);
+	ASSERT_EQ(parses, 2);
+}
+
+
+TEST_F(Parsing_FileCacheTests, filesInFoldersAreListedByName)
+{
+	writeFile("b.txt", "");
+	writeFile("a.txt", "");
+	const auto gameFolder = (folder / "game").string();
+
+	ASSERT_EQ(parsing::getFilesInFolder(gameFolder), std::vector<std::string>({ gameFolder + "/a.txt", gameFolder + "/b.txt" }));
+}
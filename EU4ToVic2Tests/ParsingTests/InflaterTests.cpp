@@ -0,0 +1,106 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/Inflater.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+
+TEST(Parsing_InflaterTests, storedBlocksCanBeInflated)
+{
+	const std::string input("\x01\x09\x00\xf6\xff\x6f\x77\x6e\x65\x72\x3d\x53\x57\x45", 14);
+
+	std::vector<char> output(9);
+	const auto size = parsing::inflate(input, output.data(), output.size(), {});
+
+	ASSERT_EQ(size, 9);
+	ASSERT_EQ(std::string(output.data(), size), "owner=SWE");
+}
+
+
+TEST(Parsing_InflaterTests, fixedHuffmanBlocksCanBeInflated)
+{
+	const std::string input("\xcb\x2f\xcf\x4b\x2d\xb2\x0d\x0e\x77\x05\x00", 11);
+
+	std::vector<char> output(9);
+	const auto size = parsing::inflate(input, output.data(), output.size(), {});
+
+	ASSERT_EQ(std::string(output.data(), size), "owner=SWE");
+}
+
+
+TEST(Parsing_InflaterTests, dynamicHuffmanBlocksCanBeInflated)
+{
+	const std::string input(
+		"\x65\xd1\xab\x0d\x42\x01\x14\x44\x41\x4f\x15\xaf\x04\xee\x2e\x5f\xf1\x24\x15\x20\xa8\x00\x0b\x09\x06\x41\xe8"
+		"\x1d\x3f\xc8\xb3\x6a\x92\x9d\xf5\xb3\x3c\xdf\x8f\xfb\x6b\xbd\xde\x2e\xcb\x77\x13\xba\xf4\x8e\xde\xd3\x07\xfa"
+		"\x48\x9f\xe8\x33\x3d\x5b\x87\x71\x90\x38\x1a\x47\xe4\xa8\x1c\x99\xa3\x73\x84\x8e\xd2\x28\x8d\xd2\x28\x8d\xd2"
+		"\x28\x8d\xd2\x28\x8d\xd2\x28\x8d\xd2\x2a\xad\xd2\xfe\xdd\xae\xb4\x4a\xab\xb4\x4a\xab\xb4\x4a\xab\xf4\x07",
+		107
+	);
+	std::string expected;
+	for (int i = 1; i < 40; i++)
+	{
+		expected += std::to_string(i) + "={ owner=SWE }\n";
+	}
+
+	std::vector<char> output(expected.size());
+	const auto size = parsing::inflate(input, output.data(), output.size(), {});
+
+	ASSERT_EQ(std::string(output.data(), size), expected);
+}
+
+
+TEST(Parsing_InflaterTests, progressIsReported)
+{
+	const std::string input("\xcb\x2f\xcf\x4b\x2d\xb2\x0d\x0e\x77\x05\x00", 11);
+
+	size_t reported = 0;
+	std::vector<char> output(9);
+	parsing::inflate(input, output.data(), output.size(), [&reported](size_t available) {
+		reported = available;
+	});
+
+	ASSERT_EQ(reported, 9);
+}
+
+
+TEST(Parsing_InflaterTests, outputLargerThanTheBufferThrowsException)
+{
+	const std::string input("\xcb\x2f\xcf\x4b\x2d\xb2\x0d\x0e\x77\x05\x00", 11);
+
+	std::vector<char> output(4);
+	ASSERT_THROW(parsing::inflate(input, output.data(), output.size(), {}), std::runtime_error);
+}
+
+
+TEST(Parsing_InflaterTests, truncatedInputThrowsException)
+{
+	const std::string input("\xcb\x2f\xcf\x4b", 4);
+
+	std::vector<char> output(9);
+	ASSERT_THROW(parsing::inflate(input, output.data(), output.size(), {}), std::runtime_error);
+}
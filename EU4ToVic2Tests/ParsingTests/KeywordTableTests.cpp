@@ -0,0 +1,151 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/KeywordTable.h"
+#include "../EU4toV2/Source/Parsing/ParsingHelpers.h"
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+struct testTarget
+{
+	std::string owner;
+	std::vector<std::string> dates;
+	std::vector<std::string> others;
+	int total = 0;
+};
+
+
+const parsing::KeywordTable<testTarget, int>& getTestKeywords()
+{
+	static const parsing::KeywordTable<testTarget, int> keywords(
+		{
+			{ "owner", [](testTarget& target, std::string_view unused, parsing::Tokenizer& tokenizer, int bonus) {
+				target.owner = parsing::getString(tokenizer);
+			}},
+			{ "value", [](testTarget& target, std::string_view unused, parsing::Tokenizer& tokenizer, int bonus) {
+				target.total += parsing::getInt(tokenizer) + bonus;
+			}},
+			{ "skipped", parsing::ignoreKeyword<testTarget, int> }
+		},
+		{
+			{ parsing::isDate, [](testTarget& target, std::string_view date, parsing::Tokenizer& tokenizer, int bonus) {
+				target.dates.emplace_back(date);
+				tokenizer.getItemText();
+			}},
+			{ parsing::isIdentifier, [](testTarget& target, std::string_view key, parsing::Tokenizer& tokenizer, int bonus) {
+				target.others.emplace_back(key);
+				tokenizer.getItemText();
+			}}
+		}
+	);
+	return keywords;
+}
+
+}
+
+
+
+TEST(Parsing_KeywordTableTests, exactKeywordsAreHandled)
+{
+	std::string input = "= { owner = SWE value = 3 }";
+	parsing::Tokenizer tokenizer(input);
+
+	testTarget target;
+	getTestKeywords().parse(target, tokenizer, 10);
+
+	ASSERT_EQ(target.owner, "SWE");
+	ASSERT_EQ(target.total, 13);
+	ASSERT_TRUE(target.others.empty());
+}
+
+
+TEST(Parsing_KeywordTableTests, patternsAreTriedInOrder)
+{
+	std::string input = "= { 1444.11.11 = { owner = DAN } culture = swedish }";
+	parsing::Tokenizer tokenizer(input);
+
+	testTarget target;
+	getTestKeywords().parse(target, tokenizer, 0);
+
+	ASSERT_EQ(target.dates, std::vector<std::string>{ "1444.11.11" });
+	ASSERT_EQ(target.others, std::vector<std::string>{ "culture" });
+	ASSERT_TRUE(target.owner.empty());
+}
+
+
+TEST(Parsing_KeywordTableTests, ignoredKeywordsSkipTheirValues)
+{
+	std::string input = "= { skipped = { owner = DAN } owner = SWE }";
+	parsing::Tokenizer tokenizer(input);
+
+	testTarget target;
+	getTestKeywords().parse(target, tokenizer, 0);
+
+	ASSERT_EQ(target.owner, "SWE");
+	ASSERT_TRUE(target.others.empty());
+}
+
+
+TEST(Parsing_KeywordTableTests, parsingStopsAtTheClosingBrace)
+{
+	std::string input = "= { owner = SWE } value = 3";
+	parsing::Tokenizer tokenizer(input);
+
+	testTarget target;
+	getTestKeywords().parse(target, tokenizer, 0);
+
+	ASSERT_EQ(target.total, 0);
+	ASSERT_EQ(*tokenizer.getNextToken(), "value");
+}
+
+
+TEST(Parsing_KeywordTableTests, keysOutsideTheTableAreSkippedUnread)
+{
+	std::string input = "= { \"quoted\" = { owner = DAN note = \"}\" } 42 = { value = 1 } owner = SWE }";
+	parsing::Tokenizer tokenizer(input);
+
+	testTarget target;
+	getTestKeywords().parse(target, tokenizer, 0);
+
+	ASSERT_EQ(target.owner, "SWE");
+	ASSERT_EQ(target.total, 0);
+}
+
+
+TEST(Parsing_KeywordTableTests, unnamedBlocksAreWalkedThrough)
+{
+	std::string input = "= { { owner = SWE } } value = 3";
+	parsing::Tokenizer tokenizer(input);
+
+	testTarget target;
+	getTestKeywords().parse(target, tokenizer, 0);
+
+	ASSERT_EQ(target.owner, "SWE");
+	ASSERT_EQ(*tokenizer.getNextToken(), "value");
+}
@@ -0,0 +1,137 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/ParsingHelpers.h"
+#include <string>
+
+
+
+TEST(Parsing_ParsingHelpersTests, getStringRemovesQuotes)
+{
+	std::string input = "= \"Stockholm\"";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(parsing::getString(tokenizer), "Stockholm");
+}
+
+
+TEST(Parsing_ParsingHelpersTests, getStringWorksWithoutEquals)
+{
+	std::string input = "swedish";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(parsing::getString(tokenizer), "swedish");
+}
+
+
+TEST(Parsing_ParsingHelpersTests, numbersCanBeRead)
+{
+	std::string input = "= -12 = 3.125";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(parsing::getInt(tokenizer), -12);
+	ASSERT_EQ(parsing::getDouble(tokenizer), 3.125);
+}
+
+
+TEST(Parsing_ParsingHelpersTests, malformedIntsBecomeZero)
+{
+	ASSERT_EQ(parsing::toInt("abc"), 0);
+}
+
+
+TEST(Parsing_ParsingHelpersTests, listsCanBeRead)
+{
+	std::string input = "= { \"SWE\" DAN NOR } = { 1 2 3 } = { 0.5 1.5 }";
+	parsing::Tokenizer tokenizer(input);
+
+	auto strings = parsing::getStrings(tokenizer);
+	ASSERT_EQ(strings.size(), 3);
+	ASSERT_EQ(strings[0], "SWE");
+	ASSERT_EQ(strings[2], "NOR");
+
+	auto ints = parsing::getInts(tokenizer);
+	ASSERT_EQ(ints.size(), 3);
+	ASSERT_EQ(ints[1], 2);
+
+	auto doubles = parsing::getDoubles(tokenizer);
+	ASSERT_EQ(doubles.size(), 2);
+	ASSERT_EQ(doubles[1], 1.5);
+}
+
+
+TEST(Parsing_ParsingHelpersTests, assignmentsCanBeRead)
+{
+	std::string input = "= { adm_tech=20 name=\"Sweden\" nested={ a=1 } { 1 2 } mil_tech=18 } next";
+	parsing::Tokenizer tokenizer(input);
+
+	auto assignments = parsing::getAssignments(tokenizer);
+	ASSERT_EQ(assignments.size(), 4);
+	ASSERT_EQ(assignments[0].first, "adm_tech");
+	ASSERT_EQ(assignments[0].second, "20");
+	ASSERT_EQ(assignments[1].second, "Sweden");
+	ASSERT_EQ(assignments[2].first, "nested");
+	ASSERT_EQ(assignments[2].second, "{ a=1 }");
+	ASSERT_EQ(assignments[3].first, "mil_tech");
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
+
+
+TEST(Parsing_ParsingHelpersTests, ignoreItemSkipsBlocks)
+{
+	std::string input = "= { a = { b } } next";
+	parsing::Tokenizer tokenizer(input);
+
+	parsing::ignoreItem("unused", tokenizer);
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
+
+
+TEST(Parsing_ParsingHelpersTests, patternKeysAreRecognised)
+{
+	ASSERT_TRUE(parsing::isIdentifier("Culture_2"));
+	ASSERT_FALSE(parsing::isIdentifier("1444.11.11"));
+	ASSERT_TRUE(parsing::isLowercaseIdentifier("base_tax"));
+	ASSERT_FALSE(parsing::isLowercaseIdentifier("SWE"));
+	ASSERT_TRUE(parsing::isDate("1444.11.11"));
+	ASSERT_FALSE(parsing::isDate("1444.11"));
+	ASSERT_TRUE(parsing::isDateKey("1444.11.11"));
+	ASSERT_TRUE(parsing::isDateKey("56456976"));
+	ASSERT_FALSE(parsing::isDateKey("owner"));
+	ASSERT_TRUE(parsing::isTag("SWE"));
+	ASSERT_TRUE(parsing::isTag("C01"));
+	ASSERT_FALSE(parsing::isTag("SWED"));
+	ASSERT_FALSE(parsing::isTag("---"));
+	ASSERT_TRUE(parsing::isProvinceKey("-1"));
+	ASSERT_FALSE(parsing::isProvinceKey("1"));
+	ASSERT_FALSE(parsing::isProvinceKey("-"));
+}
+
+
+TEST(Parsing_ParsingHelpersTests, datesCanBeReadWrittenOutOrAsHours)
+{
+	ASSERT_EQ(parsing::toDate("1444.11.11"), date(1444, 11, 11));
+	ASSERT_EQ(parsing::toDate("\"1821.1.1\""), date(1821, 1, 1));
+	ASSERT_EQ(parsing::toDate("56456976"), date(1444, 11, 11));
+}
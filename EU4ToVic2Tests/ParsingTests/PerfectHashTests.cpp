@@ -0,0 +1,83 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/PerfectHash.h"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+TEST(Parsing_PerfectHashTests, keysAreFoundAtTheirPositions)
+{
+	const std::vector<std::string_view> keys{ "owner", "controller", "cores", "history", "base_tax" };
+	const parsing::PerfectHash hash(keys);
+
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		ASSERT_EQ(hash.find(keys[i]), i);
+	}
+}
+
+
+TEST(Parsing_PerfectHashTests, unknownKeysAreNotFound)
+{
+	const parsing::PerfectHash hash({ "owner", "controller" });
+
+	ASSERT_FALSE(hash.find("own"));
+	ASSERT_FALSE(hash.find("owners"));
+	ASSERT_FALSE(hash.find(""));
+}
+
+
+TEST(Parsing_PerfectHashTests, manyKeysCanBePlaced)
+{
+	std::vector<std::string> names;
+	for (auto i = 0; i < 500; i++)
+	{
+		names.push_back("key_" + std::to_string(i));
+	}
+	const std::vector<std::string_view> keys(names.begin(), names.end());
+	const parsing::PerfectHash hash(keys);
+
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		ASSERT_EQ(hash.find(keys[i]), i);
+	}
+}
+
+
+TEST(Parsing_PerfectHashTests, emptyKeyListFindsNothing)
+{
+	const parsing::PerfectHash hash(std::vector<std::string_view>{});
+
+	ASSERT_FALSE(hash.find("owner"));
+}
+
+
+TEST(Parsing_PerfectHashTests, repeatedKeysAreRejected)
+{
+	ASSERT_THROW(parsing::PerfectHash({ "owner", "owner" }), std::runtime_error);
+}
@@ -0,0 +1,108 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/SectionScanner.h"
+#include "../EU4toV2/Source/Parsing/StreamedBuffer.h"
+#include <cstring>
+#include <string>
+#include <thread>
+
+
+
+TEST(Parsing_SectionScannerTests, sectionsCoverTheirValues)
+{
+	std::string input = "date = 1444.11.11\nprovinces = {\n\t-1 = { owner = SWE }\n}\nplayer = \"SWE\"";
+	parsing::Tokenizer tokenizer(input);
+	parsing::SectionScanner scanner(tokenizer);
+
+	auto section = scanner.getNextSection();
+	ASSERT_EQ(section->key, "date");
+	ASSERT_EQ(section->text, "= 1444.11.11");
+	section = scanner.getNextSection();
+	ASSERT_EQ(section->key, "provinces");
+	ASSERT_EQ(section->text, "= {\n\t-1 = { owner = SWE }\n}");
+	section = scanner.getNextSection();
+	ASSERT_EQ(section->key, "player");
+	ASSERT_EQ(section->text, "= \"SWE\"");
+	ASSERT_FALSE(scanner.getNextSection());
+}
+
+
+TEST(Parsing_SectionScannerTests, standaloneKeysHaveNoText)
+{
+	std::string input = "EU4txt\ndate = 1444.11.11";
+	parsing::Tokenizer tokenizer(input);
+	parsing::SectionScanner scanner(tokenizer);
+
+	auto section = scanner.getNextSection();
+	ASSERT_EQ(section->key, "EU4txt");
+	ASSERT_TRUE(section->text.empty());
+	ASSERT_EQ(scanner.getNextSection()->key, "date");
+}
+
+
+TEST(Parsing_SectionScannerTests, blocksWithoutEqualsAreSections)
+{
+	std::string input = "map_area_data{ a = { } } next = 1";
+	parsing::Tokenizer tokenizer(input);
+	parsing::SectionScanner scanner(tokenizer);
+
+	auto section = scanner.getNextSection();
+	ASSERT_EQ(section->key, "map_area_data");
+	ASSERT_EQ(section->text, "{ a = { } }");
+	ASSERT_EQ(scanner.getNextSection()->key, "next");
+}
+
+
+TEST(Parsing_SectionScannerTests, streamedSectionsAreFoundAsTheyArrive)
+{
+	const std::string input = "first = { a = 1 } second = { b = 2 }";
+	parsing::StreamedBuffer buffer(input.size());
+	std::memcpy(buffer.getWritableData(), input.data(), input.size());
+	buffer.publish(17);
+
+	parsing::Tokenizer tokenizer(buffer);
+	parsing::SectionScanner scanner(tokenizer);
+	ASSERT_EQ(scanner.getNextSection()->text, "= { a = 1 }");
+
+	std::thread writer([&buffer, &input]() { buffer.finish(input.size()); });
+	const auto section = scanner.getNextSection();
+	writer.join();
+	ASSERT_EQ(section->key, "second");
+	ASSERT_EQ(section->text, "= { b = 2 }");
+}
+
+
+TEST(Parsing_SectionScannerTests, blockSectionsCanBeListed)
+{
+	std::string input = "= {\n\tSWE = { capital = 1 }\n\tDAN = { }\n} next";
+	parsing::Tokenizer tokenizer(input);
+
+	const auto sections = parsing::getBlockSections(tokenizer);
+	ASSERT_EQ(sections.size(), 2);
+	ASSERT_EQ(sections[0].key, "SWE");
+	ASSERT_EQ(sections[0].text, "= { capital = 1 }");
+	ASSERT_EQ(sections[1].key, "DAN");
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
@@ -0,0 +1,148 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/Snapshot.h"
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+std::string makeSnapshot(uint32_t formatVersion, uint64_t key)
+{
+	std::stringstream output;
+	parsing::SnapshotWriter writer(output, formatVersion, key);
+	writer.write(true);
+	writer.write(-42);
+	writer.write(2.5);
+	writer.write("text");
+	writer.write(date("1444.11.11"));
+	writer.write(std::vector<std::string>({ "a", "", "c" }));
+	writer.write(std::set<int>({ 3, 1, 2 }));
+	writer.write(std::map<std::string, double>({ { "x", 1.0 }, { "y", -1.0 } }));
+	return output.str();
+}
+
+}
+
+
+TEST(Parsing_SnapshotTests, valuesReadBackAsTheyWereWritten)
+{
+	const auto snapshotText = makeSnapshot(1, 99);
+	parsing::SnapshotReader reader(snapshotText, 1, 99);
+
+	ASSERT_EQ(reader.read<bool>(), true);
+	ASSERT_EQ(reader.read<int>(), -42);
+	ASSERT_EQ(reader.read<double>(), 2.5);
+	ASSERT_EQ(reader.read<std::string>(), "text");
+	ASSERT_EQ(reader.read<date>(), date("1444.11.11"));
+	ASSERT_EQ(reader.read<std::vector<std::string>>(), std::vector<std::string>({ "a", "", "c" }));
+	ASSERT_EQ(reader.read<std::set<int>>(), std::set<int>({ 1, 2, 3 }));
+	const auto expectedMap = std::map<std::string, double>({ { "x", 1.0 }, { "y", -1.0 } });
+	ASSERT_EQ((reader.read<std::map<std::string, double>>()), expectedMap);
+	ASSERT_TRUE(reader.atEnd());
+}
+
+
+TEST(Parsing_SnapshotTests, otherKeysAreRejected)
+{
+	const auto snapshotText = makeSnapshot(1, 99);
+
+	ASSERT_THROW(parsing::SnapshotReader(snapshotText, 1, 98), std::runtime_error);
+}
+
+
+TEST(Parsing_SnapshotTests, otherFormatVersionsAreRejected)
+{
+	const auto snapshotText = makeSnapshot(1, 99);
+
+	ASSERT_THROW(parsing::SnapshotReader(snapshotText, 2, 99), std::runtime_error);
+}
+
+
+TEST(Parsing_SnapshotTests, otherFilesAreRejected)
+{
+	ASSERT_THROW(parsing::SnapshotReader("EU4txt\ndate=1444.11.11", 1, 99), std::runtime_error);
+	ASSERT_THROW(parsing::SnapshotReader("", 1, 99), std::runtime_error);
+}
+
+
+TEST(Parsing_SnapshotTests, truncatedSnapshotsThrowInsteadOfReadingPastTheEnd)
+{
+	const auto snapshotText = makeSnapshot(1, 99);
+	const auto truncatedText = snapshotText.substr(0, snapshotText.size() - 5);
+	parsing::SnapshotReader reader(truncatedText, 1, 99);
+
+	reader.read<bool>();
+	reader.read<int>();
+	reader.read<double>();
+	reader.read<std::string>();
+	reader.read<date>();
+	reader.read<std::vector<std::string>>();
+	reader.read<std::set<int>>();
+	ASSERT_THROW((reader.read<std::map<std::string, double>>()), std::runtime_error);
+}
+
+
+TEST(Parsing_SnapshotTests, damagedCountsThrow)
+{
+	std::stringstream output;
+	parsing::SnapshotWriter writer(output, 1, 99);
+	writer.writeCount(1000000);
+	const auto snapshotText = output.str();
+	parsing::SnapshotReader reader(snapshotText, 1, 99);
+
+	ASSERT_THROW(reader.read<std::vector<int>>(), std::runtime_error);
+}
+
+
+TEST(Parsing_SnapshotTests, keysDependOnEveryByteAndWhereInputsSplit)
+{
+	parsing::SnapshotKey first;
+	first.add("save contents");
+	parsing::SnapshotKey changed;
+	changed.add("save contentz");
+	parsing::SnapshotKey split;
+	split.add("save ");
+	split.add("contents");
+	parsing::SnapshotKey same;
+	same.add("save contents");
+
+	ASSERT_NE(first.get(), changed.get());
+	ASSERT_NE(first.get(), split.get());
+	ASSERT_EQ(first.get(), same.get());
+}
+
+
+TEST(Parsing_SnapshotTests, theBuildIdIsReadFromThisExecutable)
+{
+	ASSERT_NE(parsing::getBuildId(), 0);
+	ASSERT_EQ(parsing::getBuildId(), parsing::getBuildId());
+}
@@ -0,0 +1,93 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/StreamedBuffer.h"
+#include "../EU4toV2/Source/Parsing/Tokenizer.h"
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+
+
+TEST(Parsing_StreamedBufferTests, waitForReturnsOncePublished)
+{
+	parsing::StreamedBuffer buffer(10);
+	buffer.publish(4);
+
+	ASSERT_EQ(buffer.waitFor(3), 4);
+}
+
+
+TEST(Parsing_StreamedBufferTests, waitForReturnsEarlyWhenFinished)
+{
+	parsing::StreamedBuffer buffer(10);
+	buffer.finish(6);
+
+	ASSERT_EQ(buffer.waitFor(10), 6);
+}
+
+
+TEST(Parsing_StreamedBufferTests, writerErrorsReachTheReader)
+{
+	parsing::StreamedBuffer buffer(10);
+	buffer.fail("broken");
+
+	ASSERT_THROW(buffer.waitFor(1), std::runtime_error);
+}
+
+
+TEST(Parsing_StreamedBufferTests, cancelledBufferStopsTheWriter)
+{
+	parsing::StreamedBuffer buffer(10);
+	buffer.cancel();
+
+	ASSERT_THROW(buffer.publish(1), std::runtime_error);
+}
+
+
+TEST(Parsing_StreamedBufferTests, tokenizerWaitsForTheWriter)
+{
+	const char* text = "owner = SWE controller = DAN";
+	const auto length = std::strlen(text);
+	parsing::StreamedBuffer buffer(length);
+
+	std::thread writer([&buffer, text, length] {
+		for (size_t i = 1; i <= length; i++)
+		{
+			buffer.getWritableData()[i - 1] = text[i - 1];
+			buffer.publish(i);
+		}
+		buffer.finish(length);
+	});
+
+	parsing::Tokenizer tokenizer(buffer);
+	std::string tokens;
+	while (auto token = tokenizer.getNextToken())
+	{
+		tokens += std::string(*token) + ",";
+	}
+	writer.join();
+
+	ASSERT_EQ(tokens, "owner,=,SWE,controller,=,DAN,");
+}
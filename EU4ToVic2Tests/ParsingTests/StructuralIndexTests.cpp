@@ -0,0 +1,171 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/StructuralIndex.h"
+#include "../EU4toV2/Source/Parsing/Tokenizer.h"
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+std::vector<std::string_view> getAllTokens(parsing::Tokenizer& tokenizer)
+{
+	std::vector<std::string_view> tokens;
+	while (auto token = tokenizer.getNextToken())
+	{
+		tokens.push_back(*token);
+	}
+	return tokens;
+}
+
+
+std::vector<std::string_view> getAllItems(parsing::Tokenizer& tokenizer)
+{
+	std::vector<std::string_view> items;
+	while (!tokenizer.atEnd())
+	{
+		items.push_back(tokenizer.getItemText());
+	}
+	return items;
+}
+
+
+// script made of the characters the tokenizer treats specially, so that strings, comments and
+// blocks start and end at every possible place, across 64 byte blocks too
+std::string makeScript(unsigned seed, size_t length)
+{
+	const std::string alphabet = "ab  \n\t\"\"#{}{}==";
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+	std::string script;
+	for (size_t i = 0; i < length; i++)
+	{
+		script += alphabet[pick(generator)];
+	}
+	return script;
+}
+
+}
+
+
+TEST(Parsing_StructuralIndexTests, structuralCharactersAndTokensAreIndexed)
+{
+	std::string input = "a = {\tbb c}";
+	const parsing::StructuralIndex index(input);
+
+	ASSERT_EQ(index.getTokenStarts(), std::vector<uint32_t>({ 0, 2, 4, 6, 9, 10 }));
+}
+
+
+TEST(Parsing_StructuralIndexTests, stringsAndCommentsAreLeftOut)
+{
+	std::string input = "name = \"a { b\" # c = {\n}";
+	const parsing::StructuralIndex index(input);
+
+	ASSERT_EQ(index.getTokenStarts(), std::vector<uint32_t>({ 0, 5, 7, 23 }));
+}
+
+
+TEST(Parsing_StructuralIndexTests, quotesOnlyOpenStringsAtTheStartOfAToken)
+{
+	std::string input = "ab\"c \"d e\"f";
+	const parsing::StructuralIndex index(input);
+
+	ASSERT_EQ(index.getTokenStarts(), std::vector<uint32_t>({ 0, 5, 10 }));
+}
+
+
+TEST(Parsing_StructuralIndexTests, byteOrderMarkIsSkipped)
+{
+	std::string input = "\xEF\xBB\xBFkey=1";
+	const parsing::StructuralIndex index(input);
+
+	ASSERT_EQ(index.getTokenStarts(), std::vector<uint32_t>({ 3, 6, 7 }));
+}
+
+
+TEST(Parsing_StructuralIndexTests, everyInstructionSetGivesTheSameIndex)
+{
+	for (unsigned seed = 0; seed < 20; seed++)
+	{
+		const auto script = makeScript(seed, 1000);
+		const parsing::StructuralIndex scalarIndex(script, parsing::StructuralIndex::instructions::scalar);
+		const parsing::StructuralIndex sse2Index(script, parsing::StructuralIndex::instructions::sse2);
+		const parsing::StructuralIndex avx2Index(script, parsing::StructuralIndex::instructions::avx2);
+
+		ASSERT_EQ(scalarIndex.getTokenStarts(), sse2Index.getTokenStarts());
+		ASSERT_EQ(scalarIndex.getTokenStarts(), avx2Index.getTokenStarts());
+	}
+}
+
+
+TEST(Parsing_StructuralIndexTests, indexedTokenizerFindsTheSameTokensAndItems)
+{
+	for (unsigned seed = 0; seed < 200; seed++)
+	{
+		const auto script = makeScript(seed, 500);
+		const parsing::StructuralIndex index(script);
+
+		parsing::Tokenizer plainTokenizer(script);
+		parsing::Tokenizer indexedTokenizer(script, &index);
+		ASSERT_EQ(getAllTokens(plainTokenizer), getAllTokens(indexedTokenizer));
+
+		parsing::Tokenizer plainItemTokenizer(script);
+		parsing::Tokenizer indexedItemTokenizer(script, &index);
+		ASSERT_EQ(getAllItems(plainItemTokenizer), getAllItems(indexedItemTokenizer));
+	}
+}
+
+
+TEST(Parsing_StructuralIndexTests, partOfAnIndexedBufferCanBeTokenized)
+{
+	std::string input = "skipped = { a } kept = { b = \"c d\" } after";
+	const parsing::StructuralIndex index(input);
+
+	parsing::Tokenizer tokenizer(std::string_view(input).substr(16, 20), &index);
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "kept");
+	ASSERT_EQ(tokenizer.getItemText(), "= { b = \"c d\" }");
+	ASSERT_FALSE(tokenizer.getNextToken());
+}
+
+
+TEST(Parsing_StructuralIndexTests, tokenizerFollowsTheIndexAgainAfterAJump)
+{
+	std::string input = "first = { a } second = { b } third";
+	const parsing::StructuralIndex index(input);
+	parsing::Tokenizer tokenizer(input, &index);
+
+	tokenizer.getNextToken();
+	tokenizer.advance(5);
+	ASSERT_EQ(*tokenizer.getNextToken(), "a");
+	ASSERT_EQ(*tokenizer.getNextToken(), "}");
+	ASSERT_EQ(*tokenizer.getNextToken(), "second");
+	ASSERT_EQ(tokenizer.getItemText(), "= { b }");
+	ASSERT_EQ(*tokenizer.getNextToken(), "third");
+}
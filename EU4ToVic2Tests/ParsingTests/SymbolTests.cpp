@@ -0,0 +1,133 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/Symbol.h"
+#include "../EU4toV2/Source/ConversionContext.h"
+#include <future>
+#include <set>
+#include <string>
+#include <vector>
+
+
+
+TEST(Parsing_SymbolTests, sameNameGivesSameSymbol)
+{
+	const parsing::TagSymbol first("SWE");
+	const parsing::TagSymbol second(std::string("SWE"));
+
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(first.getId(), second.getId());
+	ASSERT_EQ(first.getName(), "SWE");
+}
+
+
+TEST(Parsing_SymbolTests, differentNamesGiveDifferentSymbols)
+{
+	const parsing::CultureSymbol swedish("swedish");
+	const parsing::CultureSymbol danish("danish");
+
+	ASSERT_NE(swedish, danish);
+	ASSERT_EQ(swedish.getName(), "swedish");
+	ASSERT_EQ(danish.getName(), "danish");
+}
+
+
+TEST(Parsing_SymbolTests, defaultSymbolIsTheEmptyName)
+{
+	const parsing::TagSymbol none;
+
+	ASSERT_TRUE(none.empty());
+	ASSERT_EQ(none.getName(), "");
+	ASSERT_EQ(none, parsing::TagSymbol(""));
+}
+
+
+TEST(Parsing_SymbolTests, findDoesNotIntern)
+{
+	const auto sizeBefore = parsing::FlagKind::getTable().size();
+
+	ASSERT_FALSE(parsing::FlagSymbol::find("symbol_tests_never_interned_flag"));
+	ASSERT_EQ(parsing::FlagKind::getTable().size(), sizeBefore);
+
+	const parsing::FlagSymbol flag("symbol_tests_interned_flag");
+	ASSERT_EQ(parsing::FlagSymbol::find("symbol_tests_interned_flag"), flag);
+}
+
+
+TEST(Parsing_SymbolTests, flagsStayWithTheirConversion)
+{
+	const auto sharedSizeBefore = parsing::SymbolTable::shared().size();
+
+	ConversionContext context;
+	{
+		ConversionContext::Scope scope(context);
+		const parsing::FlagSymbol flag("symbol_tests_conversion_flag");
+		ASSERT_EQ(flag.getName(), "symbol_tests_conversion_flag");
+		ASSERT_EQ(parsing::FlagSymbol::find("symbol_tests_conversion_flag"), flag);
+	}
+
+	ASSERT_FALSE(parsing::FlagSymbol::find("symbol_tests_conversion_flag"));
+	ASSERT_EQ(parsing::SymbolTable::shared().size(), sharedSizeBefore);
+}
+
+
+TEST(Parsing_SymbolTests, namesInternedFromManyThreadsAgree)
+{
+	std::vector<std::future<std::vector<parsing::TagSymbol>>> results;
+	for (int thread = 0; thread < 4; thread++)
+	{
+		results.push_back(std::async(std::launch::async, []() {
+			std::vector<parsing::TagSymbol> symbols;
+			for (int i = 0; i < 10000; i++)
+			{
+				symbols.emplace_back("symbol_tests_" + std::to_string(i));
+			}
+			return symbols;
+		}));
+	}
+
+	const auto expected = results[0].get();
+	for (size_t thread = 1; thread < results.size(); thread++)
+	{
+		ASSERT_EQ(results[thread].get(), expected);
+	}
+	for (int i = 0; i < 10000; i++)
+	{
+		ASSERT_EQ(expected[i].getName(), "symbol_tests_" + std::to_string(i));
+	}
+}
+
+
+TEST(Parsing_SymbolTests, symbolsOrderByNameNotByWhenTheyWereInterned)
+{
+	const parsing::TagSymbol later("symbolOrderZZZ");
+	const parsing::TagSymbol earlier("symbolOrderAAA");
+
+	const std::set<parsing::TagSymbol> symbols{ later, earlier };
+
+	ASSERT_EQ(symbols.begin()->getName(), "symbolOrderAAA");
+	ASSERT_TRUE(earlier < later);
+	ASSERT_FALSE(later < earlier);
+	ASSERT_FALSE(later < later);
+}
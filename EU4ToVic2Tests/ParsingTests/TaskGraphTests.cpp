@@ -0,0 +1,178 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/TaskGraph.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+
+TEST(Parsing_TaskGraphTests, stagesRunAfterTheirDependencies)
+{
+	std::mutex mutex;
+	std::vector<std::string> order;
+	const auto record = [&mutex, &order](const std::string& name) {
+		return [&mutex, &order, name]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			order.push_back(name);
+		};
+	};
+
+	parsing::TaskGraph graph;
+	const auto first = graph.addStage("first", record("first"));
+	const auto second = graph.addStage("second", record("second"), { first });
+	const auto third = graph.addStage("third", record("third"), { first });
+	graph.addStage("last", record("last"), { second, third });
+
+	parsing::WorkerPool pool(3);
+	graph.run(pool);
+
+	ASSERT_EQ(order.size(), 4);
+	ASSERT_EQ(order.front(), "first");
+	ASSERT_EQ(order.back(), "last");
+	ASSERT_EQ(graph.getTimings().size(), 4);
+}
+
+
+TEST(Parsing_TaskGraphTests, independentStagesRunAtTheSameTime)
+{
+	std::mutex mutex;
+	std::condition_variable started;
+	int running = 0;
+	bool overlapped = true;
+	const auto meet = [&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		running++;
+		started.notify_all();
+		overlapped &= started.wait_for(lock, std::chrono::seconds(5), [&running]() { return running == 2; });
+	};
+
+	parsing::TaskGraph graph;
+	graph.addStage("save", meet);
+	graph.addStage("install", meet);
+
+	parsing::WorkerPool pool(2);
+	graph.run(pool);
+
+	ASSERT_TRUE(overlapped);
+}
+
+
+TEST(Parsing_TaskGraphTests, poolWithoutThreadsRunsStagesInOrder)
+{
+	std::vector<int> order;
+	parsing::TaskGraph graph;
+	const auto first = graph.addStage("first", [&order]() { order.push_back(1); });
+	graph.addStage("second", [&order]() { order.push_back(2); }, { first });
+	graph.addStage("third", [&order]() { order.push_back(3); });
+
+	parsing::WorkerPool pool(0);
+	graph.run(pool);
+
+	ASSERT_EQ(order, std::vector<int>({ 1, 3, 2 }));
+}
+
+
+TEST(Parsing_TaskGraphTests, logIsWrittenInTheOrderStagesWereAdded)
+{
+	std::mutex mutex;
+	std::condition_variable secondLogged;
+	bool secondDone = false;
+
+	parsing::TaskGraph graph;
+	graph.addStage("first", [&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		secondLogged.wait_for(lock, std::chrono::seconds(5), [&secondDone]() { return secondDone; });
+		WORKER_LOG(LogLevel::Info) << "first";
+	});
+	graph.addStage("second", [&]() {
+		WORKER_LOG(LogLevel::Info) << "second";
+		std::lock_guard<std::mutex> lock(mutex);
+		secondDone = true;
+		secondLogged.notify_all();
+	});
+
+	parsing::LogCapture log;
+	parsing::WorkerPool pool(2);
+	graph.run(pool);
+
+	const auto messages = log.takeMessages();
+	ASSERT_EQ(messages.size(), 2);
+	ASSERT_EQ(messages[0].text, "first");
+	ASSERT_EQ(messages[1].text, "second");
+}
+
+
+TEST(Parsing_TaskGraphTests, failureSkipsDependentsAndIsRethrown)
+{
+	bool dependentRan = false;
+	bool independentRan = false;
+
+	parsing::TaskGraph graph;
+	const auto failing = graph.addStage("failing", []() { throw std::runtime_error("bad save"); });
+	graph.addStage("dependent", [&dependentRan]() { dependentRan = true; }, { failing });
+	graph.addStage("independent", [&independentRan]() { independentRan = true; });
+
+	parsing::WorkerPool pool(1);
+	ASSERT_THROW(graph.run(pool), std::runtime_error);
+	ASSERT_FALSE(dependentRan);
+	ASSERT_TRUE(independentRan);
+}
+
+
+TEST(Parsing_TaskGraphTests, stagesCanOnlyDependOnEarlierStages)
+{
+	parsing::TaskGraph graph;
+	ASSERT_THROW(graph.addStage("first", []() {}, { 0 }), std::invalid_argument);
+}
+
+
+TEST(Parsing_TaskGraphTests, criticalPathFollowsTheLongestChain)
+{
+	const auto sleepFor = [](int milliseconds) {
+		return [milliseconds]() { std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds)); };
+	};
+
+	parsing::TaskGraph graph;
+	const auto configuration = graph.addStage("configuration", sleepFor(1));
+	const auto save = graph.addStage("save", sleepFor(60), { configuration });
+	const auto install = graph.addStage("install", sleepFor(5), { configuration });
+	graph.addStage("output", sleepFor(1), { save, install });
+
+	parsing::WorkerPool pool(2);
+	graph.run(pool);
+
+	const auto path = graph.getCriticalPath();
+	ASSERT_EQ(path.size(), 3);
+	ASSERT_EQ(path[0].name, "configuration");
+	ASSERT_EQ(path[1].name, "save");
+	ASSERT_EQ(path[2].name, "output");
+	ASSERT_GE(path[1].seconds, 0.05);
+	ASSERT_GE(path[2].start, path[1].start + path[1].seconds);
+	ASSERT_GE(graph.getSeconds(), 0.06);
+}
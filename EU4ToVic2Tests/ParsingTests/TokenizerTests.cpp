@@ -0,0 +1,136 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/Tokenizer.h"
+#include <string>
+
+
+
+TEST(Parsing_TokenizerTests, emptyBufferHasNoTokens)
+{
+	std::string input;
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_FALSE(tokenizer.getNextToken());
+	ASSERT_TRUE(tokenizer.atEnd());
+}
+
+
+TEST(Parsing_TokenizerTests, structuralCharactersAreSeparateTokens)
+{
+	std::string input = "key={value}";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "key");
+	ASSERT_EQ(*tokenizer.getNextToken(), "=");
+	ASSERT_EQ(*tokenizer.getNextToken(), "{");
+	ASSERT_EQ(*tokenizer.getNextToken(), "value");
+	ASSERT_EQ(*tokenizer.getNextToken(), "}");
+	ASSERT_FALSE(tokenizer.getNextToken());
+}
+
+
+TEST(Parsing_TokenizerTests, quotedStringsKeepTheirQuotesAndSpaces)
+{
+	std::string input = "name = \"Holy Roman Empire\"";
+	parsing::Tokenizer tokenizer(input);
+
+	tokenizer.getNextToken();
+	tokenizer.getNextToken();
+	ASSERT_EQ(*tokenizer.getNextToken(), "\"Holy Roman Empire\"");
+}
+
+
+TEST(Parsing_TokenizerTests, commentsAreSkipped)
+{
+	std::string input = "# a comment = {\nkey # another comment\n= 1";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(*tokenizer.getNextToken(), "key");
+	ASSERT_EQ(*tokenizer.getNextToken(), "=");
+	ASSERT_EQ(*tokenizer.getNextToken(), "1");
+}
+
+
+TEST(Parsing_TokenizerTests, tokensPointIntoTheBuffer)
+{
+	std::string input = "owner=SWE";
+	parsing::Tokenizer tokenizer(input);
+
+	tokenizer.getNextToken();
+	tokenizer.getNextToken();
+	auto token = tokenizer.getNextToken();
+	ASSERT_EQ(token->data(), input.data() + 6);
+}
+
+
+TEST(Parsing_TokenizerTests, peekDoesNotConsume)
+{
+	std::string input = "first second";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(*tokenizer.peekToken(), "first");
+	ASSERT_EQ(*tokenizer.getNextToken(), "first");
+	ASSERT_EQ(*tokenizer.getNextToken(), "second");
+}
+
+
+TEST(Parsing_TokenizerTests, itemTextCoversNestedBlocks)
+{
+	std::string input = "= { a = { b = c } d = \"}\" } next";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(tokenizer.getItemText(), "= { a = { b = c } d = \"}\" }");
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
+
+
+TEST(Parsing_TokenizerTests, itemTextCoversSingleValues)
+{
+	std::string input = "= 1444.11.11 next";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(tokenizer.getItemText(), "= 1444.11.11");
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
+
+
+TEST(Parsing_TokenizerTests, itemTextHandlesBlocksWithoutEquals)
+{
+	std::string input = "{ 1 2 3 } next";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(tokenizer.getItemText(), "{ 1 2 3 }");
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
+
+
+TEST(Parsing_TokenizerTests, itemTextSkipsBracesInCommentsAndStrings)
+{
+	std::string input = "= { a = \"{\" # }\n b = x\"y c = { } } next";
+	parsing::Tokenizer tokenizer(input);
+
+	ASSERT_EQ(tokenizer.getItemText(), "= { a = \"{\" # }\n b = x\"y c = { } }");
+	ASSERT_EQ(*tokenizer.getNextToken(), "next");
+}
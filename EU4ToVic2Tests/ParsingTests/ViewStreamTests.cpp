@@ -0,0 +1,67 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/ViewStream.h"
+#include <string>
+
+
+
+TEST(Parsing_ViewStreamTests, streamReadsTheView)
+{
+	std::string input = "owner = SWE";
+	parsing::ViewStream theStream(input);
+
+	std::string key;
+	std::string equals;
+	std::string value;
+	theStream >> key >> equals >> value;
+
+	ASSERT_EQ(key, "owner");
+	ASSERT_EQ(value, "SWE");
+}
+
+
+TEST(Parsing_ViewStreamTests, consumedCountsCharactersRead)
+{
+	std::string input = "abcdef";
+	parsing::ViewStream theStream(input);
+
+	char character;
+	theStream.get(character);
+	theStream.get(character);
+	theStream.putback(character);
+
+	ASSERT_EQ(theStream.consumed(), 1);
+}
+
+
+TEST(Parsing_ViewStreamTests, streamSupportsTellAndSeek)
+{
+	std::string input = "abcdef";
+	parsing::ViewStream theStream(input);
+
+	theStream.seekg(3);
+	ASSERT_EQ(theStream.tellg(), 3);
+	ASSERT_EQ(theStream.get(), 'd');
+}
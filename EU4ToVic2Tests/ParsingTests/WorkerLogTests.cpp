@@ -0,0 +1,77 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/WorkerLog.h"
+#include <thread>
+
+
+
+TEST(Parsing_WorkerLogTests, captureHoldsMessages)
+{
+	parsing::LogCapture log;
+	WORKER_LOG(LogLevel::Warning) << "Unknown building " << 42;
+
+	const auto messages = log.takeMessages();
+	ASSERT_EQ(messages.size(), 1);
+	ASSERT_EQ(messages[0].level, LogLevel::Warning);
+	ASSERT_EQ(messages[0].text, "Unknown building 42");
+	ASSERT_TRUE(log.takeMessages().empty());
+}
+
+
+TEST(Parsing_WorkerLogTests, innerCaptureTakesMessages)
+{
+	parsing::LogCapture outer;
+	{
+		parsing::LogCapture inner;
+		WORKER_LOG(LogLevel::Info) << "inner";
+		ASSERT_EQ(inner.takeMessages().size(), 1);
+	}
+	WORKER_LOG(LogLevel::Info) << "outer";
+
+	const auto messages = outer.takeMessages();
+	ASSERT_EQ(messages.size(), 1);
+	ASSERT_EQ(messages[0].text, "outer");
+}
+
+
+TEST(Parsing_WorkerLogTests, replayedMessagesReachTheActiveCapture)
+{
+	std::vector<parsing::LogMessage> workerMessages;
+	std::thread worker([&workerMessages]() {
+		parsing::LogCapture log;
+		WORKER_LOG(LogLevel::Warning) << "first";
+		WORKER_LOG(LogLevel::Warning) << "second";
+		workerMessages = log.takeMessages();
+	});
+	worker.join();
+
+	parsing::LogCapture log;
+	parsing::replayLog(workerMessages);
+
+	const auto messages = log.takeMessages();
+	ASSERT_EQ(messages.size(), 2);
+	ASSERT_EQ(messages[0].text, "first");
+	ASSERT_EQ(messages[1].text, "second");
+}
@@ -0,0 +1,139 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/WorkerPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+
+TEST(Parsing_WorkerPoolTests, resultsComeBackThroughFutures)
+{
+	parsing::WorkerPool pool(3);
+
+	std::vector<std::future<int>> results;
+	for (auto i = 0; i < 20; i++)
+	{
+		results.push_back(pool.submit([i]() { return i * i; }));
+	}
+
+	for (auto i = 0; i < 20; i++)
+	{
+		ASSERT_EQ(results[i].get(), i * i);
+	}
+}
+
+
+TEST(Parsing_WorkerPoolTests, exceptionsComeBackThroughFutures)
+{
+	parsing::WorkerPool pool(1);
+
+	auto result = pool.submit([]() -> int { throw std::runtime_error("failed"); });
+
+	ASSERT_THROW(result.get(), std::runtime_error);
+}
+
+
+TEST(Parsing_WorkerPoolTests, poolWithoutThreadsRunsTasksImmediately)
+{
+	parsing::WorkerPool pool(0);
+
+	auto ran = false;
+	pool.submit([&ran]() { ran = true; });
+
+	ASSERT_TRUE(ran);
+	ASSERT_EQ(pool.getThreadCount(), 0);
+}
+
+
+TEST(Parsing_WorkerPoolTests, allTasksRunBeforeTheirFuturesAreReady)
+{
+	std::atomic<int> count = 0;
+	{
+		parsing::WorkerPool pool(4);
+		std::vector<std::future<void>> results;
+		for (auto i = 0; i < 100; i++)
+		{
+			results.push_back(pool.submit([&count]() { count++; }));
+		}
+		for (auto& result: results)
+		{
+			result.get();
+		}
+	}
+
+	ASSERT_EQ(count, 100);
+}
+
+
+TEST(Parsing_WorkerPoolTests, waitingTasksRunQueuedTasks)
+{
+	// one thread, busy with the outer task, so the inner ones only run if the waiting task runs them
+	parsing::WorkerPool pool(1);
+
+	auto outer = pool.submit([&pool]() {
+		std::vector<std::future<int>> inner;
+		for (auto i = 0; i < 10; i++)
+		{
+			inner.push_back(pool.submit([i]() { return i; }));
+		}
+		pool.waitAll(inner);
+
+		auto sum = 0;
+		for (auto& result: inner)
+		{
+			sum += result.get();
+		}
+		return sum;
+	});
+	pool.wait(outer);
+
+	ASSERT_EQ(outer.get(), 45);
+}
+
+
+TEST(Parsing_WorkerPoolTests, waitAllWaitsPastTheFirstError)
+{
+	parsing::WorkerPool pool(2);
+
+	std::atomic<int> count = 0;
+	std::vector<std::future<void>> results;
+	results.push_back(pool.submit([]() { throw std::runtime_error("failed"); }));
+	for (auto i = 0; i < 20; i++)
+	{
+		results.push_back(pool.submit([&count]() { count++; }));
+	}
+	pool.waitAll(results);
+
+	ASSERT_EQ(count, 20);
+	ASSERT_THROW(results.front().get(), std::runtime_error);
+}
+
+
+TEST(Parsing_WorkerPoolTests, thereIsOneSharedPool)
+{
+	ASSERT_EQ(&parsing::WorkerPool::shared(), &parsing::WorkerPool::shared());
+	ASSERT_EQ(parsing::WorkerPool::shared().getThreadCount(), parsing::WorkerPool::defaultThreadCount());
+}
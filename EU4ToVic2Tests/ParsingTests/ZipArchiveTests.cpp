@@ -0,0 +1,283 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/Parsing/Tokenizer.h"
+#include "../EU4toV2/Source/Parsing/ZipArchive.h"
+#include "../EU4toV2/Source/Parsing/ZippedSave.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+struct TestEntry
+{
+	std::string name;
+	uint16_t method = 0;
+	std::string storedData;
+	std::string contents;
+	uint32_t crc = 0;
+};
+
+
+uint32_t getCrc(const std::string& data)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	for (const auto character: data)
+	{
+		crc ^= static_cast<uint8_t>(character);
+		for (int bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 1) ? (0xEDB88320 ^ (crc >> 1)) : (crc >> 1);
+		}
+	}
+	return crc ^ 0xFFFFFFFF;
+}
+
+
+TestEntry makeStoredEntry(const std::string& name, const std::string& contents)
+{
+	return { name, 0, contents, contents, getCrc(contents) };
+}
+
+
+// "owner=SWE" as a fixed Huffman block
+TestEntry makeDeflatedEntry(const std::string& name)
+{
+	return { name, 8, std::string("\xcb\x2f\xcf\x4b\x2d\xb2\x0d\x0e\x77\x05\x00", 11), "owner=SWE", getCrc("owner=SWE") };
+}
+
+
+void add16(std::string& zip, uint16_t value)
+{
+	zip += static_cast<char>(value & 0xFF);
+	zip += static_cast<char>(value >> 8);
+}
+
+
+void add32(std::string& zip, uint32_t value)
+{
+	add16(zip, static_cast<uint16_t>(value & 0xFFFF));
+	add16(zip, static_cast<uint16_t>(value >> 16));
+}
+
+
+void add64(std::string& zip, uint64_t value)
+{
+	add32(zip, static_cast<uint32_t>(value & 0xFFFFFFFF));
+	add32(zip, static_cast<uint32_t>(value >> 32));
+}
+
+
+// a zip of the entries, with its end of central directory record in zip64 form if asked for
+std::string makeZip(const std::vector<TestEntry>& entries, bool zip64 = false)
+{
+	std::string zip;
+	std::vector<uint32_t> localHeaderOffsets;
+	for (const auto& entry: entries)
+	{
+		localHeaderOffsets.push_back(static_cast<uint32_t>(zip.size()));
+		add32(zip, 0x04034b50);
+		add16(zip, 20);
+		add16(zip, 0);
+		add16(zip, entry.method);
+		add32(zip, 0);
+		add32(zip, entry.crc);
+		add32(zip, static_cast<uint32_t>(entry.storedData.size()));
+		add32(zip, static_cast<uint32_t>(entry.contents.size()));
+		add16(zip, static_cast<uint16_t>(entry.name.size()));
+		add16(zip, 0);
+		zip += entry.name;
+		zip += entry.storedData;
+	}
+
+	const auto directoryOffset = zip.size();
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const auto& entry = entries[i];
+		add32(zip, 0x02014b50);
+		add16(zip, 20);
+		add16(zip, 20);
+		add16(zip, 0);
+		add16(zip, entry.method);
+		add32(zip, 0);
+		add32(zip, entry.crc);
+		add32(zip, static_cast<uint32_t>(entry.storedData.size()));
+		add32(zip, static_cast<uint32_t>(entry.contents.size()));
+		add16(zip, static_cast<uint16_t>(entry.name.size()));
+		add16(zip, 0);
+		add16(zip, 0);
+		add16(zip, 0);
+		add16(zip, 0);
+		add32(zip, 0);
+		add32(zip, localHeaderOffsets[i]);
+		zip += entry.name;
+	}
+	const auto directorySize = zip.size() - directoryOffset;
+
+	if (zip64)
+	{
+		const auto zip64RecordOffset = zip.size();
+		add32(zip, 0x06064b50);
+		add64(zip, 44);
+		add16(zip, 45);
+		add16(zip, 45);
+		add32(zip, 0);
+		add32(zip, 0);
+		add64(zip, entries.size());
+		add64(zip, entries.size());
+		add64(zip, directorySize);
+		add64(zip, directoryOffset);
+
+		add32(zip, 0x07064b50);
+		add32(zip, 0);
+		add64(zip, zip64RecordOffset);
+		add32(zip, 1);
+	}
+
+	add32(zip, 0x06054b50);
+	add16(zip, 0);
+	add16(zip, 0);
+	add16(zip, zip64 ? 0xFFFF : static_cast<uint16_t>(entries.size()));
+	add16(zip, zip64 ? 0xFFFF : static_cast<uint16_t>(entries.size()));
+	add32(zip, static_cast<uint32_t>(directorySize));
+	add32(zip, zip64 ? 0xFFFFFFFF : static_cast<uint32_t>(directoryOffset));
+	add16(zip, 0);
+	return zip;
+}
+
+
+std::string extract(const parsing::ZipArchive& archive, const std::string& name)
+{
+	const auto entry = archive.findEntry(name);
+	if (!entry)
+	{
+		return {};
+	}
+	std::string output(entry->uncompressedSize, '\0');
+	const auto size = archive.extract(*entry, output.data(), {});
+	output.resize(size);
+	return output;
+}
+
+
+// a file of its own for each test
+class ZipFileTest: public ::testing::Test
+{
+	protected:
+		void SetUp() override
+		{
+			path = (std::filesystem::temp_directory_path() / ("ZipArchiveTests_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".zip")).string();
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove(path);
+		}
+
+		const std::string& writeZip(const std::string& contents)
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file << contents;
+			return path;
+		}
+
+		std::string path;
+};
+
+}
+
+
+class Parsing_ZipArchiveTests: public ZipFileTest {};
+class Parsing_ZippedSaveTests: public ZipFileTest {};
+
+
+TEST_F(Parsing_ZipArchiveTests, storedEntriesCanBeExtracted)
+{
+	const parsing::ZipArchive archive(writeZip(makeZip({ makeStoredEntry("test.eu4", "date=1444.11.11") })));
+
+	ASSERT_EQ(archive.getEntries().size(), 1);
+	ASSERT_EQ(extract(archive, "test.eu4"), "date=1444.11.11");
+}
+
+
+TEST_F(Parsing_ZipArchiveTests, deflatedEntriesCanBeExtracted)
+{
+	const parsing::ZipArchive archive(writeZip(makeZip({ makeStoredEntry("meta", "date=1444.11.11"), makeDeflatedEntry("gamestate") })));
+
+	ASSERT_EQ(archive.getEntries().size(), 2);
+	ASSERT_EQ(extract(archive, "gamestate"), "owner=SWE");
+}
+
+
+TEST_F(Parsing_ZipArchiveTests, zip64DirectoriesCanBeRead)
+{
+	const parsing::ZipArchive archive(writeZip(makeZip({ makeStoredEntry("meta", "date=1444.11.11"), makeDeflatedEntry("gamestate") }, true)));
+
+	ASSERT_EQ(archive.getEntries().size(), 2);
+	ASSERT_EQ(extract(archive, "meta"), "date=1444.11.11");
+	ASSERT_EQ(extract(archive, "gamestate"), "owner=SWE");
+}
+
+
+TEST_F(Parsing_ZipArchiveTests, crcMismatchThrowsException)
+{
+	auto entry = makeDeflatedEntry("gamestate");
+	entry.crc ^= 1;
+	const parsing::ZipArchive archive(writeZip(makeZip({ entry })));
+
+	ASSERT_THROW(extract(archive, "gamestate"), std::runtime_error);
+}
+
+
+TEST_F(Parsing_ZipArchiveTests, truncatedArchiveThrowsException)
+{
+	const auto zip = makeZip({ makeStoredEntry("meta", "date=1444.11.11"), makeDeflatedEntry("gamestate") });
+
+	ASSERT_THROW(parsing::ZipArchive archive(writeZip(zip.substr(0, zip.size() - 10))), std::runtime_error);
+}
+
+
+TEST_F(Parsing_ZippedSaveTests, metaAndGamestateAreStreamedInOrder)
+{
+	const parsing::ZippedSave save(writeZip(makeZip({ makeDeflatedEntry("gamestate"), makeStoredEntry("meta", "date=1444.11.11") })));
+
+	std::vector<std::string> tokens;
+	for (const auto& part: save.getParts())
+	{
+		parsing::Tokenizer tokenizer(*part);
+		while (const auto token = tokenizer.getNextToken())
+		{
+			tokens.emplace_back(*token);
+		}
+	}
+
+	ASSERT_EQ(tokens, std::vector<std::string>({ "date", "=", "1444.11.11", "owner", "=", "SWE" }));
+}
@@ -0,0 +1,226 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/V2World/LandConnections.h"
+#include <queue>
+#include <random>
+
+
+
+namespace
+{
+
+// a directed province graph, as the adjacency mapper would give it
+class Graph
+{
+	public:
+		void addEdge(int from, int to)
+		{
+			if (static_cast<size_t>(from) >= neighbors.size())
+			{
+				neighbors.resize(from + 1);
+			}
+			neighbors[from].push_back(to);
+		}
+
+		void addBorder(int first, int second)
+		{
+			addEdge(first, second);
+			addEdge(second, first);
+		}
+
+		parsing::Span<const int> getAdjacencies(int province) const
+		{
+			if ((province < 0) || (static_cast<size_t>(province) >= neighbors.size()))
+			{
+				return {};
+			}
+			return { neighbors[province].data(), neighbors[province].size() };
+		}
+
+		std::function<parsing::Span<const int>(int)> getFunction() const
+		{
+			return [this](int province) { return getAdjacencies(province); };
+		}
+
+	private:
+		std::vector<std::vector<int>> neighbors;
+};
+
+
+// the search as setupColonies did it before: a separate breadth-first search from each capital over a copy of all
+// the provinces
+std::vector<bool> findLandConnectionsOneCountryAtATime(
+	const std::vector<std::string>& owners,
+	const std::map<std::string, int>& capitals,
+	const Graph& graph
+) {
+	std::vector<bool> reached(owners.size(), false);
+	for (const auto& capital: capitals)
+	{
+		std::map<int, std::string> openProvinces;
+		for (size_t i = 0; i < owners.size(); i++)
+		{
+			if (!owners[i].empty())
+			{
+				openProvinces.insert(std::make_pair(static_cast<int>(i), owners[i]));
+			}
+		}
+
+		const auto openItr = openProvinces.find(capital.second);
+		if ((openItr == openProvinces.end()) || (openItr->second != capital.first))
+		{
+			continue;
+		}
+		reached[openItr->first] = true;
+		std::queue<int> goodProvinces;
+		goodProvinces.push(openItr->first);
+		openProvinces.erase(openItr);
+
+		while (!goodProvinces.empty())
+		{
+			const auto currentProvince = goodProvinces.front();
+			goodProvinces.pop();
+			for (const auto adjacency: graph.getAdjacencies(currentProvince))
+			{
+				const auto neighbor = openProvinces.find(adjacency);
+				if ((neighbor == openProvinces.end()) || (neighbor->second != capital.first))
+				{
+					continue;
+				}
+				reached[neighbor->first] = true;
+				goodProvinces.push(neighbor->first);
+				openProvinces.erase(neighbor);
+			}
+		}
+	}
+	return reached;
+}
+
+}
+
+
+
+TEST(Vic2World_LandConnectionsTests, ownedCapitalReachesConnectedProvincesOfItsOwner)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "SWE", "SWE" };
+	Graph graph;
+	graph.addBorder(1, 2);
+	graph.addBorder(2, 3);
+
+	const auto reached = Vic2::findLandConnections(owners, { { "SWE", 1 } }, graph.getFunction());
+
+	ASSERT_EQ(reached, std::vector<bool>({ false, true, true, true, false }));
+}
+
+
+TEST(Vic2World_LandConnectionsTests, unownedCapitalReachesNothing)
+{
+	const std::vector<std::string> owners{ "", "DAN", "SWE" };
+	Graph graph;
+	graph.addBorder(1, 2);
+
+	const auto reached = Vic2::findLandConnections(owners, { { "SWE", 1 } }, graph.getFunction());
+
+	ASSERT_EQ(reached, std::vector<bool>({ false, false, false }));
+}
+
+
+TEST(Vic2World_LandConnectionsTests, missingCapitalReachesNothing)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE" };
+	Graph graph;
+	graph.addBorder(1, 2);
+
+	const auto reached = Vic2::findLandConnections(owners, { { "SWE", 7 }, { "DAN", -1 } }, graph.getFunction());
+
+	ASSERT_EQ(reached, std::vector<bool>({ false, false, false }));
+}
+
+
+TEST(Vic2World_LandConnectionsTests, edgesAreOnlyFollowedInTheirDirection)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "SWE" };
+	Graph graph;
+	graph.addEdge(1, 2);
+	graph.addEdge(3, 1);
+
+	const auto reached = Vic2::findLandConnections(owners, { { "SWE", 1 } }, graph.getFunction());
+
+	ASSERT_EQ(reached, std::vector<bool>({ false, true, true, false }));
+}
+
+
+TEST(Vic2World_LandConnectionsTests, countriesSharingABorderStayOnTheirOwnSide)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "NOR", "NOR", "SWE" };
+	Graph graph;
+	graph.addBorder(1, 2);
+	graph.addBorder(2, 3);
+	graph.addBorder(3, 4);
+	graph.addBorder(4, 5);
+
+	const auto reached = Vic2::findLandConnections(owners, { { "NOR", 4 }, { "SWE", 1 } }, graph.getFunction());
+
+	// 5 belongs to SWE but can only be reached through NOR
+	ASSERT_EQ(reached, std::vector<bool>({ false, true, true, true, true, false }));
+}
+
+
+TEST(Vic2World_LandConnectionsTests, matchesSearchingOneCountryAtATime)
+{
+	std::mt19937 random(1444);
+	const std::vector<std::string> tags{ "", "SWE", "DAN", "NOR" };
+	for (auto round = 0; round < 200; round++)
+	{
+		const auto provinceCount = std::uniform_int_distribution<int>(1, 40)(random);
+		std::uniform_int_distribution<int> anyProvince(-1, provinceCount + 1);
+		std::uniform_int_distribution<size_t> anyTag(0, tags.size() - 1);
+
+		std::vector<std::string> owners(provinceCount);
+		for (auto& owner: owners)
+		{
+			owner = tags[anyTag(random)];
+		}
+
+		Graph graph;
+		const auto edgeCount = std::uniform_int_distribution<int>(0, provinceCount * 3)(random);
+		for (auto i = 0; i < edgeCount; i++)
+		{
+			const auto from = std::uniform_int_distribution<int>(0, provinceCount - 1)(random);
+			graph.addEdge(from, anyProvince(random));
+		}
+
+		std::map<std::string, int> capitals;
+		for (size_t i = 1; i < tags.size(); i++)
+		{
+			capitals.insert(std::make_pair(tags[i], anyProvince(random)));
+		}
+
+		ASSERT_EQ(
+			Vic2::findLandConnections(owners, capitals, graph.getFunction()),
+			findLandConnectionsOneCountryAtATime(owners, capitals, graph)
+		) << "round " << round;
+	}
+}
@@ -0,0 +1,220 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/V2World/StateGrouping.h"
+#include "../EU4toV2/Source/V2World/StateMapper.h"
+#include <list>
+#include <random>
+#include <sstream>
+
+
+
+namespace
+{
+
+std::vector<std::vector<int>> groupProvinces(
+	const std::string& regions,
+	const std::vector<std::string>& owners,
+	const std::vector<bool>& colonial
+) {
+	std::stringstream input(regions);
+	const Vic2::stateMapper theStateMapper(input);
+	return Vic2::groupProvincesIntoStates(owners, colonial, [&theStateMapper](int province) {
+		return theStateMapper.getAllProvincesInState(province);
+	});
+}
+
+
+// the grouping as setupStates did it before: one list of every province, searched for each province of each state
+std::vector<std::vector<int>> groupProvincesFromOneList(
+	const std::string& regions,
+	const std::vector<std::string>& owners,
+	const std::vector<bool>& colonial
+) {
+	std::stringstream input(regions);
+	const Vic2::stateMapper theStateMapper(input);
+
+	std::list<int> unassignedProvinces;
+	for (size_t i = 0; i < owners.size(); i++)
+	{
+		unassignedProvinces.push_back(static_cast<int>(i));
+	}
+
+	std::vector<std::vector<int>> states;
+	while (!unassignedProvinces.empty())
+	{
+		const auto seed = unassignedProvinces.front();
+		unassignedProvinces.pop_front();
+		if (owners[seed].empty())
+		{
+			continue;
+		}
+
+		std::vector<int> stateProvinces{ seed };
+		for (const auto neighbor: theStateMapper.getAllProvincesInState(seed))
+		{
+			for (auto unassigned = unassignedProvinces.begin(); unassigned != unassignedProvinces.end(); unassigned++)
+			{
+				if ((*unassigned == neighbor) && (owners[neighbor] == owners[seed]) && (colonial[neighbor] == colonial[seed]))
+				{
+					stateProvinces.push_back(neighbor);
+					unassignedProvinces.erase(unassigned);
+					break;
+				}
+			}
+		}
+		states.push_back(std::move(stateProvinces));
+	}
+	return states;
+}
+
+}
+
+
+TEST(Vic2World_StateGroupingTests, provincesOfOneOwnerFollowTheVic2States)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "SWE", "SWE", "SWE" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 2 3 } STATE_2 = { 4 5 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1, 2, 3 }, { 4, 5 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, vic2StateSplitBetweenOwnersGivesAStateForEach)
+{
+	const std::vector<std::string> owners{ "", "SWE", "DAN", "SWE", "DAN" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 2 3 4 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1, 3 }, { 2, 4 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, sameOwnerSplitByANeighbourStaysOneState)
+{
+	// DAN's province 2 lies between SWE's 1 and 3, which still share their Vic2 state
+	const std::vector<std::string> owners{ "", "SWE", "DAN", "SWE", "SWE" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 2 3 } STATE_2 = { 4 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1, 3 }, { 2 }, { 4 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, coloniesAndCoresOfOneOwnerAreSeparateStates)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "SWE" };
+	const std::vector<bool> colonial{ false, false, true, false };
+
+	const auto states = groupProvinces("STATE_1 = { 1 2 3 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1, 3 }, { 2 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, provinceWithoutAVic2StateIsAStateOfItsOwn)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "SWE" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 3 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1, 3 }, { 2 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, unownedProvincesAreInNoState)
+{
+	const std::vector<std::string> owners{ "", "", "SWE", "", "SWE" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 2 3 4 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 2, 4 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, statesAreNumberedByTheirFirstProvinceWhoeverOwnsThem)
+{
+	// owners are handled alphabetically, but AAA's state starts after ZZZ's
+	const std::vector<std::string> owners{ "", "ZZZ", "AAA", "ZZZ", "AAA" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 } STATE_2 = { 2 4 } STATE_3 = { 3 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1 }, { 2, 4 }, { 3 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, provinceInTwoVic2StatesJoinsTheFirst)
+{
+	const std::vector<std::string> owners{ "", "SWE", "SWE", "SWE" };
+	const std::vector<bool> colonial(owners.size(), false);
+
+	const auto states = groupProvinces("STATE_1 = { 1 2 } STATE_2 = { 2 3 }", owners, colonial);
+
+	ASSERT_EQ(states, std::vector<std::vector<int>>({ { 1, 2 }, { 3 } }));
+}
+
+
+TEST(Vic2World_StateGroupingTests, matchesGroupingFromOneList)
+{
+	std::mt19937 random(1821);
+	const std::vector<std::string> tags{ "", "SWE", "DAN", "NOR" };
+	for (auto round = 0; round < 200; round++)
+	{
+		const auto provinceCount = std::uniform_int_distribution<int>(1, 40)(random);
+		std::uniform_int_distribution<int> anyProvince(0, provinceCount + 1);
+		std::uniform_int_distribution<size_t> anyTag(0, tags.size() - 1);
+		std::bernoulli_distribution isColonial(0.2);
+
+		std::vector<std::string> owners(provinceCount);
+		std::vector<bool> colonial(provinceCount);
+		for (auto i = 0; i < provinceCount; i++)
+		{
+			owners[i] = tags[anyTag(random)];
+			colonial[i] = isColonial(random);
+		}
+
+		// some provinces in no state, some in two
+		std::ostringstream regions;
+		const auto stateCount = std::uniform_int_distribution<int>(0, provinceCount / 2 + 1)(random);
+		for (auto state = 0; state < stateCount; state++)
+		{
+			regions << "STATE_" << state << " = {";
+			const auto size = std::uniform_int_distribution<int>(1, 6)(random);
+			for (auto i = 0; i < size; i++)
+			{
+				regions << " " << anyProvince(random);
+			}
+			regions << " } ";
+		}
+
+		ASSERT_EQ(groupProvinces(regions.str(), owners, colonial), groupProvincesFromOneList(regions.str(), owners, colonial)) << "round " << round;
+	}
+}
@@ -50,4 +50,24 @@ TEST(Vic2World_StateMapperTests, getAllProvincesForMultiProvinceState)
 	Vic2::stateMapper theStateMapper(input);
 
 	ASSERT_EQ(theStateMapper.getAllProvincesInState(1).size(), 3);
+}
+
+TEST(Vic2World_StateMapperTests, provincesComeInOrder)
+{
+	std::stringstream input("STATE_1 = { 3 1 2 1 }");
+	Vic2::stateMapper theStateMapper(input);
+
+	const auto provinces = theStateMapper.getAllProvincesInState(2);
+	ASSERT_EQ(std::vector<int>(provinces.begin(), provinces.end()), std::vector<int>({ 1, 2, 3 }));
+}
+
+
+TEST(Vic2World_StateMapperTests, provinceInTwoStatesStaysInTheFirst)
+{
+	std::stringstream input("STATE_1 = { 1 2 } STATE_2 = { 2 3 }");
+	Vic2::stateMapper theStateMapper(input);
+
+	ASSERT_EQ(theStateMapper.getAllProvincesInState(2).size(), 2);
+	ASSERT_EQ(theStateMapper.getAllProvincesInState(2)[0], 1);
+	ASSERT_EQ(theStateMapper.getAllProvincesInState(3).size(), 2);
 }
\ No newline at end of file
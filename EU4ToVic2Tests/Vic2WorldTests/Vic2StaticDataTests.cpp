@@ -0,0 +1,134 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "gtest/gtest.h"
+#include "../EU4toV2/Source/V2World/Vic2StaticData.h"
+#include "../EU4toV2/Source/Configuration.h"
+#include <algorithm>
+#include <sstream>
+
+
+
+namespace
+{
+
+// a snapshot of one province with a name, a climate and pops, and one factory type
+std::string getStaticDataSnapshot()
+{
+	std::ostringstream output;
+	parsing::SnapshotWriter snapshot(output, 1, 1);
+	snapshot.writeCount(1);
+	snapshot.write("/europe/1 - Stockholm.txt");
+	snapshot.write(1);
+	snapshot.write("SWE");
+	snapshot.write("SWE");
+	snapshot.write(std::vector<std::string>{ "SWE", "FIN" });
+	snapshot.write("iron");
+	snapshot.write(35);
+	snapshot.write("");
+	snapshot.write(0);
+	snapshot.write(0);
+	snapshot.write(1);
+	snapshot.write(0);
+	snapshot.write(0);
+	snapshot.write(false);
+	snapshot.write(std::map<int, std::string>{ { 1, "Stockholm" } });
+	snapshot.write(std::map<int, std::string>{ { 1, "temperate_climate" } });
+	snapshot.write(std::map<int, std::string>{ { 1, "farmlands" } });
+	snapshot.writeCount(1);
+	snapshot.write("Sweden.txt");
+	snapshot.writeCount(1);
+	snapshot.write(1);
+	snapshot.writeCount(1);
+	snapshot.write("farmers");
+	snapshot.write(5000);
+	snapshot.write("swedish");
+	snapshot.write("protestant");
+	snapshot.write(std::set<int>{ 1 });
+	snapshot.writeCount(1);
+	snapshot.write("steel_factory");
+	snapshot.write(false);
+	snapshot.write("");
+	snapshot.write("");
+	snapshot.writeCount(1);
+	snapshot.write("iron");
+	snapshot.write(2.5);
+	snapshot.write("steel");
+	snapshot.writeCount(1);
+	snapshot.write("steel_factory");
+	snapshot.write(2);
+	return output.str();
+}
+
+}
+
+
+
+TEST(Vic2World_StaticDataTests, sourceFilesIncludeBlankModAndVic2VersionsOfProvinceHistory)
+{
+	const auto files = Vic2::StaticData::getSourceFiles({ "/europe/1 - Stockholm.txt" }, {});
+
+	ASSERT_NE(std::find(files.begin(), files.end(), "./blankMod/output/history/provinces/europe/1 - Stockholm.txt"), files.end());
+	ASSERT_NE(std::find(files.begin(), files.end(), theConfiguration().getVic2Path() + "/history/provinces/europe/1 - Stockholm.txt"), files.end());
+}
+
+
+TEST(Vic2World_StaticDataTests, sourceFilesIncludePopFiles)
+{
+	const auto files = Vic2::StaticData::getSourceFiles({}, { "Sweden.txt" });
+
+	ASSERT_NE(std::find(files.begin(), files.end(), "./blankMod/output/history/pops/1836.1.1/Sweden.txt"), files.end());
+}
+
+
+TEST(Vic2World_StaticDataTests, staticDataReadsFromASnapshot)
+{
+	const auto data = getStaticDataSnapshot();
+	parsing::SnapshotReader snapshot(data, 1, 1);
+	Vic2::StaticData theStaticData(snapshot);
+
+	ASSERT_TRUE(snapshot.atEnd());
+	ASSERT_EQ(theStaticData.getProvinceHistories().size(), 1);
+	ASSERT_EQ(theStaticData.getProvinceHistories()[0].num, 1);
+	ASSERT_EQ(theStaticData.getProvinceHistories()[0].cores, std::vector<std::string>({ "SWE", "FIN" }));
+	ASSERT_EQ(theStaticData.getProvinceHistories()[0].navalBaseLevel, 1);
+	ASSERT_EQ(theStaticData.getProvinceNames().at(1), "Stockholm");
+	ASSERT_EQ(theStaticData.getPopFiles()[0].provincePops[0].second[0].size, 5000);
+	ASSERT_EQ(theStaticData.getCoastalProvinces().count(1), 1);
+	ASSERT_EQ(theStaticData.getFactoryTypes()[0].inputs.at("iron"), 2.5);
+	ASSERT_EQ(theStaticData.getStartingFactories()[0], std::make_pair(std::string("steel_factory"), 2));
+}
+
+
+TEST(Vic2World_StaticDataTests, staticDataWritesTheSnapshotItWasReadFrom)
+{
+	const auto data = getStaticDataSnapshot();
+	parsing::SnapshotReader snapshot(data, 1, 1);
+	Vic2::StaticData theStaticData(snapshot);
+
+	std::ostringstream output;
+	parsing::SnapshotWriter writer(output, 1, 1);
+	theStaticData.writeSnapshot(writer);
+
+	ASSERT_EQ(output.str(), data);
+}
@@ -23,16 +23,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Configuration.h"
 #include "ParserHelpers.h"
-#include "Log.h"
+#include "Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include <vector>
 
 
 
-Configuration theConfiguration;
-
-
-
 void Configuration::instantiate(std::istream& theStream, bool (*doesFolderExist)(const std::string& path), bool (*doesFileExist)(const std::string& path))
 {
 	registerKeyword(std::regex("EU4directory"), [this, doesFolderExist, doesFileExist](const std::string& unused, std::istream& theStream){
@@ -52,6 +48,10 @@ void Configuration::instantiate(std::istream& theStream, bool (*doesFolderExist)
 		commonItems::singleString path(theStream);
 		CK2ExportPath = path.getString();
 	});
+	registerKeyword(std::regex("binaryTokensFile"), [this](const std::string& unused, std::istream& theStream){
+		commonItems::singleString path(theStream);
+		binaryTokensPath = path.getString();
+	});
 	registerKeyword(std::regex("Vic2directory"), [this, doesFolderExist, doesFileExist](const std::string& unused, std::istream& theStream){
 		commonItems::singleString path(theStream);
 		Vic2Path = path.getString();
@@ -84,29 +84,29 @@ void Configuration::instantiate(std::istream& theStream, bool (*doesFolderExist)
 	registerKeyword(std::regex("popShaping"), [this](const std::string& unused, std::istream& theStream){
 		commonItems::singleInt popShapingInt(theStream);
 		popShaping = Configuration::POPSHAPES(popShapingInt.getInt());
-		LOG(LogLevel::Info) << "Pop Shaping: " << popShapingInt.getInt();
+		WORKER_LOG(LogLevel::Info) << "Pop Shaping: " << popShapingInt.getInt();
 		});
 	registerKeyword(std::regex("coreHandling"), [this](const std::string& unused, std::istream& theStream) {
 		commonItems::singleInt coreHandlingInt(theStream);
 		coreHandling = Configuration::COREHANDLES(coreHandlingInt.getInt());
-		LOG(LogLevel::Info) << "Core Handling: " << coreHandlingInt.getInt();
+		WORKER_LOG(LogLevel::Info) << "Core Handling: " << coreHandlingInt.getInt();
 		});
 	registerKeyword(std::regex("popShapingFactor"), [this](const std::string& unused, std::istream& theStream) {
 		commonItems::singleDouble popShapingFactorDouble(theStream);
 		popShapingFactor = popShapingFactorDouble.getDouble();
-		LOG(LogLevel::Info) << "Pop Shaping Factor: " << popShapingFactor;
+		WORKER_LOG(LogLevel::Info) << "Pop Shaping Factor: " << popShapingFactor;
 	});
 	registerKeyword(std::regex("euroCentrism"), [this](const std::string& unused, std::istream& theStream) {
 		commonItems::singleInt euroCentrismInt(theStream);
 		euroCentric = Configuration::EUROCENTRISM(euroCentrismInt.getInt());
-		LOG(LogLevel::Info) << "Eurocentrism: " << euroCentrismInt.getInt();
+		WORKER_LOG(LogLevel::Info) << "Eurocentrism: " << euroCentrismInt.getInt();
 	});
 	registerKeyword(std::regex("debug"), [this](const std::string& unused, std::istream& theStream){
 		commonItems::singleString debugString(theStream);
 		debug = (debugString.getString() == "yes");
 	});
 
-	LOG(LogLevel::Info) << "Reading configuration file";
+	WORKER_LOG(LogLevel::Info) << "Reading configuration file";
 	parseStream(theStream);
 }
 
@@ -115,23 +115,23 @@ void Configuration::verifyEU4Path(const std::string& path, bool (*doesFolderExis
 {
 	if (!doesFolderExist(path))
 	{
-		LOG(LogLevel::Error) << path << " does not exist";
+		WORKER_LOG(LogLevel::Error) << path << " does not exist";
 		exit(-1);
 	}
 	else if (!doesFileExist(path + "/eu4.exe"))
 	{
-		LOG(LogLevel::Error) << path << " does not contain Europa Universalis 4";
+		WORKER_LOG(LogLevel::Error) << path << " does not contain Europa Universalis 4";
 		exit(-1);
 	}
 
 	else if (!doesFileExist(path + "/map/positions.txt"))
 	{
-		LOG(LogLevel::Error) << path << " does not appear to be a valid EU4 install";
+		WORKER_LOG(LogLevel::Error) << path << " does not appear to be a valid EU4 install";
 		exit(-1);
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "EU4 install path is " << path;
+		WORKER_LOG(LogLevel::Debug) << "EU4 install path is " << path;
 	}
 }
 
@@ -140,17 +140,17 @@ void Configuration::verifyVic2Path(const std::string& path, bool (*doesFolderExi
 {
 	if (!doesFolderExist(path))
 	{
-		LOG(LogLevel::Error) << path << " does not exist";
+		WORKER_LOG(LogLevel::Error) << path << " does not exist";
 		exit(-1);
 	}
 	else if (!doesFileExist(path + "/v2game.exe"))
 	{
-		LOG(LogLevel::Error) << path << " does not contain Victoria 2";
+		WORKER_LOG(LogLevel::Error) << path << " does not contain Victoria 2";
 		exit(-1);
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "Victoria 2 install path is " << path;
+		WORKER_LOG(LogLevel::Debug) << "Victoria 2 install path is " << path;
 	}
 }
 
@@ -159,12 +159,12 @@ void Configuration::verifyVic2DocumentsPath(const std::string& path, bool (*does
 {
 	if (!doesFolderExist(path))
 	{
-		LOG(LogLevel::Error) << path << " does not exist";
+		WORKER_LOG(LogLevel::Error) << path << " does not exist";
 		exit(-1);
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "Victoria 2 documents directory is " << path;
+		WORKER_LOG(LogLevel::Debug) << "Victoria 2 documents directory is " << path;
 	}
 }
 
@@ -185,7 +185,7 @@ bool Configuration::wasDLCActive(const std::string& DLC)
 ConfigurationFile::ConfigurationFile(const std::string& filename)
 {
 	registerKeyword(std::regex("configuration"), [](const std::string& unused, std::istream& theStream){
-		theConfiguration.instantiate(theStream, Utils::doesFolderExist, Utils::DoesFileExist);
+		theConfiguration().instantiate(theStream, Utils::doesFolderExist, Utils::DoesFileExist);
 	});
 
 	parseFile(filename);
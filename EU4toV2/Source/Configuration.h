@@ -49,6 +49,7 @@ class Configuration: commonItems::parser
 		std::string getEU4DocumentsPath() const { return EU4DocumentsPath; }
 		std::string getSteamWorkshopPath() const { return SteamWorkshopPath; }
 		std::string getCK2ExportPath() const { return CK2ExportPath; }
+		std::string getBinaryTokensPath() const { return binaryTokensPath; }
 		std::string getVic2Path() { return Vic2Path; }
 		std::string getVic2DocumentsPath() { return Vic2DocumentsPath; }
 		std::string getVic2Gametype() { return Vic2Gametype; }
@@ -72,6 +73,7 @@ class Configuration: commonItems::parser
 		date getStartEU4Date() { return startEU4Date; }
 		std::string getOutputName() { return outputName; }
 		std::vector<std::string> getEU4Mods() { return EU4Mods; }
+		std::vector<std::string> getActiveDLCs() const { return activeDLCs; }
 
 		void setFirstEU4Date(date _firstDate) { firstEU4Date = _firstDate; }
 		void setLastEU4Date(date _lastDate) { lastEU4Date = _lastDate; }
@@ -93,6 +95,7 @@ class Configuration: commonItems::parser
 		std::string EU4DocumentsPath;
 		std::string SteamWorkshopPath;
 		std::string CK2ExportPath;
+		std::string binaryTokensPath = "eu4tokens.txt";
 		std::string Vic2Path;
 		std::string Vic2DocumentsPath;
 		std::string Vic2Gametype = "HOD";
@@ -117,7 +120,8 @@ class Configuration: commonItems::parser
 };
 
 
-extern Configuration theConfiguration;
+// the configuration of the conversion running on this thread, see ConversionContext
+Configuration& theConfiguration();
 
 
 class ConfigurationFile: commonItems::parser
@@ -0,0 +1,116 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ConversionBatch.h"
+#include "Parsing/WorkerLog.h"
+#include "Parsing/WorkerPool.h"
+#include <fstream>
+#include <future>
+#include <optional>
+#include <stdexcept>
+
+
+
+int runConversionBatch(const std::vector<ConversionJob>& jobs, const BatchJobRunner& runJob, size_t parallelJobs)
+{
+	struct JobResult
+	{
+		bool converted = false;
+		std::vector<parsing::LogMessage> messages;
+	};
+
+	// a pool without threads runs each job as it's given, logging as it goes
+	const bool holdLogs = parallelJobs > 1;
+	parsing::WorkerPool pool(holdLogs ? parallelJobs : 0);
+	std::vector<std::future<JobResult>> results;
+	for (const auto& job: jobs)
+	{
+		results.push_back(pool.submit([&runJob, &job, holdLogs]() {
+			JobResult result;
+			std::optional<parsing::LogCapture> log;
+			if (holdLogs)
+			{
+				log.emplace();
+			}
+
+			WORKER_LOG(LogLevel::Info) << "* Converting " << job.EU4SaveFileName << " *";
+			try
+			{
+				runJob(job);
+				result.converted = true;
+			}
+			catch (const std::exception& e)
+			{
+				WORKER_LOG(LogLevel::Error) << "Could not convert " << job.EU4SaveFileName << ": " << e.what();
+			}
+
+			if (log)
+			{
+				result.messages = log->takeMessages();
+			}
+			return result;
+		}));
+	}
+
+	int failures = 0;
+	for (auto& futureResult: results)
+	{
+		const auto result = futureResult.get();
+		parsing::replayLog(result.messages);
+		if (!result.converted)
+		{
+			failures++;
+		}
+	}
+
+	WORKER_LOG(LogLevel::Info) << "* Batch complete: " << jobs.size() - failures << " of " << jobs.size() << " saves converted *";
+	return failures;
+}
+
+
+std::vector<ConversionJob> readBatchFile(const std::string& batchFileName)
+{
+	std::ifstream batchFile(batchFileName);
+	if (!batchFile.is_open())
+	{
+		throw std::runtime_error("Could not open batch file " + batchFileName);
+	}
+
+	std::vector<ConversionJob> jobs;
+	std::string line;
+	while (std::getline(batchFile, line))
+	{
+		if (!line.empty() && (line.back() == '\r'))
+		{
+			line.pop_back();
+		}
+		if (line.empty())
+		{
+			continue;
+		}
+
+		jobs.push_back(parseJobLine(line));
+	}
+
+	return jobs;
+}
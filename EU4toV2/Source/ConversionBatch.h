@@ -0,0 +1,47 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef CONVERSION_BATCH_H_
+#define CONVERSION_BATCH_H_
+
+
+
+#include "ConversionJob.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+
+
+typedef std::function<void(const ConversionJob& job)> BatchJobRunner;
+
+// returns how many of the jobs failed; a job fails by throwing, is logged and the rest still run
+// With more than one parallel job, each job's log is written in one piece once it's done.
+int runConversionBatch(const std::vector<ConversionJob>& jobs, const BatchJobRunner& runJob, size_t parallelJobs = 1);
+
+// one job per line, as parseJobLine reads them; blank lines are skipped and Windows line ends are fine
+std::vector<ConversionJob> readBatchFile(const std::string& batchFileName);
+
+
+
+#endif // CONVERSION_BATCH_H_
@@ -0,0 +1,72 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ConversionContext.h"
+
+
+
+namespace
+{
+
+thread_local ConversionContext* boundContext = nullptr;
+
+}
+
+
+
+ConversionContext& ConversionContext::current()
+{
+	if (boundContext != nullptr)
+	{
+		return *boundContext;
+	}
+
+	static ConversionContext defaultContext;
+	return defaultContext;
+}
+
+
+double ConversionContext::getRandomFraction()
+{
+	std::lock_guard<std::mutex> lock(randomMutex);
+	return randomEngine() / 4294967296.0; // mt19937 gives 32 bits, so this stays below 1
+}
+
+
+ConversionContext::Scope::Scope(ConversionContext& context):
+	outer(boundContext)
+{
+	boundContext = &context;
+}
+
+
+ConversionContext::Scope::~Scope()
+{
+	boundContext = outer;
+}
+
+
+Configuration& theConfiguration()
+{
+	return ConversionContext::current().getConfiguration();
+}
@@ -0,0 +1,103 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef CONVERSION_CONTEXT_H_
+#define CONVERSION_CONTEXT_H_
+
+
+
+#include "Configuration.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <typeindex>
+
+
+
+// What one conversion reads and changes besides its two worlds: its configuration, the lookups the mappers build
+// from its save and mods, and its random choices. Data that is the same for every save, like the Vic2 regions or
+// the adjacencies, stays shared by the whole process and is never changed once read.
+//
+// Conversion code finds its context through current(). That is the context a Scope has bound to the thread, or,
+// when none has, a default one, which is all a lone conversion or a test needs. A conversion that hands work to
+// other threads binds its context on them as well.
+class ConversionContext
+{
+	public:
+		ConversionContext() = default;
+
+		ConversionContext(const ConversionContext&) = delete;
+		ConversionContext& operator=(const ConversionContext&) = delete;
+
+		static ConversionContext& current();
+
+		Configuration& getConfiguration() { return configuration; }
+
+		// this conversion's T, made by create() the first time anything asks for it
+		template<typename T, typename Create>
+		T& getState(Create create);
+
+		// in [0, 1), from a sequence that starts out the same for every conversion
+		double getRandomFraction();
+
+		class Scope
+		{
+			public:
+				explicit Scope(ConversionContext& context);
+				~Scope();
+
+				Scope(const Scope&) = delete;
+				Scope& operator=(const Scope&) = delete;
+
+			private:
+				ConversionContext* outer = nullptr;
+		};
+
+	private:
+		Configuration configuration;
+
+		std::recursive_mutex stateMutex; // making one state may ask for another
+		std::map<std::type_index, std::shared_ptr<void>> states;
+
+		std::mutex randomMutex;
+		std::mt19937 randomEngine;
+};
+
+
+
+template<typename T, typename Create>
+T& ConversionContext::getState(Create create)
+{
+	std::lock_guard<std::recursive_mutex> lock(stateMutex);
+	auto& state = states[std::type_index(typeid(T))];
+	if (!state)
+	{
+		state = std::shared_ptr<T>(create());
+	}
+	return *static_cast<T*>(state.get());
+}
+
+
+
+#endif // CONVERSION_CONTEXT_H_
@@ -0,0 +1,313 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ConversionDaemon.h"
+#include "Parsing/WorkerLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "Ws2_32.lib")
+#endif
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+
+
+namespace
+{
+#ifdef _WIN32
+	typedef SOCKET socketHandle;
+
+	void closeSocket(std::intptr_t handle)
+	{
+		closesocket(static_cast<socketHandle>(handle));
+	}
+#else
+	typedef int socketHandle;
+
+	void closeSocket(std::intptr_t handle)
+	{
+		close(static_cast<socketHandle>(handle));
+	}
+#endif
+
+
+	// a client that went away mid-job only loses the rest of its replies; the job still runs to the end
+	void sendLine(std::intptr_t connection, const std::string& line)
+	{
+		const std::string text = line + "\n";
+		size_t sent = 0;
+		while (sent < text.size())
+		{
+#if defined(MSG_NOSIGNAL)
+			const auto result = send(static_cast<socketHandle>(connection), text.data() + sent, static_cast<int>(text.size() - sent), MSG_NOSIGNAL);
+#else
+			const auto result = send(static_cast<socketHandle>(connection), text.data() + sent, static_cast<int>(text.size() - sent), 0);
+#endif
+			if (result <= 0)
+			{
+				return;
+			}
+			sent += result;
+		}
+	}
+
+
+	class LineReader
+	{
+		public:
+			explicit LineReader(std::intptr_t _connection): connection(_connection) {}
+
+			// false once the client has closed its end
+			bool readLine(std::string& line)
+			{
+				while (true)
+				{
+					const auto newline = buffered.find('\n');
+					if (newline != std::string::npos)
+					{
+						line = buffered.substr(0, newline);
+						buffered.erase(0, newline + 1);
+						if (!line.empty() && (line.back() == '\r'))
+						{
+							line.pop_back();
+						}
+						return true;
+					}
+
+					char chunk[4096];
+					const auto received = recv(static_cast<socketHandle>(connection), chunk, sizeof(chunk), 0);
+					if (received <= 0)
+					{
+						return false;
+					}
+					buffered.append(chunk, received);
+				}
+			}
+
+		private:
+			std::intptr_t connection;
+			std::string buffered;
+	};
+
+
+	std::string formatSeconds(std::chrono::steady_clock::time_point start)
+	{
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::ostringstream text;
+		text.setf(std::ios::fixed);
+		text.precision(3);
+		text << elapsed.count();
+		return text.str();
+	}
+}
+
+
+
+ConversionDaemon::ConversionDaemon(const std::string& _socketPath, JobRunner _runJob, size_t _parallelJobs):
+	socketPath(_socketPath),
+	runJob(std::move(_runJob)),
+	parallelJobs(std::max<size_t>(_parallelJobs, 1))
+{
+	sockaddr_un address;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		throw std::runtime_error("Socket path " + socketPath + " is too long.");
+	}
+
+#ifdef _WIN32
+	WSADATA winsockData;
+	if (WSAStartup(MAKEWORD(2, 2), &winsockData) != 0)
+	{
+		throw std::runtime_error("Could not start Winsock.");
+	}
+#endif
+
+	const auto handle = socket(AF_UNIX, SOCK_STREAM, 0);
+#ifdef _WIN32
+	if (handle == INVALID_SOCKET)
+#else
+	if (handle < 0)
+#endif
+	{
+		throw std::runtime_error("Could not create a socket for " + socketPath + ".");
+	}
+	listener = static_cast<std::intptr_t>(handle);
+
+	// a daemon that was killed leaves its socket file behind
+	std::remove(socketPath.c_str());
+
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+	if (
+		(bind(handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) ||
+		(listen(handle, 8) != 0)
+	)
+	{
+		closeSocket(listener);
+		throw std::runtime_error("Could not listen on " + socketPath + ".");
+	}
+
+	WORKER_LOG(LogLevel::Info) << "Listening for conversions on " << socketPath;
+}
+
+
+ConversionDaemon::~ConversionDaemon()
+{
+	closeSocket(listener);
+	std::remove(socketPath.c_str());
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+
+void ConversionDaemon::run()
+{
+	parsing::WorkerPool pool(parallelJobs);
+	while (true)
+	{
+		const auto connection = accept(static_cast<socketHandle>(listener), nullptr, nullptr);
+#ifdef _WIN32
+		if (connection == INVALID_SOCKET)
+#else
+		if (connection < 0)
+#endif
+		{
+			throw std::runtime_error("Could not accept connections on " + socketPath + ".");
+		}
+
+		if (!serveConnection(static_cast<std::intptr_t>(connection), pool))
+		{
+			WORKER_LOG(LogLevel::Info) << "Shutting down";
+			return;
+		}
+	}
+}
+
+
+bool ConversionDaemon::serveConnection(std::intptr_t connection, parsing::WorkerPool& pool)
+{
+	LineReader reader(connection);
+	std::string request;
+	if (!reader.readLine(request))
+	{
+		closeSocket(connection);
+		return true;
+	}
+
+	if (request == "shutdown")
+	{
+		for (auto& job: runningJobs)
+		{
+			job.get();
+		}
+		runningJobs.clear();
+		sendLine(connection, "bye");
+		closeSocket(connection);
+		return false;
+	}
+
+	const std::string convertCommand = "convert\t";
+	if (request.compare(0, convertCommand.size(), convertCommand) != 0)
+	{
+		sendLine(connection, "failed\t0.000\tUnknown request: " + request);
+		closeSocket(connection);
+		return true;
+	}
+
+	auto job = parseJobLine(request.substr(convertCommand.size()));
+	std::string line;
+	while (reader.readLine(line) && !line.empty())
+	{
+		job.configurationOverrides += line + "\n";
+	}
+
+	runningJobs.erase(
+		std::remove_if(runningJobs.begin(), runningJobs.end(), [](const std::future<void>& runningJob) {
+			return runningJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}),
+		runningJobs.end()
+	);
+	runningJobs.push_back(pool.submit([this, connection, job]() {
+		serveJob(connection, job);
+		closeSocket(connection);
+	}));
+	return true;
+}
+
+
+void ConversionDaemon::serveJob(std::intptr_t connection, const ConversionJob& job) const
+{
+	const auto start = std::chrono::steady_clock::now();
+	sendLine(connection, "accepted");
+
+	std::optional<parsing::LogCapture> log;
+	if (parallelJobs > 1)
+	{
+		log.emplace();
+	}
+	WORKER_LOG(LogLevel::Info) << "* Converting " << job.EU4SaveFileName << " *";
+
+	std::string failure;
+	try
+	{
+		runJob(job, [connection, start](const std::string& stage) {
+			sendLine(connection, "progress\t" + formatSeconds(start) + "\t" + stage);
+		});
+	}
+	catch (const std::exception& e)
+	{
+		failure = e.what();
+	}
+
+	const auto seconds = formatSeconds(start);
+	if (failure.empty())
+	{
+		WORKER_LOG(LogLevel::Info) << "* " << job.EU4SaveFileName << " converted in " << seconds << " seconds *";
+	}
+	else
+	{
+		WORKER_LOG(LogLevel::Error) << "Could not convert " << job.EU4SaveFileName << ": " << failure;
+	}
+	if (log)
+	{
+		const auto messages = log->takeMessages();
+		log.reset();
+		parsing::replayLog(messages);
+	}
+
+	sendLine(connection, failure.empty() ? "done\t" + seconds : "failed\t" + seconds + "\t" + failure);
+}
@@ -0,0 +1,79 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef CONVERSION_DAEMON_H_
+#define CONVERSION_DAEMON_H_
+
+
+
+#include "ConversionJob.h"
+#include "Parsing/WorkerPool.h"
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+
+
+// Serves conversions over a Unix domain socket, running up to parallelJobs of them at once. Requests are read one
+// connection at a time; with more than one parallel job, each job's log is written in one piece once it's done.
+//
+// A client sends one request and reads the replies until the daemon closes the connection:
+//		convert<TAB>save path[<TAB>output name]
+//		any number of configuration.txt lines to use for this job only
+//		an empty line
+// The daemon answers with "accepted", a "progress<TAB>seconds<TAB>stage" line as each stage starts, and finally
+// "done<TAB>seconds" or "failed<TAB>seconds<TAB>reason", seconds counting from when the job was accepted.
+// A "shutdown" request waits for the jobs still running, is answered with "bye" and stops the daemon.
+//
+// The installs are the ones the daemon was started with; overriding their directories is not supported.
+class ConversionDaemon
+{
+	public:
+		typedef std::function<void(const std::string& stage)> ProgressReporter;
+		typedef std::function<void(const ConversionJob& job, const ProgressReporter& reportProgress)> JobRunner;
+
+		ConversionDaemon(const std::string& _socketPath, JobRunner _runJob, size_t _parallelJobs = 1);
+		~ConversionDaemon();
+
+		ConversionDaemon(const ConversionDaemon&) = delete;
+		ConversionDaemon& operator=(const ConversionDaemon&) = delete;
+
+		// returns once a client asks for a shutdown
+		void run();
+
+	private:
+		bool serveConnection(std::intptr_t connection, parsing::WorkerPool& pool); // false once asked to shut down
+		void serveJob(std::intptr_t connection, const ConversionJob& job) const;
+
+		std::string socketPath;
+		JobRunner runJob;
+		size_t parallelJobs;
+		std::intptr_t listener = -1;
+		std::vector<std::future<void>> runningJobs;
+};
+
+
+
+#endif // CONVERSION_DAEMON_H_
@@ -20,8 +20,70 @@ THE SOFTWARE. */
 
 
 
+#ifndef EU4_TO_VIC2_CONVERTER_H_
+#define EU4_TO_VIC2_CONVERTER_H_
+
+
+
+#include "ConversionBatch.h"
+#include "EU4World/World.h"
+#include "Mappers/Ideas/IdeaEffectMapper.h"
+#include "Mappers/Ideas/TechGroupsMapper.h"
+#include "V2World/Vic2StaticData.h"
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
+
+
+
+// What a conversion reads that doesn't depend on its save
+struct ConversionBaseData
+{
+	std::optional<mappers::IdeaEffectMapper> ideaEffectMapper;
+	std::optional<mappers::TechGroupsMapper> techGroupsMapper;
+	std::optional<EU4::InstallData> EU4InstallData;
+	std::optional<Vic2::StaticData> Vic2StaticData;
+
+	// the installs it was read from
+	std::string EU4Path;
+	std::string Vic2Path;
+};
+
+
+// Holds the base data every conversion in a run reads the same way, loaded once up front. Each conversion gets a
+// ConversionContext of its own for everything else, so several may run at once. A job whose configuration points
+// at other installs than the session's fails.
+//
+// A conversion runs as a graph of stages, so the Vic2 provinces and pops are imported while the save is still
+// being parsed. Its log gives the stages' critical path.
+class ConverterSession
+{
+	public:
+		typedef std::function<void(const std::string& stage)> ProgressReporter;
+
+		ConverterSession();
+		void convert(const ConversionJob& job, const ProgressReporter& reportProgress = {}) const;
+
+		// a lone conversion reads the base data in stages of its own, alongside the save, instead of up front
+		static void convertOnce(const ConversionJob& job);
+
+	private:
+		ConverterSession(const ConverterSession&) = delete;
+		ConverterSession& operator=(const ConverterSession&) = delete;
+
+		ConversionBaseData baseData;
+};
+
+
+void ConvertEU4ToVic2(const std::string& EU4SaveFileName);
+
+// runs the jobs with runConversionBatch, all in one session
+int ConvertEU4ToVic2Batch(const std::vector<ConversionJob>& jobs, size_t parallelJobs = 1);
+
+// keeps a session loaded and serves conversions over a local socket until told to shut down
+void RunEU4ToVic2Daemon(const std::string& socketPath, size_t parallelJobs = 1);
 
 
 
-void ConvertEU4ToVic2(const std::string& EU4SaveFileName); 
+#endif // EU4_TO_VIC2_CONVERTER_H_
@@ -1,51 +1,92 @@
 #include "EU4Army.h"
+#include "../../ConversionContext.h"
+#include "../../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 #include "Log.h"
 
 
 EU4::EU4Army::EU4Army(std::istream& theStream)
 {
-	registerKeyword(std::regex("id"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4::EU4UnitID idblock(theStream);
-			armyId = idblock;
-		});
-	registerKeyword(std::regex("leader"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4::EU4UnitID idblock(theStream);
-			leaderId = idblock;
-		});
-	registerKeyword(std::regex("name"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString nameStr(theStream);
-			name = nameStr.getString();
-		});
-	registerKeyword(std::regex("regiment|ship"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4Regiment regimentBlock(theStream);
-			regimentList.push_back(regimentBlock);
-		});
-	registerKeyword(std::regex("location"), [this](const std::string& unused, std::istream& theStream)
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+}
+
+EU4::EU4Army::EU4Army(parsing::Tokenizer& tokenizer)
+{
+	getKeywords().parse(*this, tokenizer);
+}
+
+EU4::EU4Army::EU4Army(parsing::SnapshotReader& snapshot):
+	armyId(snapshot),
+	leaderId(snapshot)
+{
+	snapshot.read(name);
+	snapshot.read(location);
+	snapshot.read(atSea);
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		regimentList.emplace_back(snapshot);
+	}
+	snapshot.read(blocked_homes);
+}
+
+void EU4::EU4Army::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	armyId.writeSnapshot(snapshot);
+	leaderId.writeSnapshot(snapshot);
+	snapshot.write(name);
+	snapshot.write(location);
+	snapshot.write(atSea);
+	snapshot.writeCount(regimentList.size());
+	for (const auto& regiment: regimentList)
+	{
+		regiment.writeSnapshot(snapshot);
+	}
+	snapshot.write(blocked_homes);
+}
+
+const parsing::KeywordTable<EU4::EU4Army>& EU4::EU4Army::getKeywords()
+{
+	static const auto addRegiment = [](EU4Army& army, std::string_view unused, parsing::Tokenizer& tokenizer)
 		{
-			commonItems::singleInt locationInt(theStream);
-			location = locationInt.getInt();
-		});
-	// Dropped from saves at 1.20
-	registerKeyword(std::regex("at_sea"), [this](const std::string& unused, std::istream& theStream)
+			army.regimentList.emplace_back(tokenizer);
+		};
+	static const parsing::KeywordTable<EU4Army> keywords(
 		{
-			commonItems::singleInt atSeaInt(theStream);
-			atSea = atSeaInt.getInt();
-		});
-	registerKeyword(std::regex("[a-z0-9\\_]+"), commonItems::ignoreItem);
-
-	parseStream(theStream);
+			{ "id", [](EU4Army& army, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					army.armyId = EU4UnitID(tokenizer);
+				}},
+			{ "leader", [](EU4Army& army, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					army.leaderId = EU4UnitID(tokenizer);
+				}},
+			{ "name", [](EU4Army& army, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					army.name = parsing::getString(tokenizer);
+				}},
+			{ "regiment", addRegiment },
+			{ "ship", addRegiment },
+			{ "location", [](EU4Army& army, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					army.location = parsing::getInt(tokenizer);
+				}},
+			// Dropped from saves at 1.20
+			{ "at_sea", [](EU4Army& army, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					army.atSea = parsing::getInt(tokenizer);
+				}}
+		}
+	);
+	return keywords;
 }
 
 double EU4::EU4Army::getAverageStrength(REGIMENTCATEGORY category) const
 {
 	int regimentCount = regimentList.size();
 	double totalStrength = 0.0;
-	for (std::vector<EU4::EU4Regiment>::const_iterator itr = regimentList.begin(); itr != regimentList.end(); ++itr)
+	for (auto itr = regimentList.begin(); itr != regimentList.end(); ++itr)
 	{
 		if (itr->getCategory() == category)
 		{
@@ -59,7 +100,7 @@ double EU4::EU4Army::getAverageStrength(REGIMENTCATEGORY category) const
 int EU4::EU4Army::getTotalTypeStrength(REGIMENTCATEGORY category) const
 {
 	int totalStrength = 0;
-	for (std::vector<EU4Regiment>::const_iterator itr = regimentList.begin(); itr != regimentList.end(); ++itr)
+	for (auto itr = regimentList.begin(); itr != regimentList.end(); ++itr)
 	{
 		if (itr->getCategory() == category)
 		{
@@ -72,7 +113,7 @@ int EU4::EU4Army::getTotalTypeStrength(REGIMENTCATEGORY category) const
 
 void EU4::EU4Army::resolveRegimentTypes(mappers::RegimentTypeMap RTmap)
 {
-	for (std::vector<EU4Regiment>::iterator itr = regimentList.begin(); itr != regimentList.end(); ++itr)
+	for (auto itr = regimentList.begin(); itr != regimentList.end(); ++itr)
 	{
 		try
 		{
@@ -90,7 +131,7 @@ void EU4::EU4Army::resolveRegimentTypes(mappers::RegimentTypeMap RTmap)
 std::optional<int> EU4::EU4Army::getProbabilisticHomeProvince(EU4::REGIMENTCATEGORY category) const
 {
 	std::vector<int> homeProvinces;	// the possible home provinces
-	for (std::vector<EU4Regiment>::const_iterator itr = regimentList.begin(); itr != regimentList.end(); ++itr)
+	for (auto itr = regimentList.begin(); itr != regimentList.end(); ++itr)
 	{
 		if (itr->getCategory() == category)
 		{
@@ -115,7 +156,7 @@ std::optional<int> EU4::EU4Army::getProbabilisticHomeProvince(EU4::REGIMENTCATEG
 		return std::nullopt;
 	}
 
-	return homeProvinces[int(homeProvinces.size() * ((double)rand() / RAND_MAX))];
+	return homeProvinces[int(homeProvinces.size() * ConversionContext::current().getRandomFraction())];
 }
 
 void EU4::EU4Army::blockHomeProvince(const int home)
@@ -1,24 +1,30 @@
 #ifndef EU4_ARMY_H_
 #define EU4_ARMY_H_
 
+#include <memory_resource>
+#include <optional>
 #include <vector>
 #include "EU4Regiment.h"
 #include "../../Mappers/UnitTypeMapper.h"
+#include "../../Parsing/Arena.h"
 #include "Log.h"
 
 namespace EU4
 {
-	class EU4Army : public  commonItems::parser
+	class EU4Army
 	{
 	public:
 		EU4Army() = default;
 		EU4Army(std::istream& theStream); // Also applies to ships
+		EU4Army(parsing::Tokenizer& tokenizer);
+		explicit EU4Army(parsing::SnapshotReader& snapshot);
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 		std::string getName() const { return name; }
 		int getLocation() const { return location; }
 		int getAtSea() const { return atSea; }
 		EU4UnitID getId() const { return armyId; }
 		EU4UnitID getLeaderId() const { return leaderId; }
-		std::vector<EU4Regiment> getRegiments() const { return regimentList; }
+		std::vector<EU4Regiment> getRegiments() const { return std::vector<EU4Regiment>(regimentList.begin(), regimentList.end()); }
 		
 		double getAverageStrength(REGIMENTCATEGORY category) const;
 		void resolveRegimentTypes(mappers::RegimentTypeMap RTmap);
@@ -27,12 +33,14 @@ namespace EU4
 		void blockHomeProvince(const int homeId);
 
 	private:
+		static const parsing::KeywordTable<EU4Army>& getKeywords();
+
 		std::string name;
 		int location = -1;
 		int atSea = 0; // obsolete since 1.20
 		EU4UnitID armyId;
 		EU4UnitID leaderId;
-		std::vector<EU4Regiment> regimentList;
+		std::pmr::vector<EU4Regiment> regimentList{ parsing::getCurrentResource() };
 		std::vector<int> blocked_homes; // invalid homes for this army
 	};
 }
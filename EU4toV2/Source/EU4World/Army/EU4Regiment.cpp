@@ -1,35 +1,69 @@
 #include "EU4Regiment.h"
+#include "../../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 
 
+EU4::EU4Regiment::EU4Regiment(parsing::SnapshotReader& snapshot):
+	regimentId(snapshot)
+{
+	snapshot.read(name);
+	snapshot.read(regimentType);
+	snapshot.read(home);
+	snapshot.read(typeStrength);
+	category = static_cast<REGIMENTCATEGORY>(snapshot.read<int>());
+	snapshot.read(morale);
+	snapshot.read(strength);
+}
+
+void EU4::EU4Regiment::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	regimentId.writeSnapshot(snapshot);
+	snapshot.write(name);
+	snapshot.write(regimentType);
+	snapshot.write(home);
+	snapshot.write(typeStrength);
+	snapshot.write(static_cast<int>(category));
+	snapshot.write(morale);
+	snapshot.write(strength);
+}
+
 EU4::EU4Regiment::EU4Regiment(std::istream& theStream)
 {
-	registerKeyword(std::regex("id"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4::EU4UnitID idblock(theStream);
-			regimentId = idblock;
-		});
-	registerKeyword(std::regex("name"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString nameStr(theStream);
-			name = nameStr.getString();
-		});
-	registerKeyword(std::regex("type"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString typeStr(theStream);
-			regimentType = typeStr.getString();
-		});
-	registerKeyword(std::regex("home"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt homeInt(theStream);
-			home = homeInt.getInt();
-		});
-	registerKeyword(std::regex("morale"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleDouble moraleDuble(theStream);
-			morale = moraleDuble.getDouble();
-		});
-	registerKeyword(std::regex("[a-z0-9\\_]+"), commonItems::ignoreItem);
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+}
+
+EU4::EU4Regiment::EU4Regiment(parsing::Tokenizer& tokenizer)
+{
+	getKeywords().parse(*this, tokenizer);
+}
 
-	parseStream(theStream);
+const parsing::KeywordTable<EU4::EU4Regiment>& EU4::EU4Regiment::getKeywords()
+{
+	static const parsing::KeywordTable<EU4Regiment> keywords(
+		{
+			{ "id", [](EU4Regiment& regiment, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					regiment.regimentId = EU4UnitID(tokenizer);
+				}},
+			{ "name", [](EU4Regiment& regiment, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					regiment.name = parsing::getString(tokenizer);
+				}},
+			{ "type", [](EU4Regiment& regiment, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					regiment.regimentType = parsing::getString(tokenizer);
+				}},
+			{ "home", [](EU4Regiment& regiment, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					regiment.home = parsing::getInt(tokenizer);
+				}},
+			{ "morale", [](EU4Regiment& regiment, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					regiment.morale = parsing::getDouble(tokenizer);
+				}}
+		}
+	);
+	return keywords;
 }
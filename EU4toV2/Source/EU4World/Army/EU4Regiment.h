@@ -43,11 +43,14 @@ namespace EU4
 		{ REGIMENTCATEGORY::transport, "transport" }
 	};
 
-	class EU4Regiment : public  commonItems::parser
+	class EU4Regiment
 	{
 	public:
 		EU4Regiment() = default;
 		EU4Regiment(std::istream& theStream); // Also applies to ships
+		EU4Regiment(parsing::Tokenizer& tokenizer);
+		explicit EU4Regiment(parsing::SnapshotReader& snapshot);
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 		std::string getType() const { return regimentType; }
 		std::string getName() const { return name; }
 		int getHome() const { return home; }
@@ -60,6 +63,8 @@ namespace EU4
 		void setTypeStrength(const int tStrength) { typeStrength = tStrength; }
 
 	private:
+		static const parsing::KeywordTable<EU4Regiment>& getKeywords();
+
 		std::string name;
 		std::string regimentType;
 		int home = 0;
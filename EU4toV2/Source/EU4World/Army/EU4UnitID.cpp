@@ -1,21 +1,45 @@
 #include "EU4UnitID.h"
+#include "../../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 
 
+EU4::EU4UnitID::EU4UnitID(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(unitId);
+	snapshot.read(unitType);
+}
+
+void EU4::EU4UnitID::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(unitId);
+	snapshot.write(unitType);
+}
+
 EU4::EU4UnitID::EU4UnitID(std::istream& theStream)
 {
-	registerKeyword(std::regex("id"), [this](const std::string& unused, std::istream& theStream)
-	{
-		commonItems::singleInt idInt(theStream);
-		unitId = idInt.getInt();
-	});
-	registerKeyword(std::regex("type"), [this](const std::string& unused, std::istream& theStream)
-	{
-		commonItems::singleInt typeInt(theStream);
-		unitType = typeInt.getInt();
-	});
-	registerKeyword(std::regex("[a-z0-9\\_]+"), commonItems::ignoreItem);
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+}
 
-	parseStream(theStream);
+EU4::EU4UnitID::EU4UnitID(parsing::Tokenizer& tokenizer)
+{
+	getKeywords().parse(*this, tokenizer);
 }
 
+const parsing::KeywordTable<EU4::EU4UnitID>& EU4::EU4UnitID::getKeywords()
+{
+	static const parsing::KeywordTable<EU4UnitID> keywords(
+		{
+			{ "id", [](EU4UnitID& unitID, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					unitID.unitId = parsing::getInt(tokenizer);
+				}},
+			{ "type", [](EU4UnitID& unitID, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					unitID.unitType = parsing::getInt(tokenizer);
+				}}
+		}
+	);
+	return keywords;
+}
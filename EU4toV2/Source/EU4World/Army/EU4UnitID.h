@@ -1,19 +1,27 @@
 #ifndef EU4_UNIT_ID_H_
 #define EU4_UNIT_ID_H_
 
-#include "newParser.h"
+#include "../../Parsing/KeywordTable.h"
+#include "../../Parsing/Snapshot.h"
+#include <istream>
 
 namespace EU4
 {
-	class EU4UnitID : public  commonItems::parser
+	class EU4UnitID
 	{
 	public:
 		EU4UnitID() = default;
 		EU4UnitID(std::istream& theStream);
+		EU4UnitID(parsing::Tokenizer& tokenizer);
+		explicit EU4UnitID(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 		int getType() const { return unitType; }
 		int getId() const { return unitId; }
 
 	private:
+		static const parsing::KeywordTable<EU4UnitID>& getKeywords();
+
 		int unitId = 0;
 		int unitType = 0;
 	};
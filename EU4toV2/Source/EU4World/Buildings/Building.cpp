@@ -43,4 +43,20 @@ EU4::Building::Building(std::istream& theStream)
 	registerKeyword(std::regex("[a-zA-Z0-9_]+"), commonItems::ignoreItem);
 
 	parseStream(theStream);
-}
\ No newline at end of file
+}
+
+
+EU4::Building::Building(parsing::SnapshotReader& snapshot):
+	modifier(snapshot)
+{
+	snapshot.read(cost);
+	snapshot.read(manufactory);
+}
+
+
+void EU4::Building::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	modifier.writeSnapshot(snapshot);
+	snapshot.write(cost);
+	snapshot.write(manufactory);
+}
@@ -28,6 +28,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "../Modifiers/Modifier.h"
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 
 
 
@@ -38,6 +39,9 @@ class Building: commonItems::parser
 {
 	public:
 		Building(std::istream& theStream);
+		explicit Building(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		double getCost() const { return cost; }
 		const Modifier& getModifier() const { return modifier; }
@@ -36,6 +36,27 @@ EU4::Buildings::Buildings(std::istream& theStream)
 }
 
 
+EU4::Buildings::Buildings(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto buildingName = snapshot.read<std::string>();
+		buildings.insert(std::make_pair(buildingName, Building(snapshot)));
+	}
+}
+
+
+void EU4::Buildings::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(buildings.size());
+	for (const auto& building: buildings)
+	{
+		snapshot.write(building.first);
+		building.second.writeSnapshot(snapshot);
+	}
+}
+
+
 std::optional<EU4::Building> EU4::Buildings::getBuilding(const std::string& buildingName) const
 {
 	if (buildings.count(buildingName) > 0)
@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 #include "Building.h"
 #include <map>
 #include <optional>
@@ -40,6 +41,9 @@ class Buildings: commonItems::parser
 {
 	public:
 		Buildings(std::istream& theStream);
+		explicit Buildings(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		std::optional<Building> getBuilding(const std::string& buildingName) const;
 
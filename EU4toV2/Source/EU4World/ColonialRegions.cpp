@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "ColonialRegions.h"
 #include "../Configuration.h"
 #include "Color.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include "ParserHelpers.h"
 #include <algorithm>
@@ -78,13 +78,10 @@ namespace EU4
 	}
 
 
-	colonialRegions* colonialRegions::instance = nullptr;
-
-
 
 	colonialRegions::colonialRegions()
 	{
-		LOG(LogLevel::Info) << "Parsing EU4 colonial regions";
+		WORKER_LOG(LogLevel::Info) << "Parsing EU4 colonial regions";
 
 		registerKeyword(std::regex("colonial_\\w+"), [this](const std::string& regionName, std::istream& theStream)
 			{
@@ -98,9 +95,9 @@ namespace EU4
 			}
 		);
 		
-		parseFile(theConfiguration.getEU4Path() + "/common/colonial_regions/00_colonial_regions.txt");
+		parseFile(theConfiguration().getEU4Path() + "/common/colonial_regions/00_colonial_regions.txt");
 
-		for (auto mod: theConfiguration.getEU4Mods())
+		for (auto mod: theConfiguration().getEU4Mods())
 		{
 			set<string> filenames;
 			Utils::GetAllFilesInFolder(mod + "/common/colonial_regions/", filenames);
@@ -26,6 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include "../ConversionContext.h"
 #include "newParser.h"
 #include <map>
 #include <set>
@@ -44,15 +45,9 @@ namespace EU4
 			}
 
 		private:
-			static colonialRegions* instance;
 			static colonialRegions* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new colonialRegions();
-				}
-
-				return instance;
+				return &ConversionContext::current().getState<colonialRegions>([]() { return new colonialRegions; });
 			}
 
 			colonialRegions();
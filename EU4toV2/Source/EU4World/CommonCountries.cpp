@@ -0,0 +1,148 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "CommonCountries.h"
+#include "Country/EU4CustomColors.h"
+#include "../Parsing/BufferParser.h"
+#include "../Parsing/KeywordTable.h"
+#include "../Parsing/MappedFile.h"
+#include "OSCompatibilityLayer.h"
+#include <fstream>
+
+
+
+EU4::CommonCountries::CommonCountries(const std::vector<std::pair<std::string, std::string>>& tagFiles)
+{
+	for (const auto& tagFile: tagFiles)
+	{
+		readTagFile(tagFile.first, tagFile.second);
+	}
+}
+
+
+void EU4::CommonCountries::readTagFile(const std::string& tagFile, const std::string& rootPath)
+{
+	std::ifstream in(tagFile);
+	const int maxLineLength = 10000;	// the maximum line length
+	char line[maxLineLength];			// the line being processed
+
+	while (true)
+	{
+		in.getline(line, maxLineLength);
+		if (in.eof())
+		{
+			return;
+		}
+		std::string countryLine = line;
+		if (countryLine.size() < 6 || countryLine[0] == '#')
+		{
+			continue;
+		}
+
+		// First three characters must be the tag.
+		CommonCountry country;
+		country.tag = countryLine.substr(0, 3);
+
+		// The country file name is all the text after the equals sign (possibly in quotes).
+		size_t commentPos	= countryLine.find('#', 3);
+		if (commentPos != std::string::npos)
+		{
+			countryLine = countryLine.substr(0, commentPos);
+		}
+		size_t equalPos	= countryLine.find('=', 3);
+		size_t beginPos	= countryLine.find_first_not_of(' ', equalPos + 1);
+		size_t endPos		= countryLine.find_last_of('\"') + 1;
+		std::string fileName = countryLine.substr(beginPos, endPos - beginPos);
+		if (fileName.front() == '"' && fileName.back() == '"')
+		{
+			fileName = fileName.substr(1, fileName.size() - 2);
+		}
+
+		std::string fullFilename = rootPath + "/common/" + fileName;
+		countryFiles.push_back(fullFilename);
+		if (!Utils::DoesFileExist(fullFilename))
+		{
+			continue;
+		}
+		size_t lastPathSeparatorPos = fullFilename.find_last_of('/');
+		country.fileName = fullFilename.substr(lastPathSeparatorPos + 1, std::string::npos);
+		country.mapColor = readMapColor(fullFilename);
+		countries.push_back(std::move(country));
+	}
+}
+
+
+std::optional<commonItems::Color> EU4::CommonCountries::readMapColor(const std::string& countryFile)
+{
+	static const parsing::KeywordTable<std::optional<commonItems::Color>> commonCountryKeywords(
+		{
+			{ "color", [](std::optional<commonItems::Color>& mapColor, std::string_view unused, parsing::Tokenizer& tokenizer)
+				{
+					parsing::readFromStream(tokenizer, [&mapColor](std::istream& theStream) {
+						mapColor = commonItems::Color(theStream);
+					});
+				}
+			}
+		}
+	);
+
+	std::optional<commonItems::Color> mapColor;
+	const parsing::MappedFile theFile(countryFile);
+	parsing::Tokenizer tokenizer(theFile.getContents());
+	commonCountryKeywords.parse(mapColor, tokenizer);
+	return mapColor;
+}
+
+
+EU4::CommonCountries::CommonCountries(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		CommonCountry country;
+		snapshot.read(country.tag);
+		snapshot.read(country.fileName);
+		if (snapshot.read<bool>())
+		{
+			country.mapColor = readColorSnapshot(snapshot);
+		}
+		countries.push_back(std::move(country));
+	}
+	snapshot.read(countryFiles);
+}
+
+
+void EU4::CommonCountries::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(countries.size());
+	for (const auto& country: countries)
+	{
+		snapshot.write(country.tag);
+		snapshot.write(country.fileName);
+		snapshot.write(country.mapColor.has_value());
+		if (country.mapColor)
+		{
+			writeColorSnapshot(snapshot, *country.mapColor);
+		}
+	}
+	snapshot.write(countryFiles);
+}
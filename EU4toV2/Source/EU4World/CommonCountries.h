@@ -0,0 +1,79 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef EU4_COMMON_COUNTRIES_H_
+#define EU4_COMMON_COUNTRIES_H_
+
+
+
+#include "Color.h"
+#include "../Parsing/Snapshot.h"
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+namespace EU4
+{
+
+// a tag from common/country_tags, with what its country file gives
+struct CommonCountry
+{
+	std::string tag;
+	std::string fileName; // without its folders
+	std::optional<commonItems::Color> mapColor;
+};
+
+
+// Every country_tags file, each given with the folder its country files are found under, read in
+// the order given along with the country files they name. Tags named again by later files are kept
+// too, so countries can take them in the same order they always have. Lines naming files that
+// don't exist are left out.
+class CommonCountries
+{
+	public:
+		explicit CommonCountries(const std::vector<std::pair<std::string, std::string>>& tagFiles);
+		explicit CommonCountries(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
+		const std::vector<CommonCountry>& getCountries() const { return countries; }
+
+		// the country files named, found or not, for the cache to watch
+		const std::vector<std::string>& getCountryFiles() const { return countryFiles; }
+
+	private:
+		void readTagFile(const std::string& tagFile, const std::string& rootPath);
+		static std::optional<commonItems::Color> readMapColor(const std::string& countryFile);
+
+		std::vector<CommonCountry> countries;
+		std::vector<std::string> countryFiles;
+};
+
+}
+
+
+
+#endif // EU4_COMMON_COUNTRIES_H_
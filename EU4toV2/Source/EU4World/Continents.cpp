@@ -23,7 +23,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Continents.h"
 #include "../Configuration.h"
-#include "Log.h"
+#include "../Parsing/FileCache.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include "ParserHelpers.h"
 #include <algorithm>
@@ -31,30 +32,38 @@ using namespace std;
 
 
 
-EU4::continents* EU4::continents::instance = nullptr;
-
-
-
 EU4::continents::continents()
 {
-	LOG(LogLevel::Info) << "Finding Continents";
-	for (auto mod: theConfiguration.getEU4Mods())
+	WORKER_LOG(LogLevel::Info) << "Finding Continents";
+	std::vector<std::string> continentFiles;
+	for (auto mod: theConfiguration().getEU4Mods())
 	{
-		string continentFile = mod + "/map/continent.txt";
-		if (Utils::DoesFileExist(continentFile))
-		{
-			initContinentMap(continentFile);
-		}
+		continentFiles.push_back(mod + "/map/continent.txt");
 	}
+	continentFiles.push_back(theConfiguration().getEU4Path() + "/map/continent.txt");
 
-	if (continentMap.empty())
+	const parsing::FileCache cache;
+	if (!cache.load("continents", continentFiles, [this](parsing::SnapshotReader& snapshot) { snapshot.read(continentMap); }))
 	{
-		initContinentMap(theConfiguration.getEU4Path() + "/map/continent.txt");
+		for (auto mod: theConfiguration().getEU4Mods())
+		{
+			string continentFile = mod + "/map/continent.txt";
+			if (Utils::DoesFileExist(continentFile))
+			{
+				initContinentMap(continentFile);
+			}
+		}
+
+		if (continentMap.empty())
+		{
+			initContinentMap(theConfiguration().getEU4Path() + "/map/continent.txt");
+		}
+		cache.store("continents", continentFiles, [this](parsing::SnapshotWriter& snapshot) { snapshot.write(continentMap); });
 	}
 
 	if (continentMap.empty())
 	{
-		LOG(LogLevel::Warning) << "No continent mappings found - may lead to problems later";
+		WORKER_LOG(LogLevel::Warning) << "No continent mappings found - may lead to problems later";
 	}
 }
 
@@ -26,6 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include "../ConversionContext.h"
 #include "newParser.h"
 #include <map>
 #include <string>
@@ -43,15 +44,9 @@ namespace EU4
 			}
 
 		private:
-			static continents* instance;
 			static continents* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new continents;
-				}
-
-				return instance;
+				return &ConversionContext::current().getState<continents>([]() { return new continents; });
 			}
 
 			continents();
@@ -23,8 +23,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Countries.h"
 #include "EU4Country.h"
+#include "../ConversionContext.h"
 #include "../Mappers/Ideas/IdeaEffectMapper.h"
+#include "../Parsing/ParsingHelpers.h"
+#include "../Parsing/WorkerLog.h"
 #include "ParserHelpers.h"
+#include <algorithm>
+#include <future>
 
 
 
@@ -34,26 +39,148 @@ EU4::countries::countries(
 	const mappers::IdeaEffectMapper& ideaEffectMapper
 ): theCountries()
 {
-	registerKeyword(std::regex("---"), commonItems::ignoreObject);
-	registerKeyword(std::regex("REB"), commonItems::ignoreObject);
-	registerKeyword(std::regex("PIR"), commonItems::ignoreObject);
-	registerKeyword(std::regex("NAT"), commonItems::ignoreObject);
-	registerKeyword(
-		std::regex("[A-Z]{3}"),
-		[this, theVersion, ideaEffectMapper](const std::string& tag, std::istream& theStream)
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	buildCountries(indexCountries(tokenizer), tokenizer.getSettings(), theVersion, ideaEffectMapper, parsing::WorkerPool::shared());
+}
+
+
+EU4::countries::countries(
+	const EU4::Version& theVersion,
+	parsing::Tokenizer& tokenizer,
+	const mappers::IdeaEffectMapper& ideaEffectMapper,
+	parsing::WorkerPool& pool
+): theCountries()
+{
+	buildCountries(indexCountries(tokenizer), tokenizer.getSettings(), theVersion, ideaEffectMapper, pool);
+}
+
+
+std::vector<parsing::Section> EU4::countries::indexCountries(parsing::Tokenizer& tokenizer)
+{
+	std::vector<parsing::Section> countrySections;
+	for (const auto& section: parsing::getBlockSections(tokenizer))
+	{
+		// rebels, pirates and natives are not real countries
+		if (
+			parsing::isTag(section.key) &&
+			(section.key != "REB") &&
+			(section.key != "PIR") &&
+			(section.key != "NAT")
+		) {
+			countrySections.push_back(section);
+		}
+	}
+	return countrySections;
+}
+
+
+bool EU4::countries::isDeadTag(std::string_view countryText, const parsing::TokenizerSettings& settings)
+{
+	// Only the block's own keys are looked at; their values are skipped over unread.
+	parsing::Tokenizer tokenizer(countryText, settings);
+	for (const auto& section: parsing::getBlockSections(tokenizer))
+	{
+		if ((section.key == "owned_provinces") || (section.key == "army") || (section.key == "navy"))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void EU4::countries::buildCountries(
+	const std::vector<parsing::Section>& countrySections,
+	const parsing::TokenizerSettings& settings,
+	const EU4::Version& theVersion,
+	const mappers::IdeaEffectMapper& ideaEffectMapper,
+	parsing::WorkerPool& pool
+) {
+	// Countries only read their own block, the version and the idea effects, so they can be built
+	// side by side. Living countries (with provinces or forces) are the expensive ones and each gets
+	// a task of its own; the many dead tags are small and are handed out in batches. Every country
+	// keeps its warnings until all are built, and both are gathered in file order, so the result
+	// does not depend on the number of threads.
+	// Dead tags are still read in full. One that is some province's core survives removeEmptyNations and
+	// is converted like any other country, reading every field, and the cores are in the provinces section,
+	// which is parsed alongside this one; so while countries are built, no dead tag is known to be unneeded.
+	// Each task builds its countries into an arena of its own, kept with the first of them.
+	struct ParsedCountry
+	{
+		std::unique_ptr<parsing::Arena> arena;
+		std::shared_ptr<EU4::Country> country;
+		std::vector<parsing::LogMessage> messages;
+	};
+	std::vector<ParsedCountry> parsedCountries(countrySections.size());
+
+	auto& context = ConversionContext::current();
+	const auto buildRange = [&countrySections, settings, &parsedCountries, &theVersion, &ideaEffectMapper, &context](const std::vector<size_t>& indexes)
+		{
+			ConversionContext::Scope contextScope(context);
+			auto arena = std::make_unique<parsing::Arena>();
+			parsing::ArenaScope arenaScope(*arena);
+			for (const auto index: indexes)
+			{
+				parsing::LogCapture log;
+				parsing::Tokenizer countryTokenizer(countrySections[index].text, settings);
+				parsedCountries[index].country = parsing::makeArenaShared<EU4::Country>(
+					std::string(countrySections[index].key),
+					theVersion,
+					countryTokenizer,
+					ideaEffectMapper
+				);
+				parsedCountries[index].messages = log.takeMessages();
+			}
+			if (!indexes.empty())
+			{
+				parsedCountries[indexes.front()].arena = std::move(arena);
+			}
+		};
+
+	std::vector<size_t> livingCountries;
+	std::vector<size_t> deadTags;
+	for (size_t i = 0; i < countrySections.size(); i++)
+	{
+		if (isDeadTag(countrySections[i].text, settings))
 		{
-			auto country = std::make_shared<EU4::Country>(tag, theVersion, theStream, ideaEffectMapper);
-			theCountries.insert(std::make_pair(country->getTag(), country));
+			deadTags.push_back(i);
 		}
-	);
-	registerKeyword(
-		std::regex("[A-Z][0-9]{2}"),
-		[this, theVersion, ideaEffectMapper](const std::string& tag, std::istream& theStream)
+		else
 		{
-			auto country = std::make_shared<EU4::Country>(tag, theVersion, theStream, ideaEffectMapper);
-			theCountries.insert(std::make_pair(country->getTag(), country));
+			livingCountries.push_back(i);
 		}
-	);
+	}
 
-	parseStream(theStream);
-}
\ No newline at end of file
+	std::vector<std::future<void>> tasks;
+	for (const auto index: livingCountries)
+	{
+		tasks.push_back(pool.submit([&buildRange, index]() { buildRange({ index }); }));
+	}
+	const auto batchCount = std::max<size_t>(pool.getThreadCount() * 4, 1);
+	const auto batchSize = std::max<size_t>((deadTags.size() + batchCount - 1) / batchCount, 1);
+	for (size_t first = 0; first < deadTags.size(); first += batchSize)
+	{
+		std::vector<size_t> batch(
+			deadTags.begin() + first,
+			deadTags.begin() + std::min(first + batchSize, deadTags.size())
+		);
+		tasks.push_back(pool.submit([&buildRange, batch = std::move(batch)]() { buildRange(batch); }));
+	}
+	// all of them, so that on an error none is still filling in parsedCountries
+	pool.waitAll(tasks);
+	for (auto& task: tasks)
+	{
+		task.get();
+	}
+
+	for (auto& parsedCountry: parsedCountries)
+	{
+		if (parsedCountry.arena)
+		{
+			arenas.push_back(std::move(parsedCountry.arena));
+		}
+		parsing::replayLog(parsedCountry.messages);
+		theCountries.insert(std::make_pair(parsedCountry.country->getTag(), parsedCountry.country));
+	}
+}
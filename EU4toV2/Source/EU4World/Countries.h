@@ -26,11 +26,16 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include "newParser.h"
 #include "EU4Version.h"
+#include "../Parsing/Arena.h"
+#include "../Parsing/SectionScanner.h"
+#include "../Parsing/WorkerPool.h"
+#include <istream>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 
 
@@ -45,7 +50,7 @@ namespace EU4
 class Country;
 
 
-class countries: public commonItems::parser
+class countries
 {
 	public:
 		countries(
@@ -53,10 +58,30 @@ class countries: public commonItems::parser
 			std::istream& theStream,
 			const mappers::IdeaEffectMapper& ideaEffectMapper
 		);
+		countries(
+			const EU4::Version& theVersion,
+			parsing::Tokenizer& tokenizer,
+			const mappers::IdeaEffectMapper& ideaEffectMapper,
+			parsing::WorkerPool& pool = parsing::WorkerPool::shared()
+		);
 
 		std::map<std::string, std::shared_ptr<EU4::Country>> getTheCountries() const { return theCountries; }
 
+		// the arenas the countries were built in, which must outlive every copy of them
+		std::vector<std::unique_ptr<parsing::Arena>> takeArenas() { return std::move(arenas); }
+
 	private:
+		static std::vector<parsing::Section> indexCountries(parsing::Tokenizer& tokenizer);
+		static bool isDeadTag(std::string_view countryText, const parsing::TokenizerSettings& settings);
+		void buildCountries(
+			const std::vector<parsing::Section>& countrySections,
+			const parsing::TokenizerSettings& settings,
+			const EU4::Version& theVersion,
+			const mappers::IdeaEffectMapper& ideaEffectMapper,
+			parsing::WorkerPool& pool
+		);
+
+		std::vector<std::unique_ptr<parsing::Arena>> arenas;
 		std::map<std::string, std::shared_ptr<EU4::Country>> theCountries;
 };
 
@@ -4,6 +4,50 @@
 #include <algorithm>
 
 
+void EU4::writeColorSnapshot(parsing::SnapshotWriter& snapshot, const commonItems::Color& color)
+{
+	snapshot.write(static_cast<bool>(color));
+	int red = 0;
+	int green = 0;
+	int blue = 0;
+	if (color)
+	{
+		color.GetRGB(red, green, blue);
+	}
+	snapshot.write(red);
+	snapshot.write(green);
+	snapshot.write(blue);
+}
+
+commonItems::Color EU4::readColorSnapshot(parsing::SnapshotReader& snapshot)
+{
+	const auto isSet = snapshot.read<bool>();
+	const auto red = snapshot.read<int>();
+	const auto green = snapshot.read<int>();
+	const auto blue = snapshot.read<int>();
+	if (!isSet)
+	{
+		return commonItems::Color();
+	}
+	return commonItems::Color(red, green, blue);
+}
+
+EU4::CustomColors::CustomColors(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(customColors.flag);
+	snapshot.read(customColors.color);
+	snapshot.read(customColors.symbolIndex);
+	customColors.flagColors = readColorSnapshot(snapshot);
+}
+
+void EU4::CustomColors::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(customColors.flag);
+	snapshot.write(customColors.color);
+	snapshot.write(customColors.symbolIndex);
+	writeColorSnapshot(snapshot, customColors.flagColors);
+}
+
 EU4::CustomColors::CustomColors(std::istream& theStream)
 {
 	registerKeyword(std::regex("flag"), [this](const std::string& unused, std::istream& theStream)
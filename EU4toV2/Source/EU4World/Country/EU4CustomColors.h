@@ -3,10 +3,15 @@
 
 
 #include "Color.h"
+#include "../../Parsing/Snapshot.h"
 
 
 namespace EU4
 {
+	// colors keep whether they were ever set
+	void writeColorSnapshot(parsing::SnapshotWriter& snapshot, const commonItems::Color& color);
+	commonItems::Color readColorSnapshot(parsing::SnapshotReader& snapshot);
+
 	struct CustomColorsBlock
 	{
 		int flag = 0;
@@ -20,6 +25,9 @@ namespace EU4
 	public:
 		CustomColors() = default;
 		CustomColors(std::istream& theStream);
+		explicit CustomColors(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 		CustomColorsBlock getCustomColors() const { return customColors; }
 
 		void setFlag(int fl) { customColors.flag = fl; }
@@ -33,3 +33,21 @@ EU4::NationalSymbol::NationalSymbol(std::istream& theStream)
 	registerKeyword(std::regex("[a-z0-9\\_]+"), commonItems::ignoreItem);
 	parseStream(theStream);
 }
+
+EU4::NationalSymbol::NationalSymbol(parsing::SnapshotReader& snapshot):
+	customColors(snapshot)
+{
+	mapColor = readColorSnapshot(snapshot);
+	countryColor = readColorSnapshot(snapshot);
+	revolutionaryColor = readColorSnapshot(snapshot);
+	snapshot.read(customColorsInitialized);
+}
+
+void EU4::NationalSymbol::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	customColors.writeSnapshot(snapshot);
+	writeColorSnapshot(snapshot, mapColor);
+	writeColorSnapshot(snapshot, countryColor);
+	writeColorSnapshot(snapshot, revolutionaryColor);
+	snapshot.write(customColorsInitialized);
+}
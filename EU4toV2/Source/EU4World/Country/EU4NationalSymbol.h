@@ -11,6 +11,9 @@ namespace EU4
 	public:
 		NationalSymbol() = default;
 		NationalSymbol(std::istream& theStream);
+		explicit NationalSymbol(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 		commonItems::Color getMapColor() const { return mapColor; }
 		commonItems::Color getCountryColor() const { return countryColor; }
 		commonItems::Color getRevolutionaryColor() const { return revolutionaryColor; }
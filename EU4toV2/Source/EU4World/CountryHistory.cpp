@@ -21,6 +21,7 @@ THE SOFTWARE. */
 
 
 #include "CountryHistory.h"
+#include "../Parsing/Arena.h"
 #include "ParserHelpers.h"
 
 
@@ -52,7 +53,7 @@ EU4::countryHistoryDate::countryHistoryDate(std::istream& theStream):
 
 	registerKeyword(std::regex("leader"), [this](const std::string& date, std::istream& theStream)
 		{
-		std::shared_ptr<historyLeader> newLeader = std::make_unique<historyLeader>(theStream);
+		std::shared_ptr<historyLeader> newLeader = parsing::makeArenaShared<historyLeader>(theStream);
 			items.emplace_back(newLeader);
 		}
 	);
@@ -65,5 +66,5 @@ EU4::countryHistoryDate::countryHistoryDate(std::istream& theStream):
 EU4::historyLeader::historyLeader(std::istream& theStream)
 {
 	type = "leader";
-	theLeader = std::make_unique<EU4::leader>(EU4::leader(theStream));
+	theLeader = parsing::makeArenaShared<EU4::leader>(theStream);
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "CultureGroups.h"
 #include "../Configuration.h"
+#include "../Parsing/FileCache.h"
 #include "Log.h"
 #include "OSCompatibilityLayer.h"
 #include "ParserHelpers.h"
@@ -75,6 +76,26 @@ EU4::culture::culture(std::istream& theStream):
 }
 
 
+EU4::culture::culture(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(primaryTag);
+	snapshot.read(graphicalCulture);
+	snapshot.read(maleNames);
+	snapshot.read(femaleNames);
+	snapshot.read(dynastyNames);
+}
+
+
+void EU4::culture::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(primaryTag);
+	snapshot.write(graphicalCulture);
+	snapshot.write(maleNames);
+	snapshot.write(femaleNames);
+	snapshot.write(dynastyNames);
+}
+
+
 EU4::cultureGroup::cultureGroup(const std::string& name_, std::istream& theStream):
 	name(name_),
 	graphicalCulture(),
@@ -119,25 +140,100 @@ EU4::cultureGroup::cultureGroup(const std::string& name_, std::istream& theStrea
 
 
 
-EU4::cultureGroups* EU4::cultureGroups::instance = nullptr;
+EU4::cultureGroup::cultureGroup(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(name);
+	snapshot.read(graphicalCulture);
+	snapshot.read(maleNames);
+	snapshot.read(femaleNames);
+	snapshot.read(dynastyNames);
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		auto cultureName = snapshot.read<std::string>();
+		cultures.insert(make_pair(cultureName, culture(snapshot)));
+	}
+}
+
 
+void EU4::cultureGroup::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(name);
+	snapshot.write(graphicalCulture);
+	snapshot.write(maleNames);
+	snapshot.write(femaleNames);
+	snapshot.write(dynastyNames);
+	snapshot.writeCount(cultures.size());
+	for (const auto& culture: cultures)
+	{
+		snapshot.write(culture.first);
+		culture.second.writeSnapshot(snapshot);
+	}
+}
 
 
 EU4::cultureGroups::cultureGroups():
 	groupToCulturesMap(),
 	cultureToGroupMap()
 {
-	addCulturesFromFile(theConfiguration.getEU4Path() + "/common/cultures/00_cultures.txt");
+	std::vector<std::string> cultureFiles = { theConfiguration().getEU4Path() + "/common/cultures/00_cultures.txt" };
+	for (auto itr: theConfiguration().getEU4Mods())
+	{
+		for (const auto& cultureFile: parsing::getFilesInFolder(itr + "/common/cultures"))
+		{
+			cultureFiles.push_back(cultureFile);
+		}
+	}
 
-	for (auto itr: theConfiguration.getEU4Mods())
+	const parsing::FileCache cache;
+	if (cache.load("cultures", cultureFiles, [this](parsing::SnapshotReader& snapshot) { readSnapshot(snapshot); }))
 	{
-		std::set<std::string> cultureFiles;
-		Utils::GetAllFilesInFolder(itr + "/common/cultures/", cultureFiles);
-		for (auto cultureFile: cultureFiles)
+		return;
+	}
+	for (const auto& cultureFile: cultureFiles)
+	{
+		addCulturesFromFile(cultureFile);
+	}
+	cache.store("cultures", cultureFiles, [this](parsing::SnapshotWriter& snapshot) { writeSnapshot(snapshot); });
+}
+
+
+void EU4::cultureGroups::readSnapshot(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto groupName = snapshot.read<std::string>();
+		auto& cultures = groupToCulturesMap[groupName];
+		for (auto cultureCount = snapshot.readCount(); cultureCount > 0; cultureCount--)
+		{
+			cultures.emplace_back(snapshot);
+		}
+	}
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto cultureName = snapshot.read<std::string>();
+		cultureToGroupMap.insert(make_pair(cultureName, cultureGroup(snapshot)));
+	}
+}
+
+
+void EU4::cultureGroups::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(groupToCulturesMap.size());
+	for (const auto& group: groupToCulturesMap)
+	{
+		snapshot.write(group.first);
+		snapshot.writeCount(group.second.size());
+		for (const auto& culture: group.second)
 		{
-			addCulturesFromFile(itr + "/common/cultures/" + cultureFile);
+			culture.writeSnapshot(snapshot);
 		}
 	}
+	snapshot.writeCount(cultureToGroupMap.size());
+	for (const auto& culture: cultureToGroupMap)
+	{
+		snapshot.write(culture.first);
+		culture.second.writeSnapshot(snapshot);
+	}
 }
 
 
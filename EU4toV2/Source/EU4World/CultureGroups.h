@@ -26,7 +26,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include "../ConversionContext.h"
 #include "newParser.h"
+#include "../Parsing/Snapshot.h"
 #include <map>
 #include <optional>
 #include <string>
@@ -40,6 +42,9 @@ namespace EU4
 	{
 		public:
 			culture(std::istream& theStream);
+			explicit culture(parsing::SnapshotReader& snapshot);
+
+			void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		private:
 			std::string primaryTag;
@@ -54,6 +59,9 @@ namespace EU4
 	{
 		public:
 			cultureGroup(const std::string& name_, std::istream& theStream);
+			explicit cultureGroup(parsing::SnapshotReader& snapshot);
+
+			void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 			std::string getName() const { return name; }
 			std::map<std::string, culture> getCultures() const { return cultures; }
@@ -87,18 +95,15 @@ namespace EU4
 			}
 
 		private:
-			static cultureGroups* instance;
 			static cultureGroups* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new cultureGroups;
-				}
-				return instance;
+				return &ConversionContext::current().getState<cultureGroups>([]() { return new cultureGroups; });
 			}
 
 			cultureGroups();
 			void addCulturesFromFile(const std::string& filename);
+			void readSnapshot(parsing::SnapshotReader& snapshot);
+			void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 			std::optional<cultureGroup> GetCulturalGroup(const std::string& culture);
 			std::vector<culture> GetCulturesInGroup(const std::string& group);
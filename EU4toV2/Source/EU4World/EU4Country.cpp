@@ -1,9 +1,8 @@
 #include "EU4Country.h"
 #include "Country/EU4GovernmentSection.h"
 #include "../Configuration.h"
-#include "Log.h"
-#include "NewParserToOldParserConverters.h"
 #include "Object.h"
+#include "OSCompatibilityLayer.h"
 #include "ParserHelpers.h"
 #include "CultureGroups.h"
 #include "EU4Relations.h"
@@ -13,6 +12,10 @@
 #include "Provinces/EU4Province.h"
 #include "../Mappers/Ideas/IdeaEffectMapper.h"
 #include "../V2World/V2Localisation.h"
+#include "../Parsing/BufferParser.h"
+#include "../Parsing/LegacyObjects.h"
+#include "../Parsing/ParsingHelpers.h"
+#include "../Parsing/WorkerLog.h"
 #include <algorithm>
 
 
@@ -22,348 +25,485 @@ EU4::Country::Country(
 	std::istream& theStream,
 	const mappers::IdeaEffectMapper& ideaEffectMapper
 ):
-	tag(countryTag),
-	provinces(),
-	cores(),
-	inHRE(false),
-	holyRomanEmperor(false),
-	celestialEmperor(false),
-	capital(0),
-	techGroup(),
-	embracedInstitutions(),
-	isolationism(1),
-	primaryCulture(),
-	acceptedCultures(),
-	culturalUnion({}),
-	religion(),
-	stability(-3.0),
-	admTech(0.0),
-	dipTech(0.0),
-	milTech(0.0),
-	flags(),
-	modifiers(),
-	possibleDaimyo(false),
-	possibleShogun(false),
-	militaryLeaders(),
-	relations(),
-	armies(),
-	nationalIdeas(),
-	legitimacy(1.0),
-	customNation(false),
-	colony(false),
-	colonialRegion(),
-	libertyDesire(0.0),
-	randomName(),
-	revolutionary(false),
-	name(),
-	adjective(),
-	namesByLanguage(),
-	adjectivesByLanguage()
+	tag(countryTag)
 {
-	registerKeyword(std::regex("name"), [this](const std::string& unused, std::istream& theStream)
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer, theVersion);
+	finishCountry(ideaEffectMapper);
+}
+
+
+EU4::Country::Country(
+	const std::string& countryTag,
+	const EU4::Version& theVersion,
+	parsing::Tokenizer& tokenizer,
+	const mappers::IdeaEffectMapper& ideaEffectMapper
+):
+	tag(countryTag)
+{
+	getKeywords().parse(*this, tokenizer, theVersion);
+	finishCountry(ideaEffectMapper);
+}
+
+
+EU4::Country::Country(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(tag);
+	snapshot.read(inHRE);
+	snapshot.read(holyRomanEmperor);
+	snapshot.read(celestialEmperor);
+	snapshot.read(capital);
+	snapshot.read(techGroup);
+	snapshot.read(embracedInstitutions);
+	snapshot.read(isolationism);
+	snapshot.read(primaryCulture);
+	snapshot.read(acceptedCultures);
+	if (snapshot.read<bool>())
+	{
+		culturalUnion = cultureGroup(snapshot);
+	}
+	snapshot.read(religion);
+	snapshot.read(score);
+	snapshot.read(stability);
+	snapshot.read(admTech);
+	snapshot.read(dipTech);
+	snapshot.read(milTech);
+	snapshot.read(armyInvestment);
+	snapshot.read(navyInvestment);
+	snapshot.read(commerceInvestment);
+	snapshot.read(industryInvestment);
+	snapshot.read(cultureInvestment);
+	snapshot.read(slaveryInvestment);
+	snapshot.read(upper_house_compositionInvestment);
+	snapshot.read(vote_franchiseInvestment);
+	snapshot.read(voting_systemInvestment);
+	snapshot.read(public_meetingsInvestment);
+	snapshot.read(press_rightsInvestment);
+	snapshot.read(trade_unionsInvestment);
+	snapshot.read(political_partiesInvestment);
+	snapshot.read(libertyInvestment);
+	snapshot.read(equalityInvestment);
+	snapshot.read(orderInvestment);
+	snapshot.read(literacyInvestment);
+	snapshot.read(reactionaryInvestment);
+	snapshot.read(liberalInvestment);
+	for (const auto& flag: snapshot.read<std::vector<std::string>>())
+	{
+		flags.emplace(flag);
+	}
+	snapshot.read(modifiers);
+	snapshot.read(possibleDaimyo);
+	snapshot.read(possibleShogun);
+	snapshot.read(government);
+	snapshot.read(governmentRank);
+	snapshot.read(development);
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		militaryLeaders.push_back(parsing::makeArenaShared<leader>(snapshot));
+	}
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto otherTag = snapshot.read<std::string>();
+		relations.insert(make_pair(otherTag, new EU4Relations(snapshot)));
+	}
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		armies.emplace_back(snapshot);
+	}
+	snapshot.read(nationalIdeas);
+	snapshot.read(legitimacy);
+	snapshot.read(customNation);
+	snapshot.read(colony);
+	snapshot.read(overlord);
+	snapshot.read(colonialRegion);
+	snapshot.read(libertyDesire);
+	snapshot.read(randomName);
+	snapshot.read(revolutionary);
+	snapshot.read(governmentReforms);
+	snapshot.read(name);
+	snapshot.read(adjective);
+	nationalColors = NationalSymbol(snapshot);
+	snapshot.read(namesByLanguage);
+	snapshot.read(adjectivesByLanguage);
+	snapshot.read(states);
+}
+
+
+void EU4::Country::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(tag);
+	snapshot.write(inHRE);
+	snapshot.write(holyRomanEmperor);
+	snapshot.write(celestialEmperor);
+	snapshot.write(capital);
+	snapshot.write(techGroup);
+	snapshot.write(embracedInstitutions);
+	snapshot.write(isolationism);
+	snapshot.write(primaryCulture);
+	snapshot.write(acceptedCultures);
+	snapshot.write(culturalUnion.has_value());
+	if (culturalUnion)
+	{
+		culturalUnion->writeSnapshot(snapshot);
+	}
+	snapshot.write(religion);
+	snapshot.write(score);
+	snapshot.write(stability);
+	snapshot.write(admTech);
+	snapshot.write(dipTech);
+	snapshot.write(milTech);
+	snapshot.write(armyInvestment);
+	snapshot.write(navyInvestment);
+	snapshot.write(commerceInvestment);
+	snapshot.write(industryInvestment);
+	snapshot.write(cultureInvestment);
+	snapshot.write(slaveryInvestment);
+	snapshot.write(upper_house_compositionInvestment);
+	snapshot.write(vote_franchiseInvestment);
+	snapshot.write(voting_systemInvestment);
+	snapshot.write(public_meetingsInvestment);
+	snapshot.write(press_rightsInvestment);
+	snapshot.write(trade_unionsInvestment);
+	snapshot.write(political_partiesInvestment);
+	snapshot.write(libertyInvestment);
+	snapshot.write(equalityInvestment);
+	snapshot.write(orderInvestment);
+	snapshot.write(literacyInvestment);
+	snapshot.write(reactionaryInvestment);
+	snapshot.write(liberalInvestment);
+	snapshot.writeCount(flags.size());
+	for (const auto& flag: flags)
+	{
+		snapshot.write(flag.getName());
+	}
+	snapshot.write(modifiers);
+	snapshot.write(possibleDaimyo);
+	snapshot.write(possibleShogun);
+	snapshot.write(government);
+	snapshot.write(governmentRank);
+	snapshot.write(development);
+	snapshot.writeCount(militaryLeaders.size());
+	for (const auto& militaryLeader: militaryLeaders)
+	{
+		militaryLeader->writeSnapshot(snapshot);
+	}
+	snapshot.writeCount(relations.size());
+	for (const auto& relation: relations)
+	{
+		snapshot.write(relation.first);
+		relation.second->writeSnapshot(snapshot);
+	}
+	snapshot.writeCount(armies.size());
+	for (const auto& army: armies)
+	{
+		army.writeSnapshot(snapshot);
+	}
+	snapshot.write(nationalIdeas);
+	snapshot.write(legitimacy);
+	snapshot.write(customNation);
+	snapshot.write(colony);
+	snapshot.write(overlord);
+	snapshot.write(colonialRegion);
+	snapshot.write(libertyDesire);
+	snapshot.write(randomName);
+	snapshot.write(revolutionary);
+	snapshot.write(governmentReforms);
+	snapshot.write(name);
+	snapshot.write(adjective);
+	nationalColors.writeSnapshot(snapshot);
+	snapshot.write(namesByLanguage);
+	snapshot.write(adjectivesByLanguage);
+	snapshot.write(states);
+}
+
+
+const parsing::KeywordTable<EU4::Country, const EU4::Version&>& EU4::Country::getKeywords()
+{
+	static const auto readFlags = [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& alsoUnused)
 		{
-			commonItems::singleString theName(theStream);
-			name = theName.getString();
-			if (name.substr(0,1) == "\"")
+			for (const auto& flag: parsing::getAssignments(tokenizer))
 			{
-				name = name.substr(1, name.size() - 2);
+				country.flags.emplace(flag.first);
 			}
-		}
-	);
-	registerKeyword(std::regex("custom_name"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString theName(theStream);
-			randomName = V2Localisation::Convert(theName.getString());
-			customNation = true;
-		}
-	);
-	registerKeyword(std::regex("adjective"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString theAdjective(theStream);
-			adjective = theAdjective.getString();
-		}
-	);
-	// This is obsolete and not applicable from at least 1.19+, probably further back
-	registerKeyword(std::regex("map_color"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto colorColor = commonItems::Color(theStream);
-			colorColor.RandomlyFlunctuate(30);
-			// Countries whose colors are included in the object here tend to be generated countries,
-			// i.e. colonial nations which take on the color of their parent. To help distinguish 
-			// these countries from their parent's other colonies we randomly adjust the color.
-			nationalColors.setMapColor(colorColor);
-		}
-	);
-	registerKeyword(std::regex("colors"), [this](const std::string& colorsString, std::istream& theStream)
-		{
-			EU4::NationalSymbol theSection(theStream);
-			nationalColors = theSection;
-		}
-	);
-	registerKeyword(std::regex("capital"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theCapital(theStream);
-			capital = theCapital.getInt();
-		}
-	);
-	registerKeyword(std::regex("technology_group"), [this](const std::string& unused, std::istream& theStream)
+		};
+	static const auto markColony = [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& alsoUnused)
 		{
-			commonItems::singleString theTechGroup(theStream);
-			techGroup = theTechGroup.getString();
-		}
-	);
-	registerKeyword(std::regex("liberty_desire"), [this](const std::string& unused, std::istream& theStream)
+			parsing::getString(tokenizer);
+			country.colony = true;
+		};
+	static const auto addArmy = [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& alsoUnused)
 		{
-			commonItems::singleDouble theLibertyDesire(theStream);
-			libertyDesire = theLibertyDesire.getDouble();
-		}
-	);
-	registerKeyword(std::regex("institutions"), [this](const std::string& unused, std::istream& theStream)
+			country.armies.emplace_back(tokenizer);
+		};
+
+	static const parsing::KeywordTable<Country, const EU4::Version&> keywords(
 		{
-			commonItems::intList theInstitutions(theStream);
-			for (auto institution: theInstitutions.getInts())
-			{
-				if (institution == 1)
+			{ "name", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
 				{
-					embracedInstitutions.push_back(true);
+					country.name = parsing::getString(tokenizer);
 				}
-				else
+			},
+			{ "custom_name", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
 				{
-					embracedInstitutions.push_back(false);
+					country.randomName = V2Localisation::Convert(std::string(parsing::getString(tokenizer)));
+					country.customNation = true;
 				}
-			}
-		}
-	);
-	registerKeyword(std::regex("isolationism"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt isolationismValue(theStream);
-			isolationism = isolationismValue.getInt();
-		}
-	);
-	registerKeyword(std::regex("primary_culture"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString thePrimaryCulture(theStream);
-			primaryCulture = thePrimaryCulture.getString();
-		}
-	);
-	registerKeyword(std::regex("accepted_culture"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString theAcceptedCulture(theStream);
-			acceptedCultures.push_back(theAcceptedCulture.getString());
-		}
-	);
-	registerKeyword(std::regex("government_rank"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theGovernmentRank(theStream);
-			governmentRank = theGovernmentRank.getInt();
-		}
-	);
-	registerKeyword(std::regex("realm_development"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theDevelopment(theStream);
-			development = theDevelopment.getInt();
-		}
-	);
-	registerKeyword(std::regex("culture_group_union"), [this, theVersion](const std::string& unused, std::istream& theStream)
-		{
-			if (theVersion < EU4::Version("1.7.0.0"))
-			{
-				commonItems::singleString cultureGroup(theStream);
-				culturalUnion = EU4::cultureGroups::getCulturalGroup(cultureGroup.getString());
-			}
-			else
-			{
-				EU4::cultureGroup newUnion(tag + "_union", theStream);
-				culturalUnion = newUnion;
-			}
-		}
-	);
-	registerKeyword(std::regex("religion"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString theReligion(theStream);
-			religion = theReligion.getString();
-		}
-	);
-	// Obsolete since 1.26.0
-	registerKeyword(std::regex("score"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble theScore(theStream);
-		score = theScore.getDouble();
-	});
-	//Relevant since 1.20 but we only use it for 1.26+
-	registerKeyword(std::regex("age_score"), [this, theVersion](const std::string& unused, std::istream& theStream) {
-		if (theVersion >= EU4::Version("1.26.0.0")) 
-		{
-			commonItems::doubleList ageScores(theStream);
-			for (auto& agScore : ageScores.getDoubles()) score += agScore;
-		}
-	});
-	registerKeyword(std::regex("stability"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleDouble theStability(theStream);
-			stability = theStability.getDouble();
-		}
-	);
-	registerKeyword(std::regex("technology"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto topObj = commonItems::convert8859Object(unused, theStream);
-			auto techsObj = topObj->getLeaves();
-			auto techObj = techsObj[0]->getValue("adm_tech");
-			admTech = stof(techObj[0]->getLeaf());
-
-			techObj = techsObj[0]->getValue("dip_tech");
-			dipTech = stof(techObj[0]->getLeaf());
-
-			techObj = techsObj[0]->getValue("mil_tech");
-			milTech = stof(techObj[0]->getLeaf());
-		}
-	);
-	registerKeyword(std::regex("flags"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto flagsObj = commonItems::convert8859Object(unused, theStream);
-			for (auto flagObject: flagsObj->getLeaves()[0]->getLeaves())
-			{
-				flags[flagObject->getKey()] = true;
-			}
-		}
-	);
-	registerKeyword(std::regex("hidden_flags"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto flagsObj = commonItems::convert8859Object(unused, theStream);
-			for (auto flagObject: flagsObj->getLeaves()[0]->getLeaves())
-			{
-				flags[flagObject->getKey()] = true;
-			}
-		}
-	);
-	registerKeyword(std::regex("modifier"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto modifierObj = commonItems::convert8859Object(unused, theStream);
-			std::vector<shared_ptr<Object>> subModifierObj = modifierObj->getLeaves()[0]->getValue("modifier");
-			if (subModifierObj.size() > 0)
-			{
-				modifiers[subModifierObj[0]->getLeaf()] = true;
-			}
-		}
-	);
-	registerKeyword(std::regex("variables"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto variablesObj = commonItems::convert8859Object(unused, theStream);
-			for (auto variableObject: variablesObj->getLeaves()[0]->getLeaves())
-			{
-				flags[variableObject->getKey()] = true;
-			}
-		}
-	);
-	registerKeyword(std::regex("government"), [this, theVersion](const std::string& unused, std::istream& theStream){
-		if (theVersion < EU4::Version("1.23.0.0"))
-		{
-			government = EU4::governmentSection::readGovernment(theStream);
-		}
-		else
-		{
-			EU4::governmentSection theSection(theStream);
-			government = theSection.getGovernment();
-			governmentReforms = theSection.getGovernmentReforms();
-		}
-	});
-	registerKeyword(std::regex("active_relations"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto relationLeaves = commonItems::convert8859Object(unused, theStream);
-			for (auto relationLeaf: relationLeaves->getLeaves()[0]->getLeaves())
-			{
-				std::string key = relationLeaf->getKey();
-				EU4Relations* rel = new EU4Relations(relationLeaf);
-				relations.insert(make_pair(key, rel));
-			}
-		}
-	);
-	registerKeyword(std::regex("army"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4Army army(theStream);
-			armies.push_back(army);
-		}
-	);
-	registerKeyword(std::regex("navy"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4Army navy(theStream);
-			armies.push_back(navy);
-		}
-	);
-	registerKeyword(std::regex("active_idea_groups"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto topObject = commonItems::convert8859Object(unused, theStream);
-			auto activeIdeasObjs = topObject->getLeaves();
-			for (auto ideasObj: activeIdeasObjs[0]->getLeaves())
-			{
-				nationalIdeas.insert(make_pair(ideasObj->getKey(), stoi(ideasObj->getLeaf())));
-			}
-		}
-	);
-	registerKeyword(std::regex("legitimacy"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleDouble theLegitimacy(theStream);
-			legitimacy = theLegitimacy.getDouble();
-		}
-	);
-	registerKeyword(std::regex("parent"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString alsoUnused(theStream);
-			colony = true;
-		}
-	);
-	registerKeyword(std::regex("colonial_parent"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString alsoUnused(theStream);
-			colony = true;
-		}
-	);
-	registerKeyword(std::regex("overlord"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString theOverlord(theStream);
-			overlord = theOverlord.getString();
-		}
-	);
-	// This is obsolete and not applicable from at least 1.19+, probably further back:
-	// In current savegame implementation, custom_colors stores a color triplet, but apparently it used to
-	// store a custom colors block with flag and symbol - which is now custom_colors block.
-	registerKeyword(std::regex("country_colors"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4::CustomColors colorBlock(theStream);
-			nationalColors.setCustomColors(colorBlock);
-			nationalColors.setCustomColorsInitialized();
-		}
-	);
-	// This is obsolete and not applicable from at least 1.19+, probably further back
-	registerKeyword(std::regex("revolutionary_colors"), [this](const std::string& unused, std::istream& theStream)
-		{
-			auto colorColor = commonItems::Color(theStream);
-			nationalColors.setRevolutionaryColor(colorColor);
-		}
-	);
-	registerKeyword(std::regex("history"), [this](const std::string& unused, std::istream& theStream)
-		{
-			EU4::countryHistory theCountryHistory(theStream);
-
-			for (auto& leader: theCountryHistory.getItemsOfType("leader"))
-			{
-				auto actualLeader = std::static_pointer_cast<EU4::historyLeader>(leader)->getTheLeader();
-				if (actualLeader->isAlive())
+			},
+			{ "adjective", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.adjective = parsing::getString(tokenizer);
+				}
+			},
+			// This is obsolete and not applicable from at least 1.19+, probably further back
+			{ "map_color", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					parsing::readFromStream(tokenizer, [&country](std::istream& theStream) {
+						auto colorColor = commonItems::Color(theStream);
+						colorColor.RandomlyFlunctuate(30);
+						// Countries whose colors are included in the object here tend to be generated countries,
+						// i.e. colonial nations which take on the color of their parent. To help distinguish 
+						// these countries from their parent's other colonies we randomly adjust the color.
+						country.nationalColors.setMapColor(colorColor);
+					});
+				}
+			},
+			{ "colors", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					parsing::readFromStream(tokenizer, [&country](std::istream& theStream) {
+						EU4::NationalSymbol theSection(theStream);
+						country.nationalColors = theSection;
+					});
+				}
+			},
+			{ "capital", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.capital = parsing::getInt(tokenizer);
+				}
+			},
+			{ "technology_group", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.techGroup = parsing::getString(tokenizer);
+				}
+			},
+			{ "liberty_desire", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.libertyDesire = parsing::getDouble(tokenizer);
+				}
+			},
+			{ "institutions", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					for (auto institution: parsing::getInts(tokenizer))
+					{
+						country.embracedInstitutions.push_back(institution == 1);
+					}
+				}
+			},
+			{ "isolationism", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.isolationism = parsing::getInt(tokenizer);
+				}
+			},
+			{ "primary_culture", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.primaryCulture = parsing::getString(tokenizer);
+				}
+			},
+			{ "accepted_culture", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.acceptedCultures.emplace_back(parsing::getString(tokenizer));
+				}
+			},
+			{ "government_rank", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.governmentRank = parsing::getInt(tokenizer);
+				}
+			},
+			{ "realm_development", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.development = parsing::getInt(tokenizer);
+				}
+			},
+			{ "culture_group_union", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					if (theVersion < EU4::Version("1.7.0.0"))
+					{
+						country.culturalUnion = EU4::cultureGroups::getCulturalGroup(std::string(parsing::getString(tokenizer)));
+					}
+					else
+					{
+						parsing::readFromStream(tokenizer, [&country](std::istream& theStream) {
+							EU4::cultureGroup newUnion(country.tag + "_union", theStream);
+							country.culturalUnion = newUnion;
+						});
+					}
+				}
+			},
+			{ "religion", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.religion = parsing::getString(tokenizer);
+				}
+			},
+			// Obsolete since 1.26.0
+			{ "score", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.score = parsing::getDouble(tokenizer);
+				}
+			},
+			//Relevant since 1.20 but we only use it for 1.26+
+			{ "age_score", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					if (theVersion >= EU4::Version("1.26.0.0"))
+					{
+						for (auto& agScore: parsing::getDoubles(tokenizer)) country.score += agScore;
+					}
+					else
+					{
+						tokenizer.getItemText();
+					}
+				}
+			},
+			{ "stability", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.stability = parsing::getDouble(tokenizer);
+				}
+			},
+			{ "technology", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					// techs are stored at float precision, as they always have been
+					for (const auto& tech: parsing::getAssignments(tokenizer))
+					{
+						if (tech.first == "adm_tech")
+						{
+							country.admTech = static_cast<float>(parsing::toDouble(tech.second));
+						}
+						else if (tech.first == "dip_tech")
+						{
+							country.dipTech = static_cast<float>(parsing::toDouble(tech.second));
+						}
+						else if (tech.first == "mil_tech")
+						{
+							country.milTech = static_cast<float>(parsing::toDouble(tech.second));
+						}
+					}
+				}
+			},
+			{ "flags", readFlags },
+			{ "hidden_flags", readFlags },
+			{ "modifier", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					for (const auto& item: parsing::getAssignments(tokenizer))
+					{
+						if (item.first == "modifier")
+						{
+							country.modifiers[std::string(item.second)] = true;
+							break;
+						}
+					}
+				}
+			},
+			{ "variables", readFlags },
+			{ "government", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					parsing::readFromStream(tokenizer, [&country, &theVersion](std::istream& theStream) {
+						if (theVersion < EU4::Version("1.23.0.0"))
+						{
+							country.government = EU4::governmentSection::readGovernment(theStream);
+						}
+						else
+						{
+							EU4::governmentSection theSection(theStream);
+							country.government = theSection.getGovernment();
+							country.governmentReforms = theSection.getGovernmentReforms();
+						}
+					});
+				}
+			},
+			{ "active_relations", [](Country& country, std::string_view keyword, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					parsing::readFromStream(tokenizer, [&country, keyword](std::istream& theStream) {
+						auto relationLeaves = parsing::convert8859Object(std::string(keyword), theStream);
+						for (auto relationLeaf: relationLeaves->getLeaves()[0]->getLeaves())
+						{
+							std::string key = relationLeaf->getKey();
+							EU4Relations* rel = new EU4Relations(relationLeaf);
+							country.relations.insert(make_pair(key, rel));
+						}
+					});
+				}
+			},
+			{ "army", addArmy },
+			{ "navy", addArmy },
+			{ "active_idea_groups", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					for (const auto& ideaGroup: parsing::getAssignments(tokenizer))
+					{
+						country.nationalIdeas.insert(make_pair(std::string(ideaGroup.first), parsing::toInt(ideaGroup.second)));
+					}
+				}
+			},
+			{ "legitimacy", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.legitimacy = parsing::getDouble(tokenizer);
+				}
+			},
+			{ "parent", markColony },
+			{ "colonial_parent", markColony },
+			{ "overlord", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					country.overlord = parsing::getString(tokenizer);
+				}
+			},
+			// This is obsolete and not applicable from at least 1.19+, probably further back:
+			// In current savegame implementation, custom_colors stores a color triplet, but apparently it used to
+			// store a custom colors block with flag and symbol - which is now custom_colors block.
+			{ "country_colors", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					parsing::readFromStream(tokenizer, [&country](std::istream& theStream) {
+						EU4::CustomColors colorBlock(theStream);
+						country.nationalColors.setCustomColors(colorBlock);
+						country.nationalColors.setCustomColorsInitialized();
+					});
+				}
+			},
+			// This is obsolete and not applicable from at least 1.19+, probably further back
+			{ "revolutionary_colors", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
+				{
+					parsing::readFromStream(tokenizer, [&country](std::istream& theStream) {
+						auto colorColor = commonItems::Color(theStream);
+						country.nationalColors.setRevolutionaryColor(colorColor);
+					});
+				}
+			},
+			{ "history", [](Country& country, std::string_view unused, parsing::Tokenizer& tokenizer, const EU4::Version& theVersion)
 				{
-					militaryLeaders.push_back(actualLeader);
+					parsing::readFromStream(tokenizer, [&country](std::istream& theStream) {
+						EU4::countryHistory theCountryHistory(theStream);
+
+						for (auto& leader: theCountryHistory.getItemsOfType("leader"))
+						{
+							auto actualLeader = std::static_pointer_cast<EU4::historyLeader>(leader)->getTheLeader();
+							if (actualLeader->isAlive())
+							{
+								country.militaryLeaders.push_back(actualLeader);
+							}
+						}
+						/*std::vector<shared_ptr<Object>> daimyoObj = historyObj[0]->getValue("daimyo");	// the object holding the daimyo information for this country
+						if (daimyoObj.size() > 0)
+						{
+							possibleDaimyo = true;
+						}*/
+					});
 				}
 			}
-			/*std::vector<shared_ptr<Object>> daimyoObj = historyObj[0]->getValue("daimyo");	// the object holding the daimyo information for this country
-			if (daimyoObj.size() > 0)
-			{
-				possibleDaimyo = true;
-			}*/
 		}
 	);
+	return keywords;
+}
 
-	registerKeyword(std::regex("[a-z0-9\\_]+"), commonItems::ignoreItem);
-
-	parseStream(theStream);
 
+void EU4::Country::finishCountry(const mappers::IdeaEffectMapper& ideaEffectMapper)
+{
 	determineJapaneseRelations();
 	determineInvestments(ideaEffectMapper);
 	determineLibertyDesire();
@@ -382,7 +522,7 @@ void EU4::Country::dropMinorityCultures()
 		}
 		if ((culturalDevelopment / development) > 0.15)
 		{
-			LOG(LogLevel::Debug) << tag << ": Culture " << acceptedCulture << " at " << culturalDevelopment << " / " << development << " development, sufficient to adopt.";
+			WORKER_LOG(LogLevel::Debug) << tag << ": Culture " << acceptedCulture << " at " << culturalDevelopment << " / " << development << " development, sufficient to adopt.";
 			updatedCultures.push_back(acceptedCulture);
 		}
 	}
@@ -394,7 +534,7 @@ void EU4::Country::determineCulturalUnion()
 	if ((development >= 1000) || (governmentRank > 2))
 	{
 		culturalUnion = EU4::cultureGroups::getCulturalGroup(primaryCulture);
-		LOG(LogLevel::Debug) << tag << ": Cultural union accepted for " << primaryCulture << " - Development: " << development << " government rank: " << governmentRank;
+		WORKER_LOG(LogLevel::Debug) << tag << ": Cultural union accepted for " << primaryCulture << " - Development: " << development << " government rank: " << governmentRank;
 	}
 
 }
@@ -608,7 +748,7 @@ void EU4::Country::determineLibertyDesire()
 			}
 			else
 			{
-				LOG(LogLevel::Warning) << "Unknown attitude type " << attitude << " while setting liberty desire for " << tag;
+				WORKER_LOG(LogLevel::Warning) << "Unknown attitude type " << attitude << " while setting liberty desire for " << tag;
 				libertyDesire = 95.0;
 			}
 		}
@@ -616,7 +756,7 @@ void EU4::Country::determineLibertyDesire()
 }
 
 
-void EU4::Country::readFromCommonCountry(const std::string& fileName, const std::string& fullFilename)
+void EU4::Country::readFromCommonCountry(const std::string& fileName, const std::optional<commonItems::Color>& mapColor)
 {
 	if (name.empty())
 	{
@@ -625,17 +765,9 @@ void EU4::Country::readFromCommonCountry(const std::string& fileName, const std:
 		name = fileName.substr(0, extPos);
 	}
 
-	if (!nationalColors.getMapColor())
+	if (!nationalColors.getMapColor() && mapColor)
 	{
-		registerKeyword(std::regex("color"), [this](const std::string& unused, std::istream& theStream)
-			{
-				auto color = commonItems::Color(theStream);
-				nationalColors.setMapColor(color);
-			}
-		);
-		registerKeyword(std::regex("[a-zA-Z0-9_]+"), commonItems::ignoreItem);
-
-		parseFile(fullFilename);
+		nationalColors.setMapColor(*mapColor);
 	}
 }
 
@@ -706,14 +838,14 @@ int EU4::Country::hasNationalIdea(std::string ni) const
 
 bool EU4::Country::hasFlag(std::string flag) const
 {
-	std::map<std::string, bool>::const_iterator itr = flags.find(flag);
-	return (itr != flags.end());
+	const auto flagSymbol = parsing::FlagSymbol::find(flag);
+	return flagSymbol && (flags.count(*flagSymbol) > 0);
 }
 
 
 void EU4::Country::resolveRegimentTypes(mappers::RegimentTypeMap& map)
 {
-	for (std::vector<EU4Army>::iterator itr = armies.begin(); itr != armies.end(); ++itr)
+	for (auto itr = armies.begin(); itr != armies.end(); ++itr)
 	{
 		itr->resolveRegimentTypes(map);
 	}
@@ -788,7 +920,7 @@ void EU4::Country::eatCountry(std::shared_ptr<EU4::Country> target, std::shared_
 	target->clearProvinces();
 	target->clearCores();
 
-	LOG(LogLevel::Debug) << "Merged " << target->tag << " into " << tag;
+	WORKER_LOG(LogLevel::Debug) << "Merged " << target->tag << " into " << tag;
 }
 
 
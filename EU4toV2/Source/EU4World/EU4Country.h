@@ -6,8 +6,13 @@
 #include "Date.h"
 #include "CultureGroups.h"
 #include "../Mappers/UnitTypeMapper.h"
-#include "newParser.h"
+#include "../Parsing/Arena.h"
+#include "../Parsing/KeywordTable.h"
+#include "../Parsing/Snapshot.h"
+#include "../Parsing/Symbol.h"
+#include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <set>
 #include "Country/EU4NationalSymbol.h"
@@ -34,7 +39,7 @@ class TechgroupsMapper;
 
 namespace EU4
 {
-	class Country: public commonItems::parser
+	class Country
 	{
 		public:
 			Country() = default;
@@ -44,9 +49,19 @@ namespace EU4
 				std::istream& theStream,
 				const mappers::IdeaEffectMapper& ideaEffectMapper
 			);
+			Country(
+				const std::string& countryTag,
+				const EU4::Version& theVersion,
+				parsing::Tokenizer& tokenizer,
+				const mappers::IdeaEffectMapper& ideaEffectMapper
+			);
+			// provinces and cores aren't kept, they're added again once the world is loaded
+			explicit Country(parsing::SnapshotReader& snapshot);
+
+			void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 			// Add any additional information available from the specified country file.
-			void readFromCommonCountry(const std::string& fileName, const std::string& fullFilename);
+			void readFromCommonCountry(const std::string& fileName, const std::optional<commonItems::Color>& mapColor);
 
 			void setLocalisationName(const std::string& language, const std::string& name);
 			void setLocalisationAdjective(const std::string& language, const std::string& adjective);
@@ -114,7 +129,7 @@ namespace EU4
 			std::string getGovernment() const { return government; }
 			std::set<std::string> getReforms() const { return governmentReforms; }
 			std::map<std::string, EU4Relations*> getRelations() const { return relations; }
-			std::vector<EU4Army> getArmies() const { return armies; }
+			std::vector<EU4Army> getArmies() const { return std::vector<EU4Army>(armies.begin(), armies.end()); }
 			bool isCustom() const { return customNation; }
 			bool isColony() const { return colony; }
 			std::string getColonialRegion() const { return colonialRegion; }
@@ -132,6 +147,8 @@ namespace EU4
 			EU4::NationalSymbol getNationalColors() const { return nationalColors; }
 
 		private:
+			static const parsing::KeywordTable<Country, const EU4::Version&>& getKeywords();
+			void finishCountry(const mappers::IdeaEffectMapper& ideaEffectMapper);
 			void determineJapaneseRelations();
 			void determineInvestments(const mappers::IdeaEffectMapper& ideaEffectMapper);
 			void determineLibertyDesire();
@@ -142,22 +159,22 @@ namespace EU4
 			std::string tag; // the tag for the EU4 nation
 			std::vector<Province*> provinces;
 			std::vector<Province*> cores;
-			bool inHRE; // if this country is an HRE member
-			bool holyRomanEmperor; // if this country is the emperor of the HRE
-			bool celestialEmperor; // if this country is the celestial emperor
-			int capital; // the EU4 province that is this nation's capital
+			bool inHRE = false; // if this country is an HRE member
+			bool holyRomanEmperor = false; // if this country is the emperor of the HRE
+			bool celestialEmperor = false; // if this country is the celestial emperor
+			int capital = 0; // the EU4 province that is this nation's capital
 			std::string techGroup; // the tech group for this nation
 			std::vector<bool> embracedInstitutions; // the institutions this nation has embraced
-			int isolationism; // the isolationism of the country (for Shinto nations with Mandate of Heaven)
+			int isolationism = 1; // the isolationism of the country (for Shinto nations with Mandate of Heaven)
 			std::string primaryCulture; // the primary EU4 culture of this nation
 			std::vector<std::string> acceptedCultures; // the accepted EU4 cultures for this nation
 			std::optional<EU4::cultureGroup> culturalUnion;
 			std::string religion; // the accepted religion of this country
 			double score = 0.0;
-			double stability; // the stability of this nation
-			double admTech; // the admin tech of this nation
-			double dipTech; // the diplo tech of this nation
-			double milTech; // the mil tech of this nation
+			double stability = -3.0; // the stability of this nation
+			double admTech = 0.0; // the admin tech of this nation
+			double dipTech = 0.0; // the diplo tech of this nation
+			double milTech = 0.0; // the mil tech of this nation
 
 			double armyInvestment = 5.0;
 			double navyInvestment = 5.0;
@@ -180,25 +197,25 @@ namespace EU4
 			double liberalInvestment = 5.0;
 
 
-			std::map<std::string, bool> flags; // any flags set for this country
+			std::set<parsing::FlagSymbol> flags; // any flags set for this country
 			std::map<std::string, bool> modifiers; // any modifiers set for this country
-			bool possibleDaimyo; // if this country is possibly a daimyo
-			bool possibleShogun; // if this country is the shogun
+			bool possibleDaimyo = false; // if this country is possibly a daimyo
+			bool possibleShogun = false; // if this country is the shogun
 			std::vector<std::shared_ptr<EU4::leader>> militaryLeaders;
 			std::string government = "monarchy";
 			int governmentRank = 0;
 			int development = 0;
 			std::map<std::string, EU4Relations*> relations; // the relations with other nations
-			std::vector<EU4Army> armies; // both armies and navies
+			std::pmr::vector<EU4Army> armies{ parsing::getCurrentResource() }; // both armies and navies
 			std::map<std::string, int> nationalIdeas; // the national ideas for this country
-			double legitimacy; // the legitimacy of this nation
-			bool customNation; // whether or not this is a custom or random nation
-			bool colony; // whether or not this country is a colony
+			double legitimacy = 1.0; // the legitimacy of this nation
+			bool customNation = false; // whether or not this is a custom or random nation
+			bool colony = false; // whether or not this country is a colony
 			std::string overlord;
 			std::string colonialRegion; // the colonial region, if this country is a colony
-			double libertyDesire; // the amount of liberty desire
+			double libertyDesire = 0.0; // the amount of liberty desire
 			std::string randomName; // the new name of this nation in Random World
-			bool revolutionary; // does this country wave the glorious tricoloured banner of the revolution
+			bool revolutionary = false; // does this country wave the glorious tricoloured banner of the revolution
 			std::set<std::string> governmentReforms;
 
 			// Localisation attributes
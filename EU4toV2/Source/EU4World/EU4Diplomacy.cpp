@@ -21,20 +21,68 @@ THE SOFTWARE. */
 
 
 #include "EU4Diplomacy.h"
+#include "../Parsing/KeywordTable.h"
+#include "../Parsing/ParsingHelpers.h"
+#include "../Parsing/SectionScanner.h"
+#include "../Parsing/WorkerLog.h"
 #include "Log.h"
-#include "Object.h"
+#include <algorithm>
 
 
 
-EU4Agreement::EU4Agreement(shared_ptr<Object> obj)
+namespace
 {
-	type = obj->getKey();
 
-	std::vector<shared_ptr<Object>> objType = obj->getValue("subject_type");
-	if (objType.size() > 0)
-	{
-		type = objType[0]->getLeaf();
+// Agreements are kept grouped by kind, in this order, as the converter has always listed them.
+const std::vector<std::string_view> agreementKinds = {
+	"royal_marriage",
+	"guarantee",
+	"vassal",
+	"protectorate",
+	"is_colonial",
+	"is_march",
+	"sphere",
+	"alliance",
+	"union",
+	"dependency"
+};
+
+
+const parsing::KeywordTable<EU4Agreement>& getAgreementKeywords()
+{
+	static const parsing::KeywordTable<EU4Agreement> keywords(
+		{
+			{ "subject_type", [](EU4Agreement& agreement, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				agreement.type = parsing::getString(tokenizer);
+			}},
+			{ "first", [](EU4Agreement& agreement, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				agreement.country1 = parsing::getString(tokenizer);
+			}},
+			{ "second", [](EU4Agreement& agreement, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				agreement.country2 = parsing::getString(tokenizer);
+			}},
+			{ "start_date", [](EU4Agreement& agreement, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				agreement.startDate = parsing::getDate(tokenizer);
+			}}
+		}
+	);
+	return keywords;
+}
+
+}
 
+
+EU4Agreement::EU4Agreement(std::string_view kind, parsing::Tokenizer& tokenizer)
+{
+	getAgreementKeywords().parse(*this, tokenizer);
+
+	// a subject type, when given, is more specific than the key the agreement was listed under
+	if (type.empty())
+	{
+		type = kind;
+	}
+	else
+	{
 		if (type == "personal_union")
 		{
 			type = "union";
@@ -45,116 +93,73 @@ EU4Agreement::EU4Agreement(shared_ptr<Object> obj)
 		}
 		if (type == "dependency")
 		{
-			LOG(LogLevel::Warning) << "Dependency has no subject type";
+			WORKER_LOG(LogLevel::Warning) << "Dependency has no subject type";
 		}
 	}
 
-
-	std::vector<shared_ptr<Object>> objFirst = obj->getValue("first");
-	if (objFirst.size() > 0)
+	if (country1.empty())
 	{
-		country1 = objFirst[0]->getLeaf();
+		WORKER_LOG(LogLevel::Warning) << "Diplomatic agreement (" << type << ") has no first party";
 	}
-	else
+	if (country2.empty())
 	{
-		LOG(LogLevel::Warning) << "Diplomatic agreement (" << type << ") has no first party";
+		WORKER_LOG(LogLevel::Warning) << "Diplomatic agreement (" << type << ") has no second party";
 	}
+}
 
-	std::vector<shared_ptr<Object>> objSecond = obj->getValue("second");
-	if (objSecond.size() > 0)
-	{
-		country2 = objSecond[0]->getLeaf();
-	}
-	else
+
+EU4Diplomacy::EU4Diplomacy(parsing::Tokenizer& tokenizer)
+{
+	std::vector<std::vector<EU4Agreement>> agreementsByKind(agreementKinds.size());
+	for (const auto& section: parsing::getBlockSections(tokenizer))
 	{
-		LOG(LogLevel::Warning) << "Diplomatic agreement (" << type << ") has no second party";
+		const auto kind = std::find(agreementKinds.begin(), agreementKinds.end(), section.key);
+		if (kind != agreementKinds.end())
+		{
+			parsing::Tokenizer agreementTokenizer(section.text, tokenizer.getSettings());
+			agreementsByKind[kind - agreementKinds.begin()].emplace_back(section.key, agreementTokenizer);
+		}
 	}
 
-	std::vector<shared_ptr<Object>> objDate = obj->getValue("start_date");
-	if (objDate.size() > 0)
+	for (auto& kindAgreements: agreementsByKind)
 	{
-		startDate = date(objDate[0]->getLeaf());
+		agreements.insert(agreements.end(), kindAgreements.begin(), kindAgreements.end());
 	}
 }
 
 
-EU4Diplomacy::EU4Diplomacy()
+EU4Agreement::EU4Agreement(parsing::SnapshotReader& snapshot)
 {
-	agreements.clear();
+	snapshot.read(type);
+	snapshot.read(country1);
+	snapshot.read(country2);
+	snapshot.read(startDate);
 }
 
 
-EU4Diplomacy::EU4Diplomacy(shared_ptr<Object> obj)
+void EU4Agreement::writeSnapshot(parsing::SnapshotWriter& snapshot) const
 {
-	std::vector<shared_ptr<Object>> objRMs = obj->getValue("royal_marriage");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objRMs.begin(); itr != objRMs.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
-
-	std::vector<shared_ptr<Object>> objGaurantees = obj->getValue("guarantee");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objGaurantees.begin(); itr != objGaurantees.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
-
-	std::vector<shared_ptr<Object>> objVassals = obj->getValue("vassal");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objVassals.begin(); itr != objVassals.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
-
-	std::vector<shared_ptr<Object>> objProtectorate = obj->getValue("protectorate");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objProtectorate.begin(); itr != objProtectorate.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
-
-	std::vector<shared_ptr<Object>> objColonial = obj->getValue("is_colonial");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objColonial.begin(); itr != objColonial.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
-
-	std::vector<shared_ptr<Object>> objMarch = obj->getValue("is_march");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objMarch.begin(); itr != objMarch.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
+	snapshot.write(type);
+	snapshot.write(country1);
+	snapshot.write(country2);
+	snapshot.write(startDate);
+}
 
-	std::vector<shared_ptr<Object>> objSpheres = obj->getValue("sphere");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objSpheres.begin(); itr != objSpheres.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
 
-	std::vector<shared_ptr<Object>> objAlliances = obj->getValue("alliance");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objAlliances.begin(); itr != objAlliances.end(); ++itr)
+EU4Diplomacy::EU4Diplomacy(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
 	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
+		agreements.emplace_back(snapshot);
 	}
+}
 
-	std::vector<shared_ptr<Object>> objUnions = obj->getValue("union");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objUnions.begin(); itr != objUnions.end(); ++itr)
-	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
-	}
 
-	std::vector<shared_ptr<Object>> objDependencies = obj->getValue("dependency");
-	for (std::vector<shared_ptr<Object>>::iterator itr = objDependencies.begin(); itr != objDependencies.end(); ++itr)
+void EU4Diplomacy::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(agreements.size());
+	for (const auto& agreement: agreements)
 	{
-		EU4Agreement agr(*itr);		// the new agreement
-		agreements.push_back(agr);
+		agreement.writeSnapshot(snapshot);
 	}
 }
-
-
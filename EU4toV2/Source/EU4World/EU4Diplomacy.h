@@ -26,19 +26,21 @@ THE SOFTWARE. */
 
 
 #include "Date.h"
-#include <memory>
+#include "../Parsing/Snapshot.h"
+#include "../Parsing/Tokenizer.h"
+#include <string>
+#include <string_view>
 #include <vector>
 using namespace std;
 
 
 
-class Object;
-
-
-
 struct EU4Agreement
 {
-	EU4Agreement(shared_ptr<Object> obj);
+	EU4Agreement(std::string_view kind, parsing::Tokenizer& tokenizer);
+	explicit EU4Agreement(parsing::SnapshotReader& snapshot);
+
+	void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 	string	type;			// the type of agreement
 	string	country1;	// the first country
@@ -50,8 +52,12 @@ struct EU4Agreement
 class EU4Diplomacy
 {
 	public:
-		EU4Diplomacy();
-		EU4Diplomacy(shared_ptr<Object> obj);
+		EU4Diplomacy() = default;
+		explicit EU4Diplomacy(parsing::Tokenizer& tokenizer);
+		explicit EU4Diplomacy(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
 		vector<EU4Agreement>	getAgreements() const { return agreements; };
 	private:
 		vector<EU4Agreement>	agreements;	// all the agreements
@@ -59,4 +65,4 @@ class EU4Diplomacy
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -23,7 +23,8 @@ THE SOFTWARE. */
 #include "EU4Leader.h"
 #include "ID.h"
 #include "../Configuration.h"
-#include "Log.h"
+#include "../Parsing/ParsingHelpers.h"
+#include "../Parsing/WorkerLog.h"
 #include "ParserHelpers.h"
 
 
@@ -42,89 +43,139 @@ EU4::leader::leader(std::istream& theStream):
 	deathDate(),
 	id()
 {
-	registerKeyword(std::regex("name"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString nameString(theStream);
-			name = nameString.getString();
-		}
-	);
-	registerKeyword(std::regex("type"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString typeString(theStream);
-			type = typeString.getString();
-		}
-	);
-	registerKeyword(std::regex("female"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString unusedString(theStream);
-			female = true;
-		}
-	);
-	registerKeyword(std::regex("manuever"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theValue(theStream);
-			manuever = theValue.getInt();
-		}
-	);
-	registerKeyword(std::regex("fire"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theValue(theStream);
-			fire = theValue.getInt();
-		}
-	);
-	registerKeyword(std::regex("shock"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theValue(theStream);
-			shock = theValue.getInt();
-		}
-	);
-	registerKeyword(std::regex("siege"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theValue(theStream);
-			siege = theValue.getInt();
-		}
-	);
-	registerKeyword(std::regex("country"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString countryString(theStream);
-			country = countryString.getString();
-		}
-	);
-	registerKeyword(std::regex("personality"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString personalityString(theStream);
-			personality = personalityString.getString();
-		}
-	);
-	registerKeyword(std::regex("activation"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString dateString(theStream);
-			date anActivationDate(dateString.getString());
-			activationDate = anActivationDate;
-		}
-	);
-	registerKeyword(std::regex("death_date"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleString dateString(theStream);
-			date aDeathDate(dateString.getString());
-			deathDate = aDeathDate;
-		}
-	);
-	registerKeyword(std::regex("id"), [this](const std::string& unused, std::istream& theStream)
-		{
-			ID theID(theStream);
-			id = theID.getIDNum();
-		}
-	);
-	registerKeyword(std::regex("monarch_id"), [this](const std::string& unused, std::istream& theStream)
-		{
-			ID theID(theStream);
-			monarchID = theID.getIDNum();
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+}
+
+
+EU4::leader::leader(parsing::Tokenizer& tokenizer):
+	name(),
+	type(),
+	female(false),
+	fire(0),
+	shock(0),
+	manuever(0),
+	siege(0),
+	country(),
+	personality(),
+	activationDate(),
+	deathDate(),
+	id()
+{
+	getKeywords().parse(*this, tokenizer);
+}
+
+
+const parsing::KeywordTable<EU4::leader>& EU4::leader::getKeywords()
+{
+	static const parsing::KeywordTable<leader> keywords({
+		{ "name", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.name = parsing::getString(tokenizer);
+			}
+		},
+		{ "type", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.type = parsing::getString(tokenizer);
+			}
+		},
+		{ "female", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				parsing::getString(tokenizer);
+				theLeader.female = true;
+			}
+		},
+		{ "manuever", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.manuever = parsing::getInt(tokenizer);
+			}
+		},
+		{ "fire", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.fire = parsing::getInt(tokenizer);
+			}
+		},
+		{ "shock", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.shock = parsing::getInt(tokenizer);
+			}
+		},
+		{ "siege", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.siege = parsing::getInt(tokenizer);
+			}
+		},
+		{ "country", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.country = parsing::getString(tokenizer);
+			}
+		},
+		{ "personality", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.personality = parsing::getString(tokenizer);
+			}
+		},
+		{ "activation", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.activationDate = parsing::getDate(tokenizer);
+			}
+		},
+		{ "death_date", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theLeader.deathDate = parsing::getDate(tokenizer);
+			}
+		},
+		{ "id", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				ID theID(tokenizer);
+				theLeader.id = theID.getIDNum();
+			}
+		},
+		{ "monarch_id", [](leader& theLeader, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				ID theID(tokenizer);
+				theLeader.monarchID = theID.getIDNum();
+			}
 		}
-	);
-	registerKeyword(std::regex("dynasty"), commonItems::ignoreString);
+	});
+	return keywords;
+}
 
-	parseStream(theStream);
+
+EU4::leader::leader(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(name);
+	snapshot.read(type);
+	snapshot.read(female);
+	snapshot.read(fire);
+	snapshot.read(shock);
+	snapshot.read(manuever);
+	snapshot.read(siege);
+	snapshot.read(country);
+	snapshot.read(personality);
+	snapshot.read(activationDate);
+	snapshot.read(deathDate);
+	snapshot.read(id);
+	snapshot.read(monarchID);
+}
+
+
+void EU4::leader::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(name);
+	snapshot.write(type);
+	snapshot.write(female);
+	snapshot.write(fire);
+	snapshot.write(shock);
+	snapshot.write(manuever);
+	snapshot.write(siege);
+	snapshot.write(country);
+	snapshot.write(personality);
+	snapshot.write(activationDate);
+	snapshot.write(deathDate);
+	snapshot.write(id);
+	snapshot.write(monarchID);
 }
 
 
@@ -140,7 +191,7 @@ bool EU4::leader::isLand() const
 	}
 	else
 	{
-		LOG(LogLevel::Warning) << "Unknown leader type " << type;
+		WORKER_LOG(LogLevel::Warning) << "Unknown leader type " << type;
 		return false;
 	}
 }
@@ -148,7 +199,7 @@ bool EU4::leader::isLand() const
 
 bool EU4::leader::isAlive() const
 {
-	if (deathDate < theConfiguration.getLastEU4Date())
+	if (deathDate < theConfiguration().getLastEU4Date())
 	{
 		return false;
 	}
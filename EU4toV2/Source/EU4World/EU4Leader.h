@@ -26,16 +26,22 @@ THE SOFTWARE. */
 
 
 #include "Date.h"
-#include "newParser.h"
+#include "../Parsing/KeywordTable.h"
+#include "../Parsing/Snapshot.h"
+#include <istream>
 
 
 
 namespace EU4
 {
-	class leader: commonItems::parser
+	class leader
 	{
 		public:
 			leader(std::istream& theStream);
+			leader(parsing::Tokenizer& tokenizer);
+			explicit leader(parsing::SnapshotReader& snapshot);
+
+			void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 			std::string getName() const { return name; }
 			int getFire() const { return fire; }
@@ -49,6 +55,8 @@ namespace EU4
 			bool isAlive() const;
 
 		private:
+			static const parsing::KeywordTable<leader>& getKeywords();
+
 			std::string name;
 			std::string type;
 			bool female;
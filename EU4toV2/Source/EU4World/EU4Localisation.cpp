@@ -22,7 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "EU4Localisation.h"
-#include <fstream>
+#include "../Parsing/MappedFile.h"
+#include "../Parsing/WorkerLog.h"
+#include <memory>
 #include <vector>
 #include <set>
 #include "OSCompatibilityLayer.h"
@@ -30,48 +32,126 @@ using namespace std;
 
 
 
-void EU4Localisation::ReadFromFile(const std::string& fileName)
+EU4Localisation::EU4Localisation(parsing::SnapshotReader& snapshot)
 {
-	std::ifstream in(fileName);
+	const auto keyCount = snapshot.readCount();
+	localisations.reserve(keyCount);
+	for (auto count = keyCount; count > 0; count--)
+	{
+		auto key = snapshot.read<std::string>();
+		snapshot.read(localisations[std::move(key)]);
+	}
+}
+
+void EU4Localisation::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(localisations.size());
+	for (const auto& localisation: localisations)
+	{
+		snapshot.write(localisation.first);
+		snapshot.write(localisation.second);
+	}
+}
+
+void EU4Localisation::ReadFromFile(const std::string& fileName, const KeyFilter& keepKey)
+{
+	AddLocalisations(ReadLocalisations(fileName, keepKey));
+}
+
+void EU4Localisation::ReadFromAllFilesInFolder(const std::string& folderPath, const KeyFilter& keepKey)
+{
+	// Get all files in the folder.
+	set<string> fileNames;
+	Utils::GetAllFilesInFolder(folderPath, fileNames);
+
+	// Read all these files.
+	std::vector<std::string> filePaths;
+	for (const auto& fileName : fileNames)
+	{
+		filePaths.push_back(folderPath + '/' + fileName);
+	}
+	ReadFromFiles(filePaths, keepKey);
+}
+
+void EU4Localisation::ReadFromFiles(const std::vector<std::string>& fileNames, const KeyFilter& keepKey, parsing::WorkerPool& pool)
+{
+	// Each file is read on its own, and what it kept is added in the order the files were given,
+	// so later files replace earlier ones whatever order they finish in.
+	struct FileResult
+	{
+		FileLocalisations localisations;
+		std::vector<parsing::LogMessage> messages;
+	};
+
+	std::vector<std::future<FileResult>> results;
+	for (const auto& fileName : fileNames)
+	{
+		results.push_back(pool.submit([&fileName, &keepKey]() {
+			parsing::LogCapture log;
+			FileResult result;
+			result.localisations = ReadLocalisations(fileName, keepKey);
+			result.messages = log.takeMessages();
+			return result;
+		}));
+	}
 
-	const int maxLineLength = 10000;	// the maximum line length
-	char line[maxLineLength];			// the line being processed
+	// all of them, so that on an error none is still reading from fileNames
+	pool.waitAll(results);
+	for (auto& result : results)
+	{
+		const auto fileResult = result.get();
+		parsing::replayLog(fileResult.messages);
+		AddLocalisations(fileResult.localisations);
+	}
+}
+
+EU4Localisation::FileLocalisations EU4Localisation::ReadLocalisations(const std::string& fileName, const KeyFilter& keepKey)
+{
+	FileLocalisations fileLocalisations;
+
+	std::unique_ptr<parsing::MappedFile> file;
+	try
+	{
+		file = std::make_unique<parsing::MappedFile>(fileName);
+	}
+	catch (const std::runtime_error& e)
+	{
+		WORKER_LOG(LogLevel::Warning) << e.what();
+		return fileLocalisations;
+	}
+	const auto contents = file->getContents();
 
 	// First line is the language like "l_english:"
-	in.getline(line, maxLineLength);
-	std::string language = DetermineLanguageForFile(RemoveUTF8BOM(line));
+	auto lineEnd = contents.find('\n');
+	const auto language = DetermineLanguageForFile(RemoveUTF8BOM(contents.substr(0, lineEnd)));
 	if (language.empty())
 	{
-		return;
+		return fileLocalisations;
 	}
+	fileLocalisations.language = language;
 
 	// Subsequent lines are 'KEY: "Text"'
-	while (!in.eof())
+	while (lineEnd != std::string_view::npos)
 	{
-		in.getline(line, maxLineLength);
-		if (!in.eof())
+		const auto lineBegin = lineEnd + 1;
+		lineEnd = contents.find('\n', lineBegin);
+		const auto keyLocalisationPair = DetermineKeyLocalisationPair(RemoveUTF8BOM(contents.substr(lineBegin, lineEnd - lineBegin)));	// the localisation pair
+		const auto key = keyLocalisationPair.first;									// the key from the pair
+		const auto currentLocalisation = keyLocalisationPair.second;			// the localisation from the pair
+		if (!key.empty() && !currentLocalisation.empty() && (!keepKey || keepKey(key)))
 		{
-			const auto keyLocalisationPair = DetermineKeyLocalisationPair(RemoveUTF8BOM(line));		// the localisation pair
-			const std::string& key = keyLocalisationPair.first;												// the key from the pair
-			const std::string& currentLocalisation = keyLocalisationPair.second;							// the localisation from the pair
-			if (!key.empty() && !currentLocalisation.empty())
-			{
-				localisations[key][language] = currentLocalisation;
-			}
+			fileLocalisations.texts.emplace_back(key, currentLocalisation);
 		}
 	}
+
+	return fileLocalisations;
 }
 
-void EU4Localisation::ReadFromAllFilesInFolder(const std::string& folderPath)
+void EU4Localisation::AddLocalisations(const FileLocalisations& fileLocalisations)
 {
-	// Get all files in the folder.
-	set<string> fileNames;
-	Utils::GetAllFilesInFolder(folderPath, fileNames);
-
-	// Read all these files.
-	for (const auto& fileName : fileNames)
+	for (const auto& text : fileLocalisations.texts)
 	{
-		ReadFromFile(folderPath + '/' + fileName);
+		localisations[text.first][fileLocalisations.language] = text.second;
 	}
 }
 
@@ -107,9 +187,9 @@ const std::map<std::string, std::string>& EU4Localisation::GetTextInEachLanguage
 	return keyFindIter->second;
 }
 
-std::string EU4Localisation::DetermineLanguageForFile(const std::string& text)
+std::string_view EU4Localisation::DetermineLanguageForFile(std::string_view text)
 {
-	static const std::string noLanguageIndicated = "";	// used when no language is indicated
+	static const std::string_view noLanguageIndicated = "";	// used when no language is indicated
 
 	if (text.size() < 2 || text[0] != 'l' || text[1] != '_')
 	{	// Not in the desired format - no "l_"
@@ -125,9 +205,9 @@ std::string EU4Localisation::DetermineLanguageForFile(const std::string& text)
 	return text.substr(beginPos, endPos - beginPos);
 }
 
-std::pair<std::string, std::string> EU4Localisation::DetermineKeyLocalisationPair(const std::string& text)
+std::pair<std::string_view, std::string_view> EU4Localisation::DetermineKeyLocalisationPair(std::string_view text)
 {
-	static const std::pair<std::string, std::string> noLocalisationPair;	// used when there's no localisation pair
+	static const std::pair<std::string_view, std::string_view> noLocalisationPair;	// used when there's no localisation pair
 
 	size_t keyBeginPos = text.find_first_not_of(' ');	// the first non-space character
 	if (keyBeginPos == std::string::npos)
@@ -145,7 +225,7 @@ std::pair<std::string, std::string> EU4Localisation::DetermineKeyLocalisationPai
 	return std::make_pair(text.substr(keyBeginPos, keyEndPos - keyBeginPos), text.substr(localisationBeginPos, localisationEndPos - localisationBeginPos));
 }
 
-std::string EU4Localisation::RemoveUTF8BOM(const std::string& text)
+std::string_view EU4Localisation::RemoveUTF8BOM(std::string_view text)
 {
 	if (text.size() >= 3 && text[0] == '\xEF' && text[1] == '\xBB' && text[2] == '\xBF')
 	{
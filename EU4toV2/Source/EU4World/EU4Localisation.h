@@ -24,21 +24,44 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #ifndef EU4LOCALISATION_H_
 #define EU4LOCALISATION_H_
 
+#include "../Parsing/Snapshot.h"
+#include "../Parsing/WorkerPool.h"
+#include <functional>
 #include <map>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 // Holds a map from key to localised text for all languages in which 
 // the localisation is provided.
 class EU4Localisation
 {
 public:
+	EU4Localisation() = default;
+	explicit EU4Localisation(parsing::SnapshotReader& snapshot);
+
+	void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
+	// Decides which keys are kept. Texts for any other key are skipped as the files are read, so
+	// they're never stored. It may be called from several threads at once. An empty filter keeps
+	// every key.
+	typedef std::function<bool(std::string_view key)> KeyFilter;
+
 	// Adds all localisations found in the specified file. The file should begin with
 	// a line like "l_english:" to indicate what language the texts are in.
-	void ReadFromFile(const std::string& fileName);
+	void ReadFromFile(const std::string& fileName, const KeyFilter& keepKey = {});
 	// Adds all localisations found in files in the specified folder as per ReadFromFile().
-	void ReadFromAllFilesInFolder(const std::string& folderPath);
+	void ReadFromAllFilesInFolder(const std::string& folderPath, const KeyFilter& keepKey = {});
+	// Adds all localisations found in the specified files as per ReadFromFile(). The files are
+	// read several at a time, but texts from later files replace those from earlier ones just
+	// as if they had been read one after another.
+	void ReadFromFiles(
+		const std::vector<std::string>& fileNames,
+		const KeyFilter& keepKey = {},
+		parsing::WorkerPool& pool = parsing::WorkerPool::shared()
+	);
 
 	// Returns the localised text for the given key in the specified language. Returns
 	// an empty string if no such localisation is available.
@@ -48,16 +71,27 @@ public:
 	const std::map<std::string, std::string>& GetTextInEachLanguage(const std::string& key) const;
 
 private:
+	// The texts kept from one file, in the order the file has them.
+	struct FileLocalisations
+	{
+		std::string language;
+		std::vector<std::pair<std::string, std::string>> texts;
+	};
+
+	// Reads the kept texts from the file's contents, without otherwise copying them.
+	static FileLocalisations ReadLocalisations(const std::string& fileName, const KeyFilter& keepKey);
+	void AddLocalisations(const FileLocalisations& fileLocalisations);
+
 	// Returns the language name from text in the form "l_english:". Returns an empty string
 	// if the text doesn't fit this format.
-	static std::string DetermineLanguageForFile(const std::string& text);
+	static std::string_view DetermineLanguageForFile(std::string_view text);
 	// Returns the localisation from text in the form 'KEY: "Localisation"'. Returns a pair
 	// with empty strings if the text doesn't fit this format. Additional spaces around the
 	// elements can be included and are ignored.
-	static std::pair<std::string, std::string> DetermineKeyLocalisationPair(const std::string& text);
+	static std::pair<std::string_view, std::string_view> DetermineKeyLocalisationPair(std::string_view text);
 	// Removes a UTF-8 BOM from the beginning of the text, if present. (These are added by the
 	// CK2-EU4 converter.)
-	static std::string RemoveUTF8BOM(const std::string& text);
+	static std::string_view RemoveUTF8BOM(std::string_view text);
 
 	typedef std::map<std::string, std::string> LanguageToLocalisationMap;
 	typedef std::unordered_map<std::string, LanguageToLocalisationMap> KeyToLocalisationsMap;
@@ -46,3 +46,25 @@ EU4Relations::EU4Relations(shared_ptr<Object> obj)
 	vector<shared_ptr<Object>> sumObj = obj->getValue("cached_sum");	// the object holding the relationship value in newer saves
 	(sumObj.size() > 0) ? value = atoi(sumObj[0]->getLeaf().c_str()) : value = 0;
 }
+
+
+EU4Relations::EU4Relations(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(tag);
+	snapshot.read(value);
+	snapshot.read(military_access);
+	snapshot.read(last_send_diplomat);
+	snapshot.read(last_war);
+	snapshot.read(attitude);
+}
+
+
+void EU4Relations::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(tag);
+	snapshot.write(value);
+	snapshot.write(military_access);
+	snapshot.write(last_send_diplomat);
+	snapshot.write(last_war);
+	snapshot.write(attitude);
+}
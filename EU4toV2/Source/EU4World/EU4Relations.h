@@ -26,6 +26,7 @@ THE SOFTWARE. */
 
 
 #include "Date.h"
+#include "../Parsing/Snapshot.h"
 #include <string>
 #include <memory>
 using namespace std;
@@ -39,6 +40,10 @@ class EU4Relations
 {
 	public:
 		EU4Relations(shared_ptr<Object> obj);
+		explicit EU4Relations(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
 		string	getCountry()				const { return tag; }
 		int		getRelations()				const { return value; }
 		bool		hasMilitaryAccess()		const { return military_access; }
@@ -70,6 +70,24 @@ EU4::Version::Version(std::istream& input)
 }
 
 
+EU4::Version::Version(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(firstPart);
+	snapshot.read(secondPart);
+	snapshot.read(thirdPart);
+	snapshot.read(fourthPart);
+}
+
+
+void EU4::Version::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(firstPart);
+	snapshot.write(secondPart);
+	snapshot.write(thirdPart);
+	snapshot.write(fourthPart);
+}
+
+
 bool EU4::Version::operator >= (const EU4::Version& rhs) const
 {
 	if (firstPart > rhs.firstPart)
@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "newParser.h"
+#include "../Parsing/Snapshot.h"
 #include <string>
 #include <memory>
 #include <ostream>
@@ -48,6 +49,9 @@ class Version: commonItems::parser
 
 		Version(std::string version);
 		Version(std::istream& theStream);
+		explicit Version(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		bool operator >= (const Version& rhs) const;
 		bool operator > (const Version& rhs) const;
@@ -21,6 +21,7 @@ THE SOFTWARE. */
 
 
 #include "ID.h"
+#include "../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 
 
@@ -29,18 +30,33 @@ EU4::ID::ID(std::istream& theStream):
 	IDNum(),
 	type()
 {
-	registerKeyword(std::regex("id"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theNum(theStream);
-			IDNum = theNum.getInt();
-		}
-	);
-	registerKeyword(std::regex("type"), [this](const std::string& unused, std::istream& theStream)
-		{
-			commonItems::singleInt theNum(theStream);
-			type = theNum.getInt();
-		}
-	);
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+}
+
+
+EU4::ID::ID(parsing::Tokenizer& tokenizer):
+	IDNum(),
+	type()
+{
+	getKeywords().parse(*this, tokenizer);
+}
+
 
-	parseStream(theStream);
+const parsing::KeywordTable<EU4::ID>& EU4::ID::getKeywords()
+{
+	static const parsing::KeywordTable<ID> keywords({
+		{ "id", [](ID& theID, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theID.IDNum = parsing::getInt(tokenizer);
+			}
+		},
+		{ "type", [](ID& theID, std::string_view unused, parsing::Tokenizer& tokenizer)
+			{
+				theID.type = parsing::getInt(tokenizer);
+			}
+		}
+	});
+	return keywords;
 }
\ No newline at end of file
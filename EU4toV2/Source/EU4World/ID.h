@@ -25,20 +25,24 @@ THE SOFTWARE. */
 
 
 
-#include "newParser.h"
+#include "../Parsing/KeywordTable.h"
+#include <istream>
 
 
 
 namespace EU4
 {
-	class ID: commonItems::parser
+	class ID
 	{
 		public:
 			ID(std::istream& theStream);
+			ID(parsing::Tokenizer& tokenizer);
 
 			int getIDNum() { return IDNum; }
 
 		private:
+			static const parsing::KeywordTable<ID>& getKeywords();
+
 			int IDNum;
 			int type;
 	};
@@ -0,0 +1,73 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "MapAreaData.h"
+#include "../Parsing/ParsingHelpers.h"
+#include "../Parsing/SectionScanner.h"
+
+
+
+EU4::MapAreaData::MapAreaData(parsing::Tokenizer& tokenizer)
+{
+	for (const auto& area: parsing::getBlockSections(tokenizer))
+	{
+		parsing::Tokenizer areaTokenizer(area.text, tokenizer.getSettings());
+		for (const auto& item: parsing::getBlockSections(areaTokenizer))
+		{
+			if (item.key == "state")
+			{
+				parsing::Tokenizer stateTokenizer(item.text, tokenizer.getSettings());
+				readState(area.key, stateTokenizer);
+				break;
+			}
+		}
+	}
+}
+
+
+void EU4::MapAreaData::readState(std::string_view area, parsing::Tokenizer& tokenizer)
+{
+	for (const auto& item: parsing::getBlockSections(tokenizer))
+	{
+		if (item.key != "country_state")
+		{
+			continue;
+		}
+
+		CountryState countryState;
+		countryState.area = area;
+		parsing::Tokenizer countryStateTokenizer(item.text, tokenizer.getSettings());
+		for (const auto& assignment: parsing::getAssignments(countryStateTokenizer))
+		{
+			if (assignment.first == "country")
+			{
+				countryState.tag = assignment.second;
+			}
+			else if (assignment.first == "prosperity")
+			{
+				countryState.prosperity = parsing::toDouble(assignment.second);
+			}
+		}
+		countryStates.push_back(countryState);
+	}
+}
@@ -0,0 +1,67 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef EU4_MAP_AREA_DATA_H_
+#define EU4_MAP_AREA_DATA_H_
+
+
+
+#include "../Parsing/Tokenizer.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace EU4
+{
+
+// a country's part of the state in an area
+struct CountryState
+{
+	std::string area;
+	std::string tag;
+	double prosperity = 0.0;
+};
+
+
+// The save's map_area_data, read straight into the state each country holds in each area. Only an
+// area's first state block counts, and everything else in the areas is skipped unread.
+class MapAreaData
+{
+	public:
+		explicit MapAreaData(parsing::Tokenizer& tokenizer);
+
+		const std::vector<CountryState>& getCountryStates() const { return countryStates; }
+
+	private:
+		void readState(std::string_view area, parsing::Tokenizer& tokenizer);
+
+		std::vector<CountryState> countryStates;
+};
+
+}
+
+
+
+#endif // EU4_MAP_AREA_DATA_H_
@@ -57,4 +57,16 @@ double EU4::Modifier::getEffectAmount(const std::string& theEffect) const
 	{
 		return 0;
 	}
-}
\ No newline at end of file
+}
+
+
+EU4::Modifier::Modifier(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(effects);
+}
+
+
+void EU4::Modifier::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(effects);
+}
@@ -26,6 +26,7 @@ THE SOFTWARE. */
 
 
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 #include <map>
 #include <string>
 
@@ -45,6 +46,9 @@ class Modifier: commonItems::parser
 		Modifier& operator=(Modifier&&) = default;
 
 		Modifier(std::istream& theStream);
+		explicit Modifier(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		double getEffectAmount(const std::string& modifier) const;
 
@@ -32,6 +32,27 @@ EU4::Modifiers::Modifiers(std::istream& theStream)
 }
 
 
+EU4::Modifiers::Modifiers(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto modifierName = snapshot.read<std::string>();
+		modifiers.insert(std::make_pair(modifierName, Modifier(snapshot)));
+	}
+}
+
+
+void EU4::Modifiers::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(modifiers.size());
+	for (const auto& modifier: modifiers)
+	{
+		snapshot.write(modifier.first);
+		modifier.second.writeSnapshot(snapshot);
+	}
+}
+
+
 void EU4::Modifiers::addModifiers(std::istream& theStream)
 {
 	registerKeyword(std::regex("[a-zA-Z0-9\\_]+"), [this](const std::string& modifierName, std::istream& theStream) {
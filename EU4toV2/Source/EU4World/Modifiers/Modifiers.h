@@ -27,6 +27,7 @@ THE SOFTWARE. */
 
 #include "Modifier.h"
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 #include <map>
 #include <string>
 
@@ -39,6 +40,9 @@ class Modifiers: commonItems::parser
 {
 	public:
 		Modifiers(std::istream& theStream);
+		explicit Modifiers(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		void addModifiers(std::istream& theStream);
 
@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Mods.h"
 #include "Mod.h"
 #include "../../Configuration.h"
-#include "Log.h"
+#include "../../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include <fstream>
 #include <set>
@@ -53,7 +53,7 @@ EU4::Mods::Mods(std::istream& theStream, Configuration& theConfiguration)
 	loadSteamWorkshopDirectory(theConfiguration);
 	loadCK2ExportDirectory(theConfiguration);
 
-	Log(LogLevel::Debug) << "Finding Used Mods";
+	WORKER_LOG(LogLevel::Debug) << "Finding Used Mods";
 	for (auto usedMod: usedMods)
 	{
 		auto possibleModPath = getModPath(usedMod);
@@ -61,19 +61,19 @@ EU4::Mods::Mods(std::istream& theStream, Configuration& theConfiguration)
 		{
 			if (!Utils::doesFolderExist(*possibleModPath) && !Utils::DoesFileExist(*possibleModPath))
 			{
-				LOG(LogLevel::Error) << usedMod << " could not be found in the specified mod directory " \
+				WORKER_LOG(LogLevel::Error) << usedMod << " could not be found in the specified mod directory " \
 					"- a valid mod directory must be specified. Tried " << *possibleModPath;
 				exit(-1);
 			}
 			else
 			{
-				LOG(LogLevel::Debug) << "EU4 Mod is at " << *possibleModPath;
+				WORKER_LOG(LogLevel::Debug) << "EU4 Mod is at " << *possibleModPath;
 				theConfiguration.addEU4Mod(*possibleModPath);
 			}
 		}
 		else
 		{
-			LOG(LogLevel::Error) << "No path could be found for " << usedMod << ". Check that the mod is present and that the .mod file specifies the path for the mod";
+			WORKER_LOG(LogLevel::Error) << "No path could be found for " << usedMod << ". Check that the mod is present and that the .mod file specifies the path for the mod";
 			exit(-1);
 		}
 	}
@@ -92,7 +92,7 @@ void EU4::Mods::loadEU4ModDirectory(const Configuration& theConfiguration)
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "EU4 Documents directory is " << EU4DocumentsLoc;
+		WORKER_LOG(LogLevel::Debug) << "EU4 Documents directory is " << EU4DocumentsLoc;
 		loadModDirectory(EU4DocumentsLoc);
 	}
 }
@@ -110,7 +110,7 @@ void EU4::Mods::loadSteamWorkshopDirectory(const Configuration& theConfiguration
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "Steam Workshop directory is " << steamWorkshopPath;
+		WORKER_LOG(LogLevel::Debug) << "Steam Workshop directory is " << steamWorkshopPath;
 		std::set<std::string> subfolders;
 		Utils::GetAllSubfolders(steamWorkshopPath, subfolders);
 		for (auto subfolder: subfolders)
@@ -127,7 +127,7 @@ void EU4::Mods::loadSteamWorkshopDirectory(const Configuration& theConfiguration
 				{
 					possibleMods.insert(std::make_pair("mod/ugc_" + subfolder + ".mod", path));
 					possibleMods.insert(std::make_pair(theMod.getName(), path));
-					Log(LogLevel::Debug) << "\tFound a mod named " << theMod.getName() << " at " << path;
+					WORKER_LOG(LogLevel::Debug) << "\tFound a mod named " << theMod.getName() << " at " << path;
 				}
 			}
 		}
@@ -140,12 +140,12 @@ void EU4::Mods::loadCK2ExportDirectory(const Configuration& theConfiguration)
 	std::string CK2ExportLoc = theConfiguration.getCK2ExportPath();
 	if (!Utils::doesFolderExist(CK2ExportLoc))
 	{
-		LOG(LogLevel::Warning) << "No Crusader Kings 2 mod directory was specified in configuration.txt," \
+		WORKER_LOG(LogLevel::Warning) << "No Crusader Kings 2 mod directory was specified in configuration.txt," \
 			" or the path was invalid - this will cause problems with CK2 converted saves";
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "CK2 export directory is " << CK2ExportLoc;
+		WORKER_LOG(LogLevel::Debug) << "CK2 export directory is " << CK2ExportLoc;
 		loadModDirectory(CK2ExportLoc);
 	}
 }
@@ -190,7 +190,7 @@ void EU4::Mods::loadModDirectory(const std::string& searchDirectory)
 						possibleMods.insert(std::make_pair(theMod.getName(), recordDirectory));
 						possibleMods.insert(std::make_pair("mod/" + filename, recordDirectory));
 						possibleMods.insert(std::make_pair(trimmedFilename, recordDirectory));
-						Log(LogLevel::Debug) << "\tFound a mod named " << theMod.getName() <<
+						WORKER_LOG(LogLevel::Debug) << "\tFound a mod named " << theMod.getName() <<
 							" with a mod file at " << searchDirectory << "/mod/" + filename <<
 							" and itself at " << recordDirectory;
 					}
@@ -216,7 +216,7 @@ void EU4::Mods::loadModDirectory(const std::string& searchDirectory)
 						possibleCompressedMods.insert(std::make_pair(theMod.getName(), recordDirectory));
 						possibleCompressedMods.insert(std::make_pair("mod/" + filename, recordDirectory));
 						possibleCompressedMods.insert(std::make_pair(trimmedFilename, recordDirectory));
-						Log(LogLevel::Debug) << "\tFound a compessed mod named " << theMod.getName() <<
+						WORKER_LOG(LogLevel::Debug) << "\tFound a compessed mod named " << theMod.getName() <<
 							" with a mod file at " << searchDirectory << "/mod/" + filename <<
 							" and itself at " << recordDirectory;
 					}
@@ -224,7 +224,7 @@ void EU4::Mods::loadModDirectory(const std::string& searchDirectory)
 			}
 			catch (std::exception e)
 			{
-				LOG(LogLevel::Warning) << "Error while reading " << searchDirectory << "/mod/" << filename << ". " \
+				WORKER_LOG(LogLevel::Warning) << "Error while reading " << searchDirectory << "/mod/" << filename << ". " \
 					"Mod will not be useable for conversions.";
 			}
 		}
@@ -262,9 +262,9 @@ std::optional<std::string> EU4::Mods::getModPath(const std::string& modName) con
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "For now, manually uncompress " << archivePath << \
+			WORKER_LOG(LogLevel::Warning) << "For now, manually uncompress " << archivePath << \
 				" into the converter directory at EU4ToVic2/mods/" << uncompressedName;
-			LOG(LogLevel::Warning) << "Then run the converter again";
+			WORKER_LOG(LogLevel::Warning) << "Then run the converter again";
 		}
 	}
 
@@ -21,6 +21,7 @@ THE SOFTWARE. */
 
 
 #include "DateItem.h"
+#include "../../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 
 
@@ -51,4 +52,29 @@ EU4::DateItem::DateItem(const std::string& dateString, const std::string& typeSt
 	{
 		commonItems::ignoreItem(typeString, theStream);
 	}
+}
+
+
+EU4::DateItem::DateItem(const date& _theDate, std::string_view typeString, parsing::Tokenizer& tokenizer):
+	theDate(_theDate)
+{
+	if (typeString == "owner")
+	{
+		type = DateItemType::OWNER_CHANGE;
+		data = parsing::getString(tokenizer);
+	}
+	else if (typeString == "culture")
+	{
+		type = DateItemType::CULTURE_CHANGE;
+		data = parsing::getString(tokenizer);
+	}
+	else if (typeString == "religion")
+	{
+		type = DateItemType::RELIGION_CHANGE;
+		data = parsing::getString(tokenizer);
+	}
+	else
+	{
+		parsing::ignoreItem(typeString, tokenizer);
+	}
 }
\ No newline at end of file
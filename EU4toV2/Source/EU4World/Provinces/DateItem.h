@@ -25,8 +25,10 @@ THE SOFTWARE. */
 
 
 #include "Date.h"
-#include "newParser.h"
+#include "../../Parsing/Tokenizer.h"
+#include <istream>
 #include <string>
+#include <string_view>
 
 
 
@@ -42,10 +44,11 @@ enum class DateItemType
 };
 
 
-class DateItem: commonItems::parser
+class DateItem
 {
 	public:
 		DateItem(const std::string& dateString, const std::string& typeString, std::istream& theStream);
+		DateItem(const date& _theDate, std::string_view typeString, parsing::Tokenizer& tokenizer);
 
 		DateItemType getType() const { return type; }
 		date getDate() const { return theDate; }
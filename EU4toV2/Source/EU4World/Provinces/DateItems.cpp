@@ -21,15 +21,34 @@ THE SOFTWARE. */
 
 
 #include "DateItems.h"
+#include "../../Parsing/ParsingHelpers.h"
+#include "ParserHelpers.h"
 
 
 
 EU4::DateItems::DateItems(const std::string& dateString, std::istream& theStream)
 {
-	registerKeyword(std::regex("[a-zA-Z0-9_]+"), [this, dateString](const std::string& typeString, std::istream& theStream) {
-		DateItem newItem(dateString, typeString, theStream);
-		items.push_back(newItem);
-	});
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer, date(dateString));
+}
 
-	parseStream(theStream);
+
+EU4::DateItems::DateItems(const date& theDate, parsing::Tokenizer& tokenizer)
+{
+	getKeywords().parse(*this, tokenizer, theDate);
+}
+
+
+const parsing::KeywordTable<EU4::DateItems, const date&>& EU4::DateItems::getKeywords()
+{
+	static const parsing::KeywordTable<DateItems, const date&> keywords(
+		{},
+		{
+			{ parsing::isIdentifier, [](DateItems& dateItems, std::string_view typeString, parsing::Tokenizer& tokenizer, const date& theDate) {
+				dateItems.items.emplace_back(theDate, typeString, tokenizer);
+			}}
+		}
+	);
+	return keywords;
 }
\ No newline at end of file
@@ -27,7 +27,8 @@ THE SOFTWARE. */
 
 #include "DateItem.h"
 #include "Date.h"
-#include "newParser.h"
+#include "../../Parsing/KeywordTable.h"
+#include <istream>
 #include <vector>
 
 
@@ -35,14 +36,17 @@ THE SOFTWARE. */
 namespace EU4
 {
 
-class DateItems: commonItems::parser
+class DateItems
 {
 	public:
 		DateItems(const std::string& dateString, std::istream& theStream);
+		DateItems(const date& theDate, parsing::Tokenizer& tokenizer);
 
-		std::vector<DateItem> getItems() const { return items;  }
+		const std::vector<DateItem>& getItems() const { return items; }
 
 	private:
+		static const parsing::KeywordTable<DateItems, const date&>& getKeywords();
+
 		std::vector<DateItem> items;
 };
 
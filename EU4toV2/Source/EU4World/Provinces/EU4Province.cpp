@@ -24,7 +24,9 @@ THE SOFTWARE. */
 #include "ProvinceModifier.h"
 #include "../EU4Country.h"
 #include "../Religions/Religions.h"
-#include "Log.h"
+#include "../../Parsing/BufferParser.h"
+#include "../../Parsing/ParsingHelpers.h"
+#include "../../Parsing/WorkerLog.h"
 #include "ParserHelpers.h"
 #include "../../Configuration.h"
 #include <algorithm>
@@ -45,97 +47,213 @@ EU4::Province::Province(
 	const Buildings& buildingTypes,
 	const Modifiers& modifierTypes
 ) {
-	registerKeyword(std::regex("name"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString nameString(theStream);
-		name = nameString.getString();
-	});
-	registerKeyword(std::regex("base_tax"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble baseTaxDouble(theStream);
-		baseTax = baseTaxDouble.getDouble();
-	});
-	registerKeyword(std::regex("base_production"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble baseProductionDouble(theStream);
-		baseProduction = baseProductionDouble.getDouble();
-	});
-	registerKeyword(std::regex("base_manpower"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble manpowerDouble(theStream);
-		manpower = manpowerDouble.getDouble();
-	});
-	registerKeyword(std::regex("manpower"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble manpowerDouble(theStream);
-		manpower = manpowerDouble.getDouble();
-	});
-	registerKeyword(std::regex("owner"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString ownerStringString(theStream);
-		ownerString = ownerStringString.getString();
-	});
-	registerKeyword(std::regex("controller"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString controllerStringString(theStream);
-		controllerString = controllerStringString.getString();
-	});
-	registerKeyword(std::regex("cores"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::stringList coresStrings(theStream);
-		for (auto coreString : coresStrings.getStrings())
-		{
-			cores.insert(coreString);
-		}
-	});
-	registerKeyword(std::regex("core"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString coresString(theStream);
-		cores.insert(coresString.getString());
-	});
-    registerKeyword(std::regex("territorial_core"),[this](const std::string& unused, std::istream& theStream) {
-        commonItems::ignoreItem(unused, theStream);
-        territorialCore = true;
-    });
-	registerKeyword(std::regex("hre"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString hreString(theStream);
-		if (hreString.getString() == "yes")
-		{
-			inHRE = true;
-		}
-	});
-	registerKeyword(std::regex("is_city"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString cityString(theStream);
-		if (cityString.getString() == "yes")
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+	finishProvince(numString, buildingTypes, modifierTypes);
+}
+
+
+EU4::Province::Province(
+	std::string_view numString,
+	parsing::Tokenizer& tokenizer,
+	const Buildings& buildingTypes,
+	const Modifiers& modifierTypes
+) {
+	getKeywords().parse(*this, tokenizer);
+	finishProvince(numString, buildingTypes, modifierTypes);
+}
+
+
+const parsing::KeywordTable<EU4::Province>& EU4::Province::getKeywords()
+{
+	static const parsing::KeywordTable<Province> keywords(
 		{
-			city = true;
+			{ "name", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.name = parsing::getString(tokenizer);
+			}},
+			{ "base_tax", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.baseTax = parsing::getDouble(tokenizer);
+			}},
+			{ "base_production", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.baseProduction = parsing::getDouble(tokenizer);
+			}},
+			{ "base_manpower", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.manpower = parsing::getDouble(tokenizer);
+			}},
+			{ "manpower", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.manpower = parsing::getDouble(tokenizer);
+			}},
+			{ "owner", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.owner = parsing::TagSymbol(parsing::getString(tokenizer));
+			}},
+			{ "controller", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.controller = parsing::TagSymbol(parsing::getString(tokenizer));
+			}},
+			{ "cores", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				for (const auto& core: parsing::getStrings(tokenizer))
+				{
+					province.cores.insert(parsing::TagSymbol(core));
+				}
+			}},
+			{ "core", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.cores.emplace(parsing::getString(tokenizer));
+			}},
+			{ "territorial_core", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				tokenizer.getItemText();
+				province.territorialCore = true;
+			}},
+			{ "hre", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				if (parsing::getString(tokenizer) == "yes")
+				{
+					province.inHRE = true;
+				}
+			}},
+			{ "is_city", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				if (parsing::getString(tokenizer) == "yes")
+				{
+					province.city = true;
+				}
+			}},
+			{ "colonysize", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				tokenizer.getItemText();
+				province.colony = true;
+			}},
+			{ "original_coloniser", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				tokenizer.getItemText();
+				province.hadOriginalColoniser = true;
+			}},
+			{ "history", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.provinceHistory = parsing::makeArenaPtr<ProvinceHistory>(tokenizer);
+			}},
+			{ "buildings", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.buildings = parsing::makeArenaPtr<ProvinceBuildings>(tokenizer);
+			}},
+			{ "great_projects", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				parsing::readFromStream(tokenizer, [&province](std::istream& theStream) {
+					province.greatProjects = parsing::makeArenaPtr<GreatProjects>(theStream);
+				});
+			}},
+			{ "modifier", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				ProvinceModifier modifier(tokenizer);
+				province.modifiers.insert(modifier.getModifier());
+			}},
+			{ "trade_goods", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.tradeGoods = parsing::getString(tokenizer);
+			}},
+			{ "center_of_trade", [](Province& province, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				province.centerOfTradeLevel = parsing::getInt(tokenizer);
+			}}
 		}
-	});
-	registerKeyword(std::regex("colonysize"), [this](const std::string & unused, std::istream & theStream) {
-		commonItems::ignoreItem(unused, theStream);
-		colony = true;
-	});
-	registerKeyword(std::regex("original_coloniser"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::ignoreItem(unused, theStream);
-		hadOriginalColoniser = true;
-	});
-	registerKeyword(std::regex("history"), [this](const std::string& unused, std::istream& theStream) {
-		provinceHistory = std::make_unique<ProvinceHistory>(theStream);
-	});
-	registerKeyword(std::regex("buildings"), [this](const std::string& unused, std::istream& theStream) {
-		buildings = std::make_unique<ProvinceBuildings>(theStream);
-	});
-	registerKeyword(std::regex("great_projects"), [this](const std::string& unused, std::istream& theStream) {
-		greatProjects = std::make_unique<GreatProjects>(theStream);
-	});
-	registerKeyword(std::regex("modifier"), [this](const std::string& unused, std::istream& theStream) {
-		ProvinceModifier modifier(theStream);
-		modifiers.insert(modifier.getModifier());
-	});
-	registerKeyword(std::regex("trade_goods"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleString tradeGoodsString(theStream);
-		tradeGoods = tradeGoodsString.getString();
-	});
-	registerKeyword(std::regex("center_of_trade"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleInt cotLevelInt(theStream);
-		centerOfTradeLevel = cotLevelInt.getInt();
-	});
-	registerKeyword(std::regex("[a-zA-Z0-9_]+"), commonItems::ignoreItem);
-
-	parseStream(theStream);
-
-	num = 0 - stoi(numString);
+	);
+	return keywords;
+}
+
+
+EU4::Province::Province(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(num);
+	snapshot.read(name);
+	owner = parsing::TagSymbol(snapshot.read<std::string>());
+	controller = parsing::TagSymbol(snapshot.read<std::string>());
+	for (const auto& core: snapshot.read<std::vector<std::string>>())
+	{
+		cores.emplace(core);
+	}
+	snapshot.read(inHRE);
+	snapshot.read(colony);
+	snapshot.read(hadOriginalColoniser);
+	snapshot.read(territorialCore);
+	snapshot.read(city);
+
+	provinceHistory = parsing::makeArenaPtr<ProvinceHistory>(snapshot);
+	if (snapshot.read<bool>())
+	{
+		buildings = parsing::makeArenaPtr<ProvinceBuildings>(snapshot);
+	}
+	if (snapshot.read<bool>())
+	{
+		greatProjects = parsing::makeArenaPtr<GreatProjects>(snapshot);
+	}
+	snapshot.read(modifiers);
+
+	snapshot.read(baseTax);
+	snapshot.read(baseProduction);
+	snapshot.read(manpower);
+	snapshot.read(totalWeight);
+	snapshot.read(tradeGoods);
+	snapshot.read(areaName);
+	snapshot.read(taxIncome);
+	snapshot.read(productionIncome);
+	snapshot.read(manpowerWeight);
+	snapshot.read(buildingWeight);
+	snapshot.read(devModifier);
+	snapshot.read(devDelta);
+	snapshot.read(modifierWeight);
+	snapshot.read(devbonus);
+	snapshot.read(tradeSteering);
+	snapshot.read(centerOfTradeLevel);
+	provinceStats = ProvinceStats(snapshot);
+	snapshot.read(prosperity);
+	snapshot.read(stated);
+}
+
+
+void EU4::Province::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(num);
+	snapshot.write(name);
+	snapshot.write(owner.getName());
+	snapshot.write(controller.getName());
+	snapshot.writeCount(cores.size());
+	for (const auto& core: cores)
+	{
+		snapshot.write(core.getName());
+	}
+	snapshot.write(inHRE);
+	snapshot.write(colony);
+	snapshot.write(hadOriginalColoniser);
+	snapshot.write(territorialCore);
+	snapshot.write(city);
+
+	provinceHistory->writeSnapshot(snapshot);
+	snapshot.write(buildings != nullptr);
+	if (buildings)
+	{
+		buildings->writeSnapshot(snapshot);
+	}
+	snapshot.write(greatProjects != nullptr);
+	if (greatProjects)
+	{
+		greatProjects->writeSnapshot(snapshot);
+	}
+	snapshot.write(modifiers);
+
+	snapshot.write(baseTax);
+	snapshot.write(baseProduction);
+	snapshot.write(manpower);
+	snapshot.write(totalWeight);
+	snapshot.write(tradeGoods);
+	snapshot.write(areaName);
+	snapshot.write(taxIncome);
+	snapshot.write(productionIncome);
+	snapshot.write(manpowerWeight);
+	snapshot.write(buildingWeight);
+	snapshot.write(devModifier);
+	snapshot.write(devDelta);
+	snapshot.write(modifierWeight);
+	snapshot.write(devbonus);
+	snapshot.write(tradeSteering);
+	snapshot.write(centerOfTradeLevel);
+	provinceStats.writeSnapshot(snapshot);
+	snapshot.write(prosperity);
+	snapshot.write(stated);
+}
+
+
+void EU4::Province::finishProvince(std::string_view numString, const Buildings& buildingTypes, const Modifiers& modifierTypes)
+{
+	num = 0 - parsing::toInt(numString);
 
 	// for old versions of EU4 (< 1.12), copy tax to production if necessary
 	if ((baseProduction == 0.0f) && (baseTax > 0.0f))
@@ -144,8 +262,8 @@ EU4::Province::Province(
 	}
 	if (!provinceHistory)
 	{
-		std::stringstream input;
-		provinceHistory = std::make_unique<ProvinceHistory>(input);
+		parsing::Tokenizer noHistory(std::string_view{});
+		provinceHistory = parsing::makeArenaPtr<ProvinceHistory>(noHistory);
 	}
 
 	determineProvinceWeight(buildingTypes, modifierTypes);
@@ -183,13 +301,46 @@ bool EU4::Province::hasGreatProject(const std::string& greatProject) const
 }
 
 
+void EU4::Province::removeCore(const std::string& tag)
+{
+	if (const auto core = parsing::TagSymbol::find(tag))
+	{
+		cores.erase(*core);
+	}
+}
+
+
+std::set<std::string> EU4::Province::getCores() const
+{
+	std::set<std::string> coreNames;
+	for (const auto& core: cores)
+	{
+		coreNames.insert(core.getName());
+	}
+	return coreNames;
+}
+
+
+std::vector<EU4::PopRatio> EU4::Province::getPopRatios() const
+{
+	const auto& popRatios = provinceHistory->getPopRatios();
+	return std::vector<PopRatio>(popRatios.begin(), popRatios.end());
+}
+
+
 double EU4::Province::getCulturePercent(const std::string& culture) const
 {
 	double culturePercent = 0.0f;
 
-	for (auto pop: provinceHistory->getPopRatios())
+	const auto cultureSymbol = parsing::CultureSymbol::find(culture);
+	if (!cultureSymbol)
+	{
+		return culturePercent;
+	}
+
+	for (const auto& pop: provinceHistory->getPopRatios())
 	{
-		if (pop.getCulture() == culture)
+		if (pop.getCultureSymbol() == *cultureSymbol)
 		{
 			culturePercent += pop.getLowerRatio();
 		}
@@ -258,14 +409,14 @@ void EU4::Province::determineProvinceWeight(const Buildings& buildingTypes, cons
 	//manpower_weight += manpowerModifier;
 	manpower_weight *= ((1 + manpowerModifier) / 25); // should work now as intended
 
-	//LOG(LogLevel::Info) << "Manpower Weight: " << manpower_weight;
+	//WORKER_LOG(LogLevel::Info) << "Manpower Weight: " << manpower_weight;
 
 	double total_tx = (baseTax * (1 + taxModifier + 0.65) + taxEfficiency * (1 + taxModifier + 0.15));
 	double production_eff_tech = 0.2; // used to be 1.0
 
 	double total_trade_value = ((getTradeGoodPrice() * goodsProduced) + tradeValue) * (1 + tradeEfficiency);
 	double production_income = total_trade_value * (1 + production_eff_tech + productionEfficiency + 0.8);
-	//LOG(LogLevel::Info) << "province name: " << this->getProvName() 
+	//WORKER_LOG(LogLevel::Info) << "province name: " << this->getProvName() 
 	//	<< " trade good: " << tradeGoods 
 	//	<< " Price: " << getTradeGoodPrice() 
 	//	<< " trade value: " << trade_value 
@@ -384,7 +535,7 @@ void EU4::Province::determineProvinceWeight(const Buildings& buildingTypes, cons
 		modifierWeight = (std::log10(modifierWeight) - 1) * 10;
 	}
 
-	if (ownerString == "")
+	if (owner.empty())
 	{
 		totalWeight = 0;
 		modifierWeight = 0;
@@ -433,7 +584,7 @@ double EU4::Province::getTradeGoodPrice() const
 	dyes
 	tropical_wood
 	*/
-	//LOG(LogLevel::Info) << "Trade Goods Price";
+	//WORKER_LOG(LogLevel::Info) << "Trade Goods Price";
 	double tradeGoodsPrice = 0;
 
 	if (tradeGoods == "chinaware")
@@ -670,7 +821,7 @@ EU4::BuildingWeightEffects EU4::Province::getProvBuildingWeight(
 			}
 			else
 			{
-				LOG(LogLevel::Warning) << "Could not look up information for building type " << buildingName;
+				WORKER_LOG(LogLevel::Warning) << "Could not look up information for building type " << buildingName;
 			}
 		}
 	}
@@ -762,7 +913,7 @@ EU4::BuildingWeightEffects EU4::Province::getProvBuildingWeight(
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "Could not look up information for modifier type " << modifierName;
+			WORKER_LOG(LogLevel::Warning) << "Could not look up information for modifier type " << modifierName;
 		}
 	}
 
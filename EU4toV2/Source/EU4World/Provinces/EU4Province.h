@@ -34,8 +34,13 @@ THE SOFTWARE. */
 #include "ProvinceStats.h"
 #include "../Buildings/Buildings.h"
 #include "../Modifiers/Modifiers.h"
-#include "newParser.h"
+#include "../../Parsing/Arena.h"
+#include "../../Parsing/KeywordTable.h"
+#include "../../Parsing/Snapshot.h"
+#include "../../Parsing/Symbol.h"
+#include <istream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <memory>
@@ -49,7 +54,7 @@ class Country;
 class Religions;
 
 
-class Province: commonItems::parser
+class Province
 {
 	public:
 		Province(
@@ -58,9 +63,18 @@ class Province: commonItems::parser
 			const Buildings& buildingTypes,
 			const Modifiers& modifierTypes
 		);
+		Province(
+			std::string_view numString,
+			parsing::Tokenizer& tokenizer,
+			const Buildings& buildingTypes,
+			const Modifiers& modifierTypes
+		);
+		explicit Province(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
-		void addCore(const std::string& tag) { cores.insert(tag); }
-		void removeCore(const std::string& tag) { cores.erase(tag); }
+		void addCore(const std::string& tag) { cores.insert(parsing::TagSymbol(tag)); }
+		void removeCore(const std::string& tag);
 
 		bool wasInfidelConquest(const std::string& ownerReligion, const EU4::Religions& allReligions) const;
 		bool hasBuilding(const std::string& building) const;
@@ -70,9 +84,11 @@ class Province: commonItems::parser
 		std::string getArea() const { return areaName; }
 		int getNum() const { return num; }
 		std::string getName() const { return name; }
-		std::string getOwnerString() const { return ownerString; }
-		std::string getControllerString() const { return controllerString; }
-		std::set<std::string> getCores() const { return cores; }
+		std::string getOwnerString() const { return owner.getName(); }
+		std::string getControllerString() const { return controller.getName(); }
+		std::set<std::string> getCores() const;
+		parsing::TagSymbol getOwner() const { return owner; }
+		const std::set<parsing::TagSymbol>& getCoreTags() const { return cores; }
 		bool inHre() const { return inHRE; }
 		bool isTerritorialCore() const { return territorialCore; }
 		bool isColony() const { return colony; }
@@ -80,7 +96,7 @@ class Province: commonItems::parser
 		bool isState() const { return stated; }
 		bool wasColonised() const { return hadOriginalColoniser || provinceHistory->wasColonized(); }
 		bool hasModifier(const std::string& modifierName) const { return modifiers.count(modifierName) > 0; }
-		std::vector<EU4::PopRatio> getPopRatios() const { return provinceHistory->getPopRatios(); }
+		std::vector<EU4::PopRatio> getPopRatios() const;
 		std::optional<date> getFirstOwnedDate() const { return provinceHistory->getFirstOwnedDate(); }
 
 		// getters for weight attributes
@@ -103,15 +119,17 @@ class Province: commonItems::parser
 	        void makeState(double p);
 
 	      private:
+		static const parsing::KeywordTable<Province>& getKeywords();
+		void finishProvince(std::string_view numString, const Buildings& buildingTypes, const Modifiers& modifierTypes);
 		void determineProvinceWeight(const Buildings& buildingTypes, const Modifiers& modifierTypes);
 		BuildingWeightEffects getProvBuildingWeight(const Buildings& buildingTypes, const Modifiers& modifierTypes) const;
 		double getTradeGoodPrice() const;
 
 		int num = 0;
 		std::string	name;
-		std::string ownerString;
-		std::string controllerString;
-		std::set<std::string> cores;
+		parsing::TagSymbol owner;
+		parsing::TagSymbol controller;
+		std::set<parsing::TagSymbol> cores;
 
 		bool inHRE = false;
 		bool colony = false;
@@ -119,9 +137,9 @@ class Province: commonItems::parser
 		bool territorialCore = false;
 		bool city = false;
 
-		std::unique_ptr<EU4::ProvinceHistory> provinceHistory;
-		std::unique_ptr<EU4::ProvinceBuildings> buildings;
-		std::unique_ptr<EU4::GreatProjects> greatProjects;
+		parsing::ArenaPtr<EU4::ProvinceHistory> provinceHistory;
+		parsing::ArenaPtr<EU4::ProvinceBuildings> buildings;
+		parsing::ArenaPtr<EU4::GreatProjects> greatProjects;
 		std::set<std::string> modifiers;
 
 		// province attributes for weights
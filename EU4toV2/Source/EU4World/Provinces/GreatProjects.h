@@ -26,6 +26,7 @@ THE SOFTWARE. */
 
 
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 #include <set>
 #include <string>
 
@@ -38,6 +39,9 @@ class GreatProjects : commonItems::parser
 {
 	public:
 		GreatProjects(std::istream& theStream);
+		explicit GreatProjects(parsing::SnapshotReader& snapshot) { snapshot.read(greatProjects); }
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const { snapshot.write(greatProjects); }
 
 		bool hasGreatProject(const std::string& greatProject) const { return greatProjects.count(greatProject) > 0; }
 		
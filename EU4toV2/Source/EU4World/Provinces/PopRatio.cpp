@@ -23,6 +23,26 @@ THE SOFTWARE. */
 #include "PopRatio.h"
 #include <algorithm>
 
+EU4::PopRatio::PopRatio(parsing::SnapshotReader& snapshot):
+	culture(snapshot.read<std::string>()),
+	religion(snapshot.read<std::string>())
+{
+	snapshot.read(upperRatio);
+	snapshot.read(middleRatio);
+	snapshot.read(lowerRatio);
+}
+
+
+void EU4::PopRatio::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(culture.getName());
+	snapshot.write(religion.getName());
+	snapshot.write(upperRatio);
+	snapshot.write(middleRatio);
+	snapshot.write(lowerRatio);
+}
+
+
 void EU4::PopRatio::decay(float diffInYears, const EU4::PopRatio& currentPop)
 {
 	double upperNonCurrentRatio = (1.0 - currentPop.upperRatio);
@@ -56,7 +76,7 @@ void EU4::PopRatio::convertToCulture(const std::string& _culture)
 	upperRatio = 0.5;
 	middleRatio = 0.5;
 	lowerRatio = 0.0;
-	culture = _culture;
+	culture = parsing::CultureSymbol(_culture);
 }
 
 
@@ -65,7 +85,7 @@ void EU4::PopRatio::convertToReligion(const std::string& _religion)
 	upperRatio = 0.5;
 	middleRatio = 0.5;
 	lowerRatio = 0.0;
-	religion = _religion;
+	religion = parsing::ReligionSymbol(_religion);
 }
 
 
@@ -74,6 +94,6 @@ void EU4::PopRatio::convertTo(const std::string& _culture, const std::string& _r
 	upperRatio = 0.5;
 	middleRatio = 0.5;
 	lowerRatio = 0.0;
-	culture = _culture;
-	religion = _religion;
+	culture = parsing::CultureSymbol(_culture);
+	religion = parsing::ReligionSymbol(_religion);
 }
\ No newline at end of file
@@ -26,6 +26,8 @@ THE SOFTWARE. */
 
 
 #include "Date.h"
+#include "../../Parsing/Snapshot.h"
+#include "../../Parsing/Symbol.h"
 #include <string>
 
 
@@ -40,6 +42,9 @@ class PopRatio
 		culture(_culture),
 		religion(_religion)
 	{}
+		explicit PopRatio(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		void decay(float diffInYears, const EU4::PopRatio& currentPop);
 		void increase(float diffInYears);
@@ -48,15 +53,17 @@ class PopRatio
 		void convertToReligion(const std::string& religion);
 		void convertTo(const std::string& culture, const std::string& religion);
 
-		std::string getCulture() const { return culture; }
-		std::string getReligion() const { return religion; }
+		const std::string& getCulture() const { return culture.getName(); }
+		const std::string& getReligion() const { return religion.getName(); }
+		parsing::CultureSymbol getCultureSymbol() const { return culture; }
+		parsing::ReligionSymbol getReligionSymbol() const { return religion; }
 		double getUpperRatio() const { return upperRatio; }
 		double getMiddleRatio() const { return middleRatio; }
 		double getLowerRatio() const { return lowerRatio; }
 
 	private:
-		std::string culture;
-		std::string religion;
+		parsing::CultureSymbol culture;
+		parsing::ReligionSymbol religion;
 		double upperRatio = 1.0;
 		double middleRatio = 1.0;
 		double lowerRatio = 1.0;
@@ -21,6 +21,7 @@ THE SOFTWARE. */
 
 
 #include "ProvinceBuildings.h"
+#include "../../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 
 
@@ -33,4 +34,16 @@ EU4::ProvinceBuildings::ProvinceBuildings(std::istream& theStream)
 	});
 
 	parseStream(theStream);
-}
\ No newline at end of file
+}
+
+
+EU4::ProvinceBuildings::ProvinceBuildings(parsing::Tokenizer& tokenizer)
+{
+	for (const auto& building: parsing::getAssignments(tokenizer))
+	{
+		if (parsing::isIdentifier(building.first))
+		{
+			buildings.insert(std::string(building.first));
+		}
+	}
+}
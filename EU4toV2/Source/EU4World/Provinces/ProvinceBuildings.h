@@ -26,6 +26,8 @@ THE SOFTWARE. */
 
 
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
+#include "../../Parsing/Tokenizer.h"
 #include <set>
 #include <string>
 
@@ -38,6 +40,10 @@ class ProvinceBuildings: commonItems::parser
 {
 	public:
 		ProvinceBuildings(std::istream& theStream);
+		explicit ProvinceBuildings(parsing::Tokenizer& tokenizer);
+		explicit ProvinceBuildings(parsing::SnapshotReader& snapshot) { snapshot.read(buildings); }
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const { snapshot.write(buildings); }
 
 		bool hasBuilding(const std::string& building) const { return buildings.count(building) > 0; }
 
@@ -24,12 +24,13 @@ THE SOFTWARE. */
 #include "DateItem.h"
 #include "DateItems.h"
 #include "../../Configuration.h"
-#include "Log.h"
+#include "../../Parsing/ParsingHelpers.h"
+#include "../../Parsing/WorkerLog.h"
 #include "ParserHelpers.h"
 
 
 
-const date STARTING_DATE = theConfiguration.getStartEU4Date();
+const date STARTING_DATE = theConfiguration().getStartEU4Date();
 const date HARD_ENDING_DATE("1836.1.1");
 const date FUTURE_DATE("2000.1.1");
 
@@ -37,55 +38,131 @@ const date FUTURE_DATE("2000.1.1");
 
 EU4::ProvinceHistory::ProvinceHistory(std::istream& theStream)
 {
-	std::string startingCulture;
-	std::string startingReligion;
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	getKeywords().parse(*this, tokenizer);
+	finishHistory();
+}
+
+
+EU4::ProvinceHistory::ProvinceHistory(parsing::Tokenizer& tokenizer)
+{
+	getKeywords().parse(*this, tokenizer);
+	finishHistory();
+}
+
+
+namespace
+{
+
+void writeChanges(parsing::SnapshotWriter& snapshot, const std::pmr::vector<std::pair<date, std::string>>& changes)
+{
+	snapshot.writeCount(changes.size());
+	for (const auto& change: changes)
+	{
+		snapshot.write(change.first);
+		snapshot.write(change.second);
+	}
+}
+
+
+void readChanges(parsing::SnapshotReader& snapshot, std::pmr::vector<std::pair<date, std::string>>& changes)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto changeDate = snapshot.read<date>();
+		changes.emplace_back(changeDate, snapshot.read<std::string>());
+	}
+}
+
+}
 
-	registerKeyword(std::regex("owner"), [this](const std::string& unused, std::istream & theStream) {
-		commonItems::singleString ownerString(theStream);
-		ownershipHistory.push_back(std::make_pair(STARTING_DATE, ownerString.getString()));
-	});
-	registerKeyword(std::regex("culture"), [&startingCulture](const std::string& unused, std::istream & theStream) {
-		commonItems::singleString cultureString(theStream);
-		startingCulture = cultureString.getString();
-	});
-	registerKeyword(std::regex("religion"), [&startingReligion](const std::string& unused, std::istream & theStream) {
-		commonItems::singleString religionString(theStream);
-		startingReligion = religionString.getString();
-	});
-	registerKeyword(std::regex("base_tax"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble baseTaxDouble(theStream);
-		originalTax = baseTaxDouble.getDouble();
-	});
-	registerKeyword(std::regex("base_production"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble baseProductionDouble(theStream);
-		originalProduction = baseProductionDouble.getDouble();
-	});
-	registerKeyword(std::regex("base_manpower"), [this](const std::string& unused, std::istream& theStream) {
-		commonItems::singleDouble manpowerDouble(theStream);
-		originalManpower = manpowerDouble.getDouble();
-	});
-	registerKeyword(std::regex("\\d+\\.\\d+\\.\\d+"), [this](const std::string& dateString, std::istream& theStream) {
-		DateItems theItems(dateString, theStream);
-		for (DateItem item : theItems.getItems())
+
+EU4::ProvinceHistory::ProvinceHistory(parsing::SnapshotReader& snapshot)
+{
+	readChanges(snapshot, ownershipHistory);
+	readChanges(snapshot, religionHistory);
+	readChanges(snapshot, cultureHistory);
+	snapshot.read(startingCulture);
+	snapshot.read(startingReligion);
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		popRatios.emplace_back(snapshot);
+	}
+	snapshot.read(originalTax);
+	snapshot.read(originalProduction);
+	snapshot.read(originalManpower);
+}
+
+
+void EU4::ProvinceHistory::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	writeChanges(snapshot, ownershipHistory);
+	writeChanges(snapshot, religionHistory);
+	writeChanges(snapshot, cultureHistory);
+	snapshot.write(startingCulture);
+	snapshot.write(startingReligion);
+	snapshot.writeCount(popRatios.size());
+	for (const auto& popRatio: popRatios)
+	{
+		popRatio.writeSnapshot(snapshot);
+	}
+	snapshot.write(originalTax);
+	snapshot.write(originalProduction);
+	snapshot.write(originalManpower);
+}
+
+
+const parsing::KeywordTable<EU4::ProvinceHistory>& EU4::ProvinceHistory::getKeywords()
+{
+	static const parsing::KeywordTable<ProvinceHistory> keywords(
 		{
-			if (item.getType() == DateItemType::OWNER_CHANGE)
-			{
-				ownershipHistory.push_back(std::make_pair(item.getDate(), item.getData()));
-			}
-			else if (item.getType() == DateItemType::CULTURE_CHANGE)
-			{
-				cultureHistory.push_back(std::make_pair(item.getDate(), item.getData()));
-			}
-			else if (item.getType() == DateItemType::RELIGION_CHANGE)
-			{
-				religionHistory.push_back(std::make_pair(item.getDate(), item.getData()));
-			}
+			{ "owner", [](ProvinceHistory& history, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				history.ownershipHistory.push_back(std::make_pair(STARTING_DATE, std::string(parsing::getString(tokenizer))));
+			}},
+			{ "culture", [](ProvinceHistory& history, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				history.startingCulture = parsing::getString(tokenizer);
+			}},
+			{ "religion", [](ProvinceHistory& history, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				history.startingReligion = parsing::getString(tokenizer);
+			}},
+			{ "base_tax", [](ProvinceHistory& history, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				history.originalTax = parsing::getDouble(tokenizer);
+			}},
+			{ "base_production", [](ProvinceHistory& history, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				history.originalProduction = parsing::getDouble(tokenizer);
+			}},
+			{ "base_manpower", [](ProvinceHistory& history, std::string_view unused, parsing::Tokenizer& tokenizer) {
+				history.originalManpower = parsing::getDouble(tokenizer);
+			}}
+		},
+		{
+			{ parsing::isDateKey, [](ProvinceHistory& history, std::string_view dateString, parsing::Tokenizer& tokenizer) {
+				DateItems theItems(parsing::toDate(dateString), tokenizer);
+				for (const auto& item: theItems.getItems())
+				{
+					if (item.getType() == DateItemType::OWNER_CHANGE)
+					{
+						history.ownershipHistory.push_back(std::make_pair(item.getDate(), item.getData()));
+					}
+					else if (item.getType() == DateItemType::CULTURE_CHANGE)
+					{
+						history.cultureHistory.push_back(std::make_pair(item.getDate(), item.getData()));
+					}
+					else if (item.getType() == DateItemType::RELIGION_CHANGE)
+					{
+						history.religionHistory.push_back(std::make_pair(item.getDate(), item.getData()));
+					}
+				}
+			}}
 		}
-	});
-	registerKeyword(std::regex("[a-zA-Z0-9_]+"), commonItems::ignoreItem);
+	);
+	return keywords;
+}
 
-	parseStream(theStream);
 
+void EU4::ProvinceHistory::finishHistory()
+{
 	if ((startingCulture != "") && ((cultureHistory.size() == 0) || (cultureHistory.begin()->first != STARTING_DATE)))
 	{
 		cultureHistory.insert(cultureHistory.begin(), std::make_pair(STARTING_DATE, startingCulture));
@@ -130,7 +207,7 @@ bool EU4::ProvinceHistory::wasColonized() const
 	if (
 		(ownershipHistory.size() > 0) &&
 		(ownershipHistory[0].first != STARTING_DATE) &&
-		(ownershipHistory[0].first != theConfiguration.getFirstEU4Date())
+		(ownershipHistory[0].first != theConfiguration().getFirstEU4Date())
 	) {
 		return !hasOriginalCulture();
 	}
@@ -151,7 +228,7 @@ bool EU4::ProvinceHistory::wasInfidelConquest(const Religions& allReligions, con
 		std::optional<Religion> ownerReligion = allReligions.getReligion(ownerReligionString);
 		if (!originalReligion || !ownerReligion)
 		{
-			LOG(LogLevel::Warning) << "Unhandled religion in EU4 province " << num;
+			WORKER_LOG(LogLevel::Warning) << "Unhandled religion in EU4 province " << num;
 			return true;
 		}
 		else
@@ -168,14 +245,14 @@ bool EU4::ProvinceHistory::wasInfidelConquest(const Religions& allReligions, con
 
 void EU4::ProvinceHistory::buildPopRatios()
 {
-	date endDate = theConfiguration.getLastEU4Date();
+	date endDate = theConfiguration().getLastEU4Date();
 	if (endDate > HARD_ENDING_DATE)
 	{
 		endDate = HARD_ENDING_DATE;
 	}
 
 	std::string startingCulture;
-	std::vector<std::pair<date, std::string>>::iterator cultureEvent = cultureHistory.begin();
+	auto cultureEvent = cultureHistory.begin();
 	if (cultureEvent != cultureHistory.end())
 	{
 		startingCulture = cultureEvent->second;
@@ -183,7 +260,7 @@ void EU4::ProvinceHistory::buildPopRatios()
 	}
 
 	std::string startingReligion;
-	std::vector<std::pair<date, std::string>>::iterator religionEvent = religionHistory.begin();
+	auto religionEvent = religionHistory.begin();
 	if (religionEvent != religionHistory.end())
 	{
 		startingReligion = religionEvent->second;
@@ -28,8 +28,12 @@ THE SOFTWARE. */
 #include "Date.h"
 #include "PopRatio.h"
 #include "../Religions/Religions.h"
-#include "newParser.h"
+#include "../../Parsing/Arena.h"
+#include "../../Parsing/KeywordTable.h"
+#include "../../Parsing/Snapshot.h"
+#include <istream>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 #include <string>
@@ -39,10 +43,14 @@ THE SOFTWARE. */
 namespace EU4
 {
 
-class ProvinceHistory: commonItems::parser
+class ProvinceHistory
 {
 	public:
 		ProvinceHistory(std::istream& theStream);
+		ProvinceHistory(parsing::Tokenizer& tokenizer);
+		explicit ProvinceHistory(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		std::optional<date> getFirstOwnedDate() const;
 		bool hasOriginalCulture() const;
@@ -50,17 +58,21 @@ class ProvinceHistory: commonItems::parser
 		bool wasInfidelConquest(const Religions& allReligions, const std::string& ownerReligionString, int num) const;
 		double getOriginalDevelopment() const { return originalTax + originalProduction + originalManpower; }
 
-		std::vector<PopRatio> getPopRatios() const { return popRatios; }
+		const std::pmr::vector<PopRatio>& getPopRatios() const { return popRatios; }
 
 	private:
+		static const parsing::KeywordTable<ProvinceHistory>& getKeywords();
+		void finishHistory();
 		void buildPopRatios();
 		void decayPopRatios(const date& oldDate, const date& newDate, EU4::PopRatio& currentPop);
 
-		std::vector<std::pair<date, std::string>> ownershipHistory;
-		std::vector<std::pair<date, std::string>> religionHistory;
-		std::vector<std::pair<date, std::string>> cultureHistory;
+		std::pmr::vector<std::pair<date, std::string>> ownershipHistory{ parsing::getCurrentResource() };
+		std::pmr::vector<std::pair<date, std::string>> religionHistory{ parsing::getCurrentResource() };
+		std::pmr::vector<std::pair<date, std::string>> cultureHistory{ parsing::getCurrentResource() };
+		std::string startingCulture;
+		std::string startingReligion;
 
-		std::vector<PopRatio> popRatios;
+		std::pmr::vector<PopRatio> popRatios{ parsing::getCurrentResource() };
 		double originalTax = 0.0;
 		double originalProduction = 0.0;
 		double originalManpower = 0.0;
@@ -21,6 +21,7 @@ THE SOFTWARE. */
 
 
 #include "ProvinceModifier.h"
+#include "../../Parsing/ParsingHelpers.h"
 #include "ParserHelpers.h"
 
 
@@ -36,4 +37,16 @@ EU4::ProvinceModifier::ProvinceModifier(std::istream& theStream)
 	});
 
 	parseStream(theStream);
-}
\ No newline at end of file
+}
+
+
+EU4::ProvinceModifier::ProvinceModifier(parsing::Tokenizer& tokenizer)
+{
+	for (const auto& item: parsing::getAssignments(tokenizer))
+	{
+		if (item.first == "modifier")
+		{
+			modifier = item.second;
+		}
+	}
+}
@@ -26,6 +26,7 @@ THE SOFTWARE. */
 
 
 #include "newParser.h"
+#include "../../Parsing/Tokenizer.h"
 #include <string>
 
 
@@ -37,6 +38,7 @@ class ProvinceModifier: commonItems::parser
 {
 	public:
 		ProvinceModifier(std::istream& theStream);
+		explicit ProvinceModifier(parsing::Tokenizer& tokenizer);
 
 		std::string getModifier() const { return modifier; }
 
@@ -24,12 +24,45 @@ THE SOFTWARE. */
 
 
 
+#include "../../Parsing/Snapshot.h"
+
+
+
 namespace EU4
 {
 
 class ProvinceStats
 {
 	public:
+		ProvinceStats() = default;
+		explicit ProvinceStats(parsing::SnapshotReader& snapshot)
+		{
+			snapshot.read(goodsProduced);
+			snapshot.read(price);
+			snapshot.read(tradeEfficiency);
+			snapshot.read(productionEfficiency);
+			snapshot.read(tradeValue);
+			snapshot.read(totalTradeValue);
+			snapshot.read(baseTax);
+			snapshot.read(buildingsIncome);
+			snapshot.read(taxEfficiency);
+			snapshot.read(totalTaxIncome);
+		}
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const
+		{
+			snapshot.write(goodsProduced);
+			snapshot.write(price);
+			snapshot.write(tradeEfficiency);
+			snapshot.write(productionEfficiency);
+			snapshot.write(tradeValue);
+			snapshot.write(totalTradeValue);
+			snapshot.write(baseTax);
+			snapshot.write(buildingsIncome);
+			snapshot.write(taxEfficiency);
+			snapshot.write(totalTaxIncome);
+		}
+
 		double getGoodsProduced() const { return goodsProduced; }
 		double getPrice() const { return price; }
 		double getTradeEfficiency() const { return tradeEfficiency; }
@@ -22,8 +22,13 @@ THE SOFTWARE. */
 
 #include "Provinces.h"
 #include "../Buildings/Buildings.h"
-#include "Log.h"
+#include "../../ConversionContext.h"
+#include "../../Parsing/ParsingHelpers.h"
+#include "../../Parsing/WorkerLog.h"
+#include "ParserHelpers.h"
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -35,20 +40,121 @@ EU4::Provinces::Provinces(
 	const Buildings& buildingTypes,
 	const Modifiers& modifierTypes
 ) {
-	registerKeyword(
-		std::regex("-[0-9]+"),
-		[this, buildingTypes, modifierTypes](const std::string& numberString, std::istream& theStream)
+	const auto itemText = commonItems::stringOfItem(theStream).getString();
+	parsing::Tokenizer tokenizer(itemText);
+	buildProvinces(indexProvinces(tokenizer), tokenizer.getSettings(), buildingTypes, modifierTypes, parsing::WorkerPool::shared());
+}
+
+
+EU4::Provinces::Provinces(
+	parsing::Tokenizer& tokenizer,
+	const Buildings& buildingTypes,
+	const Modifiers& modifierTypes,
+	parsing::WorkerPool& pool
+) {
+	buildProvinces(indexProvinces(tokenizer), tokenizer.getSettings(), buildingTypes, modifierTypes, pool);
+}
+
+
+EU4::Provinces::Provinces(parsing::SnapshotReader& snapshot)
+{
+	arenas.push_back(std::make_unique<parsing::Arena>());
+	parsing::ArenaScope arenaScope(*arenas.back());
+	for (auto count = snapshot.readCount(); count > 0; count--)
 	{
-		Province newProvince(numberString, theStream, buildingTypes, modifierTypes);
-		provinces.insert(std::make_pair(newProvince.getNum(), std::move(newProvince)));
-	});
-	parseStream(theStream);
+		Province province(snapshot);
+		const auto provinceNumber = province.getNum();
+		provinces.insert(std::make_pair(provinceNumber, std::move(province)));
+	}
+}
+
+
+void EU4::Provinces::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(provinces.size());
+	for (const auto& province: provinces)
+	{
+		province.second.writeSnapshot(snapshot);
+	}
+}
+
+
+std::vector<parsing::Section> EU4::Provinces::indexProvinces(parsing::Tokenizer& tokenizer)
+{
+	std::vector<parsing::Section> provinceSections;
+	for (const auto& section: parsing::getBlockSections(tokenizer))
+	{
+		if (parsing::isProvinceKey(section.key))
+		{
+			provinceSections.push_back(section);
+		}
+	}
+	return provinceSections;
+}
+
+
+void EU4::Provinces::buildProvinces(
+	const std::vector<parsing::Section>& provinceSections,
+	const parsing::TokenizerSettings& settings,
+	const Buildings& buildingTypes,
+	const Modifiers& modifierTypes,
+	parsing::WorkerPool& pool
+) {
+	// Each province, its history, pop ratios and weights included, depends only on its own text and
+	// the read-only building and modifier types. They are built in contiguous batches, a few per
+	// thread to even out the load, and the batches are gathered in file order with their warnings,
+	// so the result is the same for any number of threads.
+	// Each batch builds into an arena of its own, which the provinces keep.
+	struct ProvinceBatch
+	{
+		std::unique_ptr<parsing::Arena> arena;
+		std::vector<Province> provinces;
+		std::vector<parsing::LogMessage> messages;
+	};
+
+	const auto batchCount = std::max<size_t>(pool.getThreadCount() * 4, 1);
+	const auto batchSize = std::max<size_t>((provinceSections.size() + batchCount - 1) / batchCount, 1);
+
+	auto& context = ConversionContext::current();
+	std::vector<std::future<ProvinceBatch>> batches;
+	for (size_t first = 0; first < provinceSections.size(); first += batchSize)
+	{
+		const auto last = std::min(first + batchSize, provinceSections.size());
+		batches.push_back(pool.submit([&provinceSections, settings, &buildingTypes, &modifierTypes, &context, first, last]() {
+			ConversionContext::Scope contextScope(context);
+			parsing::LogCapture log;
+			ProvinceBatch batch;
+			batch.arena = std::make_unique<parsing::Arena>();
+			parsing::ArenaScope arenaScope(*batch.arena);
+			batch.provinces.reserve(last - first);
+			for (auto i = first; i < last; i++)
+			{
+				parsing::Tokenizer provinceTokenizer(provinceSections[i].text, settings);
+				batch.provinces.emplace_back(provinceSections[i].key, provinceTokenizer, buildingTypes, modifierTypes);
+			}
+			batch.messages = log.takeMessages();
+			return batch;
+		}));
+	}
+
+	// all of them, so that on an error none is still reading the sections
+	pool.waitAll(batches);
+	for (auto& batch: batches)
+	{
+		auto builtBatch = batch.get();
+		arenas.push_back(std::move(builtBatch.arena));
+		parsing::replayLog(builtBatch.messages);
+		for (auto& province: builtBatch.provinces)
+		{
+			provinces.insert(std::make_pair(province.getNum(), std::move(province)));
+		}
+	}
 }
 
 
 EU4::Province& EU4::Provinces::getProvince(int provinceNumber)
 {
-	std::map<int, Province>::iterator province = provinces.find(provinceNumber);
+	auto province = provinces.find(provinceNumber);
 	if (province == provinces.end())
 	{
 		std::range_error exception(std::string("Old province ") + std::to_string(provinceNumber) + std::string(" does not exist (bad mapping?)"));
@@ -68,7 +174,7 @@ void EU4::Provinces::checkAllProvincesMapped(const mappers::ProvinceMapper& prov
 		auto Vic2Provinces = provinceMapper.getVic2ProvinceNumbers(province.first);
 		if ((Vic2Provinces.size() == 0) && (provinceMapper.isValidProvince(province.first)))
 		{
-			LOG(LogLevel::Warning) << "No mapping for province " << province.first;
+			WORKER_LOG(LogLevel::Warning) << "No mapping for province " << province.first;
 		}
 	}
 }
@@ -176,10 +282,10 @@ void EU4::Provinces::logTotalProvinceWeights() const
 		}
 
 	}
-	LOG(LogLevel::Info) << "Sum of all Province Weights: " << totalProvinceWeights;
+	WORKER_LOG(LogLevel::Info) << "Sum of all Province Weights: " << totalProvinceWeights;
 
 	// Total Base Tax, Total Tax Income, Total Production, Total Buildings, Total Manpower, total province weight //
-	LOG(LogLevel::Info) << "World Tag Map Size: " << world_tag_weights.size();
+	WORKER_LOG(LogLevel::Info) << "World Tag Map Size: " << world_tag_weights.size();
 
 	for (std::map<std::string, std::vector<double> >::iterator i = world_tag_weights.begin(); i != world_tag_weights.end(); i++)
 	{
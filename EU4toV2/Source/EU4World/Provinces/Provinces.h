@@ -28,19 +28,35 @@ THE SOFTWARE. */
 #include "EU4Province.h"
 #include "../Modifiers/Modifiers.h"
 #include "../../Mappers/ProvinceMappings/ProvinceMapper.h"
-#include "newParser.h"
+#include "../../Parsing/Arena.h"
+#include "../../Parsing/SectionScanner.h"
+#include "../../Parsing/Snapshot.h"
+#include "../../Parsing/WorkerPool.h"
+#include <istream>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <vector>
 
 
 
 namespace EU4
 {
 
-class Provinces: commonItems::parser
+class Provinces
 {
 	public:
 		Provinces(std::istream& theStream, const Buildings& buildingTypes, const Modifiers& modifierTypes);
+		Provinces(
+			parsing::Tokenizer& tokenizer,
+			const Buildings& buildingTypes,
+			const Modifiers& modifierTypes,
+			parsing::WorkerPool& pool = parsing::WorkerPool::shared()
+		);
+		explicit Provinces(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		Province& getProvince(int provinceNumber);
 
@@ -51,9 +67,20 @@ class Provinces: commonItems::parser
 		void determineTotalProvinceWeights(const Configuration& configuration);
 
 	private:
+		static std::vector<parsing::Section> indexProvinces(parsing::Tokenizer& tokenizer);
+		void buildProvinces(
+			const std::vector<parsing::Section>& provinceSections,
+			const parsing::TokenizerSettings& settings,
+			const Buildings& buildingTypes,
+			const Modifiers& modifierTypes,
+			parsing::WorkerPool& pool
+		);
 		void logTotalProvinceWeights() const;
 
-		std::map<int, Province> provinces;
+		// the provinces and everything they hold live in these, so they are declared first and go last
+		std::vector<std::unique_ptr<parsing::Arena>> arenas;
+		std::unique_ptr<parsing::Arena> mapArena = std::make_unique<parsing::Arena>();
+		std::pmr::map<int, Province> provinces{ mapArena.get() };
 		double totalProvinceWeights = 0.0;
 };
 
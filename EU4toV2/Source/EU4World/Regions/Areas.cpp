@@ -38,6 +38,18 @@ EU4::areas::areas(std::istream& theStream)
 }
 
 
+EU4::areas::areas(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(theAreas);
+}
+
+
+void EU4::areas::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(theAreas);
+}
+
+
 const std::set<int> EU4::areas::getProvincesInArea(const std::string& area) const
 {
 	auto areaItr(theAreas.find(area));
@@ -29,6 +29,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "Area.h"
 #include "Color.h"
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 #include <istream>
 #include <map>
 #include <set>
@@ -43,10 +44,13 @@ class areas: commonItems::parser
 {
 	public:
 		areas(std::istream& filename);
+		explicit areas(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		const std::set<int> getProvincesInArea(const std::string& area) const;
 
-		const std::map<std::string, std::set<int>> getAreas() const { return theAreas; }
+		const std::map<std::string, std::set<int>>& getAreas() const { return theAreas; }
 
 	private:
 		std::map<std::string, std::set<int>> theAreas;
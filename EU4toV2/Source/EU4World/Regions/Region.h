@@ -28,6 +28,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "newParser.h"
 #include <set>
+#include <string>
 
 
 
@@ -41,11 +42,12 @@ class region: commonItems::parser
 	public:
 		region(std::istream& theStream);
 		region(std::set<int> _provinces);
-
 		bool containsProvince(unsigned int province) const;
 
 		void addProvinces(const EU4::areas& areas);
 
+		const std::set<std::string>& getAreaNames() const { return areaNames; }
+
 	private:
 		std::set<std::string> areaNames;
 		std::set<int> provinces;
@@ -23,47 +23,158 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Regions.h"
 #include "Areas.h"
+#include "Region.h"
+#include <atomic>
 
 
 
 EU4::Regions::Regions(const EU4::areas& areas, std::istream& regionsFile)
 {
-	registerKeyword(std::regex("\\w+_region"), [this, areas](const std::string & areaName, std::istream & areasFile)
+	registerKeyword(std::regex("\\w+_region"), [this](const std::string& regionName, std::istream& regionsFile)
 	{
-		EU4::region newRegion(areasFile);
-		newRegion.addProvinces(areas);
-		regions.insert(make_pair(areaName, newRegion));
+		const EU4::region newRegion(regionsFile);
+		regionAreaNames.insert(make_pair(regionName, newRegion.getAreaNames()));
 	});
 
 	parseStream(regionsFile);
-
-	auto theAreas = areas.getAreas();
-	std::for_each(theAreas.begin(), theAreas.end(), [this](const std::pair<std::string, std::set<int>> & theArea)
-	{
-		regions.insert(make_pair(theArea.first, EU4::region(theArea.second)));
-	});
+	compile(areas);
 }
 
 
 EU4::Regions::Regions(const EU4::areas& areas)
 {
-	auto theAreas = areas.getAreas();
-	std::for_each(theAreas.begin(), theAreas.end(), [this](const std::pair<std::string, std::set<int>> & theArea)
+	compile(areas);
+}
+
+
+EU4::Regions::Regions(const EU4::areas& areas, parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(regionAreaNames);
+	compile(areas);
+}
+
+
+void EU4::Regions::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(regionAreaNames);
+}
+
+
+uint64_t EU4::Regions::nextInstanceId()
+{
+	static std::atomic<uint64_t> lastInstanceId{ 0 };
+	return ++lastInstanceId;
+}
+
+
+void EU4::Regions::compile(const EU4::areas& areas)
+{
+	std::map<std::string, size_t> areaIndex;
+	for (const auto& area: areas.getAreas())
 	{
-		regions.insert(make_pair(theArea.first, EU4::region(theArea.second)));
-	});
+		const auto areaNumber = areaIndex.size();
+		areaIndex.insert(std::make_pair(area.first, areaNumber));
+		for (const auto province: area.second)
+		{
+			if (province < 0)
+			{
+				continue;
+			}
+			if (static_cast<size_t>(province) >= areaOfProvince.size())
+			{
+				areaOfProvince.resize(province + 1, -1);
+			}
+
+			if (areaOfProvince[province] < 0)
+			{
+				areaOfProvince[province] = static_cast<int>(areaNumber);
+			}
+			else
+			{
+				otherAreasOfProvince.insert(std::make_pair(province, areaNumber));
+			}
+		}
+	}
+
+	wordsPerRegion = (areaIndex.size() + 63) / 64;
+	const auto addRegion = [this](const std::string& name) -> uint64_t* {
+		if (!regionIndexes.insert(std::make_pair(name, regionIndexes.size())).second || (wordsPerRegion == 0))
+		{
+			return nullptr; // a name taken already, or no areas to have bits for
+		}
+		regionAreas.resize(regionAreas.size() + wordsPerRegion, 0);
+		return &regionAreas[regionAreas.size() - wordsPerRegion];
+	};
+
+	for (const auto& region: regionAreaNames)
+	{
+		auto* bits = addRegion(region.first);
+		for (const auto& areaName: region.second)
+		{
+			const auto area = areaIndex.find(areaName);
+			if ((bits != nullptr) && (area != areaIndex.end()))
+			{
+				bits[area->second / 64] |= uint64_t(1) << (area->second % 64);
+			}
+		}
+	}
+	for (const auto& area: areaIndex)
+	{
+		if (auto* bits = addRegion(area.first))
+		{
+			bits[area.second / 64] |= uint64_t(1) << (area.second % 64);
+		}
+	}
 }
 
 
 bool EU4::Regions::provinceInRegion(int province, const std::string& regionName) const
 {
-	auto region = regions.find(regionName);
-	if (region != regions.end())
+	const auto index = getRegionIndex(regionName);
+	return index && provinceInRegion(province, *index);
+}
+
+
+std::optional<size_t> EU4::Regions::getRegionIndex(const std::string& regionName) const
+{
+	const auto region = regionIndexes.find(regionName);
+	if (region == regionIndexes.end())
 	{
-		return region->second.containsProvince(province);
+		return std::nullopt;
 	}
-	else
+	return region->second;
+}
+
+
+bool EU4::Regions::provinceInRegion(int province, size_t regionIndex) const
+{
+	// without any areas there are no provinces in the tables, and no bits to read
+	if ((province < 0) || (static_cast<size_t>(province) >= areaOfProvince.size()) || (regionIndex >= regionIndexes.size()))
 	{
 		return false;
 	}
+
+	const auto* bits = &regionAreas[regionIndex * wordsPerRegion];
+	const auto coversArea = [bits](size_t area) {
+		return (bits[area / 64] & (uint64_t(1) << (area % 64))) != 0;
+	};
+
+	const auto area = areaOfProvince[province];
+	if ((area >= 0) && coversArea(area))
+	{
+		return true;
+	}
+	if (!otherAreasOfProvince.empty())
+	{
+		const auto otherAreas = otherAreasOfProvince.equal_range(province);
+		for (auto otherArea = otherAreas.first; otherArea != otherAreas.second; ++otherArea)
+		{
+			if (coversArea(otherArea->second))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
 }
\ No newline at end of file
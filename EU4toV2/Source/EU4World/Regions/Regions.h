@@ -27,15 +27,26 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "newParser.h"
-#include "Region.h"
+#include "../../Parsing/Snapshot.h"
+#include <cstdint>
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 
 
 namespace EU4
 {
 
+class areas;
+
+
+// Regions and their areas, compiled as they are read into tables indexed by province: the area each province is in,
+// and for each region a bit per area it covers. Asking whether a province is in a region is then a name lookup and
+// a couple of array reads. Area names work as region names too, as the old single-file regions are just areas.
 class Regions: commonItems::parser
 {
 	public:
@@ -43,11 +54,34 @@ class Regions: commonItems::parser
 
 		Regions(const EU4::areas& areas, std::istream& regionsFile);
 		Regions(const EU4::areas& areas);
+		Regions(const EU4::areas& areas, parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
+		bool provinceInRegion(int province, const std::string& regionName) const;
 
-		virtual bool provinceInRegion(int province, const std::string& regionName) const;
+		// A region's place in the tables, for code that asks about the same regions many times: it looks each name up
+		// once and then asks by index. Areas have indexes too, as they can be used as regions.
+		virtual std::optional<size_t> getRegionIndex(const std::string& regionName) const;
+		virtual bool provinceInRegion(int province, size_t regionIndex) const;
+
+		// different for every Regions made in the process, so what was found with one is never taken for another's
+		// that happens to reuse its address; copies keep it, as they hold the same regions
+		uint64_t getInstanceId() const { return instanceId; }
 
 	private:
-		std::map<std::string, EU4::region> regions;
+		static uint64_t nextInstanceId();
+		void compile(const EU4::areas& areas);
+
+		uint64_t instanceId = nextInstanceId();
+
+		std::map<std::string, std::set<std::string>> regionAreaNames; // as read, which is all a snapshot needs
+
+		std::vector<int> areaOfProvince; // -1 where a province is in no area
+		std::multimap<int, size_t> otherAreasOfProvince; // in case the game files put a province in two areas
+		std::unordered_map<std::string, size_t> regionIndexes; // regions first, then areas under names no region took
+		size_t wordsPerRegion = 0;
+		std::vector<uint64_t> regionAreas; // wordsPerRegion words for each region
 };
 
 }
@@ -26,6 +26,20 @@
 
 
 
+EU4::Religion::Religion(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(name);
+	snapshot.read(group);
+}
+
+
+void EU4::Religion::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(name);
+	snapshot.write(group);
+}
+
+
  // e.g. catholic <-> catholic
 bool EU4::Religion::isSameReligion(const EU4::Religion& other) const
 {
@@ -26,6 +26,7 @@
 
 
 
+#include "../../Parsing/Snapshot.h"
 #include <string>
 
 
@@ -38,6 +39,9 @@ class Religion
 {
 	public:
 		Religion(std::string _name, std::string _group): name(_name), group(_group) {}
+		explicit Religion(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		// exactly one of these four functions should return true for any given pairing
 		bool isSameReligion(const Religion& other) const;	// e.g. catholic <-> catholic
@@ -26,6 +26,27 @@
 
 
 
+EU4::Religions::Religions(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		const auto religionName = snapshot.read<std::string>();
+		theReligions.insert(std::make_pair(religionName, Religion(snapshot)));
+	}
+}
+
+
+void EU4::Religions::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(theReligions.size());
+	for (const auto& religion: theReligions)
+	{
+		snapshot.write(religion.first);
+		religion.second.writeSnapshot(snapshot);
+	}
+}
+
+
 void EU4::Religions::addReligions(std::istream& theStream)
 {
 	registerKeyword(std::regex("[a-zA-Z_]+"), [this](const std::string& groupName, std::istream& theStream) {
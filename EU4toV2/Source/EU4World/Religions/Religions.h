@@ -27,6 +27,7 @@
 
 
 #include "newParser.h"
+#include "../../Parsing/Snapshot.h"
 #include "Religion.h"
 #include <map>
 #include <optional>
@@ -40,6 +41,11 @@ namespace EU4
 class Religions: commonItems::parser
 {
 	public:
+		Religions() = default;
+		explicit Religions(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
 		void addReligions(std::istream& theStream);
 
 		std::optional<Religion> getReligion(std::string name) const;
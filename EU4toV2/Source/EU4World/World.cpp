@@ -23,12 +23,14 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "World.h"
 #include "Buildings/Buildings.h"
+#include "CommonCountries.h"
 #include "Countries.h"
 #include "CultureGroups.h"
 #include "EU4Country.h"
 #include "EU4Diplomacy.h"
 #include "EU4Version.h"
 #include "EU4Localisation.h"
+#include "MapAreaData.h"
 #include "Modifiers/Modifiers.h"
 #include "Mods/Mod.h"
 #include "Mods/Mods.h"
@@ -38,174 +40,292 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../Mappers/Ideas/IdeaEffectMapper.h"
 #include "../Mappers/ProvinceMappings/ProvinceMapper.h"
 #include "../Mappers/ReligionMapper.h"
-#include "Log.h"
-#include "NewParserToOldParserConverters.h"
+#include "../Parsing/BinaryTokenReader.h"
+#include "../Parsing/BinaryTokenTable.h"
+#include "../Parsing/FileCache.h"
+#include "../Parsing/MappedFile.h"
+#include "../Parsing/ParsingHelpers.h"
+#include "../Parsing/Snapshot.h"
+#include "../Parsing/StructuralIndex.h"
+#include "../Parsing/ZippedSave.h"
+#include "../Parsing/WorkerLog.h"
 #include "Object.h"
 #include "OSCompatibilityLayer.h"
 #include "ParserHelpers.h"
-#include "ParadoxParserUTF8.h"
+#include "../Parsing/LegacyObjects.h"
 #include "StringUtils.h"
 #include <set>
 #include <algorithm>
 #include <exception>
+#include <cstdio>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <string>
 
 
 
-EU4::world::world(const string& EU4SaveFileName, const mappers::IdeaEffectMapper& ideaEffectMapper):
+namespace
+{
+
+// bump whenever anything written to snapshots, or the way it is worked out from the save, changes;
+// keys also hold the build id, which tells builds apart without this wherever the executable is readable
+constexpr uint32_t snapshotFormatVersion = 2;
+
+const std::string snapshotFolder = "snapshots";
+
+
+// the install files province building and modifier weights come from
+std::string getBuildingsFileName()
+{
+	return theConfiguration().getEU4Path() + "/common/buildings/00_buildings.txt";
+}
+
+
+std::vector<std::string> getModifiersFileNames()
+{
+	return {
+		theConfiguration().getEU4Path() + "/common/event_modifiers/00_event_modifiers.txt",
+		theConfiguration().getEU4Path() + "/common/triggered_modifiers/00_triggered_modifiers.txt",
+		theConfiguration().getEU4Path() + "/common/static_modifiers/00_static_modifiers.txt"
+	};
+}
+
+
+void addFileToKey(parsing::SnapshotKey& key, const std::string& fileName)
+{
+	key.add(fileName);
+	if (Utils::DoesFileExist(fileName))
+	{
+		const parsing::MappedFile file(fileName);
+		key.add(file.getContents());
+	}
+	else
+	{
+		key.add("missing");
+	}
+}
+
+
+// Country names and adjectives, under TAG and TAG_ADJ, are the only localisation the converter
+// uses. Every tag's are kept, not just those of the save's countries, so the texts can be cached
+// for any save.
+bool isCountryLocalisationKey(std::string_view key)
+{
+	if ((key.size() != 3) && ((key.size() != 7) || (key.substr(3) != "_ADJ")))
+	{
+		return false;
+	}
+	return std::all_of(key.begin(), key.begin() + 3, [](char character) {
+		return ((character >= 'A') && (character <= 'Z')) || ((character >= '0') && (character <= '9'));
+	});
+}
+
+}
+
+
+
+EU4::world::world(const string& EU4SaveFileName, const mappers::IdeaEffectMapper& ideaEffectMapper, const InstallData& installData):
 	theCountries()
 {
-	registerKeyword(std::regex("EU4txt"), [this](const std::string& unused, std::istream& theStream){});
-	registerKeyword(std::regex("date"), [this](const std::string& dateText, std::istream& theStream)
+	registerKeyword("EU4txt", [](std::string_view unused, parsing::Tokenizer& tokenizer){});
+	registerKeyword("date", [](std::string_view dateText, parsing::Tokenizer& tokenizer)
 		{
-			commonItems::singleString dateString(theStream);
-			date endDate(dateString.getString());
-			theConfiguration.setLastEU4Date(endDate);
+			const auto endDate = parsing::getDate(tokenizer);
+			theConfiguration().setLastEU4Date(endDate);
 		}
 	);
-	registerKeyword(std::regex("start_date"), [this](const std::string& dateText, std::istream& theStream)
+	registerKeyword("start_date", [](std::string_view dateText, parsing::Tokenizer& tokenizer)
 		{
-			commonItems::singleString startDateString(theStream);
-			date startDate(startDateString.getString());
-			theConfiguration.setStartEU4Date(startDate);
+			const auto startDate = parsing::getDate(tokenizer);
+			theConfiguration().setStartEU4Date(startDate);
 		}
 	);
-	registerKeyword(std::regex("savegame_version"), [this](const std::string& versionText, std::istream& theStream)
+	registerKeyword("savegame_version", parsing::streamHandler([this](const std::string& versionText, std::istream& theStream)
 		{
-			version = std::make_unique<EU4::Version>(theStream);
-			theConfiguration.setEU4Version(*version);
+			// Compressed saves repeat the version in their gamestate. Keep the first one, as sections
+			// already handed to workers may be reading it.
+			auto newVersion = std::make_unique<EU4::Version>(theStream);
+			if (!version)
+			{
+				version = std::move(newVersion);
+				theConfiguration().setEU4Version(*version);
+			}
 		}
-	);
-	registerKeyword(std::regex("dlc_enabled"), [this](const std::string& DLCText, std::istream& theStream)
+	));
+	registerKeyword("dlc_enabled", [](std::string_view unused, parsing::Tokenizer& tokenizer)
 		{
-			auto versionsObject = commonItems::convert8859Object(DLCText, theStream);
-			loadActiveDLC(versionsObject);
+			std::vector<std::string> activeDLCs;
+			for (const auto& DLC: parsing::getStrings(tokenizer))
+			{
+				activeDLCs.emplace_back(DLC);
+			}
+			theConfiguration().setActiveDLCs(activeDLCs);
 		}
 	);
-	registerKeyword(std::regex("mod_enabled"), [this](const std::string& modText, std::istream& theStream) {
-		Mods theMods(theStream, theConfiguration);
-	});
-	registerKeyword(std::regex("revolution_target"), [this](const std::string& revolutionText, std::istream& theStream)
+	registerKeyword("mod_enabled", parsing::streamHandler([this](const std::string& modText, std::istream& theStream) {
+		Mods theMods(theStream, theConfiguration());
+	}));
+	registerKeyword("revolution_target", [this](std::string_view unused, parsing::Tokenizer& tokenizer)
 		{
-			auto modsObject = commonItems::convert8859String(revolutionText, theStream);
-			loadRevolutionTargetString(modsObject);
+			revolutionTargetString = parsing::getString(tokenizer);
 		}
 	);
-	registerKeyword(std::regex("empire"), [this](const std::string& empireText, std::istream& theStream)
+	// Older saves name the emperor at the top level, newer ones inside the empire blocks.
+	registerKeyword("emperor", [this](std::string_view unused, parsing::Tokenizer& tokenizer)
 		{
-			auto empireObject = commonItems::convert8859Object(empireText, theStream);
-			loadEmpires(empireObject);
+			holyRomanEmperor = parsing::getString(tokenizer);
 		}
 	);
-	registerKeyword(std::regex("emperor"), [this](const std::string& emperorText, std::istream& theStream)
+	registerKeyword("empire", [this](std::string_view unused, parsing::Tokenizer& tokenizer)
 		{
-			auto emperorObject = commonItems::convert8859Object(emperorText, theStream);
-			loadEmpires(emperorObject);
+			loadEmperor(tokenizer, holyRomanEmperor);
 		}
 	);
-	registerKeyword(std::regex("celestial_empire"), [this](const std::string& empireText, std::istream& theStream)
+	registerKeyword("celestial_empire", [this](std::string_view unused, parsing::Tokenizer& tokenizer)
 		{
-			auto empireObject = commonItems::convert8859Object(empireText, theStream);
-			loadEmpires(empireObject);
+			loadEmperor(tokenizer, celestialEmperor);
 		}
 	);
-	registerKeyword(std::regex("provinces"), [this](const std::string& provincesText, std::istream& theStream) {
-		std::ifstream buildingsFile(theConfiguration.getEU4Path() + "/common/buildings/00_buildings.txt");
-		Buildings buildingTypes(buildingsFile);
-		buildingsFile.close();
-
-		std::ifstream modifiersFile(theConfiguration.getEU4Path() + "/common/event_modifiers/00_event_modifiers.txt");
-		Modifiers modifierTypes(modifiersFile);
-		modifiersFile.close();
-		modifiersFile.open(theConfiguration.getEU4Path() + "/common/triggered_modifiers/00_triggered_modifiers.txt");
-		modifierTypes.addModifiers(modifiersFile);
-		modifiersFile.close();
-		modifiersFile.open(theConfiguration.getEU4Path() + "/common/static_modifiers/00_static_modifiers.txt");
-		modifierTypes.addModifiers(modifiersFile);
-		modifiersFile.close();
 
-		provinces = std::make_unique<Provinces>(theStream, buildingTypes, modifierTypes);
-		std::optional<date> possibleDate = provinces->getProvince(1).getFirstOwnedDate();
-		if (possibleDate)
-		{
-			theConfiguration.setFirstEU4Date(*possibleDate);
-		}
+	// The big sections below are parsed on worker threads. Each returns a merge that stores its
+	// results, and the merges run in file order once the whole save has been read, so
+	// map_area_data still finds the countries it refers to.
+	registerSection("provinces", [this, &installData](std::string_view provincesText, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		auto parsedProvinces = std::make_shared<Provinces>(tokenizer, installData.buildingTypes, installData.modifierTypes);
+		return [this, parsedProvinces]()
+			{
+				provinces = std::make_unique<Provinces>(std::move(*parsedProvinces));
+				std::optional<date> possibleDate = provinces->getProvince(1).getFirstOwnedDate();
+				if (possibleDate)
+				{
+					theConfiguration().setFirstEU4Date(*possibleDate);
+				}
+			};
 	});
-	registerKeyword(
-		std::regex("countries"),
-		[this, ideaEffectMapper](const std::string& countriesText, std::istream& theStream)
+	registerSection(
+		"countries",
+		[this, &ideaEffectMapper](std::string_view countriesText, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge
 		{
-			loadCountries(theStream, ideaEffectMapper);
+			if (!version)
+			{
+				throw std::runtime_error("The save's countries come before its version.");
+			}
+			auto parsedCountries = std::make_shared<countries>(*version, tokenizer, ideaEffectMapper);
+			return [this, parsedCountries]() { loadCountries(*parsedCountries); };
 		}
 	);
-	registerKeyword(std::regex("diplomacy"), [this](const std::string& diplomacyText, std::istream& theStream) {
-		auto diplomacyObject = commonItems::convert8859Object(diplomacyText, theStream);
-		loadDiplomacy(diplomacyObject);
+	registerSection("diplomacy", [this](std::string_view unused, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		auto parsedDiplomacy = std::make_shared<EU4Diplomacy>(tokenizer);
+		return [this, parsedDiplomacy]() { diplomacy = std::make_unique<EU4Diplomacy>(std::move(*parsedDiplomacy)); };
 	});
-	registerKeyword(std::regex("map_area_data"), [this](const std::string& mapAreaKey, std::istream& theStream) {
-		// Add the missing equals sign to help out the object parser.
-		auto mapAreaObject = commonItems::convert8859Object(mapAreaKey + "=", theStream);
-		auto vec = mapAreaObject->getValue(mapAreaKey);
-		if (0 < vec.size())
-		{
-			loadMapAreaData(vec[0]);
-		}
-		else
-		{
-			LOG(LogLevel::Warning) << "Could not find map area "
-			                          "data, state information "
-			                          "will not be loaded.";
-		}
+	registerSection("map_area_data", [this](std::string_view unused, parsing::Tokenizer& tokenizer) -> parsing::sectionMerge {
+		auto mapAreaData = std::make_shared<MapAreaData>(tokenizer);
+		return [this, mapAreaData]() { loadMapAreaData(*mapAreaData); };
 	});
-	registerKeyword(std::regex("[A-Za-z0-9\\_]+"), commonItems::ignoreItem);
 
 	if (!diplomacy)
 	{
-		auto nullDiploObject = std::make_shared<Object>("");
-		diplomacy = std::make_unique<EU4Diplomacy>(nullDiploObject);
+		diplomacy = std::make_unique<EU4Diplomacy>();
 	}
 
-	LOG(LogLevel::Info) << "* Importing EU4 save *";
-	verifySave(EU4SaveFileName);
-	parseFile(EU4SaveFileName);
+	WORKER_LOG(LogLevel::Info) << "* Importing EU4 save *";
+	const auto format = verifySave(EU4SaveFileName);
+	const auto snapshotKey = getSnapshotKey(EU4SaveFileName, format);
+	if (!loadSnapshot(snapshotKey))
+	{
+		if (format == saveFormat::zipped)
+		{
+			parseZippedSave(EU4SaveFileName);
+		}
+		else if (format == saveFormat::binary)
+		{
+			const parsing::BinaryTokenTable tokens(theConfiguration().getBinaryTokensPath());
+			const parsing::MappedFile save(EU4SaveFileName);
+			parseBinarySave(save.getContents(), tokens);
+		}
+		else
+		{
+			const parsing::MappedFile save(EU4SaveFileName);
+			const parsing::StructuralIndex index(save.getContents());
+			parsing::Tokenizer tokenizer(save.getContents(), &index);
+			parseSections(tokenizer);
+		}
+		saveSnapshot(snapshotKey);
+	}
+	logArenaCounters();
 
-	LOG(LogLevel::Info) << "Building world:";
+	WORKER_LOG(LogLevel::Info) << "Building world:";
 	setEmpires();
 	addProvinceInfoToCountries();
 	dropMinoritiesFromCountries();
-	provinces->determineTotalProvinceWeights(theConfiguration);
-	LOG(LogLevel::Info) << "- Loading Regions";
+	provinces->determineTotalProvinceWeights(theConfiguration());
+	WORKER_LOG(LogLevel::Info) << "- Loading Regions";
 	loadRegions();
-	LOG(LogLevel::Info) << "- Reading Countries";
+	WORKER_LOG(LogLevel::Info) << "- Reading Countries";
 	readCommonCountries();
-	LOG(LogLevel::Info) << " - Setting Localizations";
+	WORKER_LOG(LogLevel::Info) << " - Setting Localizations";
 	setLocalisations();
-	LOG(LogLevel::Info) << "- Resolving Regiments";
+	WORKER_LOG(LogLevel::Info) << "- Resolving Regiments";
 	resolveRegimentTypes();
-	LOG(LogLevel::Info) << " - Merging Nations";
+	WORKER_LOG(LogLevel::Info) << " - Merging Nations";
 	mergeNations();
 
-	LOG(LogLevel::Info) << " - Viva la revolution!";
+	WORKER_LOG(LogLevel::Info) << " - Viva la revolution!";
 	loadRevolutionTarget();
 
-	LOG(LogLevel::Info) << " - Importing Religions";
+	WORKER_LOG(LogLevel::Info) << " - Importing Religions";
 	importReligions();
 
-	LOG(LogLevel::Info) << " - Dropping Empty Nations";
+	WORKER_LOG(LogLevel::Info) << " - Dropping Empty Nations";
 	removeEmptyNations();
-	if (theConfiguration.getRemoveType() == Configuration::DEADCORES::DeadCores)
+	if (theConfiguration().getRemoveType() == Configuration::DEADCORES::DeadCores)
 	{
 		removeDeadLandlessNations();
 	}
-	else if (theConfiguration.getRemoveType() == Configuration::DEADCORES::AllCores)
+	else if (theConfiguration().getRemoveType() == Configuration::DEADCORES::AllCores)
 	{
 		removeLandlessNations();
 	}
 }
 
 
-void EU4::world::verifySave(const std::string& EU4SaveFileName)
+EU4::InstallData EU4::world::importInstallData()
+{
+	const parsing::FileCache cache;
+	const auto buildingsFileName = getBuildingsFileName();
+	auto buildingTypes = cache.get<Buildings>("buildings", { buildingsFileName }, [&buildingsFileName]() {
+		std::ifstream buildingsFile(buildingsFileName);
+		return Buildings(buildingsFile);
+	});
+
+	const auto modifiersFileNames = getModifiersFileNames();
+	auto modifierTypes = cache.get<Modifiers>("modifiers", modifiersFileNames, [&modifiersFileNames]() {
+		std::ifstream modifiersFile(modifiersFileNames[0]);
+		Modifiers modifierTypes(modifiersFile);
+		modifiersFile.close();
+		for (size_t i = 1; i < modifiersFileNames.size(); i++)
+		{
+			modifiersFile.open(modifiersFileNames[i]);
+			modifierTypes.addModifiers(modifiersFile);
+			modifiersFile.close();
+		}
+		return modifierTypes;
+	});
+
+	return { std::move(buildingTypes), std::move(modifierTypes) };
+}
+
+
+void EU4::world::logArenaCounters()
+{
+	const auto counters = parsing::Arena::getCounters();
+	WORKER_LOG(LogLevel::Debug) << "Arenas hold " << counters.allocations << " allocations (" << counters.bytes
+		<< " bytes) in " << counters.chunks << " chunks; " << counters.heapObjects << " objects went to the heap";
+}
+
+
+EU4::world::saveFormat EU4::world::verifySave(const std::string& EU4SaveFileName)
 {
 	std::ifstream saveFile(EU4SaveFileName);
 	if (!saveFile.is_open())
@@ -219,99 +339,246 @@ void EU4::world::verifySave(const std::string& EU4SaveFileName)
 		saveFile.get(buffer, 8);
 		if ((buffer[0] == 'P') && (buffer[1] == 'K'))
 		{
-			std::runtime_error exception("Saves must be uncompressed to be converted.");
-			throw exception;
+			return saveFormat::zipped;
 		}
-		else if (
-			(buffer[0] == 'E') &&
-			(buffer[1] == 'U') &&
-			(buffer[2] == '4') &&
-			(buffer[3] == 'b') &&
-			(buffer[4] == 'i') &&
-			(buffer[5] == 'n') &&
-			(buffer[6] == 'M')
-		) {
-			std::runtime_error exception("Ironman saves cannot be converted.");
-			throw exception;
+		else if (parsing::BinaryTokenReader::isBinarySave(buffer))
+		{
+			return saveFormat::binary;
 		}
 	}
 
 	saveFile.close();
+	return saveFormat::text;
 }
 
 
-void EU4::world::loadActiveDLC(const shared_ptr<Object> EU4SaveObj)
+void EU4::world::parseZippedSave(const std::string& EU4SaveFileName)
 {
-	vector<shared_ptr<Object>> enabledDLCsObj = EU4SaveObj->getValue("dlc_enabled");
-	if (enabledDLCsObj.size() > 0)
+	WORKER_LOG(LogLevel::Info) << "Decompressing save while parsing";
+	parsing::ZippedSave zippedSave(EU4SaveFileName);
+	std::unique_ptr<parsing::BinaryTokenTable> tokens;
+	for (const auto& part: zippedSave.getParts())
 	{
-		vector<string>	activeDLCs;
-		vector<string> DLCsObj = enabledDLCsObj[0]->getTokens();
-		for (auto DLCsItr: DLCsObj)
+		const auto headerSize = part->waitFor(6);
+		if (parsing::BinaryTokenReader::isBinarySave(part->getView().substr(0, headerSize)))
 		{
-			activeDLCs.push_back(DLCsItr);
+			if (!tokens)
+			{
+				tokens = std::make_unique<parsing::BinaryTokenTable>(theConfiguration().getBinaryTokensPath());
+			}
+			const auto size = part->waitFor(part->getCapacity());
+			parseBinarySave(part->getView().substr(0, size), *tokens);
+			continue;
 		}
 
-		theConfiguration.setActiveDLCs(activeDLCs);
+		parsing::Tokenizer tokenizer(*part);
+		parseSections(tokenizer);
 	}
 }
 
 
-void EU4::world::loadEmpires(const shared_ptr<Object> EU4SaveObj)
+void EU4::world::parseBinarySave(std::string_view save, const parsing::BinaryTokenTable& tokens)
 {
-	vector<shared_ptr<Object>> emperorObj = EU4SaveObj->getValue("emperor");
-	if (emperorObj.size() > 0)
+	WORKER_LOG(LogLevel::Info) << "Reading binary save";
+	const auto knownMissingIds = tokens.getMissingIdCount();
 	{
-		holyRomanEmperor = emperorObj[0]->getLeaf();
+		parsing::Tokenizer tokenizer(save, parsing::TokenizerSettings{ nullptr, &tokens });
+		parseSections(tokenizer);
 	}
 
-	vector<shared_ptr<Object>> empireObj = EU4SaveObj->getValue("empire");
-	if (empireObj.size() > 0)
+	// every tokenizer over the save has handed its missing ids to the table by now
+	if (tokens.getMissingIdCount() > knownMissingIds)
+	{
+		WORKER_LOG(LogLevel::Warning) << tokens.getMissingIdCount() << " binary token ids are missing from the token list. Is it for the right EU4 version?";
+	}
+}
+
+
+// Snapshots hold the world as the save left it, before anything from the configuration is applied,
+// so changing the options between runs still reuses them. Province weights do take in the building
+// and modifier types, so the files those come from are part of the key.
+uint64_t EU4::world::getSnapshotKey(const std::string& EU4SaveFileName, saveFormat format)
+{
+	parsing::SnapshotKey key;
 	{
-		loadHolyRomanEmperor(empireObj);
+		const parsing::MappedFile save(EU4SaveFileName);
+		key.add(save.getContents());
 	}
-	vector<shared_ptr<Object>> celestialEmpireObj = EU4SaveObj->getValue("celestial_empire");
-	if (celestialEmpireObj.size() > 0)
+	key.add(theConfiguration().getEU4Path());
+	key.add(theConfiguration().getEU4DocumentsPath());
+	key.add(theConfiguration().getSteamWorkshopPath());
+	addFileToKey(key, getBuildingsFileName());
+	for (const auto& modifiersFileName: getModifiersFileNames())
 	{
-		loadCelestialEmperor(celestialEmpireObj);
+		addFileToKey(key, modifiersFileName);
 	}
+	if (format != saveFormat::text) // zipped saves may hold binary parts
+	{
+		addFileToKey(key, theConfiguration().getBinaryTokensPath());
+	}
+	key.add(std::to_string(snapshotFormatVersion));
+	key.add(std::to_string(parsing::getBuildId()));
+	return key.get();
 }
 
-void EU4::world::loadHolyRomanEmperor(vector<shared_ptr<Object>> empireObj)
+
+std::string EU4::world::getSnapshotFileName(uint64_t key)
+{
+	std::stringstream fileName;
+	fileName << snapshotFolder << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".snapshot";
+	return fileName.str();
+}
+
+
+bool EU4::world::loadSnapshot(uint64_t key)
 {
-	vector<shared_ptr<Object>> emperorObj = empireObj[0]->getValue("emperor");
-	if (emperorObj.size() > 0)
+	const auto snapshotFileName = getSnapshotFileName(key);
+	if (!Utils::DoesFileExist(snapshotFileName))
 	{
-		holyRomanEmperor = emperorObj[0]->getLeaf();
+		return false;
+	}
+
+	WORKER_LOG(LogLevel::Info) << "Reading the save from " << snapshotFileName;
+	try
+	{
+		const parsing::MappedFile snapshotFile(snapshotFileName);
+		parsing::SnapshotReader snapshot(snapshotFile.getContents(), snapshotFormatVersion, key);
+		readSnapshot(snapshot);
+		return true;
+	}
+	catch (const std::exception& e)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not use " << snapshotFileName << " (" << e.what() << "), reading the save instead";
+		return false;
 	}
 }
 
 
-void EU4::world::loadCelestialEmperor(vector<shared_ptr<Object>> celestialEmpireObj)
+// Everything is read into locals first, so a snapshot that turns out to be damaged partway
+// leaves the world as it was.
+void EU4::world::readSnapshot(parsing::SnapshotReader& snapshot)
 {
-	vector<shared_ptr<Object>> emperorObj = celestialEmpireObj[0]->getValue("emperor");
-	if (emperorObj.size() > 0)
+	const auto lastDate = snapshot.read<date>();
+	const auto startDate = snapshot.read<date>();
+	const auto firstDate = snapshot.read<date>();
+	const auto activeDLCs = snapshot.read<std::vector<std::string>>();
+	const auto mods = snapshot.read<std::vector<std::string>>();
+	auto snapshotVersion = std::make_unique<EU4::Version>(snapshot);
+
+	const auto snapshotHolyRomanEmperor = snapshot.read<std::string>();
+	const auto snapshotCelestialEmperor = snapshot.read<std::string>();
+	const auto snapshotRevolutionTarget = snapshot.read<std::string>();
+
+	auto snapshotProvinces = std::make_unique<Provinces>(snapshot);
+
+	auto arena = std::make_unique<parsing::Arena>();
+	std::map<std::string, std::shared_ptr<EU4::Country>> snapshotCountries;
+	{
+		parsing::ArenaScope arenaScope(*arena);
+		for (auto count = snapshot.readCount(); count > 0; count--)
+		{
+			const auto tag = snapshot.read<std::string>();
+			snapshotCountries.insert(make_pair(tag, parsing::makeArenaShared<Country>(snapshot)));
+		}
+	}
+
+	auto snapshotDiplomacy = std::make_unique<EU4Diplomacy>(snapshot);
+	if (!snapshot.atEnd())
 	{
-		celestialEmperor = emperorObj[0]->getLeaf();
+		throw std::runtime_error("The snapshot has data past its end.");
 	}
+
+	theConfiguration().setLastEU4Date(lastDate);
+	theConfiguration().setStartEU4Date(startDate);
+	theConfiguration().setFirstEU4Date(firstDate);
+	theConfiguration().setActiveDLCs(activeDLCs);
+	for (const auto& mod: mods)
+	{
+		theConfiguration().addEU4Mod(mod);
+	}
+	theConfiguration().setEU4Version(*snapshotVersion);
+	version = std::move(snapshotVersion);
+
+	holyRomanEmperor = snapshotHolyRomanEmperor;
+	celestialEmperor = snapshotCelestialEmperor;
+	revolutionTargetString = snapshotRevolutionTarget;
+	provinces = std::move(snapshotProvinces);
+	countryArenas.push_back(std::move(arena));
+	theCountries.swap(snapshotCountries);
+	diplomacy = std::move(snapshotDiplomacy);
 }
 
 
-void EU4::world::loadCountries(istream& theStream, const mappers::IdeaEffectMapper& ideaEffectMapper)
+void EU4::world::saveSnapshot(uint64_t key) const
 {
-	countries processedCountries(*version, theStream, ideaEffectMapper);
-	auto theProcessedCountries = processedCountries.getTheCountries();
-	theCountries.swap(theProcessedCountries);
+	if (!version || !provinces)
+	{
+		return;
+	}
+	if (!Utils::doesFolderExist(snapshotFolder) && !Utils::TryCreateFolder(snapshotFolder))
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not create " << snapshotFolder << ", the save won't be cached";
+		return;
+	}
+
+	const auto snapshotFileName = getSnapshotFileName(key);
+	// written under another name first, so an interrupted run never leaves half a snapshot behind
+	const auto temporaryFileName = parsing::getTemporaryFileName(snapshotFileName);
+	{
+		std::ofstream snapshotFile(temporaryFileName, std::ios::binary | std::ios::trunc);
+		parsing::SnapshotWriter snapshot(snapshotFile, snapshotFormatVersion, key);
+		writeSnapshot(snapshot);
+		snapshotFile.close();
+		if (!snapshotFile)
+		{
+			WORKER_LOG(LogLevel::Warning) << "Could not write " << temporaryFileName << ", the save won't be cached";
+			std::remove(temporaryFileName.c_str());
+			return;
+		}
+	}
+	std::remove(snapshotFileName.c_str());
+	if (std::rename(temporaryFileName.c_str(), snapshotFileName.c_str()) != 0)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not rename " << temporaryFileName << " to " << snapshotFileName;
+		std::remove(temporaryFileName.c_str());
+	}
 }
 
 
-void EU4::world::loadRevolutionTargetString(const shared_ptr<Object> EU4SaveObj)
+void EU4::world::writeSnapshot(parsing::SnapshotWriter& snapshot) const
 {
-	vector<shared_ptr<Object>> revolutionTargetObj = EU4SaveObj->getValue("revolution_target");
-	if (revolutionTargetObj.size() > 0)
+	snapshot.write(theConfiguration().getLastEU4Date());
+	snapshot.write(theConfiguration().getStartEU4Date());
+	snapshot.write(theConfiguration().getFirstEU4Date());
+	snapshot.write(theConfiguration().getActiveDLCs());
+	snapshot.write(theConfiguration().getEU4Mods());
+	version->writeSnapshot(snapshot);
+
+	snapshot.write(holyRomanEmperor);
+	snapshot.write(celestialEmperor);
+	snapshot.write(revolutionTargetString);
+
+	provinces->writeSnapshot(snapshot);
+
+	snapshot.writeCount(theCountries.size());
+	for (const auto& country: theCountries)
 	{
-		revolutionTargetString = revolutionTargetObj[0]->getLeaf();
+		snapshot.write(country.first);
+		country.second->writeSnapshot(snapshot);
 	}
+
+	diplomacy->writeSnapshot(snapshot);
+}
+
+
+void EU4::world::loadCountries(countries& processedCountries)
+{
+	for (auto& arena: processedCountries.takeArenas())
+	{
+		countryArenas.push_back(std::move(arena));
+	}
+	auto theProcessedCountries = processedCountries.getTheCountries();
+	theCountries.swap(theProcessedCountries);
 }
 
 
@@ -364,48 +631,35 @@ void EU4::world::addProvinceInfoToCountries()
 }
 
 
-void EU4::world::loadDiplomacy(const shared_ptr<Object> EU4SaveObj)
+void EU4::world::loadEmperor(parsing::Tokenizer& tokenizer, std::string& emperor)
 {
-	vector<shared_ptr<Object>> diploObj = EU4SaveObj->getValue("diplomacy");	// the object holding the world's diplomacy
-	if (diploObj.size() > 0)
-	{
-		diplomacy = std::make_unique<EU4Diplomacy>(diploObj[0]);
-	}
-	else
+	for (const auto& assignment: parsing::getAssignments(tokenizer))
 	{
-		diplomacy = std::make_unique<EU4Diplomacy>();
+		if (assignment.first == "emperor")
+		{
+			emperor = assignment.second;
+			return;
+		}
 	}
 }
 
-void EU4::world::loadMapAreaData(const shared_ptr<Object> mapAreaObject)
+
+void EU4::world::loadMapAreaData(const MapAreaData& mapAreaData)
 {
-	auto areas = mapAreaObject->getLeaves();
-	for (auto area : areas)
+	for (const auto& countryState: mapAreaData.getCountryStates())
 	{
-		std::string areaName = area->getKey();
-		auto state = area->safeGetObject("state");
-		if (state == NULL)
+		auto eu4Country = getCountry(countryState.tag);
+		if (eu4Country == NULL)
 		{
 			continue;
 		}
-		auto countries = state->getValue("country_state");
-		for (auto country : countries)
-		{
-			auto tag = stringutils::remQuotes(country->safeGetString("country"));
-			auto eu4Country = getCountry(tag);
-			if (eu4Country == NULL)
-			{
-				continue;
-			}
-			auto prosperity = country->safeGetFloat("prosperity");
-			eu4Country->addState(areaName, prosperity);
-		}
+		eu4Country->addState(countryState.area, countryState.prosperity);
 	}
 }
 
 void EU4::world::loadRegions()
 {
-	LOG(LogLevel::Info) << "Parsing EU4 regions";
+	WORKER_LOG(LogLevel::Info) << "Parsing EU4 regions";
 
 	if (*version >= EU4::Version("1.14"))
 	{
@@ -431,7 +685,7 @@ void EU4::world::assignProvincesToAreas(const std::map<std::string, std::set<int
 			}
 			catch (std::exception& e)
 			{
-				LOG(LogLevel::Warning) << e.what();
+				WORKER_LOG(LogLevel::Warning) << e.what();
 			}
 		}
 	}
@@ -439,50 +693,94 @@ void EU4::world::assignProvincesToAreas(const std::map<std::string, std::set<int
 
 void EU4::world::loadEU4RegionsOldVersion()
 {
-	std::string regionFilename = theConfiguration.getEU4Path() + "/map/region.txt";
+	// every file that might be used, so a mod gaining one is noticed
+	std::vector<std::string> candidateFiles = { theConfiguration().getEU4Path() + "/map/region.txt" };
+	for (auto itr: theConfiguration().getEU4Mods())
+	{
+		candidateFiles.push_back(itr + "/map/region.txt");
+	}
 
-	for (auto itr: theConfiguration.getEU4Mods())
+	const parsing::FileCache cache;
+	std::optional<EU4::areas> installedAreas;
+	const auto readCache = [this, &installedAreas](parsing::SnapshotReader& snapshot) {
+		installedAreas.emplace(snapshot);
+		regions = std::make_unique<Regions>(*installedAreas, snapshot);
+	};
+	if (!cache.load("oldRegions", candidateFiles, readCache))
 	{
-		if (!Utils::DoesFileExist(itr + "/map/region.txt"))
+		std::string regionFilename = theConfiguration().getEU4Path() + "/map/region.txt";
+
+		for (auto itr: theConfiguration().getEU4Mods())
 		{
-			continue;
-		}
+			if (!Utils::DoesFileExist(itr + "/map/region.txt"))
+			{
+				continue;
+			}
 
-		regionFilename = itr + "/map/region.txt";
-	}
+			regionFilename = itr + "/map/region.txt";
+		}
 
-	std::ifstream theStream(regionFilename);
-	EU4::areas installedAreas(theStream);
-	theStream.close();
-        assignProvincesToAreas(installedAreas.getAreas());
+		std::ifstream theStream(regionFilename);
+		installedAreas.emplace(theStream);
+		theStream.close();
 
-	regions = std::make_unique<Regions>(installedAreas);
+		regions = std::make_unique<Regions>(*installedAreas);
+		cache.store("oldRegions", candidateFiles, [this, &installedAreas](parsing::SnapshotWriter& snapshot) {
+			installedAreas->writeSnapshot(snapshot);
+			regions->writeSnapshot(snapshot);
+		});
+	}
+        assignProvincesToAreas(installedAreas->getAreas());
 }
 
 
 void EU4::world::loadEU4RegionsNewVersion()
 {
-	std::string areaFilename = theConfiguration.getEU4Path() + "/map/area.txt";
-	std::string regionFilename = theConfiguration.getEU4Path() + "/map/region.txt";
-	for (auto itr: theConfiguration.getEU4Mods())
+	// every file that might be used, so a mod gaining them is noticed
+	std::vector<std::string> candidateFiles = {
+		theConfiguration().getEU4Path() + "/map/area.txt",
+		theConfiguration().getEU4Path() + "/map/region.txt"
+	};
+	for (auto itr: theConfiguration().getEU4Mods())
+	{
+		candidateFiles.push_back(itr + "/map/area.txt");
+		candidateFiles.push_back(itr + "/map/region.txt");
+	}
+
+	const parsing::FileCache cache;
+	std::optional<EU4::areas> installedAreas;
+	const auto readCache = [this, &installedAreas](parsing::SnapshotReader& snapshot) {
+		installedAreas.emplace(snapshot);
+		regions = std::make_unique<Regions>(*installedAreas, snapshot);
+	};
+	if (!cache.load("regions", candidateFiles, readCache))
 	{
-		if (!Utils::DoesFileExist(itr + "/map/area.txt") || !Utils::DoesFileExist(itr + "/map/region.txt"))
+		std::string areaFilename = theConfiguration().getEU4Path() + "/map/area.txt";
+		std::string regionFilename = theConfiguration().getEU4Path() + "/map/region.txt";
+		for (auto itr: theConfiguration().getEU4Mods())
 		{
-			continue;
+			if (!Utils::DoesFileExist(itr + "/map/area.txt") || !Utils::DoesFileExist(itr + "/map/region.txt"))
+			{
+				continue;
+			}
+
+			areaFilename = itr + "/map/area.txt";
+			regionFilename = itr + "/map/region.txt";
 		}
 
-		areaFilename = itr + "/map/area.txt";
-		regionFilename = itr + "/map/region.txt";
+		std::ifstream areaStream(areaFilename);
+		installedAreas.emplace(areaStream);
+		areaStream.close();
+
+		std::ifstream regionStream(regionFilename);
+		regions = std::make_unique<Regions>(*installedAreas, regionStream);
+		regionStream.close();
+		cache.store("regions", candidateFiles, [this, &installedAreas](parsing::SnapshotWriter& snapshot) {
+			installedAreas->writeSnapshot(snapshot);
+			regions->writeSnapshot(snapshot);
+		});
 	}
-
-	std::ifstream areaStream(areaFilename);
-	EU4::areas installedAreas(areaStream);
-	areaStream.close();
-        assignProvincesToAreas(installedAreas.getAreas());
-
-	std::ifstream regionStream(regionFilename);
-	regions = std::make_unique<Regions>(installedAreas, regionStream);
-	regionStream.close();
+        assignProvincesToAreas(installedAreas->getAreas());
 }
 
 
@@ -496,7 +794,7 @@ void EU4::world::checkAllEU4CulturesMapped(const mappers::CultureMapper& culture
 		std::optional<std::string> matched = cultureMapper.cultureMatch(*regions, EU4Culture, "");
 		if (!matched)
 		{
-			LOG(LogLevel::Warning) << "No culture mapping for EU4 culture " << EU4Culture;
+			WORKER_LOG(LogLevel::Warning) << "No culture mapping for EU4 culture " << EU4Culture;
 		}
 	}
 }
@@ -504,69 +802,37 @@ void EU4::world::checkAllEU4CulturesMapped(const mappers::CultureMapper& culture
 
 void EU4::world::readCommonCountries()
 {
-	LOG(LogLevel::Info) << "Reading EU4 common/countries";
-	ifstream commonCountries(theConfiguration.getEU4Path() + "/common/country_tags/00_countries.txt");	// the data in the countries file
-	readCommonCountriesFile(commonCountries, theConfiguration.getEU4Path());
-	for (auto itr: theConfiguration.getEU4Mods())
+	WORKER_LOG(LogLevel::Info) << "Reading EU4 common/countries";
+	std::vector<std::pair<std::string, std::string>> tagFiles = {
+		{ theConfiguration().getEU4Path() + "/common/country_tags/00_countries.txt", theConfiguration().getEU4Path() }
+	};
+	for (auto itr: theConfiguration().getEU4Mods())
 	{
-		set<string> fileNames;
-		Utils::GetAllFilesInFolder(itr + "/common/country_tags/", fileNames);
-		for (set<string>::iterator fileItr = fileNames.begin(); fileItr != fileNames.end(); fileItr++)
+		for (const auto& tagFile: parsing::getFilesInFolder(itr + "/common/country_tags"))
 		{
-			ifstream convertedCommonCountries(itr + "/common/country_tags/" + *fileItr);	// a stream of the data in the converted countries file
-			readCommonCountriesFile(convertedCommonCountries, itr);
+			tagFiles.push_back(std::make_pair(tagFile, itr));
 		}
 	}
-}
-
+	std::vector<std::string> tagFileNames;
+	for (const auto& tagFile: tagFiles)
+	{
+		tagFileNames.push_back(tagFile.first);
+	}
 
-void EU4::world::readCommonCountriesFile(istream& in, const std::string& rootPath)
-{
-	// Add any info from common\countries
-	const int maxLineLength = 10000;	// the maximum line length
-	char line[maxLineLength];			// the line being processed
+	const parsing::FileCache cache;
+	std::optional<CommonCountries> commonCountries;
+	if (!cache.load("commonCountries", tagFileNames, [&commonCountries](parsing::SnapshotReader& snapshot) { commonCountries.emplace(snapshot); }))
+	{
+		commonCountries.emplace(tagFiles);
+		const auto writeCache = [&commonCountries](parsing::SnapshotWriter& snapshot) { commonCountries->writeSnapshot(snapshot); };
+		cache.store("commonCountries", tagFileNames, writeCache, commonCountries->getCountryFiles());
+	}
 
-	while (true)
+	for (const auto& commonCountry: commonCountries->getCountries())
 	{
-		in.getline(line, maxLineLength);
-		if (in.eof())
+		if (auto findIter = theCountries.find(commonCountry.tag); findIter != theCountries.end())
 		{
-			return;
-		}
-		std::string countryLine = line;
-		if (countryLine.size() >= 6 && countryLine[0] != '#')
-		{
-			// First three characters must be the tag.
-			std::string tag = countryLine.substr(0, 3);
-			if (auto findIter = theCountries.find(tag); findIter != theCountries.end())
-			{
-				auto country = findIter->second;
-
-				// The country file name is all the text after the equals sign (possibly in quotes).
-				size_t commentPos	= countryLine.find('#', 3);
-				if (commentPos != string::npos)
-				{
-					countryLine = countryLine.substr(0, commentPos);
-				}
-				size_t equalPos	= countryLine.find('=', 3);
-				size_t beginPos	= countryLine.find_first_not_of(' ', equalPos + 1);
-				size_t endPos		= countryLine.find_last_of('\"') + 1;
-				std::string fileName = countryLine.substr(beginPos, endPos - beginPos);
-				if (fileName.front() == '"' && fileName.back() == '"')
-				{
-					fileName = fileName.substr(1, fileName.size() - 2);
-				}
-				std::replace(fileName.begin(), fileName.end(), '/', '/');
-
-				// Parse the country file.
-				std::string fullFilename = rootPath + "/common/" + fileName;
-				size_t lastPathSeparatorPos = fullFilename.find_last_of('/');
-				std::string localFileName = fullFilename.substr(lastPathSeparatorPos + 1, string::npos);
-				if (Utils::DoesFileExist(fullFilename))
-				{
-					country->readFromCommonCountry(localFileName, fullFilename);
-				}
-			}
+			findIter->second->readFromCommonCountry(commonCountry.fileName, commonCountry.mapColor);
 		}
 	}
 }
@@ -574,16 +840,26 @@ void EU4::world::readCommonCountriesFile(istream& in, const std::string& rootPat
 
 void EU4::world::setLocalisations()
 {
-	LOG(LogLevel::Info) << "Reading localisation";
-	EU4Localisation localisation;
-	localisation.ReadFromAllFilesInFolder(theConfiguration.getEU4Path() + "/localisation");
-	for (auto itr: theConfiguration.getEU4Mods())
+	WORKER_LOG(LogLevel::Info) << "Reading localisation";
+	auto localisationFiles = parsing::getFilesInFolder(theConfiguration().getEU4Path() + "/localisation");
+	for (auto itr: theConfiguration().getEU4Mods())
 	{
-		LOG(LogLevel::Debug) << "Reading mod localisation";
-		localisation.ReadFromAllFilesInFolder(itr + "/localisation");
-		localisation.ReadFromAllFilesInFolder(itr + "/localisation/replace");
+		for (const auto* folder: { "/localisation", "/localisation/replace" })
+		{
+			for (const auto& localisationFile: parsing::getFilesInFolder(itr + folder))
+			{
+				localisationFiles.push_back(localisationFile);
+			}
+		}
 	}
 
+	const parsing::FileCache cache;
+	const auto localisation = cache.get<EU4Localisation>("countryLocalisation", localisationFiles, [&localisationFiles]() {
+		EU4Localisation localisation;
+		localisation.ReadFromFiles(localisationFiles, isCountryLocalisationKey);
+		return localisation;
+	});
+
 	for (auto theCountry: theCountries)
 	{
 		const auto& nameLocalisations = localisation.GetTextInEachLanguage(theCountry.second->getTag());	// the names in all languages
@@ -606,7 +882,7 @@ void EU4::world::setLocalisations()
 
 void EU4::world::resolveRegimentTypes()
 {
-	LOG(LogLevel::Info) << "Resolving unit types.";
+	WORKER_LOG(LogLevel::Info) << "Resolving unit types.";
 	mappers::UnitTypeMapper utm;
 	unitTypeMap = utm.getUnitTypeMap();
 
@@ -621,18 +897,18 @@ void EU4::world::resolveRegimentTypes()
 //		then break out things into subfunctions with a give rule as a parameter
 void EU4::world::mergeNations()
 {
-	LOG(LogLevel::Info) << "Merging nations";
-	shared_ptr<Object> mergeObj = parser_UTF8::doParseFile("merge_nations.txt");
+	WORKER_LOG(LogLevel::Info) << "Merging nations";
+	shared_ptr<Object> mergeObj = parsing::parseUTF8File("merge_nations.txt");
 	if (mergeObj == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse file merge_nations.txt";
+		WORKER_LOG(LogLevel::Error) << "Could not parse file merge_nations.txt";
 		exit(-1);
 	}
 
 	vector<shared_ptr<Object>> rules = mergeObj->getValue("merge_nations");
 	if (rules.size() < 0)
 	{
-		LOG(LogLevel::Debug) << "No nations have merging requested (skipping)";
+		WORKER_LOG(LogLevel::Debug) << "No nations have merging requested (skipping)";
 		return;
 	}
 
@@ -728,7 +1004,7 @@ void EU4::world::checkAllEU4ReligionsMapped(const mappers::ReligionMapper& relig
 		auto Vic2Religion = religionMapper.getVic2Religion(EU4Religion.first);
 		if (Vic2Religion == "")
 		{
-			Log(LogLevel::Warning) << "No religion mapping for EU4 religion " << EU4Religion.first;
+			WORKER_LOG(LogLevel::Warning) << "No religion mapping for EU4 religion " << EU4Religion.first;
 		}
 	}
 }
@@ -742,23 +1018,28 @@ void EU4::world::checkAllProvincesMapped(const mappers::ProvinceMapper& province
 
 void EU4::world::importReligions()
 {
-	LOG(LogLevel::Info) << "Parsing EU4 religions";
-
-	std::ifstream religionsFile(theConfiguration.getEU4Path() + "/common/religions/00_religion.txt");
-	theReligions.addReligions(religionsFile);
-	religionsFile.close();
+	WORKER_LOG(LogLevel::Info) << "Parsing EU4 religions";
 
-	for (auto modName: theConfiguration.getEU4Mods())
+	std::vector<std::string> religionsFiles = { theConfiguration().getEU4Path() + "/common/religions/00_religion.txt" };
+	for (auto modName: theConfiguration().getEU4Mods())
 	{
-		std::set<std::string> filenames;
-		Utils::GetAllFilesInFolder(modName + "/common/religions/", filenames);
-		for (auto filename: filenames)
+		for (const auto& religionsFile: parsing::getFilesInFolder(modName + "/common/religions"))
 		{
-			std::ifstream modReligionsFile(modName + "/common/religions/" + filename);
-			theReligions.addReligions(modReligionsFile);
-			modReligionsFile.close();
+			religionsFiles.push_back(religionsFile);
 		}
 	}
+
+	const parsing::FileCache cache;
+	theReligions = cache.get<Religions>("religions", religionsFiles, [&religionsFiles]() {
+		Religions religions;
+		for (const auto& religionsFileName: religionsFiles)
+		{
+			std::ifstream religionsFile(religionsFileName);
+			religions.addReligions(religionsFile);
+			religionsFile.close();
+		}
+		return religions;
+	});
 }
 
 
@@ -811,7 +1092,7 @@ void EU4::world::removeLandlessNations()
 		auto provinces = country.second->getProvinces();
 		if (provinces.size() == 0)
 		{
-			LOG(LogLevel::Debug) << "Removing landless nation " << country.first;
+			WORKER_LOG(LogLevel::Debug) << "Removing landless nation " << country.first;
 		}
 		else
 		{
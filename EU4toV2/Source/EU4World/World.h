@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "Army/EU4Army.h"
+#include "Buildings/Buildings.h"
 #include "EU4Diplomacy.h"
 #include "EU4Version.h"
 #include "Provinces/Provinces.h"
@@ -36,7 +37,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "../Mappers/UnitTypeMapper.h"
 #include "../Mappers/ProvinceMappings/ProvinceMapper.h"
 #include "../Mappers/ReligionMapper.h"
-#include "newParser.h"
+#include "../Parsing/BufferParser.h"
 #include <istream>
 #include <memory>
 
@@ -47,17 +48,37 @@ namespace mappers
 class IdeaEffectMapper;
 }
 
+namespace parsing
+{
+class BinaryTokenTable;
+class SnapshotReader;
+class SnapshotWriter;
+}
+
 namespace EU4
 {
 
+class countries;
 class Country;
+class MapAreaData;
 class Province;
 
 
-class world: private commonItems::parser
+// The building and modifier definitions from the EU4 install. They don't depend on the save, so they can be read
+// while it is being parsed.
+struct InstallData
+{
+	Buildings buildingTypes;
+	Modifiers modifierTypes;
+};
+
+
+class world: private parsing::BufferParser
 {
 	public:
-		world(const std::string& EU4SaveFileName, const mappers::IdeaEffectMapper& ideaEffectMapper);
+		world(const std::string& EU4SaveFileName, const mappers::IdeaEffectMapper& ideaEffectMapper, const InstallData& installData);
+
+		static InstallData importInstallData();
 
 		const Province& getProvince(int provNum) const;
 
@@ -75,28 +96,33 @@ class world: private commonItems::parser
 		bool isRandomWorld() const;
 
 	private:
-		void verifySave(const string& EU4SaveFileName);
+		enum class saveFormat { text, zipped, binary };
+		saveFormat verifySave(const string& EU4SaveFileName);
+		void parseZippedSave(const string& EU4SaveFileName);
+		void parseBinarySave(std::string_view save, const parsing::BinaryTokenTable& tokens);
+
+		static uint64_t getSnapshotKey(const std::string& EU4SaveFileName, saveFormat format);
+		static std::string getSnapshotFileName(uint64_t key);
+		bool loadSnapshot(uint64_t key);
+		void readSnapshot(parsing::SnapshotReader& snapshot);
+		void saveSnapshot(uint64_t key) const;
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 		void loadEU4Version(const shared_ptr<Object> EU4SaveObj);
-		void loadActiveDLC(const shared_ptr<Object> EU4SaveObj);
-		void loadEmpires(const shared_ptr<Object> EU4SaveObj);
-		void loadHolyRomanEmperor(vector<shared_ptr<Object>> empireObj);
-		void loadCelestialEmperor(vector<shared_ptr<Object>> celestialEmpireObj);
+		static void loadEmperor(parsing::Tokenizer& tokenizer, std::string& emperor);
 
-		void loadCountries(std::istream& theStream, const mappers::IdeaEffectMapper& ideaEffectMapper);
-		void loadRevolutionTargetString(const shared_ptr<Object> EU4SaveObj);
+		void loadCountries(countries& processedCountries);
+		static void logArenaCounters();
 		void loadRevolutionTarget();
 		void dropMinoritiesFromCountries();
 		void addProvinceInfoToCountries();
-		void loadDiplomacy(const shared_ptr<Object> EU4SaveObj);
-		void loadMapAreaData(const shared_ptr<Object> mapAreaObject);
+		void loadMapAreaData(const MapAreaData& mapAreaData);
 
 		void loadRegions();
 		void loadEU4RegionsNewVersion();
 		void loadEU4RegionsOldVersion();
 
 		void readCommonCountries();
-		void readCommonCountriesFile(istream&, const std::string& rootPath);
 
 		void setLocalisations();
 
@@ -120,6 +146,7 @@ class world: private commonItems::parser
 		string celestialEmperor;
 		std::unique_ptr<Regions> regions;
 		std::unique_ptr<Provinces> provinces;
+		std::vector<std::unique_ptr<parsing::Arena>> countryArenas; // before the countries, which live in them
 		std::map<std::string, std::shared_ptr<EU4::Country>> theCountries;
 		std::unique_ptr<EU4Diplomacy> diplomacy;
 		std::unique_ptr<EU4::Version> version;
@@ -21,40 +21,263 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include "EU4ToVic2Converter.h"
 #include "Configuration.h"
-#include "Log.h"
+#include "ConversionBatch.h"
+#include "ConversionContext.h"
+#include "ConversionDaemon.h"
+#include "Parsing/TaskGraph.h"
+#include "Parsing/WorkerLog.h"
+#include "Parsing/WorkerPool.h"
 #include "OSCompatibilityLayer.h"
 #include "EU4World/World.h"
-#include "Mappers/Ideas/IdeaEffectMapper.h"
-#include "Mappers/Ideas/TechGroupsMapper.h"
+#include "Mappers/AdjacencyMapper.h"
 #include "V2World/V2World.h"
+#include "V2World/Vic2Regions.h"
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 
 
 
 void setOutputName(const string& EU4SaveFileName);
 void deleteExistingOutputFolder();
+
+
+
+namespace
+{
+	typedef parsing::TaskGraph::StageId StageId;
+
+	// one for each stage that can run at once; the stages spread their own work over further threads
+	const size_t stageThreadCount = 5;
+
+
+	mappers::IdeaEffectMapper readIdeaEffects()
+	{
+		std::ifstream ideaEffectsFile("idea_effects.txt");
+		std::ifstream reformEffectsFile("reform_effects.txt");
+		return mappers::IdeaEffectMapper(ideaEffectsFile, reformEffectsFile);
+	}
+
+
+	mappers::TechGroupsMapper readTechGroups()
+	{
+		std::ifstream techGroupsFile("techGroups.txt");
+		return mappers::TechGroupsMapper(techGroupsFile);
+	}
+
+
+	// the stage runs in the conversion context of the thread that built the graph
+	StageId addStage(parsing::TaskGraph& graph, const std::string& name, std::function<void()> work, const std::vector<StageId>& dependencies = {})
+	{
+		auto& context = ConversionContext::current();
+		return graph.addStage(name, [&context, work = std::move(work)]() {
+			ConversionContext::Scope contextScope(context);
+			work();
+		}, dependencies);
+	}
+
+
+	std::vector<StageId> allOf(std::initializer_list<std::vector<StageId>> stageLists)
+	{
+		std::vector<StageId> stages;
+		for (const auto& stageList: stageLists)
+		{
+			stages.insert(stages.end(), stageList.begin(), stageList.end());
+		}
+		return stages;
+	}
+
+
+	// empty where the data was already loaded
+	struct BaseDataStages
+	{
+		std::vector<StageId> ideaEffects;
+		std::vector<StageId> techGroups;
+		std::vector<StageId> EU4InstallData;
+		std::vector<StageId> Vic2StaticData;
+	};
+
+
+	BaseDataStages addBaseDataStages(parsing::TaskGraph& graph, ConversionBaseData& data, StageId configuration)
+	{
+		BaseDataStages stages;
+		stages.ideaEffects = { addStage(graph, "Idea effects", [&data]() { data.ideaEffectMapper.emplace(readIdeaEffects()); }) };
+		stages.techGroups = { addStage(graph, "Tech groups", [&data]() { data.techGroupsMapper.emplace(readTechGroups()); }) };
+		stages.EU4InstallData = { addStage(graph, "EU4 install data", [&data]() {
+			data.EU4InstallData.emplace(EU4::world::importInstallData());
+		}, { configuration }) };
+		stages.Vic2StaticData = { addStage(graph, "Vic2 base data", [&data]() {
+			data.Vic2StaticData.emplace(V2World::importStaticData());
+		}, { configuration }) };
+		return stages;
+	}
+
+
+	// stages overlap, so only their sum along the critical path says where the time went
+	void logStageTimes(const parsing::TaskGraph& graph)
+	{
+		for (const auto& timing: graph.getTimings())
+		{
+			WORKER_LOG(LogLevel::Debug) << "Stage " << timing.name << " ran from " << timing.start << " to " << timing.start + timing.seconds << " seconds";
+		}
+
+		std::ostringstream path;
+		path.setf(std::ios::fixed);
+		path.precision(2);
+		double pathSeconds = 0.0;
+		for (const auto& timing: graph.getCriticalPath())
+		{
+			if (pathSeconds > 0.0)
+			{
+				path << " -> ";
+			}
+			path << timing.name << " (" << timing.seconds << ")";
+			pathSeconds += timing.seconds;
+		}
+		WORKER_LOG(LogLevel::Info) << "Critical path, " << pathSeconds << " of " << graph.getSeconds() << " seconds: " << path.str();
+	}
+
+
+	// Loaded base data was read from the installs the session was started with, and a job can't point elsewhere.
+	void readJobConfiguration(const ConversionJob& job, const ConversionBaseData* loadedData)
+	{
+		ConfigurationFile configurationFile("configuration.txt");
+		if (!job.configurationOverrides.empty())
+		{
+			std::istringstream overrides(job.configurationOverrides);
+			theConfiguration().instantiate(overrides, Utils::doesFolderExist, Utils::DoesFileExist);
+		}
+		if ((loadedData != nullptr) && (theConfiguration().getEU4Path() != loadedData->EU4Path))
+		{
+			throw std::runtime_error("The EU4 install can't be changed from " + loadedData->EU4Path + " for one job");
+		}
+		if ((loadedData != nullptr) && (theConfiguration().getVic2Path() != loadedData->Vic2Path))
+		{
+			throw std::runtime_error("The Vic2 install can't be changed from " + loadedData->Vic2Path + " for one job");
+		}
+		if (job.outputName.empty())
+		{
+			setOutputName(job.EU4SaveFileName);
+		}
+		else
+		{
+			theConfiguration().setOutputName(job.outputName);
+			WORKER_LOG(LogLevel::Info) << "Using output name " << job.outputName;
+		}
+		deleteExistingOutputFolder();
+	}
+
+
+	// Without loaded data, the graph reads it as well, alongside the save.
+	void runConversion(const ConversionJob& job, const ConverterSession::ProgressReporter& reportProgress, const ConversionBaseData* loadedData)
+	{
+		ConversionContext context;
+		ConversionContext::Scope contextScope(context);
+
+		// stages start on different threads, and a daemon's client should get whole lines
+		std::mutex progressMutex;
+		const auto startStage = [&reportProgress, &progressMutex](const std::string& stage) {
+			if (reportProgress)
+			{
+				std::lock_guard<std::mutex> lock(progressMutex);
+				reportProgress(stage);
+			}
+		};
+
+		parsing::TaskGraph graph;
+		const auto configuration = addStage(graph, "Configuration", [&job, loadedData]() { readJobConfiguration(job, loadedData); });
+
+		ConversionBaseData readData;
+		BaseDataStages baseDataStages;
+		if (loadedData == nullptr)
+		{
+			baseDataStages = addBaseDataStages(graph, readData, configuration);
+		}
+		const auto& data = (loadedData != nullptr) ? *loadedData : readData;
+
+		const auto Vic2Map = addStage(graph, "Vic2 map data", []() {
+			mappers::adjacencyMapper::load();
+			Vic2::regions::load();
+		}, { configuration });
+
+		std::unique_ptr<EU4::world> sourceWorld;
+		const auto save = addStage(graph, "EU4 save", [&job, &data, &sourceWorld, &startStage]() {
+			startStage("Reading EU4 save");
+			sourceWorld = std::make_unique<EU4::world>(job.EU4SaveFileName, *data.ideaEffectMapper, *data.EU4InstallData);
+		}, allOf({ { configuration }, baseDataStages.ideaEffects, baseDataStages.EU4InstallData }));
+
+		std::unique_ptr<V2World> destWorld;
+		const auto Vic2Import = addStage(graph, "Vic2 provinces and pops", [&data, &destWorld]() {
+			destWorld = std::make_unique<V2World>(*data.Vic2StaticData);
+		}, allOf({ { configuration }, baseDataStages.Vic2StaticData }));
+
+		addStage(graph, "Vic2 world", [&data, &sourceWorld, &destWorld, &startStage]() {
+			startStage("Building and writing Vic2 world");
+			destWorld->convert(*sourceWorld, *data.ideaEffectMapper, *data.techGroupsMapper, *data.Vic2StaticData);
+		}, allOf({ { save, Vic2Import, Vic2Map }, baseDataStages.techGroups }));
+
+		parsing::WorkerPool pool(stageThreadCount);
+		graph.run(pool);
+		logStageTimes(graph);
+		WORKER_LOG(LogLevel::Info) << "* Conversion complete *";
+	}
+}
+
+
+
+ConverterSession::ConverterSession()
+{
+	parsing::TaskGraph graph;
+	const auto configuration = addStage(graph, "Configuration", [this]() {
+		// for the location of the installs
+		ConfigurationFile configurationFile("configuration.txt");
+		baseData.EU4Path = theConfiguration().getEU4Path();
+		baseData.Vic2Path = theConfiguration().getVic2Path();
+	});
+	addBaseDataStages(graph, baseData, configuration);
+
+	parsing::WorkerPool pool(stageThreadCount);
+	graph.run(pool);
+	logStageTimes(graph);
+}
+
+
+void ConverterSession::convert(const ConversionJob& job, const ProgressReporter& reportProgress) const
+{
+	runConversion(job, reportProgress, &baseData);
+}
+
+
+void ConverterSession::convertOnce(const ConversionJob& job)
+{
+	runConversion(job, {}, nullptr);
+}
+
+
 void ConvertEU4ToVic2(const string& EU4SaveFileName)
 {
-	ConfigurationFile configurationFile("configuration.txt");
-	setOutputName(EU4SaveFileName);
-	deleteExistingOutputFolder();
+	ConverterSession::convertOnce({ EU4SaveFileName, "" });
+}
 
-	std::ifstream ideaEffectsFile("idea_effects.txt");
-	std::ifstream reformEffectsFile("reform_effects.txt");
-	mappers::IdeaEffectMapper ideaEffectMapper(ideaEffectsFile, reformEffectsFile);
-	ideaEffectsFile.close();
-	reformEffectsFile.close();
 
-	std::ifstream techGroupsFile("techGroups.txt");
-	mappers::TechGroupsMapper techGroupsMapper(techGroupsFile);
-	techGroupsFile.close();
+int ConvertEU4ToVic2Batch(const std::vector<ConversionJob>& jobs, size_t parallelJobs)
+{
+	const ConverterSession session;
+	return runConversionBatch(jobs, [&session](const ConversionJob& job) { session.convert(job); }, parallelJobs);
+}
 
-	EU4::world sourceWorld(EU4SaveFileName, ideaEffectMapper);
-	V2World destWorld(sourceWorld, ideaEffectMapper, techGroupsMapper);
 
-	LOG(LogLevel::Info) << "* V2 construction: " << destWorld.getDuration() << " seconds";
-	LOG(LogLevel::Info) << "* Conversion complete *";
+void RunEU4ToVic2Daemon(const std::string& socketPath, size_t parallelJobs)
+{
+	const ConverterSession session;
+	ConversionDaemon daemon(socketPath, [&session](const ConversionJob& job, const ConversionDaemon::ProgressReporter& reportProgress) {
+		session.convert(job, reportProgress);
+	}, parallelJobs);
+	daemon.run();
 }
 
 
@@ -68,8 +291,8 @@ void setOutputName(const string& EU4SaveFileName)
 	outputName = replaceCharacter(outputName, '-');
 	outputName = replaceCharacter(outputName, ' ');
 
-	theConfiguration.setOutputName(outputName);
-	LOG(LogLevel::Info) << "Using output name " << outputName;
+	theConfiguration().setOutputName(outputName);
+	WORKER_LOG(LogLevel::Info) << "Using output name " << outputName;
 }
 
 
@@ -102,12 +325,12 @@ string replaceCharacter(string fileName, char character)
 
 void deleteExistingOutputFolder()
 {
-	string outputFolder = Utils::getCurrentDirectory() + "/output/" + theConfiguration.getOutputName();
+	string outputFolder = Utils::getCurrentDirectory() + "/output/" + theConfiguration().getOutputName();
 	if (Utils::doesFolderExist(outputFolder.c_str()))
 	{
 		if (!Utils::deleteFolder(outputFolder))
 		{
-			LOG(LogLevel::Error) << "Could not delete pre-existing output folder " << Utils::getCurrentDirectory() << "/output/" << theConfiguration.getOutputName();
+			WORKER_LOG(LogLevel::Error) << "Could not delete pre-existing output folder " << Utils::getCurrentDirectory() << "/output/" << theConfiguration().getOutputName();
 			exit(-1);
 		}
 	}
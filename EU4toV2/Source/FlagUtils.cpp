@@ -1,7 +1,7 @@
 #include "FlagUtils.h"
 #include "targa.h"
 
-#include "Log.h"
+#include "Parsing/WorkerLog.h"
 
 bool CreateColonialFlag(std::string colonialOverlordPath, std::string colonialBasePath, std::string targetPath)
 {
@@ -13,14 +13,14 @@ bool CreateColonialFlag(std::string colonialOverlordPath, std::string colonialBa
 	res = tga_read(&ColonialBase, colonialBasePath.c_str());
 	if (0 != res)
 	{
-		LOG(LogLevel::Error) << "Failed to create colonial flag: could not open " << colonialBasePath;
+		WORKER_LOG(LogLevel::Error) << "Failed to create colonial flag: could not open " << colonialBasePath;
 		return false;
 	}
 
 	res = tga_read(&Corner, colonialOverlordPath.c_str());
 	if (0 != res)
 	{
-		LOG(LogLevel::Error) << "Failed to create colonial flag: could not open " << colonialOverlordPath;
+		WORKER_LOG(LogLevel::Error) << "Failed to create colonial flag: could not open " << colonialOverlordPath;
 		return false;
 	}
 
@@ -44,7 +44,7 @@ bool CreateColonialFlag(std::string colonialOverlordPath, std::string colonialBa
 				res = tga_unpack_pixel(sample[px], Corner.pixel_depth, &b, &g, &r, NULL);
 				if (0 != res)
 				{
-					LOG(LogLevel::Error) << "Failed to create colonial flag: could not read pixel data";
+					WORKER_LOG(LogLevel::Error) << "Failed to create colonial flag: could not read pixel data";
 					return false;
 				}
 				tb += b / 4; tg += g / 4; tr += r / 4;
@@ -53,7 +53,7 @@ bool CreateColonialFlag(std::string colonialOverlordPath, std::string colonialBa
 			res = tga_pack_pixel(targetAddress, ColonialBase.pixel_depth, tb, tg, tr, 255);
 			if (0 != res)
 			{
-				LOG(LogLevel::Error) << "Failed to create colonial flag: could not write pixel data";
+				WORKER_LOG(LogLevel::Error) << "Failed to create colonial flag: could not write pixel data";
 				return false;
 			}
 		}
@@ -61,7 +61,7 @@ bool CreateColonialFlag(std::string colonialOverlordPath, std::string colonialBa
 	res = tga_write(targetPath.c_str(), &ColonialBase);
 	if (0 != res)
 	{
-		LOG(LogLevel::Error) << "Failed to create colonial flag: could not write to " << targetPath;
+		WORKER_LOG(LogLevel::Error) << "Failed to create colonial flag: could not write to " << targetPath;
 		return false;
 	}
 
@@ -78,14 +78,14 @@ bool CreateCustomFlag(commonItems::Color c1, commonItems::Color c2, commonItems:
 	res = tga_read(&base, basePath.c_str());
 	if (0 != res)
 	{
-		LOG(LogLevel::Error) << "Failed to create custom flag: could not open " << basePath;
+		WORKER_LOG(LogLevel::Error) << "Failed to create custom flag: could not open " << basePath;
 		return false;
 	}
 
 	res = tga_read(&emblem, emblemPath.c_str());
 	if (0 != res)
 	{
-		LOG(LogLevel::Error) << "Failed to create custom flag: could not open " << emblemPath;
+		WORKER_LOG(LogLevel::Error) << "Failed to create custom flag: could not open " << emblemPath;
 		return false;
 	}
 
@@ -100,7 +100,7 @@ bool CreateCustomFlag(commonItems::Color c1, commonItems::Color c2, commonItems:
 			res = tga_unpack_pixel(targetAddress, base.pixel_depth, &b, &g, &r, NULL);
 			if (0 != res)
 			{
-				LOG(LogLevel::Error) << "Failed to create custom flag: could not read pixel data";
+				WORKER_LOG(LogLevel::Error) << "Failed to create custom flag: could not read pixel data";
 				return false;
 			}
 
@@ -124,7 +124,7 @@ bool CreateCustomFlag(commonItems::Color c1, commonItems::Color c2, commonItems:
 				res = tga_unpack_pixel(targetOverlayAddress, emblem.pixel_depth, &oBlue, &oGreen, &oRed, &oAlpha);
 				if (0 != res)
 				{
-					LOG(LogLevel::Error) << "Failed to create custom flag: could not read pixel data";
+					WORKER_LOG(LogLevel::Error) << "Failed to create custom flag: could not read pixel data";
 					return false;
 				}
 				
@@ -134,13 +134,13 @@ bool CreateCustomFlag(commonItems::Color c1, commonItems::Color c2, commonItems:
 			}
 			else
 			{
-				LOG(LogLevel::Info) << x << " " << y;
+				WORKER_LOG(LogLevel::Info) << x << " " << y;
 			}
 
 			res = tga_pack_pixel(targetAddress, base.pixel_depth, tb, tg, tr, 255);
 			if (0 != res)
 			{
-				LOG(LogLevel::Error) << "Failed to create custom flag: could not write pixel data";
+				WORKER_LOG(LogLevel::Error) << "Failed to create custom flag: could not write pixel data";
 				return false;
 			}
 
@@ -150,7 +150,7 @@ bool CreateCustomFlag(commonItems::Color c1, commonItems::Color c2, commonItems:
 	res = tga_write(targetPath.c_str(), &base);
 	if (0 != res)
 	{
-		LOG(LogLevel::Error) << "Failed to create custom flag: could not write to " << targetPath;
+		WORKER_LOG(LogLevel::Error) << "Failed to create custom flag: could not write to " << targetPath;
 		return false;
 	}
 
@@ -23,50 +23,57 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "AdjacencyMapper.h"
 #include "../Configuration.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include <fstream>
 #include <cstdint>
+#include <cstring>
 using namespace std;
 
 
 
-mappers::adjacencyMapper* mappers::adjacencyMapper::instance = nullptr;
-
-
-
 mappers::adjacencyMapper::adjacencyMapper()
 {
-	LOG(LogLevel::Info) << "Importing province adjacencies";
+	WORKER_LOG(LogLevel::Info) << "Importing province adjacencies";
 	string filename = getAdjacencyFilename();
 
-	ifstream adjacenciesFile(filename, std::ios_base::binary);
+	ifstream adjacenciesFile(filename, std::ios_base::binary | std::ios_base::ate);
 	if (!adjacenciesFile.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not open " << filename;
+		WORKER_LOG(LogLevel::Error) << "Could not open " << filename;
 		exit(-1);
 	}
 
-	inputAdjacencies(adjacenciesFile);
+	string contents(static_cast<size_t>(adjacenciesFile.tellg()), '\0');
+	adjacenciesFile.seekg(0);
+	adjacenciesFile.read(&contents[0], contents.size());
 	adjacenciesFile.close();
 
-	if (theConfiguration.getDebug())
+	inputAdjacencies(contents, theConfiguration().getVic2Gametype());
+
+	if (theConfiguration().getDebug())
 	{
 		outputAdjacenciesMapData();
 	}
 }
 
 
+mappers::adjacencyMapper::adjacencyMapper(std::string_view contents, const std::string& gametype)
+{
+	inputAdjacencies(contents, gametype);
+}
+
+
 std::string mappers::adjacencyMapper::getAdjacencyFilename()
 {
-	string filename = theConfiguration.getVic2DocumentsPath() + "/map/cache/adjacencies.bin";
+	string filename = theConfiguration().getVic2DocumentsPath() + "/map/cache/adjacencies.bin";
 	if (!Utils::DoesFileExist(filename))
 	{
-		LOG(LogLevel::Warning) << "Could not find " << filename << " - looking in install folder";
-		filename = theConfiguration.getVic2Path() + "/map/cache/adjacencies.bin";
+		WORKER_LOG(LogLevel::Warning) << "Could not find " << filename << " - looking in install folder";
+		filename = theConfiguration().getVic2Path() + "/map/cache/adjacencies.bin";
 		if (!Utils::DoesFileExist(filename))
 		{
-			LOG(LogLevel::Error) << "Could not find " << filename << ". Try running Vic2 and converting again.";
+			WORKER_LOG(LogLevel::Error) << "Could not find " << filename << ". Try running Vic2 and converting again.";
 			exit(-1);
 		}
 	}
@@ -75,21 +82,6 @@ std::string mappers::adjacencyMapper::getAdjacencyFilename()
 }
 
 
-void mappers::adjacencyMapper::inputAdjacencies(std::istream& adjacenciesFile)
-{
-	int current_province = 0;
-	while (!adjacenciesFile.eof())
-	{
-		uint32_t numAdjacencies;
-		adjacenciesFile.read(reinterpret_cast<char*>(&numAdjacencies), 4);
-
-		vector<int> adjacencies = readAnAdjacenciesSet(adjacenciesFile, numAdjacencies);
-		adjacencyMap.insert(make_pair(current_province, adjacencies));
-		current_province++;
-	}
-}
-
-
 typedef struct
 {
 	uint32_t type;			// the type of adjacency 0 = normal, 1 = ford, 2 = river crossing
@@ -103,21 +95,6 @@ typedef struct
 	uint32_t unknown4;		// still unknown
 } HODAdjacency;		// an entry in the HOD adjacencies.bin format
 
-std::istream& operator >> (std::istream& stream, HODAdjacency& adjacency)
-{
-	stream.read(reinterpret_cast<char*>(&adjacency.type), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.to), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.via), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown1), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown2), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.pathX), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.pathY), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown3), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown4), 4);
-
-	return stream;
-};
-
 typedef struct
 {
 	uint32_t type;			// the type of adjacency 0 = normal, 1 = ford, 2 = river crossing
@@ -129,19 +106,6 @@ typedef struct
 	uint32_t pathY;			// the midpoint on the path drawn between provinces
 } AHDAdjacency;		// an entry in the AHD adjacencies.bin format
 
-std::istream& operator >> (std::istream& stream, AHDAdjacency& adjacency)
-{
-	stream.read(reinterpret_cast<char*>(&adjacency.type), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.to), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.via), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown1), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown2), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.pathX), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.pathY), 4);
-
-	return stream;
-}
-
 typedef struct
 {
 	uint32_t type;			// the type of adjacency 0 = normal, 1 = ford, 2 = river crossing
@@ -151,44 +115,59 @@ typedef struct
 	uint32_t unknown2;		// still unknown
 } VanillaAdjacency;	// an entry in the vanilla adjacencies.bin format
 
-std::istream& operator >> (std::istream& stream, VanillaAdjacency& adjacency)
-{
-	stream.read(reinterpret_cast<char*>(&adjacency.type), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.to), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.via), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown1), 4);
-	stream.read(reinterpret_cast<char*>(&adjacency.unknown2), 4);
 
-	return stream;
+void mappers::adjacencyMapper::inputAdjacencies(std::string_view contents, const std::string& gametype)
+{
+	if (gametype == "vanilla")
+	{
+		inputAdjacencyRecords<VanillaAdjacency>(contents);
+	}
+	else if (gametype == "AHD")
+	{
+		inputAdjacencyRecords<AHDAdjacency>(contents);
+	}
+	else if ((gametype == "HOD") || (gametype == "HoD-NNM"))
+	{
+		inputAdjacencyRecords<HODAdjacency>(contents);
+	}
+	else
+	{
+		WORKER_LOG(LogLevel::Warning) << "Unknown Vic2 gametype " << gametype << ", so no province adjacencies were read";
+		neighborOffsets.assign(1, 0);
+	}
 }
 
 
-std::vector<int> mappers::adjacencyMapper::readAnAdjacenciesSet(std::istream& adjacenciesFile, unsigned int numAdjacencies)
+// The file is each province in turn: a count, then that many records. Knowing the record size here lets the
+// whole file be walked as a buffer, picking the neighbor out of each record.
+template<typename Record>
+void mappers::adjacencyMapper::inputAdjacencyRecords(std::string_view contents)
 {
-	vector<int> adjacencies;
-	for (unsigned int i = 0; i < numAdjacencies; i++)
+	neighborOffsets.assign(1, 0);
+	neighbors.clear();
+	neighbors.reserve(contents.size() / sizeof(Record));
+
+	size_t position = 0;
+	while (contents.size() - position >= sizeof(uint32_t))
 	{
-		if (theConfiguration.getVic2Gametype() == "vanilla")
-		{
-			VanillaAdjacency readAdjacency;
-			adjacenciesFile >> readAdjacency;
-			adjacencies.push_back(readAdjacency.to);
-		}
-		else if (theConfiguration.getVic2Gametype() == "AHD")
+		uint32_t numAdjacencies;
+		memcpy(&numAdjacencies, contents.data() + position, sizeof(numAdjacencies));
+		position += sizeof(numAdjacencies);
+		if ((contents.size() - position) / sizeof(Record) < numAdjacencies)
 		{
-			AHDAdjacency readAdjacency;
-			adjacenciesFile >> readAdjacency;
-			adjacencies.push_back(readAdjacency.to);
+			WORKER_LOG(LogLevel::Warning) << "adjacencies.bin ends partway through province " << neighborOffsets.size() - 1;
+			break;
 		}
-		if ((theConfiguration.getVic2Gametype() == "HOD") || (theConfiguration.getVic2Gametype() == "HoD-NNM"))
+
+		for (uint32_t i = 0; i < numAdjacencies; i++)
 		{
-			HODAdjacency readAdjacency;
-			adjacenciesFile >> readAdjacency;
-			adjacencies.push_back(readAdjacency.to);
+			Record readAdjacency;
+			memcpy(&readAdjacency, contents.data() + position, sizeof(Record));
+			position += sizeof(Record);
+			neighbors.push_back(readAdjacency.to);
 		}
+		neighborOffsets.push_back(neighbors.size());
 	}
-
-	return adjacencies;
 }
 
 
@@ -197,11 +176,11 @@ void mappers::adjacencyMapper::outputAdjacenciesMapData()
 	ofstream adjacenciesData("adjacenciesData.csv");
 
 	adjacenciesData << "From,To\n";
-	for (auto adjacencyMapping: adjacencyMap)
+	for (size_t province = 0; province + 1 < neighborOffsets.size(); province++)
 	{
-		for (auto adjacency: adjacencyMapping.second)
+		for (auto adjacency: getAdjacencies(static_cast<int>(province)))
 		{
-			adjacenciesData << adjacencyMapping.first << "," << adjacency << "\n";
+			adjacenciesData << province << "," << adjacency << "\n";
 		}
 	}
 
@@ -209,14 +188,13 @@ void mappers::adjacencyMapper::outputAdjacenciesMapData()
 }
 
 
-std::optional<std::vector<int>> mappers::adjacencyMapper::GetVic2Adjacencies(int Vic2Province)
+parsing::Span<const int> mappers::adjacencyMapper::getAdjacencies(int Vic2Province) const
 {
-	if(adjacencyMap.find(Vic2Province) != adjacencyMap.end())
-	{
-		return adjacencyMap.at(Vic2Province);
-	}
-	else
+	if ((Vic2Province < 0) || (static_cast<size_t>(Vic2Province) + 1 >= neighborOffsets.size()))
 	{
 		return {};
 	}
+
+	const auto first = neighborOffsets[Vic2Province];
+	return parsing::Span<const int>(neighbors.data() + first, neighborOffsets[Vic2Province + 1] - first);
 }
\ No newline at end of file
@@ -26,47 +26,53 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-#include <fstream>
-#include <map>
-#include <optional>
+#include "../Parsing/Span.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 
 
 namespace mappers
 {
+	// The Vic2 province graph from adjacencies.bin, as one array of every province's neighbors and, for each
+	// province, where its neighbors start in it.
 	class adjacencyMapper
 	{
 		public:
-			static std::optional<std::vector<int>> getVic2Adjacencies(int Vic2Province)
+			// contents is a whole adjacencies.bin, laid out for the given Vic2 gametype
+			adjacencyMapper(std::string_view contents, const std::string& gametype);
+
+			// the provinces next to Vic2Province, empty for a province that isn't in the graph
+			static parsing::Span<const int> getVic2Adjacencies(int Vic2Province)
 			{
-				return getInstance()->GetVic2Adjacencies(Vic2Province);
+				return getInstance()->getAdjacencies(Vic2Province);
 			}
 
+			// reads the adjacencies now instead of on first use, so it can be done while a save is parsed
+			static void load() { getInstance(); }
+
+			parsing::Span<const int> getAdjacencies(int Vic2Province) const;
+
 		private:
-			static adjacencyMapper* instance;
 			static adjacencyMapper* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new adjacencyMapper;
-				}
-
+				// read once from the Vic2 install and shared by every conversion; a function-local static
+				// is made exactly once even if several conversions get here together
+				static adjacencyMapper* instance = new adjacencyMapper;
 				return instance;
 			}
 
 			adjacencyMapper();
 			std::string getAdjacencyFilename();
-			void inputAdjacencies(std::istream& adjacenciesFile);
-			std::vector<int> readAnAdjacenciesSet(std::istream& adjacenciesFile, unsigned int numAdjacencies);
+			void inputAdjacencies(std::string_view contents, const std::string& gametype);
+			template<typename Record> void inputAdjacencyRecords(std::string_view contents);
 
 			void outputAdjacenciesMapData();
 
-			std::optional<std::vector<int>> GetVic2Adjacencies(int Vic2Province);
-
 
-			std::map<int, std::vector<int>> adjacencyMap;
+			std::vector<size_t> neighborOffsets; // one more than there are provinces; province i's run ends where i + 1's begins
+			std::vector<int> neighbors;
 	};
 }
 
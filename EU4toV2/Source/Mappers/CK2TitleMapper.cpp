@@ -22,15 +22,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "CK2TitleMapper.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 
 
 
-mappers::CK2TitleMapper* mappers::CK2TitleMapper::instance = nullptr;
-
-
-
 class titleMapping: commonItems::parser
 {
 	public:
@@ -99,7 +95,7 @@ mappers::CK2TitleMapper::CK2TitleMapper():
 	indianFlags(),
 	generator()
 {
-	LOG(LogLevel::Info) << "Getting CK2 titles";
+	WORKER_LOG(LogLevel::Info) << "Getting CK2 titles";
 
 	registerKeyword(std::regex("link"), [this](const std::string& unused, std::istream& theStream)
 		{
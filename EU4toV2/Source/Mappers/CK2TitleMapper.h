@@ -32,6 +32,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <set>
 #include <string>
 #include <vector>
+#include "../ConversionContext.h"
 #include "newParser.h"
 
 
@@ -62,14 +63,9 @@ namespace mappers
 			}
 
 		private:
-			static CK2TitleMapper* instance;
 			static CK2TitleMapper* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new CK2TitleMapper;
-				}
-				return instance;
+				return &ConversionContext::current().getState<CK2TitleMapper>([]() { return new CK2TitleMapper; });
 			}
 
 			CK2TitleMapper();
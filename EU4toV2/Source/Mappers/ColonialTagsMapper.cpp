@@ -22,19 +22,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "ColonialTagsMapper.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "Object.h"
 #include "ParadoxParserUTF8.h"
 
 
 
-mappers::colonialTagMapper* mappers::colonialTagMapper::instance = nullptr;
-
-
-
 mappers::colonialTagMapper::colonialTagMapper()
 {
-	LOG(LogLevel::Info) << "Parsing colony naming rules.";
+	WORKER_LOG(LogLevel::Info) << "Parsing colony naming rules.";
 
 	commonItems::parsingFunction mappingFunction = std::bind(&mappers::colonialTagMapper::initMapping, this, std::placeholders::_1, std::placeholders::_2);
 	registerKeyword(std::regex("link"), mappingFunction);
@@ -52,13 +52,10 @@ namespace mappers
 			}
 
 		private:
-			static colonialTagMapper* instance;
 			static colonialTagMapper* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new colonialTagMapper;
-				}
+				// the naming rules don't depend on the save, so all conversions share this one
+				static colonialTagMapper* instance = new colonialTagMapper;
 				return instance;
 			}
 
@@ -22,14 +22,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "ColonyFlagsetMapper.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 
 
 
-mappers::colonyFlagsetMapper* mappers::colonyFlagsetMapper::instance = nullptr;
-
-
 mappers::colonyFlag::colonyFlag(std::istream& theStream, const std::string& region):
 	name(),
 	region(region),
@@ -78,7 +75,7 @@ mappers::colonyFlagsetRegion::colonyFlagsetRegion(std::istream& theStream, const
 
 mappers::colonyFlagsetMapper::colonyFlagsetMapper()
 {
-	LOG(LogLevel::Info) << "Parsing colony naming rules.";
+	WORKER_LOG(LogLevel::Info) << "Parsing colony naming rules.";
 
 	registerKeyword(std::regex("[\\w_]+"), [this](const std::string& region, std::istream& theStream)
 		{
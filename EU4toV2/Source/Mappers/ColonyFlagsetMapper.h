@@ -26,6 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include "../ConversionContext.h"
 #include "newParser.h"
 #include <map>
 #include <memory>
@@ -81,14 +82,9 @@ namespace mappers
 			}
 
 		private:
-			static colonyFlagsetMapper* instance;
 			static colonyFlagsetMapper* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new colonyFlagsetMapper;
-				}
-				return instance;
+				return &ConversionContext::current().getState<colonyFlagsetMapper>([]() { return new colonyFlagsetMapper; });
 			}
 			colonyFlagsetMapper();
 
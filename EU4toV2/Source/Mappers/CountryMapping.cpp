@@ -34,15 +34,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "ProvinceMappings/ProvinceMapper.h"
 #include "../V2World/Vic2Regions.h"
 #include "../V2World/V2Country.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 
 
 
-mappers::CountryMappings* mappers::CountryMappings::instance = nullptr;
-
-
-
 mappers::CountryMapping::CountryMapping(std::istream& theStream)
 {
 	registerKeyword(std::regex("EU4"), [this](const std::string& unused, std::istream& theStream)
@@ -74,7 +70,7 @@ mappers::CountryMapping::CountryMapping(std::istream& theStream)
 
 mappers::CountryMappings::CountryMappings()
 {
-	LOG(LogLevel::Info) << "Getting country mappings";
+	WORKER_LOG(LogLevel::Info) << "Getting country mappings";
 	readRules();
 	getAvailableFlags();
 }
@@ -82,7 +78,7 @@ mappers::CountryMappings::CountryMappings()
 
 void mappers::CountryMappings::readRules()
 {
-	LOG(LogLevel::Info) << "Reading country mapping rules";
+	WORKER_LOG(LogLevel::Info) << "Reading country mapping rules";
 
 	registerKeyword(std::regex("link"), [this](const std::string& unused, std::istream& theStream)
 		{
@@ -97,7 +93,7 @@ void mappers::CountryMappings::readRules()
 
 void mappers::CountryMappings::getAvailableFlags()
 {
-	const vector<string> availableFlagFolders = { "blankMod/output/gfx/flags", theConfiguration.getVic2Path() + "/gfx/flags" };
+	const vector<string> availableFlagFolders = { "blankMod/output/gfx/flags", theConfiguration().getVic2Path() + "/gfx/flags" };
 
 	set<string> availableFlagFiles;
 	for (auto availableFlagFolder: availableFlagFolders)
@@ -121,7 +117,7 @@ void mappers::CountryMappings::CreateMappings(
 	const std::map<std::string, V2Country*>& Vic2Countries,
 	const ProvinceMapper& provinceMapper
 ) {
-	LOG(LogLevel::Info) << "Creating country mappings";
+	WORKER_LOG(LogLevel::Info) << "Creating country mappings";
 
 	set<std::shared_ptr<EU4::Country>> colonialCountries;
 	for (auto EU4Country: srcWorld.getCountries())
@@ -390,7 +386,7 @@ bool mappers::CountryMappings::tagIsAvailable(const mappers::colonyStruct& colon
 
 void mappers::CountryMappings::logMapping(const string& EU4Tag, const string& V2Tag, const string& reason)
 {
-	LOG(LogLevel::Debug) << "Mapping " << EU4Tag << " -> " << V2Tag << " (" << reason << ')';
+	WORKER_LOG(LogLevel::Debug) << "Mapping " << EU4Tag << " -> " << V2Tag << " (" << reason << ')';
 }
 
 
@@ -456,17 +452,17 @@ std::optional<std::string> mappers::CountryMappings::GetCK2Title(const string& E
 			// I've found titles that don't exist in the ck2 name mapping, but do exist in the flagset (c_znojmo).
 			if (availableFlags.find("k_" + titlename) != availableFlags.end())
 			{
-				LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title k_" << titlename;
+				WORKER_LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title k_" << titlename;
 				return k_name;
 			}
 			else if (availableFlags.find(d_name) != availableFlags.end())
 			{
-				LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title " << d_name;
+				WORKER_LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title " << d_name;
 				return d_name;
 			}
 			else if (availableFlags.find(c_name) != availableFlags.end())
 			{
-				LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title " << c_name;
+				WORKER_LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title " << c_name;
 				return c_name;
 			}
 		}
@@ -474,7 +470,7 @@ std::optional<std::string> mappers::CountryMappings::GetCK2Title(const string& E
 
 	if (ck2title)
 	{
-		LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title " << *ck2title;
+		WORKER_LOG(LogLevel::Debug) << "Country " << EU4Tag << " (" << name << ") has the CK2 title " << *ck2title;
 	}
 
 	return ck2title;
@@ -32,6 +32,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include <set>
 #include <string>
 #include "ColonialTagsMapper.h"
+#include "../ConversionContext.h"
 #include "ProvinceMappings/ProvinceMapper.h"
 #include "newParser.h"
 
@@ -85,15 +86,9 @@ namespace mappers
 			}
 
 		private:
-			static CountryMappings* instance;
 			static CountryMappings* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new CountryMappings();
-				}
-
-				return instance;
+				return &ConversionContext::current().getState<CountryMappings>([]() { return new CountryMappings; });
 			}
 
 			CountryMappings();
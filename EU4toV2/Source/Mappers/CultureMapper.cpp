@@ -23,7 +23,6 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "CultureMapper.h"
 #include "CultureMappingRule.h"
-#include "Log.h"
 
 
 
@@ -32,10 +31,9 @@ mappers::CultureMapper::CultureMapper(std::istream& theStream)
 	registerKeyword(std::regex("link"), [this](const std::string& unused, std::istream& theStream)
 		{
 			CultureMappingRule rule(theStream);
-			auto newRules = rule.getMappings();
-			for (auto newRule: newRules)
+			for (const auto& newRule: rule.getMappings())
 			{
-				cultureMap.push_back(newRule);
+				rulesBySourceCulture[parsing::CultureSymbol(newRule.getSourceCulture())].rules.push_back(newRule);
 			}
 		}
 	);
@@ -52,14 +50,92 @@ std::optional<std::string> mappers::CultureMapper::cultureMatch(
 	const std::string& ownerTag
 ) const
 {
-	for (auto cultureMapping: cultureMap)
+	// every source culture was interned when the rules were read, so one that never was has no rules
+	const auto cultureSymbol = parsing::CultureSymbol::find(culture);
+	if (!cultureSymbol)
 	{
-		auto possibleMatch = cultureMapping.cultureMatch(EU4Regions, culture, religion, EU4Province, ownerTag);
-		if (possibleMatch)
+		return {};
+	}
+
+	// nor can a religion or owner nothing has interned equal a distinguisher, so the empty symbol stands in for it
+	return cultureMatch(
+		EU4Regions,
+		*cultureSymbol,
+		parsing::ReligionSymbol::find(religion).value_or(parsing::ReligionSymbol()),
+		EU4Province,
+		parsing::TagSymbol::find(ownerTag).value_or(parsing::TagSymbol())
+	);
+}
+
+
+std::optional<std::string> mappers::CultureMapper::cultureMatch(
+	const EU4::Regions& EU4Regions,
+	parsing::CultureSymbol culture,
+	parsing::ReligionSymbol religion,
+	int EU4Province,
+	parsing::TagSymbol ownerTag
+) const
+{
+	const auto rules = rulesBySourceCulture.find(culture);
+	if (rules == rulesBySourceCulture.end())
+	{
+		return {};
+	}
+
+	const MatchKey key{ culture, religion, EU4Province, ownerTag };
+	std::lock_guard<std::mutex> lock(matchesMutex);
+	if (matchesRegionsId != EU4Regions.getInstanceId())
+	{
+		useRegions(EU4Regions);
+	}
+	if (const auto match = matches.find(key); match != matches.end())
+	{
+		return match->second;
+	}
+
+	std::optional<std::string> destinationCulture;
+	const auto& sourceCultureRules = rules->second;
+	for (size_t i = 0; i < sourceCultureRules.rules.size(); i++)
+	{
+		const auto& rule = sourceCultureRules.rules[i];
+		if (rule.distinguishersMatch(EU4Regions, religion, EU4Province, ownerTag, sourceCultureRules.regionIndexes[i]))
 		{
-			return possibleMatch;
+			destinationCulture = rule.getDestinationCulture();
+			break;
 		}
 	}
+	matches.emplace(key, destinationCulture);
+	return destinationCulture;
+}
 
-	return {};
+
+// called with matchesMutex held
+void mappers::CultureMapper::useRegions(const EU4::Regions& EU4Regions) const
+{
+	matches.clear();
+	for (const auto& sourceCulture: rulesBySourceCulture)
+	{
+		auto& regionIndexes = sourceCulture.second.regionIndexes;
+		regionIndexes.clear();
+		for (const auto& rule: sourceCulture.second.rules)
+		{
+			regionIndexes.push_back(rule.getRegion() ? EU4Regions.getRegionIndex(*rule.getRegion()) : std::nullopt);
+		}
+	}
+	matchesRegionsId = EU4Regions.getInstanceId();
+}
+
+
+bool mappers::CultureMapper::MatchKey::operator==(const MatchKey& rhs) const
+{
+	return (culture == rhs.culture) && (religion == rhs.religion) && (EU4Province == rhs.EU4Province) && (ownerTag == rhs.ownerTag);
+}
+
+
+size_t mappers::CultureMapper::MatchKeyHash::operator()(const MatchKey& key) const
+{
+	size_t hash = key.culture.getId();
+	hash = hash * 31 + key.religion.getId();
+	hash = hash * 31 + static_cast<size_t>(key.EU4Province);
+	return hash * 31 + key.ownerTag.getId();
 }
\ No newline at end of file
@@ -29,9 +29,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "newParser.h"
 #include "CultureMapping.h"
 #include "../EU4World/Regions/Regions.h"
+#include "../Parsing/Symbol.h"
+#include <cstdint>
 #include <istream>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -39,6 +43,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 namespace mappers
 {
 
+// The rules are indexed by their source culture, keeping the file's order within each culture, and every answer is
+// remembered, since a conversion asks the same question for each pop type of each province. Region names are looked
+// up once for each Regions the mapper is used with.
 class CultureMapper: commonItems::parser
 {
 	public:
@@ -52,8 +59,44 @@ class CultureMapper: commonItems::parser
 			const std::string& ownerTag = ""
 		) const;
 
+		std::optional<std::string> cultureMatch(
+			const EU4::Regions& EU4Regions,
+			parsing::CultureSymbol culture,
+			parsing::ReligionSymbol religion,
+			int EU4Province,
+			parsing::TagSymbol ownerTag
+		) const;
+
 	private:
-		std::vector<cultureMapping> cultureMap;
+		struct MatchKey
+		{
+			parsing::CultureSymbol culture;
+			parsing::ReligionSymbol religion;
+			int EU4Province;
+			parsing::TagSymbol ownerTag;
+
+			bool operator==(const MatchKey& rhs) const;
+		};
+
+		struct MatchKeyHash
+		{
+			size_t operator()(const MatchKey& key) const;
+		};
+
+		struct SourceCultureRules
+		{
+			std::vector<cultureMapping> rules;
+			mutable std::vector<std::optional<size_t>> regionIndexes; // each rule's region, in the regions matched against
+		};
+
+		void useRegions(const EU4::Regions& EU4Regions) const;
+
+		std::unordered_map<parsing::CultureSymbol, SourceCultureRules> rulesBySourceCulture;
+
+		// answers and region indexes hold for the regions they were found with
+		mutable std::mutex matchesMutex;
+		mutable uint64_t matchesRegionsId = 0;
+		mutable std::unordered_map<MatchKey, std::optional<std::string>, MatchKeyHash> matches;
 };
 
 }
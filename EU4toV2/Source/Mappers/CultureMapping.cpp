@@ -23,19 +23,49 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "CultureMapping.h"
 #include "../EU4World/Regions/Regions.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
+#include <limits>
+#include <stdexcept>
 
 
 
 mappers::cultureMapping::cultureMapping(
 	const std::string& _sourceCulture,
 	const std::string& _destinationCulture,
-	const std::map<distinguisherTypes, std::string>& _distinguishers
+	const std::map<distinguisherTypes, std::string>& distinguishers
 ):
 	sourceCulture(_sourceCulture),
-	destinationCulture(_destinationCulture),
-	distinguishers(_distinguishers)
-{}
+	destinationCulture(_destinationCulture)
+{
+	for (const auto& distinguisher: distinguishers)
+	{
+		if (distinguisher.first == distinguisherTypes::owner)
+		{
+			owner = parsing::TagSymbol(distinguisher.second);
+		}
+		else if (distinguisher.first == distinguisherTypes::religion)
+		{
+			religion = parsing::ReligionSymbol(distinguisher.second);
+		}
+		else if (distinguisher.first == distinguisherTypes::province)
+		{
+			try
+			{
+				province = std::stoi(distinguisher.second);
+			}
+			catch (const std::exception&)
+			{
+				WORKER_LOG(LogLevel::Warning) << "Culture mapping " << sourceCulture << " -> " << destinationCulture
+					<< " has bad province " << distinguisher.second << " and will not be used";
+				province = std::numeric_limits<int>::min();
+			}
+		}
+		else if (distinguisher.first == distinguisherTypes::region)
+		{
+			region = distinguisher.second;
+		}
+	}
+}
 
 
 std::optional<std::string> mappers::cultureMapping::cultureMatch(
@@ -44,14 +74,20 @@ std::optional<std::string> mappers::cultureMapping::cultureMatch(
 	const std::string& religion,
 	int EU4Province,
 	const std::string& ownerTag
-)
+) const
 {
-	if (sourceCulture == culture)
+	// names that were never interned can't equal any distinguisher
+	if (
+		(sourceCulture == culture) &&
+		distinguishersMatch(
+			EU4Regions,
+			parsing::ReligionSymbol::find(religion).value_or(parsing::ReligionSymbol()),
+			EU4Province,
+			parsing::TagSymbol::find(ownerTag).value_or(parsing::TagSymbol())
+		)
+	)
 	{
-		if (distinguishersMatch(EU4Regions, distinguishers, religion, EU4Province, ownerTag))
-		{
-			return destinationCulture;
-		}
+		return destinationCulture;
 	}
 
 	return {};
@@ -60,41 +96,39 @@ std::optional<std::string> mappers::cultureMapping::cultureMatch(
 
 bool mappers::cultureMapping::distinguishersMatch(
 	const EU4::Regions& EU4Regions,
-	const std::map<distinguisherTypes, std::string>& distinguishers,
-	const std::string& religion,
+	parsing::ReligionSymbol theReligion,
+	int EU4Province,
+	parsing::TagSymbol ownerTag
+) const
+{
+	const auto regionIndex = region ? EU4Regions.getRegionIndex(*region) : std::nullopt;
+	return distinguishersMatch(EU4Regions, theReligion, EU4Province, ownerTag, regionIndex);
+}
+
+
+bool mappers::cultureMapping::distinguishersMatch(
+	const EU4::Regions& EU4Regions,
+	parsing::ReligionSymbol theReligion,
 	int EU4Province,
-	const std::string& ownerTag)
+	parsing::TagSymbol ownerTag,
+	std::optional<size_t> regionIndex
+) const
 {
-	for (auto currentDistinguisher: distinguishers)
+	if (owner && (*owner != ownerTag))
 	{
-		if (currentDistinguisher.first == distinguisherTypes::owner)
-		{
-			if (ownerTag != currentDistinguisher.second)
-			{
-				return false;
-			}
-		}
-		else if (currentDistinguisher.first == distinguisherTypes::religion)
-		{
-			if (religion != currentDistinguisher.second)
-			{
-				return false;
-			}
-		}
-		else if (currentDistinguisher.first == distinguisherTypes::province)
-		{
-			if (stoi(currentDistinguisher.second) != EU4Province)
-			{
-				return false;
-			}
-		}
-		else if (currentDistinguisher.first == distinguisherTypes::region)
-		{
-			if (!EU4Regions.provinceInRegion(EU4Province, currentDistinguisher.second))
-			{
-				return false;
-			}
-		}
+		return false;
+	}
+	if (religion && (*religion != theReligion))
+	{
+		return false;
+	}
+	if (province && (*province != EU4Province))
+	{
+		return false;
+	}
+	if (region && (!regionIndex || !EU4Regions.provinceInRegion(EU4Province, *regionIndex)))
+	{
+		return false;
 	}
 
 	return true;
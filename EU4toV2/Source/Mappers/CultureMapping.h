@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "../EU4World/Regions/Regions.h"
+#include "../Parsing/Symbol.h"
 #include <map>
 #include <optional>
 #include <string>
@@ -59,20 +60,38 @@ class cultureMapping
 			const std::string& religion,
 			int EU4Province,
 			const std::string& ownerTag
-		);
+		) const;
 
-	private:
+		// for a culture already known to be the source culture
 		bool distinguishersMatch(
 			const EU4::Regions& EU4Regions,
-			const std::map<distinguisherTypes, std::string>& distinguishers,
-			const std::string& religion,
+			parsing::ReligionSymbol religion,
 			int EU4Province,
-			const std::string& ownerTag
-		);
+			parsing::TagSymbol ownerTag
+		) const;
+
+		// the same, with the region distinguisher already looked up in EU4Regions
+		bool distinguishersMatch(
+			const EU4::Regions& EU4Regions,
+			parsing::ReligionSymbol religion,
+			int EU4Province,
+			parsing::TagSymbol ownerTag,
+			std::optional<size_t> regionIndex
+		) const;
 
+		const std::string& getSourceCulture() const { return sourceCulture; }
+		const std::string& getDestinationCulture() const { return destinationCulture; }
+		const std::optional<std::string>& getRegion() const { return region; }
+
+	private:
 		std::string sourceCulture;
 		std::string destinationCulture;
-		std::map<distinguisherTypes, std::string> distinguishers;
+
+		// the distinguishers, read into the forms they are compared in
+		std::optional<parsing::TagSymbol> owner;
+		std::optional<parsing::ReligionSymbol> religion;
+		std::optional<int> province;
+		std::optional<std::string> region;
 };
 
 }
@@ -40,7 +40,7 @@ namespace mappers
 		public:
 			CultureMappingRule(std::istream& theStream);
 
-			std::vector<cultureMapping> getMappings() const { return mappings; }
+			const std::vector<cultureMapping>& getMappings() const { return mappings; }
 
 		private:
 			std::vector<cultureMapping> mappings;
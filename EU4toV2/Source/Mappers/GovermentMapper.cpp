@@ -1,5 +1,5 @@
 #include "GovernmentMapper.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "ParserHelpers.h"
 
 
@@ -26,7 +26,7 @@ std::string mappers::GovernmentMapper::matchGovernment(const std::string& source
 	}
 	else
 	{
-		LOG(LogLevel::Warning) << "No government mapping defined for " << sourceGovernment;
+		WORKER_LOG(LogLevel::Warning) << "No government mapping defined for " << sourceGovernment;
 		return "";
 	}
 }
@@ -23,12 +23,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "IdeaEffectMapper.h"
 #include "IdeaEffects.h"
-#include "Log.h"
+#include "../../Parsing/WorkerLog.h"
 
 
 mappers::IdeaEffectMapper::IdeaEffectMapper(std::istream& theStream, std::istream& theSecondStream)
 {
-	LOG(LogLevel::Info) << "getting idea effects";
+	WORKER_LOG(LogLevel::Info) << "getting idea effects";
 	registerProperties(theStream);
 	parseStream(theStream);
 	parseStream(theSecondStream);
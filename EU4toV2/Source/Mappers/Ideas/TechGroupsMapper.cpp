@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "TechGroupsMapper.h"
 #include "TechGroups.h"
-#include "Log.h"
+#include "../../Parsing/WorkerLog.h"
 
 
 
@@ -36,7 +36,7 @@ mappers::TechGroupsMapper::TechGroupsMapper(std::istream& theStream)
 		literacies[techGroup] = techGroups.getLiteracyBoost();
 	});
 
-	LOG(LogLevel::Info) << "getting tech groups";
+	WORKER_LOG(LogLevel::Info) << "getting tech groups";
 	parseStream(theStream);
 }
 
@@ -25,7 +25,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "ProvinceMappingsVersion.h"
 #include "../../Configuration.h"
 #include "../../EU4World/EU4Version.h"
-#include "Log.h"
+#include "../../Parsing/WorkerLog.h"
 #include <fstream>
 #include <stdexcept>
 
@@ -55,7 +55,7 @@ mappers::ProvinceMappingsVersion mappers::ProvinceMapper::getMappingsVersion(
 	{
 		if (saveVersion >= mappingsVersion->first)
 		{
-			LOG(LogLevel::Debug) << "Using version " << mappingsVersion->first << " mappings";
+			WORKER_LOG(LogLevel::Debug) << "Using version " << mappingsVersion->first << " mappings";
 			return mappingsVersion->second;
 		}
 	}
@@ -159,10 +159,10 @@ bool mappers::ProvinceMapper::isProvinceResettable(int Vic2ProvinceNumber, const
 
 void mappers::ProvinceMapper::determineValidProvinces()
 {
-	std::ifstream definitionFile((theConfiguration.getEU4Path() + "/map/definition.csv"));
+	std::ifstream definitionFile((theConfiguration().getEU4Path() + "/map/definition.csv"));
 	if (!definitionFile.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not open map/definition.csv";
+		WORKER_LOG(LogLevel::Error) << "Could not open map/definition.csv";
 		exit(-1);
 	}
 	char input[256];
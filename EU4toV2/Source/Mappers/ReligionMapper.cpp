@@ -34,7 +34,7 @@ mappers::ReligionMapper::ReligionMapper(std::istream& theStream)
 		ReligionMapping theMapping(theStream);
 		for (auto EU4Religion: theMapping.getEU4Religions())
 		{
-			EU4ToVic2ReligionMap.insert(make_pair(EU4Religion, theMapping.getVic2Religion()));
+			EU4ToVic2ReligionMap.insert(make_pair(parsing::ReligionSymbol(EU4Religion), theMapping.getVic2Religion()));
 		}
 	});
 
@@ -43,6 +43,18 @@ mappers::ReligionMapper::ReligionMapper(std::istream& theStream)
 
 
 std::optional<std::string> mappers::ReligionMapper::getVic2Religion(const std::string& EU4Religion) const
+{
+	// a religion nothing has interned can't be in the map
+	const auto religion = parsing::ReligionSymbol::find(EU4Religion);
+	if (!religion)
+	{
+		return {};
+	}
+	return getVic2Religion(*religion);
+}
+
+
+std::optional<std::string> mappers::ReligionMapper::getVic2Religion(parsing::ReligionSymbol EU4Religion) const
 {
 	auto mapping = EU4ToVic2ReligionMap.find(EU4Religion);
 	if (mapping != EU4ToVic2ReligionMap.end())
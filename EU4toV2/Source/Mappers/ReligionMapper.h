@@ -27,9 +27,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "newParser.h"
-#include <map>
+#include "../Parsing/Symbol.h"
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 
 
@@ -42,9 +43,10 @@ class ReligionMapper: commonItems::parser
 		ReligionMapper(std::istream& theStream);
 
 		std::optional<std::string> getVic2Religion(const std::string& EU4Religion) const;
+		std::optional<std::string> getVic2Religion(parsing::ReligionSymbol EU4Religion) const; // for every pop, so no string lookup
 
 	private:
-		std::map<std::string, std::string> EU4ToVic2ReligionMap;
+		std::unordered_map<parsing::ReligionSymbol, std::string> EU4ToVic2ReligionMap;
 };
 
 }
@@ -1,6 +1,6 @@
 #include "UnitTypeMapper.h"
 #include "ParserHelpers.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include <set>
 #include <fstream>
 #include "OSCompatibilityLayer.h"
@@ -9,16 +9,16 @@
 
 mappers::UnitTypeMapper::UnitTypeMapper()
 {
-	LOG(LogLevel::Info) << "\tReading unit strengths from EU4 installation folder";
+	WORKER_LOG(LogLevel::Info) << "\tReading unit strengths from EU4 installation folder";
 
 	std::set<std::string> filenames;
-	Utils::GetAllFilesInFolder(theConfiguration.getEU4Path() + "/common/units/", filenames);
+	Utils::GetAllFilesInFolder(theConfiguration().getEU4Path() + "/common/units/", filenames);
 	for (auto filename : filenames)
 	{
-		AddUnitFileToRegimentTypeMap((theConfiguration.getEU4Path() + "/common/units"), filename);
+		AddUnitFileToRegimentTypeMap((theConfiguration().getEU4Path() + "/common/units"), filename);
 	}
 
-	for (auto modName : theConfiguration.getEU4Mods())
+	for (auto modName : theConfiguration().getEU4Mods())
 	{
 		std::set<std::string> filenames;
 		Utils::GetAllFilesInFolder(modName + "/common/units/", filenames);
@@ -47,7 +47,7 @@ void mappers::UnitTypeMapper::AddUnitFileToRegimentTypeMap(const std::string& di
 	UnitType unitType(incFile);
 	if (unitType.getCategory() == EU4::REGIMENTCATEGORY::num_reg_categories)
 	{
-		LOG(LogLevel::Warning) << "Unit file for " << name << " at: " << filePath << " has no type!";
+		WORKER_LOG(LogLevel::Warning) << "Unit file for " << name << " at: " << filePath << " has no type!";
 		return;
 	}
 
@@ -0,0 +1,125 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "Arena.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+
+
+namespace
+{
+
+constexpr size_t largestChunkSize = 1024 * 1024;
+
+thread_local parsing::Arena* activeArena = nullptr;
+
+std::atomic<size_t> totalAllocations{ 0 };
+std::atomic<size_t> totalBytes{ 0 };
+std::atomic<size_t> totalChunks{ 0 };
+std::atomic<size_t> totalHeapObjects{ 0 };
+
+}
+
+
+
+parsing::Arena::~Arena()
+{
+	addToCounters();
+}
+
+
+void parsing::Arena::addToCounters()
+{
+	totalAllocations += allocations - countedAllocations;
+	totalBytes += bytes - countedBytes;
+	totalChunks += chunks.size() - countedChunks;
+	countedAllocations = allocations;
+	countedBytes = bytes;
+	countedChunks = chunks.size();
+}
+
+
+void* parsing::Arena::do_allocate(size_t size, size_t alignment)
+{
+	auto padding = (alignment - reinterpret_cast<uintptr_t>(next) % alignment) % alignment;
+	if (padding + size > remaining)
+	{
+		const auto chunkSize = std::max(nextChunkSize, size + alignment);
+		chunks.push_back(std::unique_ptr<std::byte[]>(new std::byte[chunkSize])); // left uninitialised, unlike make_unique
+		next = chunks.back().get();
+		remaining = chunkSize;
+		nextChunkSize = std::min(nextChunkSize * 2, largestChunkSize);
+		padding = (alignment - reinterpret_cast<uintptr_t>(next) % alignment) % alignment;
+	}
+
+	auto allocation = next + padding;
+	next += padding + size;
+	remaining -= padding + size;
+	allocations++;
+	bytes += size;
+	return allocation;
+}
+
+
+parsing::ArenaCounters parsing::Arena::getCounters()
+{
+	ArenaCounters counters;
+	counters.allocations = totalAllocations;
+	counters.bytes = totalBytes;
+	counters.chunks = totalChunks;
+	counters.heapObjects = totalHeapObjects;
+	return counters;
+}
+
+
+parsing::ArenaScope::ArenaScope(Arena& _arena):
+	arena(_arena),
+	outer(activeArena)
+{
+	activeArena = &arena;
+}
+
+
+parsing::ArenaScope::~ArenaScope()
+{
+	arena.addToCounters();
+	activeArena = outer;
+}
+
+
+std::pmr::memory_resource* parsing::getCurrentResource()
+{
+	if (activeArena)
+	{
+		return activeArena;
+	}
+	return std::pmr::get_default_resource();
+}
+
+
+void parsing::countHeapObject()
+{
+	totalHeapObjects++;
+}
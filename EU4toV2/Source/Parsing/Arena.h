@@ -0,0 +1,179 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_ARENA_H_
+#define PARSING_ARENA_H_
+
+
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// Running totals over every arena in the process, brought up to date as each ArenaScope ends and
+// each arena is destroyed, to check how much of the parsed world's
+// allocation the arenas take: allocations and bytes handed out from arenas, the chunks they took
+// from the heap to do it, and objects made with makeArenaPtr or makeArenaShared while no arena was
+// in scope, which went to the heap one at a time.
+struct ArenaCounters
+{
+	size_t allocations = 0;
+	size_t bytes = 0;
+	size_t chunks = 0;
+	size_t heapObjects = 0;
+};
+
+
+// A monotonic memory resource: allocation bumps a pointer through chunks taken from the heap, which
+// grow as the arena does, and deallocation does nothing. All the memory goes back at once when the
+// arena is destroyed, so everything allocated from it must be gone (or never need freeing) by then.
+// An arena is used from one thread at a time.
+class Arena: public std::pmr::memory_resource
+{
+	public:
+		Arena() = default;
+		~Arena();
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		size_t getAllocations() const { return allocations; }
+		size_t getBytes() const { return bytes; }
+		size_t getChunkCount() const { return chunks.size(); }
+
+		static ArenaCounters getCounters();
+
+	private:
+		friend class ArenaScope;
+		void addToCounters();
+
+		void* do_allocate(size_t size, size_t alignment) override;
+		void do_deallocate(void*, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		std::vector<std::unique_ptr<std::byte[]>> chunks;
+		std::byte* next = nullptr;
+		size_t remaining = 0;
+		size_t nextChunkSize = 4096;
+		size_t allocations = 0;
+		size_t bytes = 0;
+		size_t countedAllocations = 0;
+		size_t countedBytes = 0;
+		size_t countedChunks = 0;
+};
+
+
+// While an ArenaScope is alive on a thread, objects built there through getCurrentResource,
+// makeArenaPtr and makeArenaShared are placed in its arena. Scopes nest; the innermost one wins.
+// Without one they go to the heap as usual.
+class ArenaScope
+{
+	public:
+		explicit ArenaScope(Arena& arena);
+		~ArenaScope();
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		Arena& arena;
+		Arena* outer = nullptr;
+};
+
+
+// the arena in scope on this thread, or the default (heap) resource; for pmr containers
+std::pmr::memory_resource* getCurrentResource();
+void countHeapObject();
+
+
+// Destroys the object and returns its memory to the resource it came from, which for an arena is
+// nothing.
+template<typename T>
+class ArenaDeleter
+{
+	public:
+		ArenaDeleter() = default;
+		explicit ArenaDeleter(std::pmr::memory_resource* _resource): resource(_resource) {}
+
+		void operator()(T* object) const
+		{
+			object->~T();
+			resource->deallocate(object, sizeof(T), alignof(T));
+		}
+
+	private:
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+};
+
+
+template<typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+
+template<typename T, typename... Args>
+ArenaPtr<T> makeArenaPtr(Args&&... args)
+{
+	auto resource = getCurrentResource();
+	if (resource == std::pmr::get_default_resource())
+	{
+		countHeapObject();
+	}
+	std::pmr::polymorphic_allocator<T> allocator(resource);
+	auto object = allocator.allocate(1);
+	try
+	{
+		new(object) T(std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		allocator.deallocate(object, 1);
+		throw;
+	}
+	return ArenaPtr<T>(object, ArenaDeleter<T>(resource));
+}
+
+
+// the object and its shared_ptr control block in one allocation from the arena in scope
+template<typename T, typename... Args>
+std::shared_ptr<T> makeArenaShared(Args&&... args)
+{
+	auto resource = getCurrentResource();
+	if (resource == std::pmr::get_default_resource())
+	{
+		countHeapObject();
+	}
+	return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource), std::forward<Args>(args)...);
+}
+
+}
+
+
+
+#endif // PARSING_ARENA_H_
@@ -0,0 +1,392 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "BinaryTokenReader.h"
+#include "BinaryTokenTable.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+const std::string_view binaryHeader = "EU4bin";
+
+const uint16_t EQUALS = 0x0001;
+const uint16_t OPEN = 0x0003;
+const uint16_t CLOSE = 0x0004;
+const uint16_t INT = 0x000c;
+const uint16_t FLOAT = 0x000d;
+const uint16_t BOOL = 0x000e;
+const uint16_t QUOTED_STRING = 0x000f;
+const uint16_t UINT = 0x0014;
+const uint16_t UNQUOTED_STRING = 0x0017;
+const uint16_t DOUBLE = 0x0167;
+const uint16_t RGB = 0x0243;
+const uint16_t ULONG = 0x029c;
+const uint16_t LONG = 0x0317;
+
+const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+// the fields read as dates by the readers that take text, wherever they appear
+const std::string_view dateFields[] = {
+	"date", "start_date", "end_date", "activation", "death_date", "birth_date", "last_send_diplomat", "last_war"
+};
+
+const size_t chunkSize = 4096;
+
+
+bool isDateField(std::string_view key)
+{
+	return std::find(std::begin(dateFields), std::end(dateFields), key) != std::end(dateFields);
+}
+
+}
+
+
+
+parsing::BinaryTokenReader::BinaryTokenReader(std::string_view _data, const BinaryTokenTable& _tokens):
+	data(_data),
+	tokens(_tokens)
+{
+}
+
+
+parsing::BinaryTokenReader::~BinaryTokenReader()
+{
+	if (!missingIds.empty())
+	{
+		tokens.addMissingIds(missingIds);
+	}
+}
+
+
+bool parsing::BinaryTokenReader::isBinarySave(std::string_view data)
+{
+	return data.substr(0, binaryHeader.size()) == binaryHeader;
+}
+
+
+size_t parsing::BinaryTokenReader::getHeaderSize(std::string_view data)
+{
+	return isBinarySave(data) ? binaryHeader.size() : 0;
+}
+
+
+std::optional<std::string_view> parsing::BinaryTokenReader::getNextToken(size_t& position)
+{
+	if (position >= data.size())
+	{
+		return std::nullopt;
+	}
+
+	const auto id = read<uint16_t>(position);
+	switch (id)
+	{
+		case EQUALS:
+			return std::string_view("=");
+		case OPEN:
+			return std::string_view("{");
+		case CLOSE:
+			return std::string_view("}");
+		case BOOL:
+			return std::string_view((read<uint8_t>(position) != 0) ? "yes" : "no");
+		case QUOTED_STRING:
+		case UNQUOTED_STRING:
+			if (const auto value = readString(position); !value.empty())
+			{
+				return value;
+			}
+			return std::string_view("\"\"");
+		case INT:
+		case UINT:
+		case FLOAT:
+		case DOUBLE:
+		case ULONG:
+		case LONG:
+		{
+			char buffer[48];
+			return keep(readNumber(id, position, buffer, sizeof(buffer)));
+		}
+		default:
+			return getName(id);
+	}
+}
+
+
+void parsing::BinaryTokenReader::skipBlock(size_t& position)
+{
+	auto braceDepth = 1;
+	while (position < data.size())
+	{
+		switch (read<uint16_t>(position))
+		{
+			case OPEN:
+				braceDepth++;
+				break;
+			case CLOSE:
+				braceDepth--;
+				if (braceDepth == 0)
+				{
+					return;
+				}
+				break;
+			case BOOL:
+				read<uint8_t>(position);
+				break;
+			case INT:
+			case UINT:
+			case FLOAT:
+				read<uint32_t>(position);
+				break;
+			case DOUBLE:
+			case ULONG:
+			case LONG:
+				read<uint64_t>(position);
+				break;
+			case QUOTED_STRING:
+			case UNQUOTED_STRING:
+				readString(position);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+
+std::string parsing::BinaryTokenReader::getItemText(size_t& position, std::string_view key)
+{
+	std::string text;
+	std::vector<std::string_view> blockKeys; // the key of each open block, empty for unnamed ones
+	auto lastName = key; // the last name or string written, empty after a number
+	auto afterEquals = false;
+	while (position < data.size())
+	{
+		const auto id = read<uint16_t>(position);
+		if (id == EQUALS)
+		{
+			text += "= ";
+			afterEquals = true;
+			continue;
+		}
+		else if (id == OPEN)
+		{
+			blockKeys.push_back(afterEquals ? lastName : std::string_view());
+			text += "{ ";
+			afterEquals = false;
+			continue;
+		}
+		else if (id == CLOSE)
+		{
+			text += "}\n";
+			if (!blockKeys.empty())
+			{
+				blockKeys.pop_back();
+			}
+			if (blockKeys.empty())
+			{
+				break;
+			}
+			afterEquals = false;
+			continue;
+		}
+
+		char buffer[48];
+		if (id == INT)
+		{
+			const auto value = read<int32_t>(position);
+			const auto isKey = (peekId(position) == EQUALS);
+			const auto isDate = isKey ?
+				(!blockKeys.empty() && (blockKeys.back() == "history")) :
+				(afterEquals && isDateField(lastName));
+			if (isDate)
+			{
+				const auto theDate = decodeBinaryDate(value);
+				text.append(buffer, std::snprintf(buffer, sizeof(buffer), "%d.%d.%d", theDate.year, theDate.month, theDate.day));
+			}
+			else
+			{
+				text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+			}
+			lastName = {};
+		}
+		else if ((id == UINT) || (id == FLOAT) || (id == DOUBLE) || (id == ULONG) || (id == LONG))
+		{
+			text += readNumber(id, position, buffer, sizeof(buffer));
+			lastName = {};
+		}
+		else if (id == BOOL)
+		{
+			text += (read<uint8_t>(position) != 0) ? "yes" : "no";
+			lastName = {};
+		}
+		else if ((id == QUOTED_STRING) || (id == UNQUOTED_STRING))
+		{
+			lastName = readString(position);
+			if ((id == QUOTED_STRING) || lastName.empty())
+			{
+				text += '"';
+				text += lastName;
+				text += '"';
+			}
+			else
+			{
+				text += lastName;
+			}
+		}
+		else
+		{
+			lastName = getName(id);
+			text += lastName;
+		}
+		text += ' ';
+
+		afterEquals = false;
+		if (blockKeys.empty()) // a single value ends the item
+		{
+			break;
+		}
+	}
+
+	return text;
+}
+
+
+template<typename T> T parsing::BinaryTokenReader::read(size_t& position)
+{
+	if (data.size() - position < sizeof(T))
+	{
+		throw std::runtime_error("The binary save ends in the middle of a value.");
+	}
+
+	// saves are little-endian, as are all platforms the converter is built for
+	T value;
+	std::memcpy(&value, data.data() + position, sizeof(T));
+	position += sizeof(T);
+	return value;
+}
+
+
+std::optional<uint16_t> parsing::BinaryTokenReader::peekId(size_t position) const
+{
+	if (data.size() - position < sizeof(uint16_t))
+	{
+		return std::nullopt;
+	}
+
+	uint16_t id;
+	std::memcpy(&id, data.data() + position, sizeof(id));
+	return id;
+}
+
+
+std::string_view parsing::BinaryTokenReader::readString(size_t& position)
+{
+	const auto length = read<uint16_t>(position);
+	if (data.size() - position < length)
+	{
+		throw std::runtime_error("The binary save ends in the middle of a string.");
+	}
+
+	const auto value = data.substr(position, length);
+	position += length;
+	return value;
+}
+
+
+std::string_view parsing::BinaryTokenReader::getName(uint16_t id)
+{
+	if (const auto name = tokens.getName(id); !name.empty())
+	{
+		return name;
+	}
+	else if (id == RGB)
+	{
+		return "rgb";
+	}
+
+	char unknownName[24];
+	const auto length = std::snprintf(unknownName, sizeof(unknownName), "__unknown_0x%04x", id);
+	missingIds.insert(id);
+	return keep(std::string_view(unknownName, length));
+}
+
+
+std::string_view parsing::BinaryTokenReader::readNumber(uint16_t id, size_t& position, char* buffer, size_t size)
+{
+	switch (id)
+	{
+		case INT:
+			return std::string_view(buffer, std::to_chars(buffer, buffer + size, read<int32_t>(position)).ptr - buffer);
+		case UINT:
+			return std::string_view(buffer, std::to_chars(buffer, buffer + size, read<uint32_t>(position)).ptr - buffer);
+		case ULONG:
+			return std::string_view(buffer, std::to_chars(buffer, buffer + size, read<uint64_t>(position)).ptr - buffer);
+		case LONG:
+			return std::string_view(buffer, std::to_chars(buffer, buffer + size, read<int64_t>(position)).ptr - buffer);
+		case FLOAT:
+			return std::string_view(buffer, std::snprintf(buffer, size, "%.3f", read<int32_t>(position) / 1000.0));
+		default: // DOUBLE
+			return std::string_view(buffer, std::snprintf(buffer, size, "%.5f", read<int64_t>(position) / 32768.0));
+	}
+}
+
+
+std::string_view parsing::BinaryTokenReader::keep(std::string_view text)
+{
+	if (text.size() > spaceLeft)
+	{
+		chunks.push_back(std::make_unique<char[]>(chunkSize));
+		nextFree = chunks.back().get();
+		spaceLeft = chunkSize;
+	}
+
+	std::memcpy(nextFree, text.data(), text.size());
+	const std::string_view kept(nextFree, text.size());
+	nextFree += text.size();
+	spaceLeft -= text.size();
+	return kept;
+}
+
+
+parsing::BinaryDate parsing::decodeBinaryDate(int32_t hours)
+{
+	auto days = hours / 24;
+	BinaryDate theDate;
+	theDate.year = days / 365 - 5000;
+	days %= 365;
+	auto month = 0;
+	while ((month < 11) && (days >= daysInMonth[month]))
+	{
+		days -= daysInMonth[month];
+		month++;
+	}
+	theDate.month = month + 1;
+	theDate.day = days + 1;
+	return theDate;
+}
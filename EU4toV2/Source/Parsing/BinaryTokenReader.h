@@ -0,0 +1,108 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_BINARY_TOKEN_READER_H_
+#define PARSING_BINARY_TOKEN_READER_H_
+
+
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+class BinaryTokenTable;
+
+
+// Decodes the token stream of a binary (EU4bin) save for a Tokenizer, one token at a time and without
+// turning the save into text first. Tokens come out as they would from a text save: names come from
+// the token table, strings are views into the save, and numbers are written out into storage the
+// reader keeps for as long as it lives. Ids the table does not know come out as __unknown_0xNNNN so
+// the structure is kept intact, and are handed to the table when the reader goes away.
+// The save stores dates as plain integers, so integers stay numbers here; the handlers of date fields
+// know to read them as dates (see parsing::getDate).
+class BinaryTokenReader
+{
+	public:
+		BinaryTokenReader(std::string_view data, const BinaryTokenTable& tokens);
+		~BinaryTokenReader();
+
+		BinaryTokenReader(const BinaryTokenReader&) = delete;
+		BinaryTokenReader& operator=(const BinaryTokenReader&) = delete;
+
+		static bool isBinarySave(std::string_view data);
+		static size_t getHeaderSize(std::string_view data);
+
+		// the token at position, which is moved past it; nothing at the end of the data
+		std::optional<std::string_view> getNextToken(size_t& position);
+
+		// moves position past the end of the block whose '{' was the last token read
+		void skipBlock(size_t& position);
+
+		// The item at position (an optional '=' followed by a value or a block) written out as Paradox
+		// script, for readers that only take text. Values of known date fields, and the keys of
+		// history blocks, are written as dates. key is the key the item belongs to.
+		std::string getItemText(size_t& position, std::string_view key);
+
+	private:
+		template<typename T> T read(size_t& position);
+		std::optional<uint16_t> peekId(size_t position) const;
+		std::string_view readString(size_t& position);
+		std::string_view getName(uint16_t id);
+		std::string_view readNumber(uint16_t id, size_t& position, char* buffer, size_t size);
+		std::string_view keep(std::string_view text);
+
+		std::string_view data;
+		const BinaryTokenTable& tokens;
+
+		std::vector<std::unique_ptr<char[]>> chunks;
+		char* nextFree = nullptr;
+		size_t spaceLeft = 0;
+
+		std::set<uint16_t> missingIds;
+};
+
+
+// EU4 writes dates in binary saves as the number of hours since the start of 5000 BC, with no leap
+// years.
+struct BinaryDate
+{
+	int year = 1;
+	int month = 1;
+	int day = 1;
+};
+BinaryDate decodeBinaryDate(int32_t hours);
+
+}
+
+
+
+#endif // PARSING_BINARY_TOKEN_READER_H_
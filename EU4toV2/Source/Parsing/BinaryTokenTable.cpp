@@ -0,0 +1,175 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "BinaryTokenTable.h"
+#include "Log.h"
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+std::optional<uint16_t> parseId(const std::string& text)
+{
+	size_t digitsStart = 0;
+	int base = 10;
+	if ((text.size() > 2) && (text[0] == '0') && ((text[1] == 'x') || (text[1] == 'X')))
+	{
+		digitsStart = 2;
+		base = 16;
+	}
+	if (digitsStart == text.size())
+	{
+		return std::nullopt;
+	}
+
+	unsigned long id = 0;
+	for (size_t i = digitsStart; i < text.size(); i++)
+	{
+		const auto character = text[i];
+		unsigned long digit;
+		if ((character >= '0') && (character <= '9'))
+		{
+			digit = character - '0';
+		}
+		else if ((base == 16) && (character >= 'a') && (character <= 'f'))
+		{
+			digit = character - 'a' + 10;
+		}
+		else if ((base == 16) && (character >= 'A') && (character <= 'F'))
+		{
+			digit = character - 'A' + 10;
+		}
+		else
+		{
+			return std::nullopt;
+		}
+
+		id = id * base + digit;
+		if (id > 0xffff)
+		{
+			return std::nullopt;
+		}
+	}
+
+	return static_cast<uint16_t>(id);
+}
+
+}
+
+
+
+parsing::BinaryTokenTable::BinaryTokenTable(const std::string& filename)
+{
+	std::ifstream tokensFile(filename);
+	if (!tokensFile.is_open())
+	{
+		throw std::runtime_error("Could not open the binary token list " + filename + ". It is needed to read ironman saves.");
+	}
+
+	readTokens(tokensFile);
+	LOG(LogLevel::Debug) << "Read " << tokenCount << " binary tokens from " << filename;
+}
+
+
+parsing::BinaryTokenTable::BinaryTokenTable(std::istream& theStream)
+{
+	readTokens(theStream);
+}
+
+
+void parsing::BinaryTokenTable::readTokens(std::istream& theStream)
+{
+	std::string line;
+	while (std::getline(theStream, line))
+	{
+		if (const auto comment = line.find('#'); comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+
+		std::istringstream lineStream(line);
+		std::string first;
+		std::string second;
+		if (!(lineStream >> first >> second))
+		{
+			continue;
+		}
+
+		if (const auto id = parseId(first); id)
+		{
+			addToken(*id, second);
+		}
+		else if (const auto id = parseId(second); id)
+		{
+			addToken(*id, first);
+		}
+		else
+		{
+			LOG(LogLevel::Warning) << "Ignoring binary token line without an id: " << line;
+		}
+	}
+}
+
+
+void parsing::BinaryTokenTable::addToken(uint16_t id, std::string_view name)
+{
+	if (names.empty())
+	{
+		names.resize(0x10000);
+	}
+
+	if (names[id].empty())
+	{
+		tokenCount++;
+	}
+	names[id] = name;
+}
+
+
+std::string_view parsing::BinaryTokenTable::getName(uint16_t id) const
+{
+	if (names.empty())
+	{
+		return {};
+	}
+	return names[id];
+}
+
+
+void parsing::BinaryTokenTable::addMissingIds(const std::set<uint16_t>& ids) const
+{
+	std::lock_guard<std::mutex> lock(missingIdsLock);
+	missingIds.insert(ids.begin(), ids.end());
+}
+
+
+size_t parsing::BinaryTokenTable::getMissingIdCount() const
+{
+	std::lock_guard<std::mutex> lock(missingIdsLock);
+	return missingIds.size();
+}
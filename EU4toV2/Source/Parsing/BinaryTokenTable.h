@@ -0,0 +1,78 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_BINARY_TOKEN_TABLE_H_
+#define PARSING_BINARY_TOKEN_TABLE_H_
+
+
+
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// Maps the 16-bit token ids of binary (ironman) saves to the names they stand for. The ids change
+// between EU4 versions and are not shipped with the game, so the list is read from a file the user
+// provides: one id and one name per line, in either order, with '#' starting a comment. Ids may be
+// written in decimal or as 0x-prefixed hex.
+class BinaryTokenTable
+{
+	public:
+		BinaryTokenTable() = default;
+		explicit BinaryTokenTable(const std::string& filename);
+		explicit BinaryTokenTable(std::istream& theStream);
+
+		void addToken(uint16_t id, std::string_view name);
+
+		// empty if the id is unknown
+		std::string_view getName(uint16_t id) const;
+		size_t size() const { return tokenCount; }
+
+		// Ids met in a save that the list has no name for. Readers on any thread add the ones they
+		// found as they finish, so that they can be warned about once.
+		void addMissingIds(const std::set<uint16_t>& ids) const;
+		size_t getMissingIdCount() const;
+
+	private:
+		void readTokens(std::istream& theStream);
+
+		std::vector<std::string> names;
+		size_t tokenCount = 0;
+
+		mutable std::mutex missingIdsLock;
+		mutable std::set<uint16_t> missingIds;
+};
+
+}
+
+
+
+#endif // PARSING_BINARY_TOKEN_TABLE_H_
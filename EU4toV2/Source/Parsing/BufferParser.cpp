@@ -0,0 +1,208 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "BufferParser.h"
+#include "../ConversionContext.h"
+#include "MappedFile.h"
+#include "SectionScanner.h"
+#include "StructuralIndex.h"
+#include "ViewStream.h"
+#include "WorkerLog.h"
+#include <optional>
+
+
+
+parsing::tokenHandler parsing::streamHandler(commonItems::parsingFunction handler)
+{
+	return [handler](std::string_view keyword, Tokenizer& tokenizer)
+	{
+		readFromStream(tokenizer, [&handler, keyword](std::istream& theStream) {
+			handler(std::string(keyword), theStream);
+		});
+	};
+}
+
+
+void parsing::readFromStream(Tokenizer& tokenizer, const std::function<void(std::istream&)>& reader)
+{
+	if (tokenizer.isBinary())
+	{
+		// readers take text, so a binary item is written out for them on its own
+		const auto itemText = tokenizer.getItemScript();
+		ViewStream theStream(itemText);
+		reader(theStream);
+		return;
+	}
+
+	std::optional<ViewStream> theStream;
+	if (tokenizer.getSource() != nullptr)
+	{
+		theStream.emplace(*tokenizer.getSource(), tokenizer.getPosition());
+	}
+	else
+	{
+		theStream.emplace(tokenizer.getRemaining());
+	}
+	reader(*theStream);
+	tokenizer.advance(theStream->consumed());
+}
+
+
+void parsing::BufferParser::registerKeyword(const std::string& keyword, tokenHandler handler)
+{
+	keywords[keyword] = handler;
+}
+
+
+void parsing::BufferParser::registerPattern(const std::regex& pattern, tokenHandler handler)
+{
+	patterns.push_back(std::make_pair(pattern, handler));
+}
+
+
+void parsing::BufferParser::registerSection(const std::string& keyword, sectionHandler handler)
+{
+	sections[keyword] = handler;
+}
+
+
+void parsing::BufferParser::clearRegisteredKeywords()
+{
+	keywords.clear();
+	patterns.clear();
+	sections.clear();
+}
+
+
+void parsing::BufferParser::parseBuffer(Tokenizer& tokenizer)
+{
+	auto braceDepth = 0;
+	while (true)
+	{
+		auto token = tokenizer.getNextToken();
+		if (!token)
+		{
+			break;
+		}
+		else if (handleToken(*token, tokenizer))
+		{
+			continue;
+		}
+		else if (*token == "{")
+		{
+			braceDepth++;
+		}
+		else if (*token == "}")
+		{
+			braceDepth--;
+			if (braceDepth == 0)
+			{
+				break;
+			}
+		}
+	}
+}
+
+
+void parsing::BufferParser::parseFile(const std::string& filename)
+{
+	MappedFile theFile(filename);
+	const StructuralIndex index(theFile.getContents());
+	Tokenizer tokenizer(theFile.getContents(), &index);
+	parseBuffer(tokenizer);
+}
+
+
+void parsing::BufferParser::parseSections(Tokenizer& tokenizer, WorkerPool& pool)
+{
+	// A streamed text buffer has no index of its own, so each registered section is indexed by the
+	// worker that parses it. Handlers read the conversion's configuration and state, so they run in
+	// the caller's context.
+	std::vector<std::future<sectionMerge>> merges;
+	auto& context = ConversionContext::current();
+	const auto settings = tokenizer.getSettings();
+	SectionScanner scanner(tokenizer);
+	try
+	{
+		while (const auto section = scanner.getNextSection())
+		{
+			if (const auto handler = sections.find(section->key); handler != sections.end())
+			{
+				merges.push_back(pool.submit([&handler = handler->second, section = *section, settings, &context]() -> sectionMerge {
+					ConversionContext::Scope contextScope(context);
+					LogCapture log;
+					std::optional<StructuralIndex> sectionIndex;
+					if ((settings.index == nullptr) && (settings.binaryTokens == nullptr))
+					{
+						sectionIndex.emplace(section.text);
+					}
+					Tokenizer sectionTokenizer(section.text, sectionIndex ? TokenizerSettings{ &*sectionIndex } : settings);
+					auto merge = handler(section.key, sectionTokenizer);
+					return [messages = log.takeMessages(), merge = std::move(merge)]() {
+						replayLog(messages);
+						merge();
+					};
+				}));
+			}
+			else
+			{
+				Tokenizer sectionTokenizer(section->text, settings);
+				handleToken(section->key, sectionTokenizer);
+			}
+		}
+	}
+	catch (...)
+	{
+		// the sections already handed out read from the buffer, which may go away with the error
+		pool.waitAll(merges);
+		throw;
+	}
+
+	// every section is done before the first error is rethrown, for the same reason
+	pool.waitAll(merges);
+	for (auto& merge: merges)
+	{
+		merge.get()();
+	}
+}
+
+
+bool parsing::BufferParser::handleToken(std::string_view token, Tokenizer& tokenizer)
+{
+	if (auto keyword = keywords.find(token); keyword != keywords.end())
+	{
+		keyword->second(token, tokenizer);
+		return true;
+	}
+
+	for (const auto& pattern: patterns)
+	{
+		if (std::regex_match(token.begin(), token.end(), pattern.first))
+		{
+			pattern.second(token, tokenizer);
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,98 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_BUFFER_PARSER_H_
+#define PARSING_BUFFER_PARSER_H_
+
+
+
+#include "Tokenizer.h"
+#include "WorkerPool.h"
+#include "newParser.h"
+#include <functional>
+#include <istream>
+#include <map>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+typedef std::function<void(std::string_view, Tokenizer&)> tokenHandler;
+
+// Section handlers run on worker threads, concurrently with each other and with the rest of the
+// parse, so they must not change shared state. Instead they return a merge that applies what they
+// read; merges run on the parsing thread, in the order their sections appeared. Messages logged
+// through WORKER_LOG while a section is parsed are written out just before its merge.
+typedef std::function<void()> sectionMerge;
+typedef std::function<sectionMerge(std::string_view, Tokenizer&)> sectionHandler;
+
+
+// Wraps a handler written for commonItems::parser so it can be registered with a BufferParser.
+// The handler reads from a stream over the rest of the buffer, and the tokenizer then resumes
+// exactly where the handler stopped reading.
+tokenHandler streamHandler(commonItems::parsingFunction handler);
+
+// The same bridge for a single item: reader gets a stream positioned at the tokenizer, and the
+// tokenizer skips whatever the reader consumed. A binary item is written out as text for the
+// reader, and skipped whole.
+void readFromStream(Tokenizer& tokenizer, const std::function<void(std::istream&)>& reader);
+
+
+// The buffer based counterpart to commonItems::parser. Exact keywords are looked up before
+// patterns, and patterns are tried in the order they were registered.
+class BufferParser
+{
+	public:
+		void registerKeyword(const std::string& keyword, tokenHandler handler);
+		void registerPattern(const std::regex& pattern, tokenHandler handler);
+		void registerSection(const std::string& keyword, sectionHandler handler);
+		void clearRegisteredKeywords();
+
+		void parseBuffer(Tokenizer& tokenizer);
+		void parseFile(const std::string& filename);
+
+		// Splits the buffer into its top-level sections. Registered sections are parsed on the pool
+		// while the remaining ones go through the keyword handlers on this thread, and the sections'
+		// merges run once the whole buffer has been read. A section no keyword, pattern or section
+		// handler claims is skipped whole, so no catch-all pattern is needed to ignore it. Section
+		// handlers can hand work to the same pool, and wait for it there.
+		void parseSections(Tokenizer& tokenizer, WorkerPool& pool = WorkerPool::shared());
+
+	private:
+		bool handleToken(std::string_view token, Tokenizer& tokenizer);
+
+		std::map<std::string, tokenHandler, std::less<>> keywords;
+		std::vector<std::pair<std::regex, tokenHandler>> patterns;
+		std::map<std::string, sectionHandler, std::less<>> sections;
+};
+
+}
+
+
+
+#endif // PARSING_BUFFER_PARSER_H_
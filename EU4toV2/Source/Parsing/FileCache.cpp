@@ -0,0 +1,245 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "FileCache.h"
+#include "MappedFile.h"
+#include "WorkerLog.h"
+#include "OSCompatibilityLayer.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+
+
+namespace
+{
+
+// bump whenever anything written to the cache changes
+constexpr uint32_t cacheFormatVersion = 2;
+
+
+uint64_t hashContents(const std::string& path)
+{
+	const parsing::MappedFile file(path);
+	parsing::SnapshotKey key;
+	key.add(file.getContents());
+	return key.get();
+}
+
+
+// the key in an entry's header only covers its name and which files it came from; whether they
+// changed is up to the stamps that follow
+uint64_t getEntryKey(const std::string& name, const std::vector<std::string>& files)
+{
+	parsing::SnapshotKey key;
+	key.add(name);
+	for (const auto& file: files)
+	{
+		key.add(file);
+	}
+	return key.get();
+}
+
+
+bool isUnchanged(const parsing::FileStamp& stamp)
+{
+	std::error_code error;
+	const auto exists = std::filesystem::is_regular_file(stamp.path, error);
+	if (exists != stamp.exists)
+	{
+		return false;
+	}
+	if (!exists)
+	{
+		return true;
+	}
+
+	const auto size = std::filesystem::file_size(stamp.path, error);
+	if (error || (size != stamp.size))
+	{
+		return false;
+	}
+	const auto modified = std::filesystem::last_write_time(stamp.path, error);
+	if (!error && (static_cast<uint64_t>(modified.time_since_epoch().count()) == stamp.modified))
+	{
+		return true;
+	}
+	return hashContents(stamp.path) == stamp.contentHash;
+}
+
+}
+
+
+
+parsing::FileStamp parsing::stampFile(const std::string& path)
+{
+	FileStamp stamp;
+	stamp.path = path;
+
+	std::error_code error;
+	stamp.exists = std::filesystem::is_regular_file(path, error);
+	if (!stamp.exists)
+	{
+		return stamp;
+	}
+	stamp.size = std::filesystem::file_size(path, error);
+	stamp.modified = static_cast<uint64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+	stamp.contentHash = hashContents(path);
+	return stamp;
+}
+
+
+std::vector<std::string> parsing::getFilesInFolder(const std::string& folder)
+{
+	std::set<std::string> fileNames;
+	Utils::GetAllFilesInFolder(folder, fileNames);
+
+	std::vector<std::string> files;
+	for (const auto& fileName: fileNames)
+	{
+		files.push_back(folder + "/" + fileName);
+	}
+	return files;
+}
+
+
+std::string parsing::getTemporaryFileName(const std::string& fileName)
+{
+	std::ostringstream temporaryFileName;
+	temporaryFileName << fileName << "." << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+	return temporaryFileName.str();
+}
+
+
+bool parsing::FileCache::load(
+	const std::string& name,
+	const std::vector<std::string>& files,
+	const std::function<void(SnapshotReader&)>& readData
+) const
+{
+	const auto fileName = getFileName(name);
+	if (!Utils::DoesFileExist(fileName))
+	{
+		return false;
+	}
+
+	try
+	{
+		const MappedFile cacheFile(fileName);
+		SnapshotReader snapshot(cacheFile.getContents(), cacheFormatVersion, getEntryKey(name, files));
+		for (auto count = snapshot.readCount(); count > 0; count--)
+		{
+			FileStamp stamp;
+			snapshot.read(stamp.path);
+			snapshot.read(stamp.exists);
+			snapshot.read(stamp.size);
+			snapshot.read(stamp.modified);
+			snapshot.read(stamp.contentHash);
+			if (!isUnchanged(stamp))
+			{
+				WORKER_LOG(LogLevel::Debug) << "Cached " << name << " is out of date, " << stamp.path << " changed";
+				return false;
+			}
+		}
+		readData(snapshot);
+		if (!snapshot.atEnd())
+		{
+			throw std::runtime_error("it has data past its end");
+		}
+	}
+	catch (const std::exception& e)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not use cached " << name << " (" << e.what() << ")";
+		return false;
+	}
+
+	WORKER_LOG(LogLevel::Debug) << "Read " << name << " from the cache";
+	return true;
+}
+
+
+void parsing::FileCache::store(
+	const std::string& name,
+	const std::vector<std::string>& files,
+	const std::function<void(SnapshotWriter&)>& writeData,
+	const std::vector<std::string>& otherFiles
+) const
+{
+	// another thread may be storing an entry too, and make the folder first
+	if (!Utils::doesFolderExist(folder) && !Utils::TryCreateFolder(folder) && !Utils::doesFolderExist(folder))
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not create " << folder << ", " << name << " won't be cached";
+		return;
+	}
+
+	const auto fileName = getFileName(name);
+	const auto temporaryFileName = getTemporaryFileName(fileName);
+	try
+	{
+		std::ofstream cacheFile(temporaryFileName, std::ios::binary | std::ios::trunc);
+		SnapshotWriter snapshot(cacheFile, cacheFormatVersion, getEntryKey(name, files));
+		snapshot.writeCount(files.size() + otherFiles.size());
+		for (const auto* fileList: { &files, &otherFiles })
+		{
+			for (const auto& file: *fileList)
+			{
+				const auto stamp = stampFile(file);
+				snapshot.write(stamp.path);
+				snapshot.write(stamp.exists);
+				snapshot.write(stamp.size);
+				snapshot.write(stamp.modified);
+				snapshot.write(stamp.contentHash);
+			}
+		}
+		writeData(snapshot);
+		cacheFile.close();
+		if (!cacheFile)
+		{
+			throw std::runtime_error("could not write " + temporaryFileName);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not cache " << name << " (" << e.what() << ")";
+		std::remove(temporaryFileName.c_str());
+		return;
+	}
+
+	std::remove(fileName.c_str());
+	if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not rename " << temporaryFileName << " to " << fileName;
+		std::remove(temporaryFileName.c_str());
+	}
+}
+
+
+std::string parsing::FileCache::getFileName(const std::string& name) const
+{
+	return folder + "/" + name + ".cache";
+}
@@ -0,0 +1,116 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_FILE_CACHE_H_
+#define PARSING_FILE_CACHE_H_
+
+
+
+#include "Snapshot.h"
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// What a cached file looked like when the cache entry was made. Files that weren't there are
+// stamped too, so one appearing later is noticed.
+struct FileStamp
+{
+	std::string path;
+	bool exists = false;
+	uint64_t size = 0;
+	uint64_t modified = 0;
+	uint64_t contentHash = 0;
+};
+
+
+FileStamp stampFile(const std::string& path);
+
+// the files in a folder, with the folder in front of their names, in the order mods are read in
+std::vector<std::string> getFilesInFolder(const std::string& folder);
+
+// where to write a file's new contents before renaming them into place, different on each thread
+// so conversions writing the same file at once don't mix their data
+std::string getTemporaryFileName(const std::string& fileName);
+
+
+// Keeps what was worked out from game and mod files in the cache folder, so later runs can read it
+// back instead of parsing those files again. Each entry is stored with a stamp for every file it
+// came from, in the order they were read, so mod load order is part of it. An entry is only handed
+// back while every file still has its size and content: a file whose size and time match its stamp
+// is taken as unchanged, any other is hashed again and compared. Unusable entries are reported as
+// misses, never as errors.
+class FileCache
+{
+	public:
+		explicit FileCache(std::string _folder = "cache"): folder(std::move(_folder)) {}
+
+		// Calls readData on the entry stored under name, if it was made from exactly these files.
+		// Returns whether it did.
+		bool load(const std::string& name, const std::vector<std::string>& files, const std::function<void(SnapshotReader&)>& readData) const;
+		// Files only found while parsing, such as those named in the listed files, are given as
+		// otherFiles. They are checked like the others, but don't need to be known to find the entry.
+		void store(
+			const std::string& name,
+			const std::vector<std::string>& files,
+			const std::function<void(SnapshotWriter&)>& writeData,
+			const std::vector<std::string>& otherFiles = {}
+		) const;
+
+		// A T read back from the cache, or made by parse and then cached. T has a SnapshotReader
+		// constructor and a writeSnapshot member.
+		template<typename T, typename Parse>
+		T get(const std::string& name, const std::vector<std::string>& files, Parse parse) const;
+
+	private:
+		std::string getFileName(const std::string& name) const;
+
+		std::string folder;
+};
+
+
+template<typename T, typename Parse>
+T FileCache::get(const std::string& name, const std::vector<std::string>& files, Parse parse) const
+{
+	std::optional<T> cached;
+	if (load(name, files, [&cached](SnapshotReader& snapshot) { cached.emplace(snapshot); }))
+	{
+		return std::move(*cached);
+	}
+
+	T parsed = parse();
+	store(name, files, [&parsed](SnapshotWriter& snapshot) { parsed.writeSnapshot(snapshot); });
+	return parsed;
+}
+
+}
+
+
+
+#endif // PARSING_FILE_CACHE_H_
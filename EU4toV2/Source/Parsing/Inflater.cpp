@@ -0,0 +1,450 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "Inflater.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+const int MAX_BITS = 15;
+const int FAST_BITS = 10;
+const int MAX_LITERAL_CODES = 288;
+const int MAX_DISTANCE_CODES = 32;
+
+const std::array<uint16_t, 29> LENGTH_BASES = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+const std::array<uint8_t, 29> LENGTH_EXTRA_BITS = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+const std::array<uint16_t, 30> DISTANCE_BASES = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+	12289, 16385, 24577
+};
+const std::array<uint8_t, 30> DISTANCE_EXTRA_BITS = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+const std::array<uint8_t, 19> CODE_LENGTH_ORDER = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+
+class BitReader
+{
+	public:
+		explicit BitReader(std::string_view input):
+			data(reinterpret_cast<const uint8_t*>(input.data())),
+			size(input.size())
+		{}
+
+		uint32_t peekBits(int count)
+		{
+			if (bitCount < count)
+			{
+				refill();
+			}
+			return static_cast<uint32_t>(bitBuffer & ((uint64_t(1) << count) - 1));
+		}
+
+		void dropBits(int count)
+		{
+			if (bitCount < count)
+			{
+				throw std::runtime_error("Compressed save data ends unexpectedly.");
+			}
+			bitBuffer >>= count;
+			bitCount -= count;
+		}
+
+		uint32_t getBits(int count)
+		{
+			const auto bits = peekBits(count);
+			dropBits(count);
+			return bits;
+		}
+
+		void alignToByte()
+		{
+			dropBits(bitCount % 8);
+		}
+
+		// copies whole bytes, first from the bit buffer and then directly from the input
+		void copyBytes(char* destination, size_t count)
+		{
+			while ((count > 0) && (bitCount >= 8))
+			{
+				*destination++ = static_cast<char>(getBits(8));
+				count--;
+			}
+			if (count > size - position)
+			{
+				throw std::runtime_error("Compressed save data ends unexpectedly.");
+			}
+			std::memcpy(destination, data + position, count);
+			position += count;
+		}
+
+	private:
+		void refill()
+		{
+			while ((bitCount <= 56) && (position < size))
+			{
+				bitBuffer |= uint64_t(data[position++]) << bitCount;
+				bitCount += 8;
+			}
+		}
+
+		const uint8_t* data;
+		size_t size;
+		size_t position = 0;
+		uint64_t bitBuffer = 0;
+		int bitCount = 0;
+};
+
+
+// A canonical Huffman code. Codes up to FAST_BITS long are resolved with a single table lookup,
+// longer ones fall back to walking the code lengths.
+class HuffmanTable
+{
+	public:
+		void build(const uint8_t* lengths, int symbolCount)
+		{
+			counts.fill(0);
+			for (int symbol = 0; symbol < symbolCount; symbol++)
+			{
+				counts[lengths[symbol]]++;
+			}
+			counts[0] = 0;
+
+			auto left = 1;
+			for (int length = 1; length <= MAX_BITS; length++)
+			{
+				left <<= 1;
+				left -= counts[length];
+				if (left < 0)
+				{
+					throw std::runtime_error("Compressed save data has an invalid Huffman code.");
+				}
+			}
+
+			std::array<uint16_t, MAX_BITS + 2> offsets;
+			offsets[1] = 0;
+			for (int length = 1; length < MAX_BITS; length++)
+			{
+				offsets[length + 1] = offsets[length] + counts[length];
+			}
+			for (int symbol = 0; symbol < symbolCount; symbol++)
+			{
+				if (lengths[symbol] != 0)
+				{
+					symbols[offsets[lengths[symbol]]++] = static_cast<uint16_t>(symbol);
+				}
+			}
+
+			fastTable.fill(0);
+			uint32_t code = 0;
+			auto index = 0;
+			for (int length = 1; length <= FAST_BITS; length++)
+			{
+				for (int i = 0; i < counts[length]; i++)
+				{
+					const auto reversed = reverseBits(code, length);
+					const auto entry = static_cast<uint16_t>((symbols[index] << 4) | length);
+					for (uint32_t slot = reversed; slot < (1u << FAST_BITS); slot += (1u << length))
+					{
+						fastTable[slot] = entry;
+					}
+					code++;
+					index++;
+				}
+				code <<= 1;
+			}
+		}
+
+		int decode(BitReader& reader) const
+		{
+			const auto bits = reader.peekBits(MAX_BITS);
+			const auto entry = fastTable[bits & ((1u << FAST_BITS) - 1)];
+			if (entry != 0)
+			{
+				reader.dropBits(entry & 0xF);
+				return entry >> 4;
+			}
+
+			int code = 0;
+			int first = 0;
+			int index = 0;
+			for (int length = 1; length <= MAX_BITS; length++)
+			{
+				code |= (bits >> (length - 1)) & 1;
+				const int count = counts[length];
+				if (code - count < first)
+				{
+					reader.dropBits(length);
+					return symbols[index + (code - first)];
+				}
+				index += count;
+				first += count;
+				first <<= 1;
+				code <<= 1;
+			}
+			throw std::runtime_error("Compressed save data has an invalid Huffman code.");
+		}
+
+	private:
+		static uint32_t reverseBits(uint32_t code, int length)
+		{
+			uint32_t reversed = 0;
+			for (int i = 0; i < length; i++)
+			{
+				reversed = (reversed << 1) | (code & 1);
+				code >>= 1;
+			}
+			return reversed;
+		}
+
+		std::array<uint16_t, MAX_BITS + 1> counts;
+		std::array<uint16_t, MAX_LITERAL_CODES> symbols;
+		std::array<uint16_t, 1 << FAST_BITS> fastTable;
+};
+
+
+class Inflater
+{
+	public:
+		Inflater(std::string_view input, char* _output, size_t _outputSize):
+			reader(input),
+			output(_output),
+			outputSize(_outputSize)
+		{}
+
+		size_t run(const std::function<void(size_t)>& progress)
+		{
+			auto lastBlock = false;
+			while (!lastBlock)
+			{
+				lastBlock = reader.getBits(1) == 1;
+				const auto blockType = reader.getBits(2);
+				if (blockType == 0)
+				{
+					inflateStoredBlock();
+				}
+				else if (blockType == 1)
+				{
+					buildFixedTables();
+					inflateCompressedBlock();
+				}
+				else if (blockType == 2)
+				{
+					buildDynamicTables();
+					inflateCompressedBlock();
+				}
+				else
+				{
+					throw std::runtime_error("Compressed save data has an invalid block type.");
+				}
+
+				if (progress)
+				{
+					progress(outputPosition);
+				}
+			}
+			return outputPosition;
+		}
+
+	private:
+		void inflateStoredBlock()
+		{
+			reader.alignToByte();
+			const auto length = reader.getBits(16);
+			const auto complement = reader.getBits(16);
+			if ((length ^ 0xFFFF) != complement)
+			{
+				throw std::runtime_error("Compressed save data has a corrupt stored block.");
+			}
+			ensureRoom(length);
+			reader.copyBytes(output + outputPosition, length);
+			outputPosition += length;
+		}
+
+		void buildFixedTables()
+		{
+			std::array<uint8_t, MAX_LITERAL_CODES + MAX_DISTANCE_CODES> lengths;
+			std::fill(lengths.begin(), lengths.begin() + 144, 8);
+			std::fill(lengths.begin() + 144, lengths.begin() + 256, 9);
+			std::fill(lengths.begin() + 256, lengths.begin() + 280, 7);
+			std::fill(lengths.begin() + 280, lengths.begin() + MAX_LITERAL_CODES, 8);
+			std::fill(lengths.begin() + MAX_LITERAL_CODES, lengths.end(), 5);
+			literalTable.build(lengths.data(), MAX_LITERAL_CODES);
+			distanceTable.build(lengths.data() + MAX_LITERAL_CODES, MAX_DISTANCE_CODES);
+		}
+
+		void buildDynamicTables()
+		{
+			const int literalCount = reader.getBits(5) + 257;
+			const int distanceCount = reader.getBits(5) + 1;
+			const int codeLengthCount = reader.getBits(4) + 4;
+			if ((literalCount > 286) || (distanceCount > 30))
+			{
+				throw std::runtime_error("Compressed save data has too many codes.");
+			}
+
+			std::array<uint8_t, 19> codeLengthLengths{};
+			for (int i = 0; i < codeLengthCount; i++)
+			{
+				codeLengthLengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(reader.getBits(3));
+			}
+			HuffmanTable codeLengthTable;
+			codeLengthTable.build(codeLengthLengths.data(), 19);
+
+			std::array<uint8_t, MAX_LITERAL_CODES + MAX_DISTANCE_CODES> lengths{};
+			int index = 0;
+			while (index < literalCount + distanceCount)
+			{
+				const auto symbol = codeLengthTable.decode(reader);
+				if (symbol < 16)
+				{
+					lengths[index++] = static_cast<uint8_t>(symbol);
+					continue;
+				}
+
+				uint8_t repeatedLength = 0;
+				int repeat = 0;
+				if (symbol == 16)
+				{
+					if (index == 0)
+					{
+						throw std::runtime_error("Compressed save data repeats a missing code length.");
+					}
+					repeatedLength = lengths[index - 1];
+					repeat = 3 + reader.getBits(2);
+				}
+				else if (symbol == 17)
+				{
+					repeat = 3 + reader.getBits(3);
+				}
+				else
+				{
+					repeat = 11 + reader.getBits(7);
+				}
+				if (index + repeat > literalCount + distanceCount)
+				{
+					throw std::runtime_error("Compressed save data has too many code lengths.");
+				}
+				while (repeat-- > 0)
+				{
+					lengths[index++] = repeatedLength;
+				}
+			}
+
+			if (lengths[256] == 0)
+			{
+				throw std::runtime_error("Compressed save data has no end of block code.");
+			}
+			literalTable.build(lengths.data(), literalCount);
+			distanceTable.build(lengths.data() + literalCount, distanceCount);
+		}
+
+		void inflateCompressedBlock()
+		{
+			while (true)
+			{
+				const auto symbol = literalTable.decode(reader);
+				if (symbol < 256)
+				{
+					ensureRoom(1);
+					output[outputPosition++] = static_cast<char>(symbol);
+				}
+				else if (symbol == 256)
+				{
+					return;
+				}
+				else
+				{
+					const auto lengthCode = symbol - 257;
+					if (lengthCode >= 29)
+					{
+						throw std::runtime_error("Compressed save data has an invalid length code.");
+					}
+					const size_t length = LENGTH_BASES[lengthCode] + reader.getBits(LENGTH_EXTRA_BITS[lengthCode]);
+
+					const auto distanceCode = distanceTable.decode(reader);
+					if (distanceCode >= 30)
+					{
+						throw std::runtime_error("Compressed save data has an invalid distance code.");
+					}
+					const size_t distance = DISTANCE_BASES[distanceCode] + reader.getBits(DISTANCE_EXTRA_BITS[distanceCode]);
+					if (distance > outputPosition)
+					{
+						throw std::runtime_error("Compressed save data refers back before its start.");
+					}
+
+					ensureRoom(length);
+					auto destination = output + outputPosition;
+					const auto source = destination - distance;
+					if (distance >= length)
+					{
+						std::memcpy(destination, source, length);
+					}
+					else
+					{
+						for (size_t i = 0; i < length; i++)
+						{
+							destination[i] = source[i];
+						}
+					}
+					outputPosition += length;
+				}
+			}
+		}
+
+		void ensureRoom(size_t count) const
+		{
+			if (count > outputSize - outputPosition)
+			{
+				throw std::runtime_error("Compressed save data is larger than its recorded size.");
+			}
+		}
+
+		BitReader reader;
+		HuffmanTable literalTable;
+		HuffmanTable distanceTable;
+		char* output;
+		size_t outputSize;
+		size_t outputPosition = 0;
+};
+
+}
+
+
+size_t parsing::inflate(std::string_view input, char* output, size_t outputSize, const std::function<void(size_t)>& progress)
+{
+	Inflater inflater(input, output, outputSize);
+	return inflater.run(progress);
+}
@@ -0,0 +1,47 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_INFLATER_H_
+#define PARSING_INFLATER_H_
+
+
+
+#include <functional>
+#include <string_view>
+
+
+
+namespace parsing
+{
+
+// Decompresses raw DEFLATE data (RFC 1951) into a caller supplied buffer and returns the number of
+// bytes written. progress is called with the running output size after every block, so a consumer
+// can start on the data before decompression has finished. Throws std::runtime_error on corrupt or
+// truncated input.
+size_t inflate(std::string_view input, char* output, size_t outputSize, const std::function<void(size_t)>& progress);
+
+}
+
+
+
+#endif // PARSING_INFLATER_H_
@@ -0,0 +1,160 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_KEYWORD_TABLE_H_
+#define PARSING_KEYWORD_TABLE_H_
+
+
+
+#include "ParsingHelpers.h"
+#include "PerfectHash.h"
+#include "Tokenizer.h"
+#include <initializer_list>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// The keywords a class understands, built once (usually as a function-local static) and shared by
+// every object of that class. Handlers are plain functions that receive the object being read, so
+// nothing is registered per object. Exact keywords are found through a perfect hash; the few keys
+// that follow a pattern (dates, tags, province numbers) are recognised by classifier functions,
+// tried in order.
+// The table is the class's schema: any other key has its value jumped over with a raw scan for the
+// matching brace, so the parts of a save a class does not use are never split into tokens.
+// Context lets a table pass through values an object only needs while it is being read.
+template<typename Target, typename... Context>
+class KeywordTable
+{
+	public:
+		typedef void (*keywordHandler)(Target& target, std::string_view keyword, Tokenizer& tokenizer, Context... context);
+		typedef bool (*classifier)(std::string_view token);
+
+		KeywordTable(
+			std::initializer_list<std::pair<std::string_view, keywordHandler>> keywords,
+			std::initializer_list<std::pair<classifier, keywordHandler>> _patterns = {}
+		);
+
+		void parse(Target& target, Tokenizer& tokenizer, Context... context) const;
+
+	private:
+		static std::vector<std::string_view> getKeys(std::initializer_list<std::pair<std::string_view, keywordHandler>> keywords);
+
+		PerfectHash keywordHash;
+		std::vector<keywordHandler> keywordHandlers;
+		std::vector<std::pair<classifier, keywordHandler>> patterns;
+};
+
+
+// for keys that are recognised only so their values can be skipped
+template<typename Target, typename... Context>
+void ignoreKeyword(Target& target, std::string_view keyword, Tokenizer& tokenizer, Context... context)
+{
+	tokenizer.getItemText();
+}
+
+}
+
+
+
+template<typename Target, typename... Context>
+parsing::KeywordTable<Target, Context...>::KeywordTable(
+	std::initializer_list<std::pair<std::string_view, keywordHandler>> keywords,
+	std::initializer_list<std::pair<classifier, keywordHandler>> _patterns
+):
+	keywordHash(getKeys(keywords)),
+	patterns(_patterns)
+{
+	for (const auto& keyword: keywords)
+	{
+		keywordHandlers.push_back(keyword.second);
+	}
+}
+
+
+template<typename Target, typename... Context>
+void parsing::KeywordTable<Target, Context...>::parse(Target& target, Tokenizer& tokenizer, Context... context) const
+{
+	auto braceDepth = 0;
+	while (auto token = tokenizer.getNextToken())
+	{
+		if (const auto keyword = keywordHash.find(*token); keyword)
+		{
+			keywordHandlers[*keyword](target, *token, tokenizer, context...);
+			continue;
+		}
+
+		auto matched = false;
+		for (const auto& pattern: patterns)
+		{
+			if (pattern.first(*token))
+			{
+				pattern.second(target, *token, tokenizer, context...);
+				matched = true;
+				break;
+			}
+		}
+		if (matched)
+		{
+			continue;
+		}
+
+		if (isKey(*token, tokenizer))
+		{
+			tokenizer.getItemText();
+		}
+		else if (*token == "{")
+		{
+			braceDepth++;
+		}
+		else if (*token == "}")
+		{
+			braceDepth--;
+			if (braceDepth == 0)
+			{
+				break;
+			}
+		}
+	}
+}
+
+
+template<typename Target, typename... Context>
+std::vector<std::string_view> parsing::KeywordTable<Target, Context...>::getKeys(
+	std::initializer_list<std::pair<std::string_view, keywordHandler>> keywords
+) {
+	std::vector<std::string_view> keys;
+	for (const auto& keyword: keywords)
+	{
+		keys.push_back(keyword.first);
+	}
+	return keys;
+}
+
+
+
+#endif // PARSING_KEYWORD_TABLE_H_
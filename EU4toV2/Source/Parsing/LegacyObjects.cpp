@@ -0,0 +1,65 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "LegacyObjects.h"
+#include "NewParserToOldParserConverters.h"
+#include "ParadoxParser8859_15.h"
+#include "ParadoxParserUTF8.h"
+#include <mutex>
+
+
+
+namespace
+{
+
+std::mutex legacyParserMutex;
+
+}
+
+
+std::shared_ptr<Object> parsing::convert8859Object(const std::string& topKey, std::istream& theStream)
+{
+	std::lock_guard<std::mutex> lock(legacyParserMutex);
+	return commonItems::convert8859Object(topKey, theStream);
+}
+
+
+std::shared_ptr<Object> parsing::convert8859String(const std::string& topKey, std::istream& theStream)
+{
+	std::lock_guard<std::mutex> lock(legacyParserMutex);
+	return commonItems::convert8859String(topKey, theStream);
+}
+
+
+std::shared_ptr<Object> parsing::parse8859File(const std::string& fileName)
+{
+	std::lock_guard<std::mutex> lock(legacyParserMutex);
+	return parser_8859_15::doParseFile(fileName);
+}
+
+
+std::shared_ptr<Object> parsing::parseUTF8File(const std::string& fileName)
+{
+	std::lock_guard<std::mutex> lock(legacyParserMutex);
+	return parser_UTF8::doParseFile(fileName);
+}
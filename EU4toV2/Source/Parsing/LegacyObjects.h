@@ -0,0 +1,54 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_LEGACY_OBJECTS_H_
+#define PARSING_LEGACY_OBJECTS_H_
+
+
+
+#include "Object.h"
+#include <istream>
+#include <memory>
+#include <string>
+
+
+
+namespace parsing
+{
+
+// commonItems' Object parser keeps its state in globals. These take a lock around its converters
+// so that code reached from worker threads can still build Objects; call them instead of the
+// commonItems versions anywhere a save section is read.
+std::shared_ptr<Object> convert8859Object(const std::string& topKey, std::istream& theStream);
+std::shared_ptr<Object> convert8859String(const std::string& topKey, std::istream& theStream);
+
+// The same lock, for reading whole files; call these instead of parser_8859_15::doParseFile and
+// parser_UTF8::doParseFile in code that may run while a save is being read.
+std::shared_ptr<Object> parse8859File(const std::string& fileName);
+std::shared_ptr<Object> parseUTF8File(const std::string& fileName);
+
+}
+
+
+
+#endif // PARSING_LEGACY_OBJECTS_H_
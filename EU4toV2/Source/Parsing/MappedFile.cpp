@@ -0,0 +1,134 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "MappedFile.h"
+#include <stdexcept>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+#ifdef _WIN32
+
+parsing::MappedFile::MappedFile(const std::string& filename)
+{
+	fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		fileHandle = nullptr;
+		throw std::runtime_error("Could not open " + filename + " for reading.");
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Could not determine the size of " + filename + ".");
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+	if (size == 0)
+	{
+		return;
+	}
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr)
+	{
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Could not map " + filename + ".");
+	}
+	data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr)
+	{
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Could not map " + filename + ".");
+	}
+}
+
+
+parsing::MappedFile::~MappedFile()
+{
+	if (data != nullptr)
+	{
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != nullptr)
+	{
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != nullptr)
+	{
+		CloseHandle(fileHandle);
+	}
+}
+
+#else
+
+parsing::MappedFile::MappedFile(const std::string& filename)
+{
+	const auto fileDescriptor = open(filename.c_str(), O_RDONLY);
+	if (fileDescriptor == -1)
+	{
+		throw std::runtime_error("Could not open " + filename + " for reading.");
+	}
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) == -1)
+	{
+		close(fileDescriptor);
+		throw std::runtime_error("Could not determine the size of " + filename + ".");
+	}
+	size = static_cast<size_t>(fileStatus.st_size);
+	if (size == 0)
+	{
+		close(fileDescriptor);
+		return;
+	}
+
+	auto mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (mapping == MAP_FAILED)
+	{
+		throw std::runtime_error("Could not map " + filename + ".");
+	}
+	madvise(mapping, size, MADV_SEQUENTIAL);
+	data = static_cast<const char*>(mapping);
+}
+
+
+parsing::MappedFile::~MappedFile()
+{
+	if (data != nullptr)
+	{
+		munmap(const_cast<char*>(data), size);
+	}
+}
+
+#endif
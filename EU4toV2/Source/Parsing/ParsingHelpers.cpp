@@ -0,0 +1,383 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ParsingHelpers.h"
+#include "BinaryTokenReader.h"
+#include "WorkerLog.h"
+#include <cstdlib>
+#include <cstring>
+
+
+
+void parsing::ignoreItem(std::string_view unused, Tokenizer& tokenizer)
+{
+	tokenizer.getItemText();
+}
+
+
+std::string_view parsing::removeQuotes(std::string_view text)
+{
+	if ((text.size() >= 2) && (text.front() == '"') && (text.back() == '"'))
+	{
+		return text.substr(1, text.size() - 2);
+	}
+	return text;
+}
+
+
+int parsing::toInt(std::string_view text)
+{
+	text = removeQuotes(text);
+
+	size_t position = 0;
+	auto negative = false;
+	if ((position < text.size()) && ((text[position] == '-') || (text[position] == '+')))
+	{
+		negative = (text[position] == '-');
+		position++;
+	}
+
+	const auto firstDigit = position;
+	long long value = 0;
+	while ((position < text.size()) && (text[position] >= '0') && (text[position] <= '9'))
+	{
+		value = value * 10 + (text[position] - '0');
+		position++;
+	}
+
+	if (position == firstDigit)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Expected an int, but instead got " << std::string(text);
+		return 0;
+	}
+	return static_cast<int>(negative ? -value : value);
+}
+
+
+double parsing::toDouble(std::string_view text)
+{
+	text = removeQuotes(text);
+
+	char buffer[64];
+	if (text.size() < sizeof(buffer))
+	{
+		std::memcpy(buffer, text.data(), text.size());
+		buffer[text.size()] = '\0';
+
+		char* end = nullptr;
+		const auto value = std::strtod(buffer, &end);
+		if (end == buffer)
+		{
+			WORKER_LOG(LogLevel::Warning) << "Expected a double, but instead got " << std::string(text);
+			return 0.0;
+		}
+		return value;
+	}
+
+	const std::string longText(text);
+	return std::strtod(longText.c_str(), nullptr);
+}
+
+
+date parsing::toDate(std::string_view text)
+{
+	text = removeQuotes(text);
+	if (!isDate(text) && isDateKey(text))
+	{
+		const auto theDate = decodeBinaryDate(toInt(text));
+		return date(theDate.year, theDate.month, theDate.day);
+	}
+	return date(std::string(text));
+}
+
+
+std::string_view parsing::getString(Tokenizer& tokenizer)
+{
+	auto token = tokenizer.getNextToken();
+	if (token && (*token == "="))
+	{
+		token = tokenizer.getNextToken();
+	}
+	if (!token)
+	{
+		return {};
+	}
+	return removeQuotes(*token);
+}
+
+
+int parsing::getInt(Tokenizer& tokenizer)
+{
+	return toInt(getString(tokenizer));
+}
+
+
+double parsing::getDouble(Tokenizer& tokenizer)
+{
+	return toDouble(getString(tokenizer));
+}
+
+
+date parsing::getDate(Tokenizer& tokenizer)
+{
+	return toDate(getString(tokenizer));
+}
+
+
+std::vector<std::string_view> parsing::getStrings(Tokenizer& tokenizer)
+{
+	std::vector<std::string_view> strings;
+
+	auto token = tokenizer.getNextToken();
+	if (token && (*token == "="))
+	{
+		token = tokenizer.getNextToken();
+	}
+	if (!token)
+	{
+		return strings;
+	}
+	if (*token != "{")
+	{
+		strings.push_back(removeQuotes(*token));
+		return strings;
+	}
+
+	auto braceDepth = 1;
+	while (braceDepth > 0)
+	{
+		token = tokenizer.getNextToken();
+		if (!token)
+		{
+			break;
+		}
+		else if (*token == "{")
+		{
+			braceDepth++;
+		}
+		else if (*token == "}")
+		{
+			braceDepth--;
+		}
+		else if ((braceDepth == 1) && (*token != "="))
+		{
+			strings.push_back(removeQuotes(*token));
+		}
+	}
+
+	return strings;
+}
+
+
+std::vector<int> parsing::getInts(Tokenizer& tokenizer)
+{
+	std::vector<int> ints;
+	for (const auto& text: getStrings(tokenizer))
+	{
+		ints.push_back(toInt(text));
+	}
+	return ints;
+}
+
+
+std::vector<double> parsing::getDoubles(Tokenizer& tokenizer)
+{
+	std::vector<double> doubles;
+	for (const auto& text: getStrings(tokenizer))
+	{
+		doubles.push_back(toDouble(text));
+	}
+	return doubles;
+}
+
+
+std::vector<std::pair<std::string_view, std::string_view>> parsing::getAssignments(Tokenizer& tokenizer)
+{
+	std::vector<std::pair<std::string_view, std::string_view>> assignments;
+
+	auto token = tokenizer.getNextToken();
+	if (token && (*token == "="))
+	{
+		token = tokenizer.getNextToken();
+	}
+	if (!token || (*token != "{"))
+	{
+		return assignments;
+	}
+
+	auto braceDepth = 1;
+	while (braceDepth > 0)
+	{
+		const auto key = tokenizer.getNextToken();
+		if (!key)
+		{
+			break;
+		}
+		else if (*key == "{")
+		{
+			braceDepth++;
+		}
+		else if (*key == "}")
+		{
+			braceDepth--;
+		}
+		else if (const auto next = tokenizer.peekToken(); (braceDepth == 1) && next && (*next == "="))
+		{
+			tokenizer.getNextToken();
+			if (const auto value = tokenizer.peekToken(); value && (*value == "{"))
+			{
+				assignments.emplace_back(*key, tokenizer.getItemText());
+			}
+			else if (value)
+			{
+				assignments.emplace_back(*key, removeQuotes(*tokenizer.getNextToken()));
+			}
+		}
+	}
+
+	return assignments;
+}
+
+
+bool parsing::isIdentifier(std::string_view token)
+{
+	if (token.empty())
+	{
+		return false;
+	}
+	for (const auto character: token)
+	{
+		if (
+			((character < 'a') || (character > 'z')) &&
+			((character < 'A') || (character > 'Z')) &&
+			((character < '0') || (character > '9')) &&
+			(character != '_')
+		) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool parsing::isLowercaseIdentifier(std::string_view token)
+{
+	if (token.empty())
+	{
+		return false;
+	}
+	for (const auto character: token)
+	{
+		if (((character < 'a') || (character > 'z')) && ((character < '0') || (character > '9')) && (character != '_'))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool parsing::isDate(std::string_view token)
+{
+	auto parts = 0;
+	auto digits = 0;
+	for (const auto character: token)
+	{
+		if ((character >= '0') && (character <= '9'))
+		{
+			digits++;
+		}
+		else if ((character == '.') && (digits > 0) && (parts < 2))
+		{
+			parts++;
+			digits = 0;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return (parts == 2) && (digits > 0);
+}
+
+
+bool parsing::isDateKey(std::string_view token)
+{
+	if (isDate(token))
+	{
+		return true;
+	}
+	else if (token.empty())
+	{
+		return false;
+	}
+	for (const auto character: token)
+	{
+		if ((character < '0') || (character > '9'))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool parsing::isTag(std::string_view token)
+{
+	if ((token.size() != 3) || (token[0] < 'A') || (token[0] > 'Z'))
+	{
+		return false;
+	}
+	const auto isUpper = [](char character) { return (character >= 'A') && (character <= 'Z'); };
+	const auto isDigit = [](char character) { return (character >= '0') && (character <= '9'); };
+	return (isUpper(token[1]) && isUpper(token[2])) || (isDigit(token[1]) && isDigit(token[2]));
+}
+
+
+bool parsing::isProvinceKey(std::string_view token)
+{
+	if ((token.size() < 2) || (token[0] != '-'))
+	{
+		return false;
+	}
+	for (size_t i = 1; i < token.size(); i++)
+	{
+		if ((token[i] < '0') || (token[i] > '9'))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool parsing::isKey(std::string_view token, Tokenizer& tokenizer)
+{
+	if ((token == "=") || (token == "{") || (token == "}"))
+	{
+		return false;
+	}
+
+	const auto next = tokenizer.peekToken();
+	return next && ((*next == "=") || (*next == "{"));
+}
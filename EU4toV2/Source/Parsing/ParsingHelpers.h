@@ -0,0 +1,77 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_HELPERS_H_
+#define PARSING_HELPERS_H_
+
+
+
+#include "Date.h"
+#include "Tokenizer.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+void ignoreItem(std::string_view unused, Tokenizer& tokenizer);
+
+std::string_view removeQuotes(std::string_view text);
+int toInt(std::string_view text);
+double toDouble(std::string_view text);
+// a date written out (1444.11.11), or a whole number of hours as binary saves store dates
+date toDate(std::string_view text);
+
+// Readers for the value following a keyword ("= value" or "= { values }"). Views point into the
+// tokenizer's buffer and must be copied if they need to outlive it.
+std::string_view getString(Tokenizer& tokenizer);
+int getInt(Tokenizer& tokenizer);
+double getDouble(Tokenizer& tokenizer);
+date getDate(Tokenizer& tokenizer);
+std::vector<std::string_view> getStrings(Tokenizer& tokenizer);
+std::vector<int> getInts(Tokenizer& tokenizer);
+std::vector<double> getDoubles(Tokenizer& tokenizer);
+
+// The key = value pairs of a block, in order. Values that are blocks come back as their raw text.
+std::vector<std::pair<std::string_view, std::string_view>> getAssignments(Tokenizer& tokenizer);
+
+// Whole-token tests for keys that follow a pattern rather than being spelled out
+bool isIdentifier(std::string_view token); // [A-Za-z0-9_]+
+bool isLowercaseIdentifier(std::string_view token); // [a-z0-9_]+
+bool isDate(std::string_view token); // 1444.11.11
+bool isDateKey(std::string_view token); // 1444.11.11, or a whole number for the dated entries of binary saves
+bool isTag(std::string_view token); // SWE, or C01 for generated countries
+bool isProvinceKey(std::string_view token); // -1, as provinces are keyed in saves
+
+// whether a value ("= value", "= { ... }" or "{ ... }") follows token, making it the key of an item
+bool isKey(std::string_view token, Tokenizer& tokenizer);
+
+}
+
+
+
+#endif // PARSING_HELPERS_H_
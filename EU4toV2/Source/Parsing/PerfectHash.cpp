@@ -0,0 +1,103 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "PerfectHash.h"
+#include <stdexcept>
+
+
+
+parsing::PerfectHash::PerfectHash(const std::vector<std::string_view>& _keys)
+{
+	for (const auto& key: _keys)
+	{
+		keys.emplace_back(key);
+	}
+
+	size_t slotCount = 4;
+	while (slotCount < keys.size() * 2)
+	{
+		slotCount *= 2;
+	}
+
+	// A collision free seed is usually found within a few tries at this load factor; growing the
+	// table makes it certain eventually, as long as no key is repeated.
+	while (true)
+	{
+		for (uint32_t candidate = 1; candidate <= 256; candidate++)
+		{
+			if (tryToPlace(candidate, slotCount))
+			{
+				return;
+			}
+		}
+		if (slotCount >= (1 << 20))
+		{
+			throw std::runtime_error("Could not build a keyword table. Is a keyword listed twice?");
+		}
+		slotCount *= 2;
+	}
+}
+
+
+std::optional<size_t> parsing::PerfectHash::find(std::string_view key) const
+{
+	const auto slot = slots[hash(key, seed) & mask];
+	if ((slot >= 0) && (keys[slot] == key))
+	{
+		return static_cast<size_t>(slot);
+	}
+	return std::nullopt;
+}
+
+
+uint32_t parsing::PerfectHash::hash(std::string_view key, uint32_t seed)
+{
+	// FNV-1a, with the seed folded into the offset basis
+	auto value = 2166136261u ^ (seed * 16777619u);
+	for (const auto character: key)
+	{
+		value ^= static_cast<unsigned char>(character);
+		value *= 16777619u;
+	}
+	return value ^ (value >> 15);
+}
+
+
+bool parsing::PerfectHash::tryToPlace(uint32_t candidate, size_t slotCount)
+{
+	slots.assign(slotCount, -1);
+	mask = static_cast<uint32_t>(slotCount - 1);
+
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		auto& slot = slots[hash(keys[i], candidate) & mask];
+		if (slot >= 0)
+		{
+			return false;
+		}
+		slot = static_cast<int>(i);
+	}
+
+	seed = candidate;
+	return true;
+}
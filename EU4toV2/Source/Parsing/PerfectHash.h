@@ -0,0 +1,64 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_PERFECT_HASH_H_
+#define PARSING_PERFECT_HASH_H_
+
+
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// A lookup over a fixed set of keys, searched for once at construction. The seed is chosen so that
+// no two keys share a slot, so finding a key costs one hash and at most one comparison.
+class PerfectHash
+{
+	public:
+		explicit PerfectHash(const std::vector<std::string_view>& keys);
+
+		// the key's position in the list given to the constructor
+		std::optional<size_t> find(std::string_view key) const;
+
+	private:
+		static uint32_t hash(std::string_view key, uint32_t seed);
+		bool tryToPlace(uint32_t seed, size_t slotCount);
+
+		std::vector<std::string> keys;
+		std::vector<int> slots;
+		uint32_t seed = 0;
+		uint32_t mask = 0;
+};
+
+}
+
+
+
+#endif // PARSING_PERFECT_HASH_H_
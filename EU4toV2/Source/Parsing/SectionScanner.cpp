@@ -0,0 +1,68 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "SectionScanner.h"
+
+
+
+std::optional<parsing::Section> parsing::SectionScanner::getNextSection()
+{
+	const auto key = tokenizer.getNextToken();
+	if (!key)
+	{
+		return std::nullopt;
+	}
+
+	Section section{ *key, {} };
+	if ((*key == "{") || (*key == "}"))
+	{
+		return section;
+	}
+
+	if (const auto next = tokenizer.peekToken(); next && ((*next == "=") || (*next == "{")))
+	{
+		section.text = tokenizer.getItemText();
+	}
+	return section;
+}
+
+
+std::vector<parsing::Section> parsing::getBlockSections(Tokenizer& tokenizer)
+{
+	for (auto token = tokenizer.peekToken(); token && ((*token == "=") || (*token == "{")); token = tokenizer.peekToken())
+	{
+		tokenizer.getNextToken();
+	}
+
+	std::vector<Section> sections;
+	SectionScanner scanner(tokenizer);
+	while (const auto section = scanner.getNextSection())
+	{
+		if (section->key == "}")
+		{
+			break;
+		}
+		sections.push_back(*section);
+	}
+	return sections;
+}
@@ -0,0 +1,71 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_SECTION_SCANNER_H_
+#define PARSING_SECTION_SCANNER_H_
+
+
+
+#include "Tokenizer.h"
+#include <optional>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// A top-level entry: its key and the raw text of its value, starting at the '=' (or the '{' when
+// the save leaves the '=' out). Keys that stand alone, such as the EU4txt header, have no text.
+struct Section
+{
+	std::string_view key;
+	std::string_view text;
+};
+
+
+// Walks the top level of a buffer without interpreting it. Values are skipped with a brace-matching
+// scan, so each section's byte range is known long before anything inside it has been parsed.
+// Over a streamed buffer, a section is handed out as soon as its closing brace has arrived.
+class SectionScanner
+{
+	public:
+		explicit SectionScanner(Tokenizer& _tokenizer): tokenizer(_tokenizer) {}
+
+		std::optional<Section> getNextSection();
+
+	private:
+		Tokenizer& tokenizer;
+};
+
+
+// The entries of the block at the tokenizer ("= { key = value ... }"), found the same way. Unnamed
+// blocks wrapped around the entries are stepped into.
+std::vector<Section> getBlockSections(Tokenizer& tokenizer);
+
+}
+
+
+
+#endif // PARSING_SECTION_SCANNER_H_
@@ -0,0 +1,261 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <stdexcept>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+
+
+namespace
+{
+
+constexpr char magic[8] = { 'E', 'U', '4', 'S', 'N', 'A', 'P', '\0' };
+
+
+std::string getExecutablePath()
+{
+#ifdef _WIN32
+	char path[MAX_PATH];
+	const auto length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+	if ((length == 0) || (length == MAX_PATH))
+	{
+		return {};
+	}
+	return std::string(path, length);
+#else
+	return "/proc/self/exe";
+#endif
+}
+
+}
+
+
+
+parsing::SnapshotWriter::SnapshotWriter(std::ostream& _output, uint32_t formatVersion, uint64_t key):
+	output(_output)
+{
+	writeBytes(magic, sizeof(magic));
+	write(formatVersion);
+	write(key);
+}
+
+
+void parsing::SnapshotWriter::write(bool value)
+{
+	const uint8_t byte = value ? 1 : 0;
+	writeBytes(&byte, sizeof(byte));
+}
+
+
+void parsing::SnapshotWriter::write(int value)
+{
+	const auto fixedWidth = static_cast<int32_t>(value);
+	writeBytes(&fixedWidth, sizeof(fixedWidth));
+}
+
+
+void parsing::SnapshotWriter::write(uint32_t value)
+{
+	writeBytes(&value, sizeof(value));
+}
+
+
+void parsing::SnapshotWriter::write(uint64_t value)
+{
+	writeBytes(&value, sizeof(value));
+}
+
+
+void parsing::SnapshotWriter::write(double value)
+{
+	writeBytes(&value, sizeof(value));
+}
+
+
+void parsing::SnapshotWriter::write(std::string_view value)
+{
+	writeCount(value.size());
+	writeBytes(value.data(), value.size());
+}
+
+
+void parsing::SnapshotWriter::write(const date& value)
+{
+	write(value.toString());
+}
+
+
+void parsing::SnapshotWriter::writeBytes(const void* bytes, size_t size)
+{
+	output.write(static_cast<const char*>(bytes), size);
+}
+
+
+parsing::SnapshotReader::SnapshotReader(std::string_view _buffer, uint32_t formatVersion, uint64_t key):
+	buffer(_buffer)
+{
+	char fileMagic[sizeof(magic)];
+	readBytes(fileMagic, sizeof(fileMagic));
+	if (std::memcmp(fileMagic, magic, sizeof(magic)) != 0)
+	{
+		throw std::runtime_error("Not a snapshot");
+	}
+	if (read<uint32_t>() != formatVersion)
+	{
+		throw std::runtime_error("Snapshot has a different format version");
+	}
+	if (read<uint64_t>() != key)
+	{
+		throw std::runtime_error("Snapshot was made from something else");
+	}
+}
+
+
+void parsing::SnapshotReader::read(bool& value)
+{
+	uint8_t byte;
+	readBytes(&byte, sizeof(byte));
+	if (byte > 1)
+	{
+		throw std::runtime_error("Snapshot is damaged");
+	}
+	value = (byte == 1);
+}
+
+
+void parsing::SnapshotReader::read(int& value)
+{
+	int32_t fixedWidth;
+	readBytes(&fixedWidth, sizeof(fixedWidth));
+	value = fixedWidth;
+}
+
+
+void parsing::SnapshotReader::read(uint32_t& value)
+{
+	readBytes(&value, sizeof(value));
+}
+
+
+void parsing::SnapshotReader::read(uint64_t& value)
+{
+	readBytes(&value, sizeof(value));
+}
+
+
+void parsing::SnapshotReader::read(double& value)
+{
+	readBytes(&value, sizeof(value));
+}
+
+
+void parsing::SnapshotReader::read(std::string& value)
+{
+	const auto size = readCount();
+	value.assign(buffer.data() + position, size);
+	position += size;
+}
+
+
+void parsing::SnapshotReader::read(date& value)
+{
+	value = date(read<std::string>());
+}
+
+
+size_t parsing::SnapshotReader::readCount()
+{
+	const auto count = read<uint64_t>();
+	if (count > buffer.size() - position)
+	{
+		throw std::runtime_error("Snapshot is truncated");
+	}
+	return static_cast<size_t>(count);
+}
+
+
+void parsing::SnapshotReader::readBytes(void* bytes, size_t size)
+{
+	if (size > buffer.size() - position)
+	{
+		throw std::runtime_error("Snapshot is truncated");
+	}
+	std::memcpy(bytes, buffer.data() + position, size);
+	position += size;
+}
+
+
+void parsing::SnapshotKey::add(std::string_view bytes)
+{
+	// eight bytes at a time, each word mixed in as in MurmurHash64A; the length goes in too, so
+	// the boundaries between the parts added are part of the key
+	constexpr uint64_t multiplier = 0xC6A4A7935BD1E995;
+	const auto mix = [this](uint64_t word) {
+		word *= multiplier;
+		word ^= word >> 47;
+		word *= multiplier;
+		hash ^= word;
+		hash *= multiplier;
+	};
+
+	mix(bytes.size());
+	size_t position = 0;
+	for (; position + sizeof(uint64_t) <= bytes.size(); position += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, bytes.data() + position, sizeof(word));
+		mix(word);
+	}
+	uint64_t tail = 0;
+	std::memcpy(&tail, bytes.data() + position, bytes.size() - position);
+	mix(tail);
+}
+
+
+uint64_t parsing::getBuildId()
+{
+	static const auto buildId = []() -> uint64_t {
+		const auto path = getExecutablePath();
+		if (path.empty())
+		{
+			return 0;
+		}
+		try
+		{
+			const MappedFile executable(path);
+			SnapshotKey key;
+			key.add(executable.getContents());
+			return key.get();
+		}
+		catch (const std::runtime_error&)
+		{
+			return 0;
+		}
+	}();
+	return buildId;
+}
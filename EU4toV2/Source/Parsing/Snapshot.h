@@ -0,0 +1,212 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_SNAPSHOT_H_
+#define PARSING_SNAPSHOT_H_
+
+
+
+#include "Date.h"
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// Snapshots hold parsed data in a plain binary form that reads back far faster than the text it
+// came from. A snapshot starts with a header naming the format version and a key for what it was
+// made from (see SnapshotKey); a reader given any other version or key, or a file cut short,
+// throws rather than return data that doesn't belong to the caller.
+// Values are written in the machine's own byte order, as snapshots are a local cache.
+// Classes that can be snapshotted have a writeSnapshot member and a constructor taking a
+// SnapshotReader, which read their members back in the order they were written.
+class SnapshotWriter
+{
+	public:
+		SnapshotWriter(std::ostream& _output, uint32_t formatVersion, uint64_t key);
+
+		void write(bool value);
+		void write(int value);
+		void write(uint32_t value);
+		void write(uint64_t value);
+		void write(double value);
+		void write(std::string_view value);
+		void write(const std::string& value) { write(std::string_view(value)); }
+		void write(const char* value) { write(std::string_view(value)); }
+		void write(const date& value);
+
+		template<typename T>
+		void write(const std::vector<T>& values);
+		template<typename T>
+		void write(const std::set<T>& values);
+		template<typename Key, typename Value>
+		void write(const std::map<Key, Value>& values);
+
+		void writeCount(size_t count) { write(static_cast<uint64_t>(count)); }
+
+	private:
+		void writeBytes(const void* bytes, size_t size);
+
+		std::ostream& output;
+};
+
+
+class SnapshotReader
+{
+	public:
+		SnapshotReader(std::string_view _buffer, uint32_t formatVersion, uint64_t key);
+
+		void read(bool& value);
+		void read(int& value);
+		void read(uint32_t& value);
+		void read(uint64_t& value);
+		void read(double& value);
+		void read(std::string& value);
+		void read(date& value);
+
+		template<typename T>
+		void read(std::vector<T>& values);
+		template<typename T>
+		void read(std::set<T>& values);
+		template<typename Key, typename Value>
+		void read(std::map<Key, Value>& values);
+
+		template<typename T>
+		T read()
+		{
+			T value{};
+			read(value);
+			return value;
+		}
+
+		// a count of items that follow, each taking at least one byte, so a damaged count can't
+		// ask for more items than the snapshot could hold
+		size_t readCount();
+
+		bool atEnd() const { return position == buffer.size(); }
+
+	private:
+		void readBytes(void* bytes, size_t size);
+
+		std::string_view buffer;
+		size_t position = 0;
+};
+
+
+// Builds the key a snapshot is stored under from everything its contents depend on.
+class SnapshotKey
+{
+	public:
+		void add(std::string_view bytes);
+		uint64_t get() const { return hash; }
+
+	private:
+		uint64_t hash = 0x9E3779B97F4A7C15;
+};
+
+
+// The running converter's executable, hashed once: the same for every run of one build and
+// different for any other build, so a key holding it is never matched by another build's snapshot.
+// Zero when the executable can't be read.
+uint64_t getBuildId();
+
+
+template<typename T>
+void SnapshotWriter::write(const std::vector<T>& values)
+{
+	writeCount(values.size());
+	for (const auto& value: values)
+	{
+		write(value);
+	}
+}
+
+
+template<typename T>
+void SnapshotWriter::write(const std::set<T>& values)
+{
+	writeCount(values.size());
+	for (const auto& value: values)
+	{
+		write(value);
+	}
+}
+
+
+template<typename Key, typename Value>
+void SnapshotWriter::write(const std::map<Key, Value>& values)
+{
+	writeCount(values.size());
+	for (const auto& value: values)
+	{
+		write(value.first);
+		write(value.second);
+	}
+}
+
+
+template<typename T>
+void SnapshotReader::read(std::vector<T>& values)
+{
+	values.clear();
+	for (auto count = readCount(); count > 0; count--)
+	{
+		values.push_back(read<T>());
+	}
+}
+
+
+template<typename T>
+void SnapshotReader::read(std::set<T>& values)
+{
+	values.clear();
+	for (auto count = readCount(); count > 0; count--)
+	{
+		values.insert(read<T>());
+	}
+}
+
+
+template<typename Key, typename Value>
+void SnapshotReader::read(std::map<Key, Value>& values)
+{
+	values.clear();
+	for (auto count = readCount(); count > 0; count--)
+	{
+		auto key = read<Key>();
+		values.insert(std::make_pair(std::move(key), read<Value>()));
+	}
+}
+
+}
+
+
+
+#endif // PARSING_SNAPSHOT_H_
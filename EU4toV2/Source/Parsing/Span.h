@@ -0,0 +1,59 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_SPAN_H_
+#define PARSING_SPAN_H_
+
+
+
+#include <cstddef>
+
+
+
+namespace parsing
+{
+
+// Some Ts lying next to each other in memory that belong to something else, which has to outlive the span.
+template<typename T>
+class Span
+{
+	public:
+		Span() = default;
+		Span(T* _first, size_t _count): first(_first), count(_count) {}
+
+		T* begin() const { return first; }
+		T* end() const { return first + count; }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		T& operator[](size_t index) const { return first[index]; }
+
+	private:
+		T* first = nullptr;
+		size_t count = 0;
+};
+
+}
+
+
+
+#endif // PARSING_SPAN_H_
@@ -0,0 +1,92 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "StreamedBuffer.h"
+#include <stdexcept>
+
+
+
+parsing::StreamedBuffer::StreamedBuffer(size_t _capacity):
+	data(new char[_capacity]),
+	capacity(_capacity),
+	available(0),
+	cancelled(false)
+{
+}
+
+
+void parsing::StreamedBuffer::publish(size_t newAvailable)
+{
+	if (cancelled)
+	{
+		throw std::runtime_error("Reading the save was cancelled.");
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		available.store(newAvailable, std::memory_order_release);
+	}
+	readyCondition.notify_all();
+}
+
+
+void parsing::StreamedBuffer::finish(size_t finalSize)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		available.store(finalSize, std::memory_order_release);
+		finished = true;
+	}
+	readyCondition.notify_all();
+}
+
+
+void parsing::StreamedBuffer::fail(const std::string& newError)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		error = newError;
+		finished = true;
+	}
+	readyCondition.notify_all();
+}
+
+
+size_t parsing::StreamedBuffer::waitFor(size_t wanted) const
+{
+	const auto ready = available.load(std::memory_order_acquire);
+	if (ready >= wanted)
+	{
+		return ready;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	readyCondition.wait(lock, [this, wanted] {
+		return finished || (available.load(std::memory_order_acquire) >= wanted);
+	});
+	if (!error.empty())
+	{
+		throw std::runtime_error(error);
+	}
+	return available.load(std::memory_order_acquire);
+}
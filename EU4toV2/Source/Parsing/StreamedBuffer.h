@@ -0,0 +1,82 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_STREAMED_BUFFER_H_
+#define PARSING_STREAMED_BUFFER_H_
+
+
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+
+
+namespace parsing
+{
+
+// A fixed size buffer that one thread fills from the front while another reads it. The writer
+// publishes how much is ready; readers block in waitFor() until the bytes they need have arrived.
+class StreamedBuffer
+{
+	public:
+		explicit StreamedBuffer(size_t capacity);
+
+		char* getWritableData() { return data.get(); }
+		size_t getCapacity() const { return capacity; }
+
+		void publish(size_t available);
+		void finish(size_t finalSize);
+		void fail(const std::string& error);
+
+		// Returns the number of ready bytes once at least wanted are ready or no more will arrive.
+		// Rethrows the writer's error, if there was one.
+		size_t waitFor(size_t wanted) const;
+
+		// stops the writer at its next publish()
+		void cancel() { cancelled = true; }
+		bool isCancelled() const { return cancelled; }
+
+		// the whole buffer, including the part that has not been written yet
+		std::string_view getView() const { return std::string_view(data.get(), capacity); }
+
+	private:
+		std::unique_ptr<char[]> data;
+		size_t capacity;
+
+		std::atomic<size_t> available;
+		std::atomic<bool> cancelled;
+		bool finished = false;
+		std::string error;
+		mutable std::mutex mutex;
+		mutable std::condition_variable readyCondition;
+};
+
+}
+
+
+
+#endif // PARSING_STREAMED_BUFFER_H_
@@ -0,0 +1,390 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "StructuralIndex.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PARSING_HAS_SSE2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PARSING_AVX2_TARGET
+#else
+#define PARSING_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+
+
+namespace
+{
+
+// one bit per byte of a 64 byte block, the lowest bit for the first byte
+struct CharacterMasks
+{
+	uint64_t whitespace = 0;
+	uint64_t structural = 0;
+	uint64_t quote = 0;
+	uint64_t hash = 0;
+	uint64_t newline = 0;
+};
+
+
+CharacterMasks classifyScalar(const char* block)
+{
+	CharacterMasks masks;
+	for (auto i = 0; i < 64; i++)
+	{
+		const auto bit = uint64_t(1) << i;
+		switch (block[i])
+		{
+			case '\n':
+				masks.newline |= bit;
+				masks.whitespace |= bit;
+				break;
+			case ' ':
+			case '\t':
+			case '\r':
+			case '\f':
+			case '\v':
+				masks.whitespace |= bit;
+				break;
+			case '=':
+			case '{':
+			case '}':
+				masks.structural |= bit;
+				break;
+			case '"':
+				masks.quote |= bit;
+				break;
+			case '#':
+				masks.hash |= bit;
+				break;
+		}
+	}
+	return masks;
+}
+
+
+#ifdef PARSING_HAS_SSE2
+
+uint64_t matchSSE2(__m128i bytes, char character)
+{
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(character))));
+}
+
+
+CharacterMasks classifySSE2(const char* block)
+{
+	CharacterMasks masks;
+	for (auto i = 0; i < 4; i++)
+	{
+		const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+		const auto shift = 16 * i;
+
+		// '\t' to '\r' are the five characters from 9 up: once 9 is taken off, they are the bytes that
+		// an unsigned minimum with 4 leaves unchanged
+		const auto fromTab = _mm_sub_epi8(bytes, _mm_set1_epi8(9));
+		const auto controlWhitespace = _mm_cmpeq_epi8(_mm_min_epu8(fromTab, _mm_set1_epi8(4)), fromTab);
+		const auto whitespace = _mm_or_si128(controlWhitespace, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')));
+
+		masks.whitespace |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(whitespace))) << shift;
+		masks.structural |= (matchSSE2(bytes, '=') | matchSSE2(bytes, '{') | matchSSE2(bytes, '}')) << shift;
+		masks.quote |= matchSSE2(bytes, '"') << shift;
+		masks.hash |= matchSSE2(bytes, '#') << shift;
+		masks.newline |= matchSSE2(bytes, '\n') << shift;
+	}
+	return masks;
+}
+
+
+PARSING_AVX2_TARGET uint64_t matchAVX2(__m256i bytes, char character)
+{
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(character))));
+}
+
+
+PARSING_AVX2_TARGET CharacterMasks classifyAVX2(const char* block)
+{
+	CharacterMasks masks;
+	for (auto i = 0; i < 2; i++)
+	{
+		const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+		const auto shift = 32 * i;
+
+		const auto fromTab = _mm256_sub_epi8(bytes, _mm256_set1_epi8(9));
+		const auto controlWhitespace = _mm256_cmpeq_epi8(_mm256_min_epu8(fromTab, _mm256_set1_epi8(4)), fromTab);
+		const auto whitespace = _mm256_or_si256(controlWhitespace, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')));
+
+		masks.whitespace |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << shift;
+		masks.structural |= (matchAVX2(bytes, '=') | matchAVX2(bytes, '{') | matchAVX2(bytes, '}')) << shift;
+		masks.quote |= matchAVX2(bytes, '"') << shift;
+		masks.hash |= matchAVX2(bytes, '#') << shift;
+		masks.newline |= matchAVX2(bytes, '\n') << shift;
+	}
+	return masks;
+}
+
+
+bool hasAVX2()
+{
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return false;
+	}
+	__cpuid(info, 1);
+	const auto osSavesRegisters = (info[2] & (1 << 27)) != 0;
+	const auto hasAVX = (info[2] & (1 << 28)) != 0;
+	if (!osSavesRegisters || !hasAVX || ((_xgetbv(0) & 6) != 6))
+	{
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+
+int lowestBit(uint64_t bits)
+{
+#if defined(_MSC_VER) && !defined(_M_X64)
+	unsigned long index;
+	if (_BitScanForward(&index, static_cast<unsigned long>(bits)))
+	{
+		return static_cast<int>(index);
+	}
+	_BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+	return static_cast<int>(index) + 32;
+#elif defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+
+// bits first to last, inclusive; empty when last comes before first
+uint64_t bitRange(int first, int last)
+{
+	if ((first > last) || (first > 63))
+	{
+		return 0;
+	}
+	const auto fromFirst = ~uint64_t(0) << first;
+	const auto toLast = (last >= 63) ? ~uint64_t(0) : ((uint64_t(1) << (last + 1)) - 1);
+	return fromFirst & toLast;
+}
+
+
+// Turns a block's character masks into token starts, carrying open strings and comments from one
+// block to the next. A quote opens a string only where a token may start, so quotes cannot be
+// paired with a prefix XOR as in JSON; blocks holding quotes or '#' walk them in order instead.
+class BlockResolver
+{
+	public:
+		uint64_t resolve(const CharacterMasks& masks);
+
+	private:
+		bool inString = false;
+		bool inComment = false;
+		bool previousEndsToken = true;
+};
+
+
+uint64_t BlockResolver::resolve(const CharacterMasks& masks)
+{
+	const auto separators = masks.whitespace | masks.structural;
+	const auto carry = previousEndsToken ? uint64_t(1) : uint64_t(0);
+	if (!inString && !inComment && ((masks.quote | masks.hash) == 0))
+	{
+		previousEndsToken = (separators >> 63) != 0;
+		return masks.structural | (~separators & ((separators << 1) | carry));
+	}
+
+	// string contents with their closing quote, and comments up to their newline
+	uint64_t excluded = 0;
+	uint64_t closingQuotes = 0;
+	auto rangeStart = 0;
+	auto events = masks.quote | masks.hash | masks.newline;
+	while (events != 0)
+	{
+		const auto bit = lowestBit(events);
+		const auto eventMask = uint64_t(1) << bit;
+		events &= events - 1;
+
+		if (inString)
+		{
+			if ((masks.quote & eventMask) != 0)
+			{
+				excluded |= bitRange(rangeStart, bit);
+				closingQuotes |= eventMask;
+				inString = false;
+			}
+		}
+		else if (inComment)
+		{
+			if ((masks.newline & eventMask) != 0)
+			{
+				excluded |= bitRange(rangeStart, bit - 1);
+				inComment = false;
+			}
+		}
+		else if ((masks.hash & eventMask) != 0)
+		{
+			inComment = true;
+			rangeStart = bit;
+		}
+		else if ((masks.quote & eventMask) != 0)
+		{
+			const auto atTokenStart = (bit == 0) ?
+				previousEndsToken :
+				((((separators & ~excluded) | closingQuotes) >> (bit - 1)) & 1) != 0;
+			if (atTokenStart)
+			{
+				inString = true;
+				rangeStart = bit + 1;
+			}
+		}
+	}
+	if (inString || inComment)
+	{
+		excluded |= bitRange(rangeStart, 63);
+	}
+
+	const auto endsToken = (separators & ~excluded) | closingQuotes;
+	previousEndsToken = (endsToken >> 63) != 0;
+	return ((masks.structural | (~separators & ((endsToken << 1) | carry))) & ~excluded);
+}
+
+}
+
+
+parsing::StructuralIndex::instructions parsing::StructuralIndex::bestInstructions()
+{
+#ifdef PARSING_HAS_SSE2
+	static const auto best = hasAVX2() ? instructions::avx2 : instructions::sse2;
+	return best;
+#else
+	return instructions::scalar;
+#endif
+}
+
+
+parsing::StructuralIndex::StructuralIndex(std::string_view _buffer):
+	StructuralIndex(_buffer, bestInstructions())
+{
+}
+
+
+parsing::StructuralIndex::StructuralIndex(std::string_view _buffer, instructions classifier):
+	buffer(_buffer)
+{
+	if (buffer.size() > std::numeric_limits<uint32_t>::max())
+	{
+		throw std::runtime_error("A buffer of 4 GB or more cannot be indexed.");
+	}
+
+	// instructions the processor lacks fall back to the best it has
+	classifier = std::min(classifier, bestInstructions());
+	auto classify = classifyScalar;
+#ifdef PARSING_HAS_SSE2
+	if (classifier == instructions::avx2)
+	{
+		classify = classifyAVX2;
+	}
+	else if (classifier == instructions::sse2)
+	{
+		classify = classifySSE2;
+	}
+#endif
+
+	// the same byte order mark the Tokenizer skips
+	size_t blockStart = 0;
+	if ((buffer.size() >= 3) && (buffer.substr(0, 3) == "\xEF\xBB\xBF"))
+	{
+		blockStart = 3;
+	}
+
+	tokenStarts.reserve(buffer.size() / 8);
+	BlockResolver resolver;
+	while (blockStart < buffer.size())
+	{
+		CharacterMasks masks;
+		if (buffer.size() - blockStart >= 64)
+		{
+			masks = classify(buffer.data() + blockStart);
+		}
+		else
+		{
+			char lastBlock[64];
+			std::memset(lastBlock, ' ', sizeof(lastBlock));
+			std::memcpy(lastBlock, buffer.data() + blockStart, buffer.size() - blockStart);
+			masks = classify(lastBlock);
+		}
+
+		auto starts = resolver.resolve(masks);
+		while (starts != 0)
+		{
+			tokenStarts.push_back(static_cast<uint32_t>(blockStart + lowestBit(starts)));
+			starts &= starts - 1;
+		}
+		blockStart += 64;
+	}
+}
+
+
+size_t parsing::StructuralIndex::find(size_t position, size_t hint) const
+{
+	const auto begin = tokenStarts.begin();
+	hint = std::min(hint, tokenStarts.size());
+	if ((hint > 0) && (tokenStarts[hint - 1] >= position))
+	{
+		return std::lower_bound(begin, begin + hint, position) - begin;
+	}
+
+	// gallop forward from the hint, then bisect the last step
+	auto low = hint;
+	auto high = hint;
+	size_t step = 1;
+	while ((high < tokenStarts.size()) && (tokenStarts[high] < position))
+	{
+		low = high + 1;
+		high += step;
+		step *= 2;
+	}
+	high = std::min(high, tokenStarts.size());
+	return std::lower_bound(begin + low, begin + high, position) - begin;
+}
@@ -0,0 +1,70 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_STRUCTURAL_INDEX_H_
+#define PARSING_STRUCTURAL_INDEX_H_
+
+
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// The first stage of a two stage parse, after simdjson. One pass over the buffer classifies it 64
+// bytes at a time with vector compares (AVX2 or SSE2 where the processor has them, plain code
+// otherwise) and records where every token starts: each '=', '{' and '}', and the first byte of
+// every other token. Strings and comments are resolved in the same pass, by the Tokenizer's rules,
+// so a Tokenizer given the index (the second stage) moves from token to token without looking at
+// whitespace or comments, and skips a block by counting the braces among its entries.
+// Offsets are 32 bits wide, so a buffer must be smaller than 4 GB.
+class StructuralIndex
+{
+	public:
+		enum class instructions { scalar, sse2, avx2 };
+		static instructions bestInstructions();
+
+		explicit StructuralIndex(std::string_view buffer);
+		StructuralIndex(std::string_view buffer, instructions classifier);
+
+		std::string_view getBuffer() const { return buffer; }
+		const std::vector<uint32_t>& getTokenStarts() const { return tokenStarts; }
+
+		// the first entry at or after position; positions mostly move forward by a little, so the
+		// search starts from hint
+		size_t find(size_t position, size_t hint) const;
+
+	private:
+		std::string_view buffer;
+		std::vector<uint32_t> tokenStarts;
+};
+
+}
+
+
+
+#endif // PARSING_STRUCTURAL_INDEX_H_
@@ -0,0 +1,168 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "Symbol.h"
+#include "../ConversionContext.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+
+
+namespace
+{
+
+// Names live in fixed size chunks that are never moved or freed, so a reader holding an id can find
+// its name without the lock: the id only reaches it after the name was stored.
+constexpr uint32_t chunkBits = 12;
+constexpr uint32_t chunkSize = 1u << chunkBits;
+constexpr uint32_t chunkCount = 4096;
+
+}
+
+
+class parsing::SymbolTable::Names
+{
+	public:
+		Names()
+		{
+			add("");
+		}
+
+		uint32_t intern(std::string_view name)
+		{
+			{
+				std::shared_lock<std::shared_mutex> lock(mutex);
+				if (const auto id = ids.find(name); id != ids.end())
+				{
+					return id->second;
+				}
+			}
+
+			std::unique_lock<std::shared_mutex> lock(mutex);
+			if (const auto id = ids.find(name); id != ids.end())
+			{
+				return id->second;
+			}
+			return add(name);
+		}
+
+		std::optional<uint32_t> find(std::string_view name)
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			if (const auto id = ids.find(name); id != ids.end())
+			{
+				return id->second;
+			}
+			return std::nullopt;
+		}
+
+		const std::string& getName(uint32_t id) const
+		{
+			return chunks[id >> chunkBits].load(std::memory_order_acquire)[id & (chunkSize - 1)];
+		}
+
+		size_t size()
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			return count;
+		}
+
+	private:
+		// called with the lock held exclusively
+		uint32_t add(std::string_view name)
+		{
+			const auto id = count;
+			if ((id >> chunkBits) >= chunkCount)
+			{
+				throw std::runtime_error("Too many distinct names to intern");
+			}
+			if ((id & (chunkSize - 1)) == 0)
+			{
+				storage[id >> chunkBits] = std::make_unique<std::string[]>(chunkSize);
+				chunks[id >> chunkBits].store(storage[id >> chunkBits].get(), std::memory_order_release);
+			}
+
+			auto& stored = storage[id >> chunkBits][id & (chunkSize - 1)];
+			stored = name;
+			ids.emplace(stored, id);
+			count++;
+			return id;
+		}
+
+		std::shared_mutex mutex;
+		std::unordered_map<std::string_view, uint32_t> ids;
+		std::array<std::unique_ptr<std::string[]>, chunkCount> storage;
+		std::array<std::atomic<std::string*>, chunkCount> chunks{};
+		uint32_t count = 0;
+};
+
+
+parsing::SymbolTable::SymbolTable():
+	names(std::make_unique<Names>())
+{
+}
+
+
+parsing::SymbolTable::~SymbolTable() = default;
+
+
+parsing::SymbolTable& parsing::SymbolTable::shared()
+{
+	static SymbolTable table;
+	return table;
+}
+
+
+uint32_t parsing::SymbolTable::intern(std::string_view name)
+{
+	return names->intern(name);
+}
+
+
+std::optional<uint32_t> parsing::SymbolTable::find(std::string_view name)
+{
+	return names->find(name);
+}
+
+
+const std::string& parsing::SymbolTable::getName(uint32_t id) const
+{
+	return names->getName(id);
+}
+
+
+size_t parsing::SymbolTable::size()
+{
+	return names->size();
+}
+
+
+parsing::SymbolTable& parsing::FlagKind::getTable()
+{
+	return ConversionContext::current().getState<SymbolTable>([]() { return new SymbolTable; });
+}
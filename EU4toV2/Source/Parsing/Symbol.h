@@ -0,0 +1,150 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_SYMBOL_H_
+#define PARSING_SYMBOL_H_
+
+
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+
+namespace parsing
+{
+
+// The names behind Symbols of some kinds. Every distinct name gets the next number the first time it
+// is interned and keeps it, and its text, for the life of the table. Id 0 is the empty name.
+// Interning and looking up are safe from any thread; reading a name back takes no lock.
+//
+// Names every save shares - tags, cultures, religions - live in the one shared() table for the whole
+// process. Names a save makes up as it goes, like its flags and variables, live in a table of the
+// conversion's own, so they go away with it and a batch of saves can't fill the shared one.
+class SymbolTable
+{
+	public:
+		SymbolTable();
+		~SymbolTable();
+
+		SymbolTable(const SymbolTable&) = delete;
+		SymbolTable& operator=(const SymbolTable&) = delete;
+
+		static SymbolTable& shared();
+
+		uint32_t intern(std::string_view name);
+		std::optional<uint32_t> find(std::string_view name);
+		const std::string& getName(uint32_t id) const;
+		size_t size();
+
+	private:
+		class Names;
+		std::unique_ptr<Names> names;
+};
+
+
+// A name read from the game files (a tag, a culture, a religion, a flag...) held as its number in its
+// kind's SymbolTable, so copies, equality and hashes are integer operations. Kind keeps different
+// sorts of names from being mixed up and says, through Kind::getTable(), which table they live in.
+// Symbols order alphabetically, as their names would: ids depend on which thread reached a name
+// first, and sets and maps of symbols must come out the same on every run.
+template<typename Kind>
+class Symbol
+{
+	public:
+		Symbol() = default;
+		explicit Symbol(std::string_view name): id(Kind::getTable().intern(name)) {}
+
+		// the symbol for a name if anything has interned it, without interning it otherwise; a name that
+		// was never interned can't be held by anything
+		static std::optional<Symbol> find(std::string_view name)
+		{
+			if (const auto id = Kind::getTable().find(name))
+			{
+				return Symbol(*id);
+			}
+			return std::nullopt;
+		}
+
+		const std::string& getName() const { return Kind::getTable().getName(id); }
+		uint32_t getId() const { return id; }
+		bool empty() const { return id == 0; }
+
+		bool operator==(const Symbol& rhs) const { return id == rhs.id; }
+		bool operator!=(const Symbol& rhs) const { return id != rhs.id; }
+		bool operator<(const Symbol& rhs) const { return (id != rhs.id) && (getName() < rhs.getName()); }
+
+	private:
+		explicit Symbol(uint32_t _id): id(_id) {}
+
+		uint32_t id = 0;
+};
+
+
+struct TagKind
+{
+	static SymbolTable& getTable() { return SymbolTable::shared(); }
+};
+
+struct CultureKind
+{
+	static SymbolTable& getTable() { return SymbolTable::shared(); }
+};
+
+struct ReligionKind
+{
+	static SymbolTable& getTable() { return SymbolTable::shared(); }
+};
+
+// a flag read while the current ConversionContext is bound must also be read back while it is
+struct FlagKind
+{
+	static SymbolTable& getTable();
+};
+
+using TagSymbol = Symbol<TagKind>;
+using CultureSymbol = Symbol<CultureKind>;
+using ReligionSymbol = Symbol<ReligionKind>;
+using FlagSymbol = Symbol<FlagKind>;
+
+}
+
+
+namespace std
+{
+
+template<typename Kind>
+struct hash<parsing::Symbol<Kind>>
+{
+	size_t operator()(const parsing::Symbol<Kind>& symbol) const { return symbol.getId(); }
+};
+
+}
+
+
+
+#endif // PARSING_SYMBOL_H_
@@ -0,0 +1,244 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "TaskGraph.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+}
+
+
+
+parsing::TaskGraph::StageId parsing::TaskGraph::addStage(
+	const std::string& name,
+	std::function<void()> work,
+	const std::vector<StageId>& dependencies
+) {
+	const StageId id = stages.size();
+	for (const auto dependency: dependencies)
+	{
+		if (dependency >= id)
+		{
+			throw std::invalid_argument("Stage " + name + " depends on a stage added after it.");
+		}
+		stages[dependency].dependents.push_back(id);
+	}
+
+	Stage stage;
+	stage.name = name;
+	stage.work = std::move(work);
+	stage.dependencies = dependencies;
+	stage.timing.name = name;
+	stages.push_back(std::move(stage));
+	return id;
+}
+
+
+void parsing::TaskGraph::run(WorkerPool& pool)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	std::mutex mutex;
+	std::condition_variable stageFinished;
+	std::deque<StageId> ready;
+	std::vector<size_t> unfinishedDependencies;
+	for (StageId id = 0; id < stages.size(); id++)
+	{
+		stages[id].finished = false;
+		stages[id].failure = nullptr;
+		unfinishedDependencies.push_back(stages[id].dependencies.size());
+		if (stages[id].dependencies.empty())
+		{
+			ready.push_back(id);
+		}
+	}
+	size_t running = 0;
+	bool failed = false;
+	StageId logged = 0;
+	std::vector<std::future<void>> tasks;
+
+	const auto runStage = [this, start, &mutex, &stageFinished, &ready, &unfinishedDependencies, &running, &failed](StageId id) {
+		auto& stage = stages[id];
+		const auto stageStart = secondsSince(start);
+		std::exception_ptr failure;
+		std::vector<LogMessage> messages;
+		{
+			LogCapture log;
+			try
+			{
+				stage.work();
+			}
+			catch (...)
+			{
+				failure = std::current_exception();
+			}
+			messages = log.takeMessages();
+		}
+		const auto stageSeconds = secondsSince(start) - stageStart;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		stage.timing.start = stageStart;
+		stage.timing.seconds = stageSeconds;
+		stage.messages = std::move(messages);
+		stage.failure = failure;
+		stage.finished = true;
+		running--;
+		if (failure)
+		{
+			failed = true;
+			ready.clear();
+		}
+		else if (!failed)
+		{
+			for (const auto dependent: stage.dependents)
+			{
+				if (--unfinishedDependencies[dependent] == 0)
+				{
+					ready.push_back(dependent);
+				}
+			}
+		}
+		stageFinished.notify_all();
+	};
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		while (!ready.empty())
+		{
+			const auto id = ready.front();
+			ready.pop_front();
+			running++;
+
+			// a pool without threads runs the stage right here, and the stage takes the lock when it ends
+			lock.unlock();
+			tasks.push_back(pool.submit([&runStage, id]() { runStage(id); }));
+			lock.lock();
+		}
+
+		while ((logged < stages.size()) && stages[logged].finished)
+		{
+			std::vector<LogMessage> messages;
+			messages.swap(stages[logged].messages);
+			logged++;
+			lock.unlock();
+			replayLog(messages);
+			lock.lock();
+		}
+
+		if (running == 0)
+		{
+			break;
+		}
+		stageFinished.wait(lock, [this, &ready, &running, logged]() {
+			return !ready.empty() || (running == 0) || ((logged < stages.size()) && stages[logged].finished);
+		});
+	}
+	lock.unlock();
+
+	for (auto& task: tasks)
+	{
+		task.get();
+	}
+	seconds = secondsSince(start);
+
+	// after a failure, the later stages that did run are still logged, in order, before it is passed on
+	for (; logged < stages.size(); logged++)
+	{
+		replayLog(stages[logged].messages);
+		stages[logged].messages.clear();
+	}
+	for (const auto& stage: stages)
+	{
+		if (stage.failure)
+		{
+			std::rethrow_exception(stage.failure);
+		}
+	}
+}
+
+
+std::vector<parsing::TaskGraph::StageTiming> parsing::TaskGraph::getTimings() const
+{
+	std::vector<StageTiming> timings;
+	for (const auto& stage: stages)
+	{
+		if (stage.finished)
+		{
+			timings.push_back(stage.timing);
+		}
+	}
+	return timings;
+}
+
+
+std::vector<parsing::TaskGraph::StageTiming> parsing::TaskGraph::getCriticalPath() const
+{
+	// stages only depend on earlier ones, so one pass in order sees every dependency before its dependents
+	std::vector<double> pathSeconds(stages.size(), 0.0);
+	std::vector<StageId> previous(stages.size(), stages.size());
+	StageId last = stages.size();
+	for (StageId id = 0; id < stages.size(); id++)
+	{
+		if (!stages[id].finished)
+		{
+			continue;
+		}
+		for (const auto dependency: stages[id].dependencies)
+		{
+			if ((previous[id] == stages.size()) || (pathSeconds[dependency] > pathSeconds[id]))
+			{
+				pathSeconds[id] = pathSeconds[dependency];
+				previous[id] = dependency;
+			}
+		}
+		pathSeconds[id] += stages[id].timing.seconds;
+
+		if ((last == stages.size()) || (pathSeconds[id] > pathSeconds[last]))
+		{
+			last = id;
+		}
+	}
+
+	std::vector<StageTiming> path;
+	for (auto id = last; id < stages.size(); id = previous[id])
+	{
+		path.insert(path.begin(), stages[id].timing);
+	}
+	return path;
+}
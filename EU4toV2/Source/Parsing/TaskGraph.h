@@ -0,0 +1,93 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_TASK_GRAPH_H_
+#define PARSING_TASK_GRAPH_H_
+
+
+
+#include "WorkerLog.h"
+#include "WorkerPool.h"
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// Named stages that run on a WorkerPool, each as soon as the stages it depends on have finished.
+// A stage can only depend on stages added before it, so the order they were added in is always one
+// they could run in one after another. Each stage's log is captured and written in that order, so
+// the log reads the same however the stages were scheduled.
+class TaskGraph
+{
+	public:
+		typedef size_t StageId;
+
+		struct StageTiming
+		{
+			std::string name;
+			double start = 0.0; // seconds after run() was called
+			double seconds = 0.0;
+		};
+
+		StageId addStage(const std::string& name, std::function<void()> work, const std::vector<StageId>& dependencies = {});
+
+		// Returns once every stage has run. If one throws, the stages depending on it are skipped and,
+		// once the stages already running have finished, its exception is rethrown.
+		void run(WorkerPool& pool);
+
+		// after run(), in the order the stages were added; stages that never ran are left out
+		std::vector<StageTiming> getTimings() const;
+
+		// after run(), the chain of dependent stages that took longest in total. However many threads the
+		// graph is given, it can't finish faster than this.
+		std::vector<StageTiming> getCriticalPath() const;
+
+		double getSeconds() const { return seconds; } // how long run() took
+
+	private:
+		struct Stage
+		{
+			std::string name;
+			std::function<void()> work;
+			std::vector<StageId> dependencies;
+			std::vector<StageId> dependents;
+			bool finished = false;
+			StageTiming timing;
+			std::vector<LogMessage> messages;
+			std::exception_ptr failure;
+		};
+
+		std::vector<Stage> stages;
+		double seconds = 0.0;
+};
+
+}
+
+
+
+#endif // PARSING_TASK_GRAPH_H_
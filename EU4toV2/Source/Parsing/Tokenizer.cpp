@@ -0,0 +1,363 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "Tokenizer.h"
+#include "BinaryTokenReader.h"
+#include "StreamedBuffer.h"
+#include "StructuralIndex.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+bool isWhitespace(const char character)
+{
+	return (character == ' ') || (character == '\t') || (character == '\n') || (character == '\r') || (character == '\f') || (character == '\v');
+}
+
+
+bool isStructural(const char character)
+{
+	return (character == '=') || (character == '{') || (character == '}');
+}
+
+}
+
+
+parsing::Tokenizer::Tokenizer(std::string_view _buffer, const StructuralIndex* _index):
+	Tokenizer(_buffer, TokenizerSettings{ _index, nullptr })
+{
+}
+
+
+parsing::Tokenizer::Tokenizer(std::string_view _buffer, const TokenizerSettings& settings):
+	buffer(_buffer),
+	limit(_buffer.size())
+{
+	if (settings.binaryTokens != nullptr)
+	{
+		binaryTokens = settings.binaryTokens;
+		binaryReader = std::make_unique<BinaryTokenReader>(buffer, *binaryTokens);
+		position = BinaryTokenReader::getHeaderSize(buffer);
+		return;
+	}
+
+	if ((buffer.size() >= 3) && (buffer.substr(0, 3) == "\xEF\xBB\xBF"))
+	{
+		position = 3;
+	}
+
+	if ((settings.index != nullptr) && !buffer.empty())
+	{
+		const auto indexed = settings.index->getBuffer();
+		if ((buffer.data() < indexed.data()) || (buffer.data() + buffer.size() > indexed.data() + indexed.size()))
+		{
+			throw std::runtime_error("A tokenizer was given a structural index of a different buffer.");
+		}
+		index = settings.index;
+		indexOffset = buffer.data() - indexed.data();
+		nextEntry = index->find(indexOffset + position, 0);
+	}
+}
+
+
+parsing::Tokenizer::Tokenizer(const StreamedBuffer& _source):
+	buffer(_source.getView()),
+	source(&_source)
+{
+	if (isAvailable(2) && (buffer.substr(0, 3) == "\xEF\xBB\xBF"))
+	{
+		position = 3;
+	}
+}
+
+
+parsing::Tokenizer::~Tokenizer() = default;
+parsing::Tokenizer::Tokenizer(Tokenizer&&) noexcept = default;
+parsing::Tokenizer& parsing::Tokenizer::operator=(Tokenizer&&) noexcept = default;
+
+
+std::optional<std::string_view> parsing::Tokenizer::getNextToken()
+{
+	if (binaryReader)
+	{
+		auto token = binaryReader->getNextToken(position);
+		if (token)
+		{
+			lastToken = *token;
+		}
+		return token;
+	}
+
+	skipWhitespaceAndComments();
+	if (!isAvailable(position))
+	{
+		return {};
+	}
+
+	const auto start = position;
+	if (onIndex)
+	{
+		nextEntry++;
+	}
+	if (isStructural(buffer[position]))
+	{
+		position++;
+		return buffer.substr(start, 1);
+	}
+
+	if (buffer[position] == '"')
+	{
+		position++;
+		while (isAvailable(position) && (buffer[position] != '"'))
+		{
+			position++;
+		}
+		if (isAvailable(position))
+		{
+			position++;
+		}
+		return buffer.substr(start, position - start);
+	}
+
+	while (
+		isAvailable(position) &&
+		!isWhitespace(buffer[position]) &&
+		!isStructural(buffer[position]) &&
+		(buffer[position] != '#')
+	) {
+		position++;
+	}
+	return buffer.substr(start, position - start);
+}
+
+
+std::optional<std::string_view> parsing::Tokenizer::peekToken()
+{
+	const auto savedPosition = position;
+	const auto savedEntry = nextEntry;
+	const auto savedOnIndex = onIndex;
+	const auto savedToken = lastToken;
+	auto token = getNextToken();
+	position = savedPosition;
+	nextEntry = savedEntry;
+	onIndex = savedOnIndex;
+	lastToken = savedToken;
+	return token;
+}
+
+
+std::string_view parsing::Tokenizer::getItemText()
+{
+	skipWhitespaceAndComments();
+	const auto start = position;
+
+	auto token = getNextToken();
+	if (token && (*token == "="))
+	{
+		token = getNextToken();
+	}
+	if (token && (*token == "{"))
+	{
+		skipBlock();
+	}
+
+	return buffer.substr(start, position - start);
+}
+
+
+std::string parsing::Tokenizer::getItemScript()
+{
+	if (binaryReader)
+	{
+		return binaryReader->getItemText(position, lastToken);
+	}
+	return std::string(getItemText());
+}
+
+
+bool parsing::Tokenizer::atEnd()
+{
+	skipWhitespaceAndComments();
+	return !isAvailable(position);
+}
+
+
+void parsing::Tokenizer::skipWhitespaceAndComments()
+{
+	if (binaryReader)
+	{
+		return;
+	}
+	else if (onIndex)
+	{
+		position = getEntryPosition(nextEntry);
+		return;
+	}
+
+	while (isAvailable(position))
+	{
+		if (isWhitespace(buffer[position]))
+		{
+			position++;
+		}
+		else if (buffer[position] == '#')
+		{
+			while (isAvailable(position) && (buffer[position] != '\n'))
+			{
+				position++;
+			}
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	// after a jump (or at the start), the index is followed again from the first token it agrees on
+	if (index != nullptr)
+	{
+		nextEntry = index->find(indexOffset + position, nextEntry);
+		onIndex = (getEntryPosition(nextEntry) == position);
+	}
+}
+
+
+void parsing::Tokenizer::skipBlock()
+{
+	if (binaryReader)
+	{
+		binaryReader->skipBlock(position);
+		return;
+	}
+	else if (onIndex)
+	{
+		skipIndexedBlock();
+		return;
+	}
+
+	// Matches braces byte by byte instead of cutting tokens, following the same rules: quotes only
+	// open a string at the start of a token, and '#' starts a comment anywhere outside one.
+	auto braceDepth = 1;
+	auto atTokenStart = true;
+	while (isAvailable(position))
+	{
+		const auto character = buffer[position];
+		if ((character == '"') && atTokenStart)
+		{
+			position++;
+			while (isAvailable(position) && (buffer[position] != '"'))
+			{
+				position++;
+			}
+			if (isAvailable(position))
+			{
+				position++;
+			}
+			continue;
+		}
+		else if (character == '#')
+		{
+			while (isAvailable(position) && (buffer[position] != '\n'))
+			{
+				position++;
+			}
+			continue;
+		}
+		else if (character == '{')
+		{
+			braceDepth++;
+		}
+		else if (character == '}')
+		{
+			braceDepth--;
+			if (braceDepth == 0)
+			{
+				position++;
+				return;
+			}
+		}
+
+		atTokenStart = isWhitespace(character) || isStructural(character);
+		position++;
+	}
+}
+
+
+void parsing::Tokenizer::skipIndexedBlock()
+{
+	// Strings and comments are already left out of the index, so only braces need looking at.
+	const auto& tokenStarts = index->getTokenStarts();
+	auto braceDepth = 1;
+	for (; nextEntry < tokenStarts.size(); nextEntry++)
+	{
+		const auto entryPosition = tokenStarts[nextEntry] - indexOffset;
+		if (entryPosition >= limit)
+		{
+			break;
+		}
+
+		const auto character = buffer[entryPosition];
+		if (character == '{')
+		{
+			braceDepth++;
+		}
+		else if (character == '}')
+		{
+			braceDepth--;
+			if (braceDepth == 0)
+			{
+				position = entryPosition + 1;
+				nextEntry++;
+				return;
+			}
+		}
+	}
+	position = limit;
+}
+
+
+size_t parsing::Tokenizer::getEntryPosition(size_t entry) const
+{
+	const auto& tokenStarts = index->getTokenStarts();
+	if (entry >= tokenStarts.size())
+	{
+		return limit;
+	}
+	return std::min<size_t>(tokenStarts[entry] - indexOffset, limit);
+}
+
+
+bool parsing::Tokenizer::waitForData(size_t index)
+{
+	if (source == nullptr)
+	{
+		return false;
+	}
+
+	limit = source->waitFor(index + 1);
+	return index < limit;
+}
@@ -0,0 +1,123 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_TOKENIZER_H_
+#define PARSING_TOKENIZER_H_
+
+
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+
+namespace parsing
+{
+
+class BinaryTokenReader;
+class BinaryTokenTable;
+class StreamedBuffer;
+class StructuralIndex;
+
+
+// How a tokenizer reads its buffer, handed on to the tokenizers made for parts of it: with a
+// structural index of the text, or as the token stream of a binary save.
+struct TokenizerSettings
+{
+	const StructuralIndex* index = nullptr;
+	const BinaryTokenTable* binaryTokens = nullptr;
+};
+
+
+// Splits Paradox script held in a single contiguous buffer (usually a mapped file) into tokens.
+// Tokens are views into that buffer, so nothing is copied unless a handler decides to keep a value.
+// The rules follow commonItems::parser: '=', '{' and '}' are tokens of their own, '#' starts a
+// comment, and quoted strings are returned with their quotes.
+// A tokenizer over a StreamedBuffer waits for data as it catches up with the writer.
+// Given a StructuralIndex of the buffer (or of a larger buffer it is part of), the tokenizer jumps
+// from one indexed token start to the next, and skips blocks by counting braces among the entries.
+// Given a binary token table, the buffer is read as a binary save and its tokens are decoded as
+// they are asked for; quoted strings then come without their quotes.
+class Tokenizer
+{
+	public:
+		explicit Tokenizer(std::string_view buffer, const StructuralIndex* index = nullptr);
+		Tokenizer(std::string_view buffer, const TokenizerSettings& settings);
+		explicit Tokenizer(const StreamedBuffer& source);
+		~Tokenizer();
+
+		Tokenizer(Tokenizer&&) noexcept;
+		Tokenizer& operator=(Tokenizer&&) noexcept;
+
+		std::optional<std::string_view> getNextToken();
+		std::optional<std::string_view> peekToken();
+
+		// the raw text of the next item: an optional '=' followed by a single value or a complete {} block
+		std::string_view getItemText();
+
+		// the next item as Paradox script, for readers that only take text; binary items are written out
+		std::string getItemScript();
+
+		size_t getPosition() const { return position; }
+		void setPosition(size_t newPosition) { position = newPosition; onIndex = false; }
+		void advance(size_t distance) { position += distance; onIndex = false; }
+
+		std::string_view getBuffer() const { return buffer.substr(0, limit); }
+		std::string_view getRemaining() const { return buffer.substr(position, limit - position); }
+		const StreamedBuffer* getSource() const { return source; }
+		const StructuralIndex* getIndex() const { return index; }
+		TokenizerSettings getSettings() const { return { index, binaryTokens }; }
+		bool isBinary() const { return binaryTokens != nullptr; }
+		bool atEnd();
+
+	private:
+		void skipWhitespaceAndComments();
+		void skipBlock();
+		void skipIndexedBlock();
+		size_t getEntryPosition(size_t entry) const;
+
+		bool isAvailable(size_t index) { return (index < limit) || waitForData(index); }
+		bool waitForData(size_t index);
+
+		std::string_view buffer;
+		size_t position = 0;
+		size_t limit = 0;
+		const StreamedBuffer* source = nullptr;
+
+		const StructuralIndex* index = nullptr;
+		size_t indexOffset = 0; // where this buffer starts in the indexed one
+		size_t nextEntry = 0;
+		bool onIndex = false; // position is between tokens, and nextEntry is the token that follows
+
+		const BinaryTokenTable* binaryTokens = nullptr;
+		std::unique_ptr<BinaryTokenReader> binaryReader;
+		std::string_view lastToken; // kept for binary buffers only, as the key of getItemScript
+};
+
+}
+
+
+
+#endif // PARSING_TOKENIZER_H_
@@ -0,0 +1,115 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ViewStream.h"
+#include "StreamedBuffer.h"
+
+
+
+parsing::ViewBuffer::ViewBuffer(std::string_view view)
+{
+	auto begin = const_cast<char*>(view.data());
+	setg(begin, begin, begin + view.size());
+}
+
+
+parsing::ViewBuffer::ViewBuffer(const StreamedBuffer& _source, size_t offset):
+	source(&_source),
+	sourceOffset(offset)
+{
+	auto begin = const_cast<char*>(source->getView().data()) + offset;
+	const auto ready = source->waitFor(offset);
+	setg(begin, begin, begin + ((ready > offset) ? ready - offset : 0));
+}
+
+
+parsing::ViewBuffer::int_type parsing::ViewBuffer::underflow()
+{
+	if (gptr() < egptr())
+	{
+		return traits_type::to_int_type(*gptr());
+	}
+	if (source == nullptr)
+	{
+		return traits_type::eof();
+	}
+
+	const size_t end = sourceOffset + (egptr() - eback());
+	const auto ready = source->waitFor(end + 1);
+	if (ready <= end)
+	{
+		return traits_type::eof();
+	}
+	setg(eback(), gptr(), eback() + (ready - sourceOffset));
+	return traits_type::to_int_type(*gptr());
+}
+
+
+parsing::ViewBuffer::pos_type parsing::ViewBuffer::seekoff(
+	off_type offset,
+	std::ios_base::seekdir direction,
+	std::ios_base::openmode which
+) {
+	if (!(which & std::ios_base::in))
+	{
+		return pos_type(off_type(-1));
+	}
+
+	off_type base = 0;
+	if (direction == std::ios_base::cur)
+	{
+		base = gptr() - eback();
+	}
+	else if (direction == std::ios_base::end)
+	{
+		base = egptr() - eback();
+	}
+
+	const auto target = base + offset;
+	if ((target < 0) || (target > egptr() - eback()))
+	{
+		return pos_type(off_type(-1));
+	}
+	setg(eback(), eback() + target, egptr());
+	return pos_type(target);
+}
+
+
+parsing::ViewBuffer::pos_type parsing::ViewBuffer::seekpos(pos_type position, std::ios_base::openmode which)
+{
+	return seekoff(off_type(position), std::ios_base::beg, which);
+}
+
+
+parsing::ViewStream::ViewStream(std::string_view view):
+	ViewBuffer(view),
+	std::istream(static_cast<ViewBuffer*>(this))
+{
+}
+
+
+parsing::ViewStream::ViewStream(const StreamedBuffer& source, size_t offset):
+	ViewBuffer(source, offset),
+	std::istream(static_cast<ViewBuffer*>(this))
+{
+}
@@ -0,0 +1,76 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_VIEW_STREAM_H_
+#define PARSING_VIEW_STREAM_H_
+
+
+
+#include <istream>
+#include <streambuf>
+#include <string_view>
+
+
+
+namespace parsing
+{
+
+class StreamedBuffer;
+
+
+// A read-only streambuf that reads straight out of an existing buffer instead of copying it.
+// Over a StreamedBuffer it waits for the writer whenever it runs out of data.
+class ViewBuffer: public std::streambuf
+{
+	public:
+		explicit ViewBuffer(std::string_view view);
+		ViewBuffer(const StreamedBuffer& source, size_t offset);
+
+		size_t consumed() const { return gptr() - eback(); }
+
+	protected:
+		int_type underflow() override;
+		pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override;
+		pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+
+	private:
+		const StreamedBuffer* source = nullptr;
+		size_t sourceOffset = 0;
+};
+
+
+// Lets handlers written against std::istream read from a mapped buffer without copying it.
+class ViewStream: private ViewBuffer, public std::istream
+{
+	public:
+		explicit ViewStream(std::string_view view);
+		ViewStream(const StreamedBuffer& source, size_t offset);
+
+		using ViewBuffer::consumed;
+};
+
+}
+
+
+
+#endif // PARSING_VIEW_STREAM_H_
@@ -0,0 +1,101 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "WorkerLog.h"
+#include <mutex>
+
+
+
+namespace
+{
+
+thread_local parsing::LogCapture* activeCapture = nullptr;
+
+
+// LOG itself may only be used by one thread at a time
+std::mutex& getLogMutex()
+{
+	static std::mutex logMutex;
+	return logMutex;
+}
+
+}
+
+
+
+parsing::LogCapture::LogCapture():
+	outer(activeCapture)
+{
+	activeCapture = this;
+}
+
+
+parsing::LogCapture::~LogCapture()
+{
+	activeCapture = outer;
+}
+
+
+std::vector<parsing::LogMessage> parsing::LogCapture::takeMessages()
+{
+	std::vector<LogMessage> taken;
+	taken.swap(messages);
+	return taken;
+}
+
+
+void parsing::LogCapture::write(LogMessage message)
+{
+	if (activeCapture != nullptr)
+	{
+		activeCapture->messages.push_back(std::move(message));
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(getLogMutex());
+		LOG(message.level) << message.text;
+	}
+}
+
+
+void parsing::replayLog(const std::vector<LogMessage>& messages)
+{
+	if (activeCapture != nullptr)
+	{
+		activeCapture->messages.insert(activeCapture->messages.end(), messages.begin(), messages.end());
+		return;
+	}
+
+	// all in one go, so the messages don't end up mixed with those of another thread
+	std::lock_guard<std::mutex> lock(getLogMutex());
+	for (const auto& message: messages)
+	{
+		LOG(message.level) << message.text;
+	}
+}
+
+
+parsing::WorkerLog::~WorkerLog()
+{
+	LogCapture::write({ level, message.str() });
+}
@@ -0,0 +1,102 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_WORKER_LOG_H_
+#define PARSING_WORKER_LOG_H_
+
+
+
+#include "Log.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+struct LogMessage
+{
+	LogLevel level;
+	std::string text;
+};
+
+
+// LOG writes straight to the console and the log file, which is only safe from one thread at a time.
+// Code that may run on a worker logs through WORKER_LOG instead. While a LogCapture is alive on the
+// thread its messages are held there, to be replayed later by the thread that owns the log, in an
+// order that does not depend on how the work was scheduled. Without a capture they go to LOG, one
+// thread at a time. Captures nest; the innermost one on a thread receives the messages.
+class LogCapture
+{
+	public:
+		LogCapture();
+		~LogCapture();
+
+		LogCapture(const LogCapture&) = delete;
+		LogCapture& operator=(const LogCapture&) = delete;
+
+		// the messages captured so far, leaving the capture empty
+		std::vector<LogMessage> takeMessages();
+
+		// to the capture active on this thread, if there is one, otherwise to LOG
+		static void write(LogMessage message);
+
+	private:
+		friend void replayLog(const std::vector<LogMessage>& messages);
+
+		std::vector<LogMessage> messages;
+		LogCapture* outer = nullptr;
+};
+
+
+void replayLog(const std::vector<LogMessage>& messages);
+
+
+class WorkerLog
+{
+	public:
+		explicit WorkerLog(LogLevel _level): level(_level) {}
+		~WorkerLog();
+
+		template<typename T>
+		WorkerLog& operator<<(const T& value)
+		{
+			message << value;
+			return *this;
+		}
+
+	private:
+		LogLevel level;
+		std::ostringstream message;
+};
+
+}
+
+
+#define WORKER_LOG(LEVEL) parsing::WorkerLog(LEVEL)
+
+
+
+#endif // PARSING_WORKER_LOG_H_
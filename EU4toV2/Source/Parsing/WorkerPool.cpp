@@ -0,0 +1,132 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "WorkerPool.h"
+
+
+
+parsing::WorkerPool::WorkerPool(size_t threadCount)
+{
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		workers.emplace_back(&WorkerPool::work, this);
+	}
+}
+
+
+parsing::WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		jobs.clear();
+	}
+	jobAvailable.notify_all();
+	progress.notify_all();
+
+	for (auto& worker: workers)
+	{
+		worker.join();
+	}
+}
+
+
+size_t parsing::WorkerPool::defaultThreadCount()
+{
+	const auto cores = std::thread::hardware_concurrency();
+	return (cores > 0) ? cores : 1;
+}
+
+
+parsing::WorkerPool& parsing::WorkerPool::shared()
+{
+	static WorkerPool pool;
+	return pool;
+}
+
+
+void parsing::WorkerPool::enqueue(std::function<void()> job)
+{
+	if (workers.empty())
+	{
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push_back(std::move(job));
+	}
+	jobAvailable.notify_one();
+	progress.notify_all();
+}
+
+
+void parsing::WorkerPool::work()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (stopping)
+			{
+				return;
+			}
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		runJob(job);
+	}
+}
+
+
+void parsing::WorkerPool::runJob(std::function<void()>& job)
+{
+	job();
+
+	// taking the lock orders this after a waiter's check of its future, so the wakeup is never missed
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+	progress.notify_all();
+}
+
+
+void parsing::WorkerPool::helpOrWait(const std::function<bool()>& done)
+{
+	std::function<void()> job;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		// a stopping pool has dropped its queue, which readies the futures of the dropped jobs
+		progress.wait(lock, [this, &done] { return (!stopping && !jobs.empty()) || done(); });
+		if (stopping || jobs.empty())
+		{
+			return;
+		}
+		job = std::move(jobs.front());
+		jobs.pop_front();
+	}
+	runJob(job);
+}
@@ -0,0 +1,138 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_WORKER_POOL_H_
+#define PARSING_WORKER_POOL_H_
+
+
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// A fixed set of threads that run submitted tasks in the order they were submitted. Results and
+// exceptions come back through the returned futures. A pool without threads runs each task as it is
+// submitted, which keeps single threaded runs deterministic.
+// Destroying the pool waits for the tasks already running and drops those that have not started, so
+// a pool declared next to the data its tasks read is always gone before that data is.
+//
+// A task that waits for tasks it submitted to the same pool does so through wait or waitAll, which
+// run queued tasks on the waiting thread until the awaited ones are done. So nested parallel work
+// shares one set of threads without deadlocking, however deep it goes and however many conversions
+// use the pool at once. The price is that a waiting task's thread may run any other queued task in
+// the meantime: every task binds the conversion context, log capture and arena it uses itself.
+class WorkerPool
+{
+	public:
+		explicit WorkerPool(size_t threadCount = defaultThreadCount());
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		template<typename Task>
+		std::future<std::invoke_result_t<Task>> submit(Task task);
+
+		// until result is ready, helping with queued tasks meanwhile
+		template<typename Result>
+		void wait(const std::future<Result>& result);
+
+		// all of them, so that none is still running when the first error is rethrown
+		template<typename Result>
+		void waitAll(const std::vector<std::future<Result>>& results);
+
+		size_t getThreadCount() const { return workers.size(); }
+
+		// one thread per core, and at least one
+		static size_t defaultThreadCount();
+
+		// The process's pool for parsing, with defaultThreadCount threads, shared by every
+		// conversion so that nested and concurrent parses don't each start a pool of their own.
+		static WorkerPool& shared();
+
+	private:
+		void enqueue(std::function<void()> job);
+		void work();
+		void runJob(std::function<void()>& job);
+		void helpOrWait(const std::function<bool()>& done);
+
+		std::vector<std::thread> workers;
+		std::deque<std::function<void()>> jobs;
+		std::mutex mutex;
+		std::condition_variable jobAvailable;
+		std::condition_variable progress; // a job was queued or finished
+		bool stopping = false;
+};
+
+}
+
+
+
+template<typename Task>
+std::future<std::invoke_result_t<Task>> parsing::WorkerPool::submit(Task task)
+{
+	// std::function needs a copyable target, so the single-use packaged_task is shared
+	auto packagedTask = std::make_shared<std::packaged_task<std::invoke_result_t<Task>()>>(std::move(task));
+	auto result = packagedTask->get_future();
+	enqueue([packagedTask]() { (*packagedTask)(); });
+	return result;
+}
+
+
+template<typename Result>
+void parsing::WorkerPool::wait(const std::future<Result>& result)
+{
+	const std::function<bool()> done = [&result]() {
+		return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	};
+	while (!done())
+	{
+		helpOrWait(done);
+	}
+}
+
+
+template<typename Result>
+void parsing::WorkerPool::waitAll(const std::vector<std::future<Result>>& results)
+{
+	for (const auto& result: results)
+	{
+		wait(result);
+	}
+}
+
+
+
+#endif // PARSING_WORKER_POOL_H_
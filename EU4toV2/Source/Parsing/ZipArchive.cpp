@@ -0,0 +1,297 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ZipArchive.h"
+#include "Inflater.h"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+
+
+namespace
+{
+
+const uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+const uint32_t ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06064b50;
+const uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+const uint32_t CENTRAL_DIRECTORY_SIGNATURE = 0x02014b50;
+const uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+
+const uint16_t METHOD_STORED = 0;
+const uint16_t METHOD_DEFLATED = 8;
+
+
+uint16_t read16(std::string_view data, size_t offset)
+{
+	if (offset + 2 > data.size())
+	{
+		throw std::runtime_error("Zip file is truncated.");
+	}
+	const auto bytes = reinterpret_cast<const uint8_t*>(data.data() + offset);
+	return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+
+uint32_t read32(std::string_view data, size_t offset)
+{
+	return read16(data, offset) | (static_cast<uint32_t>(read16(data, offset + 2)) << 16);
+}
+
+
+uint64_t read64(std::string_view data, size_t offset)
+{
+	return read32(data, offset) | (static_cast<uint64_t>(read32(data, offset + 4)) << 32);
+}
+
+
+// slicing-by-8 CRC-32, as zip uses it
+class Crc32
+{
+	public:
+		Crc32()
+		{
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				auto value = i;
+				for (int bit = 0; bit < 8; bit++)
+				{
+					value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+				}
+				tables[0][i] = value;
+			}
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				for (int slice = 1; slice < 8; slice++)
+				{
+					tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+				}
+			}
+		}
+
+		void update(const char* data, size_t size)
+		{
+			auto bytes = reinterpret_cast<const uint8_t*>(data);
+			while (size >= 8)
+			{
+				const auto low = crc ^ (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24));
+				crc =
+					tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+					tables[3][bytes[4]] ^ tables[2][bytes[5]] ^ tables[1][bytes[6]] ^ tables[0][bytes[7]];
+				bytes += 8;
+				size -= 8;
+			}
+			while (size-- > 0)
+			{
+				crc = tables[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+			}
+		}
+
+		uint32_t getValue() const { return crc ^ 0xFFFFFFFF; }
+
+	private:
+		std::array<std::array<uint32_t, 256>, 8> tables;
+		uint32_t crc = 0xFFFFFFFF;
+};
+
+}
+
+
+parsing::ZipArchive::ZipArchive(const std::string& _filename):
+	filename(_filename),
+	file(_filename)
+{
+	readCentralDirectory();
+}
+
+
+std::optional<parsing::ZipEntry> parsing::ZipArchive::findEntry(const std::string& name) const
+{
+	for (const auto& entry: entries)
+	{
+		if (entry.name == name)
+		{
+			return entry;
+		}
+	}
+	return {};
+}
+
+
+std::string_view parsing::ZipArchive::getStoredData(const ZipEntry& entry) const
+{
+	const auto contents = file.getContents();
+	if (read32(contents, entry.localHeaderOffset) != LOCAL_HEADER_SIGNATURE)
+	{
+		throw std::runtime_error(filename + " has a corrupt entry for " + entry.name + ".");
+	}
+
+	const auto dataOffset = entry.localHeaderOffset + 30 + read16(contents, entry.localHeaderOffset + 26) + read16(contents, entry.localHeaderOffset + 28);
+	if ((dataOffset > contents.size()) || (entry.compressedSize > contents.size() - dataOffset))
+	{
+		throw std::runtime_error(filename + " is truncated.");
+	}
+	return contents.substr(dataOffset, entry.compressedSize);
+}
+
+
+size_t parsing::ZipArchive::extract(const ZipEntry& entry, char* output, const std::function<void(size_t)>& progress) const
+{
+	const auto storedData = getStoredData(entry);
+
+	Crc32 crc;
+	size_t checked = 0;
+	auto checkAndReport = [&crc, &checked, output, &progress](size_t extracted)
+	{
+		crc.update(output + checked, extracted - checked);
+		checked = extracted;
+		if (progress)
+		{
+			progress(extracted);
+		}
+	};
+
+	size_t extracted = 0;
+	if (entry.method == METHOD_STORED)
+	{
+		if (storedData.size() > entry.uncompressedSize)
+		{
+			throw std::runtime_error(entry.name + " in " + filename + " is corrupt.");
+		}
+		std::memcpy(output, storedData.data(), storedData.size());
+		extracted = storedData.size();
+		checkAndReport(extracted);
+	}
+	else if (entry.method == METHOD_DEFLATED)
+	{
+		extracted = inflate(storedData, output, entry.uncompressedSize, checkAndReport);
+	}
+	else
+	{
+		throw std::runtime_error(entry.name + " in " + filename + " uses an unsupported compression method.");
+	}
+
+	if ((extracted != entry.uncompressedSize) || (crc.getValue() != entry.crc))
+	{
+		throw std::runtime_error(entry.name + " in " + filename + " is corrupt.");
+	}
+	return extracted;
+}
+
+
+void parsing::ZipArchive::readCentralDirectory()
+{
+	const auto contents = file.getContents();
+	if (contents.size() < 22)
+	{
+		throw std::runtime_error(filename + " is not a zip file.");
+	}
+
+	// the end of central directory record is followed by a comment of at most 64k
+	size_t endRecord = contents.size() - 22;
+	const size_t searchLimit = (contents.size() > 22 + 0xFFFF) ? contents.size() - 22 - 0xFFFF : 0;
+	while (read32(contents, endRecord) != END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+	{
+		if (endRecord == searchLimit)
+		{
+			throw std::runtime_error(filename + " is not a zip file.");
+		}
+		endRecord--;
+	}
+
+	uint64_t entryCount = read16(contents, endRecord + 10);
+	uint64_t directoryOffset = read32(contents, endRecord + 16);
+	if (
+		(endRecord >= 20) &&
+		(read32(contents, endRecord - 20) == ZIP64_LOCATOR_SIGNATURE) &&
+		((entryCount == 0xFFFF) || (directoryOffset == 0xFFFFFFFF))
+	) {
+		const auto zip64Record = read64(contents, endRecord - 20 + 8);
+		if (read32(contents, zip64Record) != ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+		{
+			throw std::runtime_error(filename + " has a corrupt zip64 directory.");
+		}
+		entryCount = read64(contents, zip64Record + 32);
+		directoryOffset = read64(contents, zip64Record + 48);
+	}
+
+	auto offset = directoryOffset;
+	for (uint64_t i = 0; i < entryCount; i++)
+	{
+		if (read32(contents, offset) != CENTRAL_DIRECTORY_SIGNATURE)
+		{
+			throw std::runtime_error(filename + " has a corrupt central directory.");
+		}
+
+		ZipEntry entry;
+		const auto flags = read16(contents, offset + 8);
+		entry.method = read16(contents, offset + 10);
+		entry.crc = read32(contents, offset + 16);
+		entry.compressedSize = read32(contents, offset + 20);
+		entry.uncompressedSize = read32(contents, offset + 24);
+		const auto nameLength = read16(contents, offset + 28);
+		const auto extraLength = read16(contents, offset + 30);
+		const auto commentLength = read16(contents, offset + 32);
+		entry.localHeaderOffset = read32(contents, offset + 42);
+		if (offset + 46 + nameLength > contents.size())
+		{
+			throw std::runtime_error(filename + " is truncated.");
+		}
+		entry.name = std::string(contents.substr(offset + 46, nameLength));
+		if (flags & 1)
+		{
+			throw std::runtime_error(entry.name + " in " + filename + " is encrypted.");
+		}
+
+		// zip64 sizes and offsets live in an extra field, in this order, when the 32 bit ones overflow
+		auto extra = offset + 46 + nameLength;
+		const auto extraEnd = extra + extraLength;
+		while (extra + 4 <= extraEnd)
+		{
+			const auto id = read16(contents, extra);
+			const auto size = read16(contents, extra + 2);
+			if (id == 0x0001)
+			{
+				auto field = extra + 4;
+				if (entry.uncompressedSize == 0xFFFFFFFF)
+				{
+					entry.uncompressedSize = read64(contents, field);
+					field += 8;
+				}
+				if (entry.compressedSize == 0xFFFFFFFF)
+				{
+					entry.compressedSize = read64(contents, field);
+					field += 8;
+				}
+				if (entry.localHeaderOffset == 0xFFFFFFFF)
+				{
+					entry.localHeaderOffset = read64(contents, field);
+				}
+			}
+			extra += 4 + size;
+		}
+
+		entries.push_back(entry);
+		offset = extraEnd + commentLength;
+	}
+}
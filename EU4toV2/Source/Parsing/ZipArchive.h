@@ -0,0 +1,82 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_ZIP_ARCHIVE_H_
+#define PARSING_ZIP_ARCHIVE_H_
+
+
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+struct ZipEntry
+{
+	std::string name;
+	uint16_t method = 0;
+	uint32_t crc = 0;
+	uint64_t compressedSize = 0;
+	uint64_t uncompressedSize = 0;
+	uint64_t localHeaderOffset = 0;
+};
+
+
+// Read-only access to a zip file through its central directory. Only stored and deflated entries
+// can be extracted, which covers everything EU4 writes.
+class ZipArchive
+{
+	public:
+		explicit ZipArchive(const std::string& filename);
+
+		const std::vector<ZipEntry>& getEntries() const { return entries; }
+		std::optional<ZipEntry> findEntry(const std::string& name) const;
+
+		// the entry's data as stored in the archive, still compressed if the entry is
+		std::string_view getStoredData(const ZipEntry& entry) const;
+
+		// Extracts the entry into output, which must hold at least entry.uncompressedSize bytes.
+		// progress is called with the number of bytes extracted so far.
+		size_t extract(const ZipEntry& entry, char* output, const std::function<void(size_t)>& progress) const;
+
+	private:
+		void readCentralDirectory();
+
+		std::string filename;
+		MappedFile file;
+		std::vector<ZipEntry> entries;
+};
+
+}
+
+
+
+#endif // PARSING_ZIP_ARCHIVE_H_
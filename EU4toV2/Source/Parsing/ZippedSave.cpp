@@ -0,0 +1,98 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "ZippedSave.h"
+#include <stdexcept>
+
+
+
+parsing::ZippedSave::ZippedSave(const std::string& filename):
+	archive(filename)
+{
+	if (auto gamestate = archive.findEntry("gamestate"); gamestate)
+	{
+		if (auto meta = archive.findEntry("meta"); meta)
+		{
+			partEntries.push_back(*meta);
+		}
+		partEntries.push_back(*gamestate);
+	}
+	else
+	{
+		for (const auto& entry: archive.getEntries())
+		{
+			if ((entry.name.size() > 4) && (entry.name.substr(entry.name.size() - 4) == ".eu4"))
+			{
+				partEntries.push_back(entry);
+				break;
+			}
+		}
+	}
+	if (partEntries.empty())
+	{
+		throw std::runtime_error("Could not find a save inside " + filename + ".");
+	}
+
+	for (const auto& entry: partEntries)
+	{
+		parts.push_back(std::make_unique<StreamedBuffer>(entry.uncompressedSize));
+	}
+	extractor = std::thread(&ZippedSave::extractParts, this);
+}
+
+
+parsing::ZippedSave::~ZippedSave()
+{
+	for (auto& part: parts)
+	{
+		part->cancel();
+	}
+	if (extractor.joinable())
+	{
+		extractor.join();
+	}
+}
+
+
+void parsing::ZippedSave::extractParts()
+{
+	for (size_t i = 0; i < parts.size(); i++)
+	{
+		auto& part = *parts[i];
+		try
+		{
+			const auto extracted = archive.extract(partEntries[i], part.getWritableData(), [&part](size_t available) {
+				part.publish(available);
+			});
+			part.finish(extracted);
+		}
+		catch (std::exception& e)
+		{
+			for (size_t j = i; j < parts.size(); j++)
+			{
+				parts[j]->fail(e.what());
+			}
+			return;
+		}
+	}
+}
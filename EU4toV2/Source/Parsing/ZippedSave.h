@@ -0,0 +1,69 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef PARSING_ZIPPED_SAVE_H_
+#define PARSING_ZIPPED_SAVE_H_
+
+
+
+#include "StreamedBuffer.h"
+#include "ZipArchive.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace parsing
+{
+
+// The text of a compressed save, extracted on a background thread so it can be parsed while it is
+// still being decompressed. Saves written by EU4 itself keep the header in 'meta' and the world in
+// 'gamestate'; zips that wrap an uncompressed save hold a single .eu4 entry.
+class ZippedSave
+{
+	public:
+		explicit ZippedSave(const std::string& filename);
+		~ZippedSave();
+
+		ZippedSave(const ZippedSave&) = delete;
+		ZippedSave& operator=(const ZippedSave&) = delete;
+
+		// in the order they should be parsed
+		const std::vector<std::unique_ptr<StreamedBuffer>>& getParts() const { return parts; }
+
+	private:
+		void extractParts();
+
+		ZipArchive archive;
+		std::vector<ZipEntry> partEntries;
+		std::vector<std::unique_ptr<StreamedBuffer>> parts;
+		std::thread extractor;
+};
+
+}
+
+
+
+#endif // PARSING_ZIPPED_SAVE_H_
@@ -0,0 +1,67 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "LandConnections.h"
+#include <queue>
+
+
+
+std::vector<bool> Vic2::findLandConnections(
+	const std::vector<std::string>& owners,
+	const std::map<std::string, int>& capitals,
+	const std::function<parsing::Span<const int>(int)>& getAdjacencies
+) {
+	const auto isOwnedBy = [&owners](int province, const std::string& owner) {
+		return (province >= 0) && (static_cast<size_t>(province) < owners.size()) && !owner.empty() && (owners[province] == owner);
+	};
+
+	std::vector<bool> reached(owners.size(), false);
+	std::queue<int> goodProvinces;
+	for (const auto& capital: capitals)
+	{
+		if (!isOwnedBy(capital.second, capital.first)) // if the capital is not owned, don't bother running
+		{
+			continue;
+		}
+		reached[capital.second] = true;
+		goodProvinces.push(capital.second);
+	}
+
+	while (!goodProvinces.empty())
+	{
+		const auto currentProvince = goodProvinces.front();
+		goodProvinces.pop();
+		const auto& owner = owners[currentProvince];
+		for (const auto adjacency: getAdjacencies(currentProvince))
+		{
+			if (!isOwnedBy(adjacency, owner) || reached[adjacency])
+			{
+				continue;
+			}
+			reached[adjacency] = true;
+			goodProvinces.push(adjacency);
+		}
+	}
+
+	return reached;
+}
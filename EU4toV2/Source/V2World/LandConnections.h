@@ -0,0 +1,55 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef LAND_CONNECTIONS_H
+#define LAND_CONNECTIONS_H
+
+
+
+#include "../Parsing/Span.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+
+
+namespace Vic2
+{
+
+// For each province number, whether its owner reaches it overland from the capital: one search out from every
+// owned capital at once, stepping only onto provinces with the capital's owner, so no two searches meet.
+// owners[n] is the owner of province n, empty for nobody or for a number with no province. Countries that don't
+// own their capital reach nothing. Adjacencies are followed in the direction given, as Vic2's aren't always
+// symmetric.
+std::vector<bool> findLandConnections(
+	const std::vector<std::string>& owners,
+	const std::map<std::string, int>& capitals,
+	const std::function<parsing::Span<const int>(int)>& getAdjacencies
+);
+
+}
+
+
+
+#endif // LAND_CONNECTIONS_H
@@ -0,0 +1,80 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "StateGrouping.h"
+#include <algorithm>
+#include <map>
+
+
+
+std::vector<std::vector<int>> Vic2::groupProvincesIntoStates(
+	const std::vector<std::string>& owners,
+	const std::vector<bool>& colonial,
+	const std::function<parsing::Span<const int>(int)>& getStateProvinces
+) {
+	// a state only ever holds provinces of one owner, so each owner's provinces are split into states on their own
+	std::map<std::string, std::vector<int>> provincesByOwner;
+	for (size_t province = 0; province < owners.size(); province++)
+	{
+		if (!owners[province].empty())
+		{
+			provincesByOwner[owners[province]].push_back(static_cast<int>(province));
+		}
+	}
+
+	// Owners only mark their own provinces, and a byte each keeps them apart, so owners could be handed out to threads.
+	std::vector<char> assigned(owners.size(), false);
+	std::vector<std::vector<int>> states;
+	for (const auto& ownedProvinces: provincesByOwner)
+	{
+		for (const auto seed: ownedProvinces.second)
+		{
+			if (assigned[seed])
+			{
+				continue;
+			}
+			assigned[seed] = true;
+			std::vector<int> stateProvinces{ seed };
+
+			for (const auto neighbor: getStateProvinces(seed))
+			{
+				if ((neighbor < 0) || (static_cast<size_t>(neighbor) >= owners.size()) || assigned[neighbor])
+				{
+					continue;
+				}
+				if ((owners[neighbor] != ownedProvinces.first) || (colonial[neighbor] != colonial[seed]))
+				{
+					continue;
+				}
+				stateProvinces.push_back(neighbor);
+				assigned[neighbor] = true;
+			}
+			states.push_back(std::move(stateProvinces));
+		}
+	}
+
+	std::sort(states.begin(), states.end(), [](const std::vector<int>& a, const std::vector<int>& b) {
+		return a.front() < b.front();
+	});
+	return states;
+}
@@ -0,0 +1,55 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef STATE_GROUPING_H
+#define STATE_GROUPING_H
+
+
+
+#include "../Parsing/Span.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+
+
+namespace Vic2
+{
+
+// The provinces of each new Vic2 state, the province that started it first, in state id order. Each owner's
+// provinces are taken in order, and any not yet in a state starts a new one with the rest of its Vic2 state that
+// have the same owner and colonial status and aren't in a state yet. States are numbered in the order of the
+// provinces that started them, whoever owns them.
+// owners[n] and colonial[n] are for province n, owners[n] empty for nobody or for a number with no province.
+// getStateProvinces gives every province in a province's Vic2 state, as the state mapper does.
+std::vector<std::vector<int>> groupProvincesIntoStates(
+	const std::vector<std::string>& owners,
+	const std::vector<bool>& colonial,
+	const std::function<parsing::Span<const int>(int)>& getStateProvinces
+);
+
+}
+
+
+
+#endif // STATE_GROUPING_H
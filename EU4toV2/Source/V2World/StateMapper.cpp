@@ -23,9 +23,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "StateMapper.h"
 #include "../Configuration.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include "ParserHelpers.h"
+#include <algorithm>
 #include <fstream>
 
 
@@ -35,40 +36,48 @@ Vic2::stateMapper::stateMapper(std::istream& theStream)
 	registerKeyword(std::regex("[a-zA-Z0-9_]+"), [this](const std::string& unused, std::istream& theStream){
 		commonItems::intList provinceList(theStream);
 
-		std::set<int> provinces;
-		for (auto province: provinceList.getInts())
-		{
-			provinces.insert(province);
-		}
+		auto provinces = provinceList.getInts();
+		std::sort(provinces.begin(), provinces.end());
+		provinces.erase(std::unique(provinces.begin(), provinces.end()), provinces.end());
 
+		const auto state = static_cast<int>(stateProvinces.size());
 		for (auto province: provinces)
 		{
-			stateProvincesMap.insert(std::make_pair(province, provinces));
+			if (province < 0)
+			{
+				continue;
+			}
+			if (static_cast<size_t>(province) >= stateOfProvince.size())
+			{
+				stateOfProvince.resize(province + 1, -1);
+			}
+			if (stateOfProvince[province] == -1)
+			{
+				stateOfProvince[province] = state;
+			}
 		}
+		stateProvinces.push_back(std::move(provinces));
 	});
 
 	parseStream(theStream);
 }
 
 
-std::set<int> Vic2::stateMapper::getAllProvincesInState(int province)
+parsing::Span<const int> Vic2::stateMapper::getAllProvincesInState(int province) const
 {
-	auto mapping = stateProvincesMap.find(province);
-	if (mapping != stateProvincesMap.end())
-	{
-		return mapping->second;
-	}
-	else
+	if ((province < 0) || (static_cast<size_t>(province) >= stateOfProvince.size()) || (stateOfProvince[province] == -1))
 	{
-		std::set<int> empty;
-		return empty;
+		return {};
 	}
+
+	const auto& provinces = stateProvinces[stateOfProvince[province]];
+	return parsing::Span<const int>(provinces.data(), provinces.size());
 }
 
 
 Vic2::stateMapperFile::stateMapperFile()
 {
-	LOG(LogLevel::Info) << "Parsing region structure";
+	WORKER_LOG(LogLevel::Info) << "Parsing region structure";
 
 	std::string filename;
 	if (Utils::DoesFileExist("./blankMod/output/map/region.txt"))
@@ -77,13 +86,13 @@ Vic2::stateMapperFile::stateMapperFile()
 	}
 	else
 	{
-		filename = theConfiguration.getVic2Path() + "/map/region.txt";
+		filename = theConfiguration().getVic2Path() + "/map/region.txt";
 	}
 
 	std::ifstream theFile(filename);
 	if (!theFile.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not open " << filename << " for parsing.";
+		WORKER_LOG(LogLevel::Error) << "Could not open " << filename << " for parsing.";
 		return;
 	}
 
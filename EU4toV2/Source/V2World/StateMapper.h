@@ -27,9 +27,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "newParser.h"
-#include <map>
+#include "../Parsing/Span.h"
 #include <memory>
-#include <set>
+#include <vector>
 
 
 
@@ -38,6 +38,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 namespace Vic2
 {
 
+// The Vic2 states from region.txt, each a sorted list of its provinces, and the state each province is in. A province
+// listed in more than one state stays in the first.
 class stateMapper: commonItems::parser
 {
 	public:
@@ -48,12 +50,14 @@ class stateMapper: commonItems::parser
 		stateMapper& operator=(const stateMapper&) = default;
 		stateMapper& operator=(stateMapper&&) = default;
 
-		std::set<int> getAllProvincesInState(int province);
+		// every province in the same state as province, itself included; empty if it's in no state
+		parsing::Span<const int> getAllProvincesInState(int province) const;
 
 	private:
 		stateMapper() = delete;
 
-		std::map<int, std::set<int>> stateProvincesMap;
+		std::vector<std::vector<int>> stateProvinces;
+		std::vector<int> stateOfProvince; // -1 where a province is in no state
 };
 
 
@@ -22,18 +22,28 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Army.h"
-#include "Log.h"
+#include "../ConversionContext.h"
+#include "../Parsing/WorkerLog.h"
 #include <cstring>
 
 
 
-static int nextArmyID = 0;
+namespace
+{
+
+// IDs count up from 1 within each conversion
+struct ArmyIDCounter
+{
+	int lastID = 0;
+};
+
+}
 
 
 V2ArmyID::V2ArmyID()
 {
 	type = 40; // seems to be always 40, for army, navy, ship and regiment
-	id = ++nextArmyID;
+	id = ++ConversionContext::current().getState<ArmyIDCounter>([]() { return new ArmyIDCounter; }).lastID;
 }
 
 
@@ -79,7 +89,7 @@ V2Regiment::V2Regiment(EU4::REGIMENTCATEGORY rc) : category(rc)
 		isShip = true;
 		break;
 	default:
-		LOG(LogLevel::Warning) << "Unexpected regiment category " << rc;
+		WORKER_LOG(LogLevel::Warning) << "Unexpected regiment category " << rc;
 		break;
 	}
 	home = 0;
@@ -123,7 +133,7 @@ std::ostream& operator<<(std::ostream& output, const V2Army& army)
 {
 	if (army.regiments.size() == 0)
 	{
-		LOG(LogLevel::Debug) << "Army " << army.name << " has no regiments after conversion; skipping";
+		WORKER_LOG(LogLevel::Debug) << "Army " << army.name << " has no regiments after conversion; skipping";
 		return output;
 	}
 	if (army.isNavy)
@@ -1,10 +1,11 @@
 #include "V2Country.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "../Configuration.h"
+#include "../ConversionContext.h"
 #include "../Mappers/ReligionMapper.h"
 #include "../Mappers/PartyNameMapper.h"
 #include "CardinalToOrdinal.h"
-#include "ParadoxParser8859_15.h"
+#include "../Parsing/LegacyObjects.h"
 #include "OSCompatibilityLayer.h"
 #include "../EU4World/CultureGroups.h"
 #include "../EU4World/World.h"
@@ -176,20 +177,20 @@ shared_ptr<Object> V2Country::parseCountryFile(const string& filename)
 	{
 		fileToParse = "./blankMod/output/common/countries/" + filename;
 	}
-	else if (Utils::DoesFileExist(theConfiguration.getVic2Path() + "/common/countries/" + filename))
+	else if (Utils::DoesFileExist(theConfiguration().getVic2Path() + "/common/countries/" + filename))
 	{
-		fileToParse = theConfiguration.getVic2Path() + "/common/countries/" + filename;
+		fileToParse = theConfiguration().getVic2Path() + "/common/countries/" + filename;
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "Could not find file common/countries/" << filename << " - skipping";
+		WORKER_LOG(LogLevel::Debug) << "Could not find file common/countries/" << filename << " - skipping";
 		return nullptr;
 	}
 
-	shared_ptr<Object> countryData = parser_8859_15::doParseFile(fileToParse);
+	shared_ptr<Object> countryData = parsing::parse8859File(fileToParse);
 	if (countryData == nullptr)
 	{
-		LOG(LogLevel::Warning) << "Could not parse file " << fileToParse;
+		WORKER_LOG(LogLevel::Warning) << "Could not parse file " << fileToParse;
 	}
 
 	return countryData;
@@ -283,9 +284,9 @@ void V2Country::output() const
 	if(!dynamicCountry)
 	{
 		FILE* output;
-		if (fopen_s(&output, ("output/" + theConfiguration.getOutputName() + "/history/countries/" + filename).c_str(), "w") != 0)
+		if (fopen_s(&output, ("output/" + theConfiguration().getOutputName() + "/history/countries/" + filename).c_str(), "w") != 0)
 		{
-			LOG(LogLevel::Error) << "Could not create country history file " << filename;
+			WORKER_LOG(LogLevel::Error) << "Could not create country history file " << filename;
 			exit(-1);
 		}
 
@@ -404,10 +405,10 @@ void V2Country::output() const
 	if (newCountry)
 	{
 		// Output common country file.
-		std::ofstream commonCountryOutput("output/" + theConfiguration.getOutputName() + "/common/countries/" + commonCountryFile);
+		std::ofstream commonCountryOutput("output/" + theConfiguration().getOutputName() + "/common/countries/" + commonCountryFile);
 		if (!commonCountryOutput.is_open())
 		{
-			LOG(LogLevel::Error) << "Could not open output/" + theConfiguration.getOutputName() + "/common/countries/" + commonCountryFile;
+			WORKER_LOG(LogLevel::Error) << "Could not open output/" + theConfiguration().getOutputName() + "/common/countries/" + commonCountryFile;
 			exit(-1);
 		}
 		commonCountryOutput << "graphical_culture = UsGC\n";	// default to US graphics
@@ -463,7 +464,7 @@ void V2Country::outputElection(FILE* output) const
 
 void V2Country::outputOOB() const
 {
-	std::ofstream output("output/" + theConfiguration.getOutputName() + "/history/units/" + tag + "_OOB.txt");
+	std::ofstream output("output/" + theConfiguration().getOutputName() + "/history/units/" + tag + "_OOB.txt");
 	if (!output.is_open())
 	{
 		std::runtime_error exception("Could not create OOB file " + tag + "_OOB.txt");
@@ -517,7 +518,7 @@ void V2Country::initFromEU4Country(
 	auto possibleFilename = Utils::GetFileFromTag("./blankMod/output/history/countries/", tag);
 	if (!possibleFilename)
 	{
-		possibleFilename = Utils::GetFileFromTag(theConfiguration.getVic2Path() + "/history/countries/", tag);
+		possibleFilename = Utils::GetFileFromTag(theConfiguration().getVic2Path() + "/history/countries/", tag);
 	}
 
 	if (!possibleFilename)
@@ -591,7 +592,7 @@ void V2Country::setReligion(std::shared_ptr<EU4::Country> srcCountry, const mapp
 		std::optional<std::string> match = religionMapper.getVic2Religion(srcReligion);
 		if (!match)
 		{
-			LOG(LogLevel::Warning) << "No religion mapping defined for " << srcReligion
+			WORKER_LOG(LogLevel::Warning) << "No religion mapping defined for " << srcReligion
 				<< " (" << srcCountry->getTag() << " -> " << tag << ')';
 		}
 		else
@@ -619,7 +620,7 @@ void V2Country::setPrimaryAndAcceptedCultures(std::shared_ptr<EU4::Country> srcC
 		);
 		if (!matched)
 		{
-			LOG(LogLevel::Warning) << "No culture mapping defined for " << srcCulture
+			WORKER_LOG(LogLevel::Warning) << "No culture mapping defined for " << srcCulture
 				<< " (" << srcCountry->getTag() << " -> " << tag << ')';
 		}
 		else
@@ -657,7 +658,7 @@ void V2Country::setPrimaryAndAcceptedCultures(std::shared_ptr<EU4::Country> srcC
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "No culture mapping defined for " << srcCulture
+			WORKER_LOG(LogLevel::Warning) << "No culture mapping defined for " << srcCulture
 				<< " (" << srcCountry->getTag() << " -> " << tag << ')';
 		}
 	}
@@ -673,7 +674,7 @@ void V2Country::determineGovernmentType(std::shared_ptr<EU4::Country> srcCountry
 		std::string enforce = ideaEffectMapper.getEnforceFromIdea(reformStr, 7);
 		if (!enforce.empty())
 		{
-			LOG(LogLevel::Debug) << "Forcing government " << enforce << " on " << tag;
+			WORKER_LOG(LogLevel::Debug) << "Forcing government " << enforce << " on " << tag;
 			government = enforce;
 		}
 	}
@@ -726,7 +727,7 @@ void V2Country::resolvePolitics()
 		upperHouseReactionary = static_cast<int>(upperHouseReactionary / 3);
 		upperHouseLiberal = static_cast<int>(upperHouseLiberal * 3);
 		upperHouseConservative = 100 - (upperHouseReactionary + upperHouseLiberal);
-		LOG(LogLevel::Debug) << tag << " is revolutionary! ";
+		WORKER_LOG(LogLevel::Debug) << tag << " is revolutionary! ";
 	}
 
 	string idealogy;
@@ -850,9 +851,9 @@ void V2Country::calculateLiteracy(std::shared_ptr<EU4::Country> srcCountry)
 
 	literacy += collegeBonus + universityBonus;
 
-	if (literacy > theConfiguration.getMaxLiteracy())
+	if (literacy > theConfiguration().getMaxLiteracy())
 	{
-		literacy = theConfiguration.getMaxLiteracy();
+		literacy = theConfiguration().getMaxLiteracy();
 	}
 
 	// Finally apply collective national literacy modifier.
@@ -878,17 +879,17 @@ void V2Country::buildCanals(std::shared_ptr<EU4::Country> srcCountry)
 	{
 		if (prov->hasGreatProject("suez_canal"))
 		{
-			LOG(LogLevel::Debug) << "Building Suez Canal in: " << prov->getName();
+			WORKER_LOG(LogLevel::Debug) << "Building Suez Canal in: " << prov->getName();
 			decisions.push_back("build_suez_canal");
 		}
 		if (prov->hasGreatProject("kiel_canal"))
 		{
-			LOG(LogLevel::Debug) << "Building Kiel Canal in: " << prov->getName();
+			WORKER_LOG(LogLevel::Debug) << "Building Kiel Canal in: " << prov->getName();
 			decisions.push_back("build_kiel_canal");
 		}
 		if (prov->hasGreatProject("panama_canal"))
 		{
-			LOG(LogLevel::Debug) << "Building Panama Canal in: " << prov->getName();
+			WORKER_LOG(LogLevel::Debug) << "Building Panama Canal in: " << prov->getName();
 			decisions.push_back("build_panama_canal");
 		}
 	}
@@ -908,7 +909,7 @@ void V2Country::initFromHistory()
 	{
 		if (inputBuffer.rfind(tag, 0) == 0)
 		{
-			LOG(LogLevel::Debug) << "Found " << tag << " in unreleasables.";
+			WORKER_LOG(LogLevel::Debug) << "Found " << tag << " in unreleasables.";
 			isReleasableVassal = false;
 		}
 	}
@@ -924,11 +925,11 @@ void V2Country::initFromHistory()
 	}
 	else
 	{
-		possibleFilename = Utils::GetFileFromTag(theConfiguration.getVic2Path() + "/history/countries/", tag);
+		possibleFilename = Utils::GetFileFromTag(theConfiguration().getVic2Path() + "/history/countries/", tag);
 		if (possibleFilename)
 		{
 			filename = *possibleFilename;
-			fullFilename = theConfiguration.getVic2Path() + "/history/countries/" + filename;
+			fullFilename = theConfiguration().getVic2Path() + "/history/countries/" + filename;
 		}
 	}
 	if (!possibleFilename)
@@ -940,10 +941,10 @@ void V2Country::initFromHistory()
 		return;
 	}
 
-	shared_ptr<Object> obj = parser_8859_15::doParseFile(fullFilename.c_str());
+	shared_ptr<Object> obj = parsing::parse8859File(fullFilename.c_str());
 	if (obj == nullptr)
 	{
-		LOG(LogLevel::Error) << "Could not parse file " << fullFilename;
+		WORKER_LOG(LogLevel::Error) << "Could not parse file " << fullFilename;
 		exit(-1);
 	}
 
@@ -1009,28 +1010,32 @@ void V2Country::addProvince(V2Province* _province)
 	auto itr = provinces.find(_province->getNum());
 	if (itr != provinces.end())
 	{
-		LOG(LogLevel::Error) << "Inserting province " << _province->getNum() << " multiple times (addProvince())";
+		WORKER_LOG(LogLevel::Error) << "Inserting province " << _province->getNum() << " multiple times (addProvince())";
 	}
 	provinces.insert(make_pair(_province->getNum(), _province));
 }
 
 
+static set<int> readPortBlacklist()
+{
+	set<int> port_blacklist;
+	int temp = 0;
+	ifstream s("port_blacklist.txt");
+	while (s.good() && !s.eof())
+	{
+		s >> temp;
+		port_blacklist.insert(temp);
+	}
+	s.close();
+	return port_blacklist;
+}
+
+
 static set<int> getPortBlacklist()
 {
 	// hack for naval bases.  not ALL naval bases are in port provinces, and if you spawn a navy at a naval base in
 	// a non-port province, Vicky crashes....
-	static set<int> port_blacklist;
-	if (port_blacklist.size() == 0)
-	{
-		int temp = 0;
-		ifstream s("port_blacklist.txt");
-		while (s.good() && !s.eof())
-		{
-			s >> temp;
-			port_blacklist.insert(temp);
-		}
-		s.close();
-	}
+	static const set<int> port_blacklist = readPortBlacklist();
 	return port_blacklist;
 }
 
@@ -1092,7 +1097,7 @@ void V2Country::addState(V2State* newState)
 		}
 
 		// find the province with the highest naval base level
-		if ((theConfiguration.getVic2Gametype() == "HOD") || (theConfiguration.getVic2Gametype() == "HoD-NNM"))
+		if ((theConfiguration().getVic2Gametype() == "HOD") || (theConfiguration().getVic2Gametype() == "HoD-NNM"))
 		{
 			int navalLevel = 0;
 			const EU4::Province* srcProvince = newProvinces[i]->getSrcProvince();
@@ -1124,7 +1129,7 @@ void V2Country::addState(V2State* newState)
 			newProvinces[i]->setNavalBaseLevel(0);
 		}
 	}
-	if (((theConfiguration.getVic2Gametype() == "HOD") || (theConfiguration.getVic2Gametype() == "HoD-NNM")) && (highestNavalLevel > 0))
+	if (((theConfiguration().getVic2Gametype() == "HOD") || (theConfiguration().getVic2Gametype() == "HoD-NNM")) && (highestNavalLevel > 0))
 	{
 		newProvinces[hasHighestLevel]->setNavalBaseLevel(1);
 	}
@@ -1190,7 +1195,7 @@ void V2Country::convertArmies(
 		auto locationCandidates = provinceMapper.getVic2ProvinceNumbers(aitr->getLocation());
 		if (locationCandidates.size() == 0)
 		{
-			LOG(LogLevel::Debug) << "Army or Navy " << aitr->getName() << " assigned to unmapped province " << aitr->getLocation() << "; dissolving to pool";
+			WORKER_LOG(LogLevel::Debug) << "Army or Navy " << aitr->getName() << " assigned to unmapped province " << aitr->getLocation() << "; dissolving to pool";
 			int regimentCounts[static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories)] = { 0 };
 			army.getRegimentCounts(regimentCounts);
 			for (int rc = static_cast<int>(EU4::REGIMENTCATEGORY::infantry); rc < static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories); ++rc)
@@ -1201,7 +1206,7 @@ void V2Country::convertArmies(
 		}
 		else if ((locationCandidates.size() == 1) && (*locationCandidates.begin() == 0))
 		{
-			LOG(LogLevel::Debug) << "Army or Navy " << aitr->getName() << " assigned to dropped province " << aitr->getLocation() << "; dissolving to pool";
+			WORKER_LOG(LogLevel::Debug) << "Army or Navy " << aitr->getName() << " assigned to dropped province " << aitr->getLocation() << "; dissolving to pool";
 			int regimentCounts[static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories)] = { 0 };
 			army.getRegimentCounts(regimentCounts);
 			for (int rc = static_cast<int>(EU4::REGIMENTCATEGORY::infantry); rc < static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories); ++rc)
@@ -1224,7 +1229,7 @@ void V2Country::convertArmies(
 				locationCandidates = getPortProvinces(locationCandidates, allProvinces);
 				if (locationCandidates.size() == 0)
 				{
-					LOG(LogLevel::Debug) << "Navy " << aitr->getName() << " assigned to EU4 province " << aitr->getLocation() << " which has no corresponding V2 port provinces; dissolving to pool";
+					WORKER_LOG(LogLevel::Debug) << "Navy " << aitr->getName() << " assigned to EU4 province " << aitr->getLocation() << " which has no corresponding V2 port provinces; dissolving to pool";
 					int regimentCounts[static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories)] = { 0 };
 					army.getRegimentCounts(regimentCounts);
 					for (int rc = static_cast<int>(EU4::REGIMENTCATEGORY::infantry); rc < static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories); ++rc)
@@ -1236,13 +1241,13 @@ void V2Country::convertArmies(
 			}
 		}
 
-		int selectedLocation = locationCandidates[int(locationCandidates.size() * ((double)rand() / RAND_MAX))];
+		int selectedLocation = locationCandidates[int(locationCandidates.size() * ConversionContext::current().getRandomFraction())];
 		if (army.getNavy() && usePort)
 		{
 			vector<int>::iterator white = std::find(port_whitelist.begin(), port_whitelist.end(), selectedLocation);
 			if (white == port_whitelist.end())
 			{
-				LOG(LogLevel::Warning) << "Assigning navy to non-whitelisted port province " << selectedLocation << " - if the save crashes, try blacklisting this province";
+				WORKER_LOG(LogLevel::Warning) << "Assigning navy to non-whitelisted port province " << selectedLocation << " - if the save crashes, try blacklisting this province";
 			}
 		}
 		army.setLocation(selectedLocation);
@@ -1259,7 +1264,7 @@ void V2Country::convertArmies(
                         attempts++;
 			if (army == nullptr)
 			{
-				LOG(LogLevel::Debug) << "No suitable army or navy found for " << tag << "'s pooled regiments of " << EU4::RegimentCategoryTypes[static_cast<EU4::REGIMENTCATEGORY>(rc)];
+				WORKER_LOG(LogLevel::Debug) << "No suitable army or navy found for " << tag << "'s pooled regiments of " << EU4::RegimentCategoryTypes[static_cast<EU4::REGIMENTCATEGORY>(rc)];
 				break;
 			}
 			switch (addRegimentToArmy(*army, static_cast<EU4::REGIMENTCATEGORY>(rc), allProvinces, provinceMapper))
@@ -1271,7 +1276,7 @@ void V2Country::convertArmies(
 				case addRegimentToArmyResult::retry:
 					break;
 				case addRegimentToArmyResult::doNotRetry:
-					LOG(LogLevel::Debug) << "Disqualifying army/navy " << army->getName() << " from receiving more " << EU4::RegimentCategoryTypes[static_cast<EU4::REGIMENTCATEGORY>(rc)] << " from the pool";
+					WORKER_LOG(LogLevel::Debug) << "Disqualifying army/navy " << army->getName() << " from receiving more " << EU4::RegimentCategoryTypes[static_cast<EU4::REGIMENTCATEGORY>(rc)] << " from the pool";
 					army->setArmyRemainders(static_cast<EU4::REGIMENTCATEGORY>(rc), -2000.0);
 					break;
 			}
@@ -1305,7 +1310,7 @@ void V2Country::convertArmies(
 			}
 		}
 	}
-	LOG(LogLevel::Debug) << "Output " << n_tests << " test ships.";
+	WORKER_LOG(LogLevel::Debug) << "Output " << n_tests << " test ships.";
 #endif
 }
 
@@ -1335,7 +1340,7 @@ void V2Country::addRelation(V2Relations& newRelation)
 
 void V2Country::absorbVassal(V2Country* vassal)
 {
-	Log(LogLevel::Debug) << "\t" << tag << " is absorbing " << vassal->getTag();
+	WORKER_LOG(LogLevel::Debug) << "\t" << tag << " is absorbing " << vassal->getTag();
 
 	// change province ownership and add owner cores if needed
 	map<int, V2Province*> vassalProvinces = vassal->getProvinces();
@@ -1408,17 +1413,17 @@ bool V2Country::addFactory(V2Factory* factory)
 		vector<string>::iterator itr = find(techs.begin(), techs.end(), requiredTech);
 		if (itr == techs.end())
 		{
-			LOG(LogLevel::Debug) << tag << " rejected " << factory->getTypeName() << " (missing required tech: " << requiredTech << ')';
+			WORKER_LOG(LogLevel::Debug) << tag << " rejected " << factory->getTypeName() << " (missing required tech: " << requiredTech << ')';
 			return false;
 		}
 	}
 
 	// check factory inventions
-	if ((theConfiguration.getVic2Gametype() == "vanilla") || (theConfiguration.getVic2Gametype() == "AHD"))
+	if ((theConfiguration().getVic2Gametype() == "vanilla") || (theConfiguration().getVic2Gametype() == "AHD"))
 	{
 		if (inventions.count(factory->getRequiredInvention()) != 0)
 		{
-			LOG(LogLevel::Debug) << tag << " rejected " << factory->getTypeName() << " (missing required invention: " << factory->getRequiredInvention() << ')';
+			WORKER_LOG(LogLevel::Debug) << tag << " rejected " << factory->getTypeName() << " (missing required invention: " << factory->getRequiredInvention() << ')';
 			return false;
 		}
 	}
@@ -1458,13 +1463,13 @@ bool V2Country::addFactory(V2Factory* factory)
 
 	if (candidates.size() == 0)
 	{
-		LOG(LogLevel::Debug) << tag << " rejected " << factory->getTypeName() << " (no candidate states)";
+		WORKER_LOG(LogLevel::Debug) << tag << " rejected " << factory->getTypeName() << " (no candidate states)";
 		return false;
 	}
 
 	V2State* target = candidates[0].second;
 	target->addFactory(factory);
-	LOG(LogLevel::Debug) << tag << " accepted " << factory->getTypeName() << " (" << candidates.size() << " candidate states)";
+	WORKER_LOG(LogLevel::Debug) << tag << " accepted " << factory->getTypeName() << " (" << candidates.size() << " candidate states)";
 	numFactories++;
 	return true;
 }
@@ -1499,7 +1504,7 @@ void V2Country::convertUncivReforms(int techGroupAlgorithm, double topTech, int
 
 void V2Country::oldCivConversionMethod() // civilisation level conversion method for games up to 1.18
 {
-	if ((srcCountry != nullptr) && ((theConfiguration.getVic2Gametype() == "AHD") || (theConfiguration.getVic2Gametype() == "HOD") || (theConfiguration.getVic2Gametype() == "HoD-NNM")))
+	if ((srcCountry != nullptr) && ((theConfiguration().getVic2Gametype() == "AHD") || (theConfiguration().getVic2Gametype() == "HOD") || (theConfiguration().getVic2Gametype() == "HoD-NNM")))
 	{
 		if ((srcCountry->getTechGroup() == "western") || (srcCountry->getTechGroup() == "high_american") || (srcCountry->getTechGroup() == "eastern") || (srcCountry->getTechGroup() == "ottoman") || (srcCountry->numEmbracedInstitutions() >= 7))//civilised, do nothing
 		{
@@ -1518,7 +1523,7 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 0%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 0%";
 			uncivReforms = new V2UncivReforms(0, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
@@ -1527,7 +1532,7 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << ", " << srcCountry->numEmbracedInstitutions() << " institutions and an isolationism of " << srcCountry->numEmbracedInstitutions() << ". westernization at 50%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << ", " << srcCountry->numEmbracedInstitutions() << " institutions and an isolationism of " << srcCountry->numEmbracedInstitutions() << ". westernization at 50%";
 			uncivReforms = new V2UncivReforms(50, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
@@ -1536,7 +1541,7 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 44%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 44%";
 			uncivReforms = new V2UncivReforms(44, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
@@ -1545,7 +1550,7 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << ", " << srcCountry->numEmbracedInstitutions() << " institutions and an isolationism of " << srcCountry->numEmbracedInstitutions() << ".  Westernization at 40%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << ", " << srcCountry->numEmbracedInstitutions() << " institutions and an isolationism of " << srcCountry->numEmbracedInstitutions() << ".  Westernization at 40%";
 			uncivReforms = new V2UncivReforms(40, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
@@ -1554,7 +1559,7 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 36%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 36%";
 			uncivReforms = new V2UncivReforms(36, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
@@ -1563,7 +1568,7 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 30%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 30%";
 			uncivReforms = new V2UncivReforms(30, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
@@ -1572,13 +1577,13 @@ void V2Country::oldCivConversionMethod() // civilisation level conversion method
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
-			LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 20%";
+			WORKER_LOG(LogLevel::Debug) << "Setting unciv reforms for " << tag << " who has tech group " << srcCountry->getTechGroup() << " and " << srcCountry->numEmbracedInstitutions() << " institutions. westernization at 20%";
 			uncivReforms = new V2UncivReforms(20, militaryDev, socioEconDev, this);
 			government = "absolute_monarchy";
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "Unhandled tech group (" << srcCountry->getTechGroup() << " with " << srcCountry->numEmbracedInstitutions() << " institutions) for " << tag << " - giving no reforms";
+			WORKER_LOG(LogLevel::Warning) << "Unhandled tech group (" << srcCountry->getTechGroup() << " with " << srcCountry->numEmbracedInstitutions() << " institutions) for " << tag << " - giving no reforms";
 			double totalTechs = srcCountry->getMilTech() + srcCountry->getAdmTech();
 			double militaryDev = srcCountry->getMilTech() / totalTechs;
 			double socioEconDev = srcCountry->getAdmTech() / totalTechs;
@@ -1607,13 +1612,13 @@ void V2Country::newCivConversionMethod(double topTech, int topInsitutions, const
 
 			string techGroup = srcCountry->getTechGroup();
 
-			if (theConfiguration.getEuroCentrism() == Configuration::EUROCENTRISM::EuroCentric)
+			if (theConfiguration().getEuroCentrism() == Configuration::EUROCENTRISM::EuroCentric)
 			{
 				literacy *= (1 + (static_cast<double>(techGroupsMapper.getLiteracyFromTechGroup(techGroup)) - 5.0) * 10.0 / 100.0);
 				civLevel = civLevel * (static_cast<double>(techGroupsMapper.getWesternizationFromTechGroup(techGroup)) / 10.0);
 			}
 
-			literacy = literacy * theConfiguration.getMaxLiteracy() * (pow(10, (civLevel / 100) * 0.9 + 0.1) / 10);
+			literacy = literacy * theConfiguration().getMaxLiteracy() * (pow(10, (civLevel / 100) * 0.9 + 0.1) / 10);
 
 			if (civLevel == 100)
 			{
@@ -1624,7 +1629,7 @@ void V2Country::newCivConversionMethod(double topTech, int topInsitutions, const
 				civilized = false;
 			}
 
-			if (((theConfiguration.getVic2Gametype() == "AHD") || (theConfiguration.getVic2Gametype() == "HOD") || (theConfiguration.getVic2Gametype() == "HoD-NNM")) && (civilized == false))
+			if (((theConfiguration().getVic2Gametype() == "AHD") || (theConfiguration().getVic2Gametype() == "HOD") || (theConfiguration().getVic2Gametype() == "HoD-NNM")) && (civilized == false))
 			{
 				totalTechs = totalTechs - srcCountry->getDipTech();
 				double militaryDev = srcCountry->getMilTech() / totalTechs;
@@ -1705,28 +1710,28 @@ void V2Country::setupPops(
 
 void V2Country::setArmyTech(double normalizedScore)
 {
-	if ((theConfiguration.getVic2Gametype() != "vanilla") && !civilized)
+	if ((theConfiguration().getVic2Gametype() != "vanilla") && !civilized)
 		return;
 }
 
 
 void V2Country::setNavyTech(double normalizedScore)
 {
-	if ((theConfiguration.getVic2Gametype() != "vanilla") && !civilized)
+	if ((theConfiguration().getVic2Gametype() != "vanilla") && !civilized)
 		return;
 }
 
 
 void V2Country::setCommerceTech(double normalizedScore)
 {
-	if ((theConfiguration.getVic2Gametype() != "vanilla") && !civilized)
+	if ((theConfiguration().getVic2Gametype() != "vanilla") && !civilized)
 		return;
 }
 
 
 void V2Country::setIndustryTech(double normalizedScore)
 {
-	if ((theConfiguration.getVic2Gametype() != "vanilla") && !civilized)
+	if ((theConfiguration().getVic2Gametype() != "vanilla") && !civilized)
 		techs.push_back("mechanized_mining");
 		return;
 }
@@ -1734,7 +1739,7 @@ void V2Country::setIndustryTech(double normalizedScore)
 
 void V2Country::setCultureTech(double normalizedScore)
 {
-	if ((theConfiguration.getVic2Gametype() != "vanilla") && !civilized)
+	if ((theConfiguration().getVic2Gametype() != "vanilla") && !civilized)
 		return;
 }
 
@@ -1785,19 +1790,19 @@ addRegimentToArmyResult V2Country::addRegimentToArmy(
 	std::optional<int> eu4Home = army.getSourceArmy().getProbabilisticHomeProvince(rc);
 	if (!eu4Home)
 	{
-		LOG(LogLevel::Debug) << "Army/navy " << army.getName() << " has no valid home provinces for " << EU4::RegimentCategoryTypes[rc] << "; dissolving to pool";
+		WORKER_LOG(LogLevel::Debug) << "Army/navy " << army.getName() << " has no valid home provinces for " << EU4::RegimentCategoryTypes[rc] << "; dissolving to pool";
 		return addRegimentToArmyResult::doNotRetry;
 	}
 	auto homeCandidates = provinceMapper.getVic2ProvinceNumbers(*eu4Home);
 	if (homeCandidates.size() == 0)
 	{
-		LOG(LogLevel::Debug) << EU4::RegimentCategoryTypes[rc] << " unit in army/navy " << army.getName() << " has unmapped home province " << *eu4Home << " - dissolving to pool";
+		WORKER_LOG(LogLevel::Debug) << EU4::RegimentCategoryTypes[rc] << " unit in army/navy " << army.getName() << " has unmapped home province " << *eu4Home << " - dissolving to pool";
 		army.getSourceArmy().blockHomeProvince(*eu4Home);
 		return addRegimentToArmyResult::retry;
 	}
 	if (*homeCandidates.begin() == 0)
 	{
-		LOG(LogLevel::Debug) << EU4::RegimentCategoryTypes[rc] << " unit in army/navy " << army.getName() << " has dropped home province " << *eu4Home << " - dissolving to pool";
+		WORKER_LOG(LogLevel::Debug) << EU4::RegimentCategoryTypes[rc] << " unit in army/navy " << army.getName() << " has dropped home province " << *eu4Home << " - dissolving to pool";
 		army.getSourceArmy().blockHomeProvince(*eu4Home);
 		return addRegimentToArmyResult::retry;
 	}
@@ -1809,7 +1814,7 @@ addRegimentToArmyResult V2Country::addRegimentToArmy(
 		if (homeCandidates.size() != 0)
 		{
 			std::vector<int>::const_iterator it(homeCandidates.begin());
-			std::advance(it, int(homeCandidates.size() * ((double)rand() / RAND_MAX)));
+			std::advance(it, int(homeCandidates.size() * ConversionContext::current().getRandomFraction()));
 			int homeProvinceID = *it;
 			map<int, V2Province*>::iterator pitr = allProvinces.find(homeProvinceID);
 			if (pitr != allProvinces.end())
@@ -1833,7 +1838,7 @@ addRegimentToArmyResult V2Country::addRegimentToArmy(
 		sort(sortedHomeCandidates.begin(), sortedHomeCandidates.end(), ProvinceRegimentCapacityPredicate);
 		if (sortedHomeCandidates.size() == 0)
 		{
-			LOG(LogLevel::Debug) << "No valid home for a " << tag << " " << EU4::RegimentCategoryTypes[rc] << " regiment - dissolving regiment to pool";
+			WORKER_LOG(LogLevel::Debug) << "No valid home for a " << tag << " " << EU4::RegimentCategoryTypes[rc] << " regiment - dissolving regiment to pool";
 			// all provinces in a given province map have the same owner, so the source home was bad
 			army.getSourceArmy().blockHomeProvince(*eu4Home);
 			return addRegimentToArmyResult::retry;
@@ -1855,29 +1860,25 @@ addRegimentToArmyResult V2Country::addRegimentToArmy(
 				{
 					int currentProvince = goodProvinces.front();
 					goodProvinces.pop();
-					auto adjacencies = mappers::adjacencyMapper::getVic2Adjacencies(currentProvince);
-					if (adjacencies)
+					for (const auto adjacency: mappers::adjacencyMapper::getVic2Adjacencies(currentProvince))
 					{
-						for (auto adjacency: *adjacencies)
+						auto openItr = openProvinces.find(adjacency);
+						if (openItr == openProvinces.end())
+						{
+							continue;
+						}
+						if (openItr->second->getOwner() == tag)
 						{
-							auto openItr = openProvinces.find(adjacency);
-							if (openItr == openProvinces.end())
-							{
-								continue;
-							}
-							if (openItr->second->getOwner() == tag)
-							{
-								homeProvince = openItr->second;
-							}
-							goodProvinces.push(openItr->first);
-							openProvinces.erase(openItr);
+							homeProvince = openItr->second;
 						}
+						goodProvinces.push(openItr->first);
+						openProvinces.erase(openItr);
 					}
 				} while ((goodProvinces.size() > 0) && (homeProvince == nullptr));
 			}
 			if (homeProvince == nullptr)
 			{
-				LOG(LogLevel::Debug) << "V2 province " << sortedHomeCandidates[0]->getNum() << " is home for a " << tag << " " << EU4::RegimentCategoryTypes[rc] << " regiment, but belongs to " << sortedHomeCandidates[0]->getOwner() << " - dissolving regiment to pool";
+				WORKER_LOG(LogLevel::Debug) << "V2 province " << sortedHomeCandidates[0]->getNum() << " is home for a " << tag << " " << EU4::RegimentCategoryTypes[rc] << " regiment, but belongs to " << sortedHomeCandidates[0]->getOwner() << " - dissolving regiment to pool";
 				// all provinces in a given province map have the same owner, so the source home was bad
 				army.getSourceArmy().blockHomeProvince(*eu4Home);
 				return addRegimentToArmyResult::retry;
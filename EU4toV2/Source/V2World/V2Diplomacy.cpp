@@ -22,7 +22,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Diplomacy.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "../Configuration.h"
 #include "OSCompatibilityLayer.h"
 #include <fstream>
@@ -46,34 +46,34 @@ std::ostream& operator<<(std::ostream& output, V2Agreement theAgreement)
 
 void V2Diplomacy::output() const
 {
-	LOG(LogLevel::Debug) << "Writing diplomacy";
-	Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/history/diplomacy");
+	WORKER_LOG(LogLevel::Debug) << "Writing diplomacy";
+	Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/history/diplomacy");
 
-	std::ofstream alliances("output/" + theConfiguration.getOutputName() + "/history/diplomacy/Alliances.txt");
+	std::ofstream alliances("output/" + theConfiguration().getOutputName() + "/history/diplomacy/Alliances.txt");
 	if (!alliances.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not create alliances history file";
+		WORKER_LOG(LogLevel::Error) << "Could not create alliances history file";
 		exit(-1);
 	}
 
-	std::ofstream guarantees("output/" + theConfiguration.getOutputName() + "/history/diplomacy/Guarantees.txt");
+	std::ofstream guarantees("output/" + theConfiguration().getOutputName() + "/history/diplomacy/Guarantees.txt");
 	if (!guarantees.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not create guarantees history file";
+		WORKER_LOG(LogLevel::Error) << "Could not create guarantees history file";
 		exit(-1);
 	}
 
-	std::ofstream puppetStates("output/" + theConfiguration.getOutputName() + "/history/diplomacy/PuppetStates.txt");
+	std::ofstream puppetStates("output/" + theConfiguration().getOutputName() + "/history/diplomacy/PuppetStates.txt");
 	if (!puppetStates.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not create puppet states history file";
+		WORKER_LOG(LogLevel::Error) << "Could not create puppet states history file";
 		exit(-1);
 	}
 
-	std::ofstream unions("output/" + theConfiguration.getOutputName() + "/history/diplomacy/Unions.txt");
+	std::ofstream unions("output/" + theConfiguration().getOutputName() + "/history/diplomacy/Unions.txt");
 	if (!unions.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not create unions history file";
+		WORKER_LOG(LogLevel::Error) << "Could not create unions history file";
 		exit(-1);
 	}
 	
@@ -97,7 +97,7 @@ void V2Diplomacy::output() const
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "Cannot ouput diplomatic agreement type " << agreement.type;
+			WORKER_LOG(LogLevel::Warning) << "Cannot ouput diplomatic agreement type " << agreement.type;
 			continue;
 		}
 	}
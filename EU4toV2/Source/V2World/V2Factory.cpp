@@ -22,9 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Factory.h"
-#include "ParadoxParser8859_15.h"
-#include "Log.h"
-#include "../Configuration.h"
+#include "Vic2StaticData.h"
+#include "Object.h"
+#include "../Parsing/WorkerLog.h"
 
 
 
@@ -64,6 +64,37 @@ V2FactoryType::V2FactoryType(shared_ptr<Object> factory)
 }
 
 
+V2FactoryType::V2FactoryType(parsing::SnapshotReader& snapshot)
+{
+	snapshot.read(name);
+	snapshot.read(requireCoastal);
+	snapshot.read(requireTech);
+	snapshot.read(requiredInvention);
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		auto goods = snapshot.read<std::string>();
+		inputs.insert(make_pair(std::move(goods), static_cast<float>(snapshot.read<double>())));
+	}
+	snapshot.read(outputGoods);
+}
+
+
+void V2FactoryType::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.write(name);
+	snapshot.write(requireCoastal);
+	snapshot.write(requireTech);
+	snapshot.write(requiredInvention);
+	snapshot.writeCount(inputs.size());
+	for (const auto& input: inputs)
+	{
+		snapshot.write(input.first);
+		snapshot.write(static_cast<double>(input.second));
+	}
+	snapshot.write(outputGoods);
+}
+
+
 std::ostream& operator<<(std::ostream& output, const V2Factory& factory)
 {
 	// V2 takes care of hiring employees on day 1, provided sufficient starting capital
@@ -84,74 +115,24 @@ void V2Factory::increaseLevel()
 }
 
 
-V2FactoryFactory::V2FactoryFactory()
+V2FactoryFactory::V2FactoryFactory(const Vic2::StaticData& staticData)
 {
-	// load required techs/inventions
-	factoryTechReqs.clear();
-	loadRequiredTechs(theConfiguration.getVic2Path() + "/technologies/army_tech.txt");
-	loadRequiredTechs(theConfiguration.getVic2Path() + "/technologies/commerce_tech.txt");
-	loadRequiredTechs(theConfiguration.getVic2Path() + "/technologies/culture_tech.txt");
-	loadRequiredTechs(theConfiguration.getVic2Path() + "/technologies/industry_tech.txt");
-	loadRequiredTechs(theConfiguration.getVic2Path() + "/technologies/navy_tech.txt");
-	factoryInventionReqs.clear();
-	loadRequiredInventions(theConfiguration.getVic2Path() + "/inventions/army_inventions.txt");
-	loadRequiredInventions(theConfiguration.getVic2Path() + "/inventions/commerce_inventions.txt");
-	loadRequiredInventions(theConfiguration.getVic2Path() + "/inventions/culture_inventions.txt");
-	loadRequiredInventions(theConfiguration.getVic2Path() + "/inventions/industry_inventions.txt");
-	loadRequiredInventions(theConfiguration.getVic2Path() + "/inventions/navy_inventions.txt");
-
-	// load factory types
 	factoryTypes.clear();
-	shared_ptr<Object> obj = parser_8859_15::doParseFile((theConfiguration.getVic2Path() + "/common/production_types.txt").c_str());
-	if (obj == NULL)
+	for (const auto& factoryType: staticData.getFactoryTypes())
 	{
-		LOG(LogLevel::Error) << "Could not parse file " << theConfiguration.getVic2Path() << "/common/production_types.txt";
-		exit(-1);
-	}
-	vector<shared_ptr<Object>> factoryObjs = obj->getLeaves();
-	for (vector<shared_ptr<Object>>::iterator itr = factoryObjs.begin(); itr != factoryObjs.end(); ++itr)
-	{
-		V2FactoryType* ft = new V2FactoryType(*itr);
-		map<string,string>::iterator reqitr = factoryTechReqs.find(ft->name);
-		if (reqitr != factoryTechReqs.end())
-		{
-			ft->requireTech = reqitr->second;
-		}
-		reqitr = factoryInventionReqs.find(ft->name);
-		if (reqitr != factoryInventionReqs.end())
-		{
-			ft->requiredInvention = reqitr->second;
-		}
-		factoryTypes[ft->name] = ft;
+		factoryTypes[factoryType.name] = new V2FactoryType(factoryType);
 	}
 
 	factoryCounts.clear();
-	obj = parser_8859_15::doParseFile("starting_factories.txt");
-	if (obj == NULL)
+	for (const auto& startingFactory: staticData.getStartingFactories())
 	{
-		LOG(LogLevel::Error) << "Could not parse file starting_factories.txt";
-		exit(-1);
-	}
-	vector<shared_ptr<Object>> top = obj->getValue("starting_factories");
-	if (top.size() != 1)
-	{
-		LOG(LogLevel::Error) << "Error: Could not load starting factory list!";
-		printf("Error: Could not load starting factory list!\n");
-		exit(-1);
-	}
-	vector<shared_ptr<Object>> factories = top[0]->getLeaves();
-	for (vector<shared_ptr<Object>>::iterator itr = factories.begin(); itr != factories.end(); ++itr)
-	{
-		string factoryType = (*itr)->getKey();
-		int count = atoi((*itr)->getLeaf().c_str());
-
-		map<string, V2FactoryType*>::iterator t = factoryTypes.find(factoryType);
+		map<string, V2FactoryType*>::iterator t = factoryTypes.find(startingFactory.first);
 		if (t == factoryTypes.end())
 		{
-			LOG(LogLevel::Error) << "Error: Could not locate V2 factory type for starting factories of type %s!";
+			WORKER_LOG(LogLevel::Error) << "Error: Could not locate V2 factory type for starting factories of type %s!";
 			continue;
 		}
-		factoryCounts.push_back(pair<V2FactoryType*, int>(t->second, count));
+		factoryCounts.push_back(pair<V2FactoryType*, int>(t->second, startingFactory.second));
 	}
 }
 
@@ -169,48 +150,3 @@ deque<V2Factory*> V2FactoryFactory::buildFactories() const
 	}
 	return retval;
 }
-
-
-void V2FactoryFactory::loadRequiredTechs(string filename)
-{
-	shared_ptr<Object> obj = parser_8859_15::doParseFile(filename.c_str());
-	if (obj == NULL)
-	{
-		LOG(LogLevel::Error) << "Could not parse file " << filename;
-		exit(-1);
-	}
-	vector<shared_ptr<Object>> techObjs = obj->getLeaves();
-	for (vector<shared_ptr<Object>>::iterator itr = techObjs.begin(); itr != techObjs.end(); ++itr)
-	{
-		vector<shared_ptr<Object>> building = (*itr)->getValue("activate_building");
-		for (vector<shared_ptr<Object>>::iterator bitr = building.begin(); bitr != building.end(); ++bitr)
-		{
-			factoryTechReqs.insert(make_pair((*bitr)->getLeaf(), (*itr)->getKey()));
-		}
-	}
-}
-
-
-void V2FactoryFactory::loadRequiredInventions(string filename)
-{
-	shared_ptr<Object> obj = parser_8859_15::doParseFile(filename.c_str());
-	if (obj == NULL)
-	{
-		LOG(LogLevel::Error) << "Could not parse file " << filename;
-		exit(-1);
-	}
-	vector<shared_ptr<Object>> invObjs = obj->getLeaves();
-	for (vector<shared_ptr<Object>>::iterator itr = invObjs.begin(); itr != invObjs.end(); ++itr)
-	{
-		vector<shared_ptr<Object>> effect = (*itr)->getValue("effect");
-		if (effect.size() == 0)
-		{
-			continue;
-		}
-		vector<shared_ptr<Object>> building = effect[0]->getValue("activate_building");
-		for (vector<shared_ptr<Object>>::iterator bitr = building.begin(); bitr != building.end(); ++bitr)
-		{
-			factoryInventionReqs.insert(make_pair((*bitr)->getLeaf(), (*itr)->getKey()));
-		}
-	}
-}
\ No newline at end of file
@@ -26,6 +26,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
+#include "../Parsing/Snapshot.h"
 #include <deque>
 #include <vector>
 #include <map>
@@ -37,12 +38,19 @@ using namespace std;
 
 
 class Object;
+namespace Vic2
+{
+class StaticData;
+}
 
 
 
 struct V2FactoryType
 {
 	V2FactoryType(shared_ptr<Object> factory);
+	explicit V2FactoryType(parsing::SnapshotReader& snapshot);
+
+	void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
 
 	string						name;
 	bool							requireCoastal;
@@ -76,15 +84,11 @@ class V2Factory
 class V2FactoryFactory
 {
 	public:
-		V2FactoryFactory();
+		explicit V2FactoryFactory(const Vic2::StaticData& staticData);
 		deque<V2Factory*>	buildFactories() const;
 	private:
-		void					loadRequiredTechs(string filename);
-		void					loadRequiredInventions(string filename);
 		vector<pair<V2FactoryType*, int>>	factoryCounts;
 		map<string, V2FactoryType*>			factoryTypes;
-		map<string, string>						factoryTechReqs;
-		map<string, string>						factoryInventionReqs;
 };
 
 
@@ -8,7 +8,7 @@
 #include "../EU4World/EU4Country.h"
 #include "V2Country.h"
 #include "../Configuration.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include "../Mappers/CK2TitleMapper.h"
 #include "../Mappers/ColonyFlagsetMapper.h"
@@ -21,10 +21,10 @@ const std::vector<std::string> V2Flags::flagFileSuffixes = { ".tga", "_communist
 
 void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 {
-	LOG(LogLevel::Debug) << "Initializing flags";
+	WORKER_LOG(LogLevel::Debug) << "Initializing flags";
 	tagMap.clear();
 
-	static std::mt19937 generator(static_cast<int>(std::chrono::system_clock::now().time_since_epoch().count()));
+	std::mt19937 generator(static_cast<int>(std::chrono::system_clock::now().time_since_epoch().count()));
 
 	determineUseableFlags();
 	getRequiredTags(V2Countries);
@@ -68,7 +68,7 @@ void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 
 				if (randomCK2title && (usableFlagTags.find(*randomCK2title) != usableFlagTags.end()))
 				{
-					LOG(LogLevel::Info) << "Country " << i->first << " (" << i->second->getLocalName() << ") has been given the CK2 flag " << *randomCK2title;
+					WORKER_LOG(LogLevel::Info) << "Country " << i->first << " (" << i->second->getLocalName() << ") has been given the CK2 flag " << *randomCK2title;
 					tagMap[i->first] =* randomCK2title;
 					usableFlagTags.erase(*randomCK2title);
 					requiredTags.erase(i->first);
@@ -107,7 +107,7 @@ void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 
 		colonialtitle->setOverlord(overlord->getTag());
 		colonialFlagMapping[country.first] = colonialtitle;
-		LOG(LogLevel::Info) << "Country with tag " << country.first << " is " << colonialtitle->getName() << ", ruled by " << colonialtitle->getOverlord();
+		WORKER_LOG(LogLevel::Info) << "Country with tag " << country.first << " is " << colonialtitle->getName() << ", ruled by " << colonialtitle->getOverlord();
 
 		usableFlagTags.erase(colonialtitle->getName());
 		requiredTags.erase(country.first);
@@ -142,7 +142,7 @@ void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 					V2Country* overlord = (*v2c)->getColonyOverlord();
 					std::string overlordName = overlord->getTag();
 					flag->setOverlord(overlordName);
-					LOG(LogLevel::Info) << "Country with tag " << (*v2c)->getTag() << " is now " << key << ", ruled by " << overlordName;
+					WORKER_LOG(LogLevel::Info) << "Country with tag " << (*v2c)->getTag() << " is now " << key << ", ruled by " << overlordName;
 
 					usableFlagTags.erase(flag->getName());
 					requiredTags.erase((*v2c)->getTag());
@@ -163,7 +163,7 @@ void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 		advance(randomTagIter, randomTagIndex);
 		const std::string& flagTag = *randomTagIter;
 		tagMap[V2Tag] = flagTag;
-		LOG(LogLevel::Debug) << "Country with tag " << V2Tag << " has no flag and will use the flag for " << flagTag << " instead";
+		WORKER_LOG(LogLevel::Debug) << "Country with tag " << V2Tag << " has no flag and will use the flag for " << flagTag << " instead";
 		if (usableFlagTags.size() > requiredTags.size() - tagMap.size())
 		{
 			usableFlagTags.erase(flagTag);
@@ -182,12 +182,12 @@ void V2Flags::SetV2Tags(const std::map<std::string, V2Country*>& V2Countries)
 		
 		if (nationalColors.isCustomColorsInitialized())
 		{
-			LOG(LogLevel::Debug) << "Ordering a custom flag build for: " << tag;
+			WORKER_LOG(LogLevel::Debug) << "Ordering a custom flag build for: " << tag;
 			customFlagMapping[tag] = nationalColors.getCustomColors();
 		}
 		else if (eu4country->isRevolutionary() && nationalColors.getRevolutionaryColor())
 		{
-			LOG(LogLevel::Debug) << "Ordering a revolutionary flag build for: " << tag;
+			WORKER_LOG(LogLevel::Debug) << "Ordering a revolutionary flag build for: " << tag;
 			nationalColors.retrieveCustomColors().setFlagColors(nationalColors.getRevolutionaryColor());
 			customFlagMapping[tag] = nationalColors.getCustomColors();
 		}
@@ -247,7 +247,7 @@ std::set<std::string> V2Flags::determineAvailableFlags()
 {
 	std::set<std::string> availableFlags;
 
-	const std::vector<std::string> availableFlagFolders = { "flags", theConfiguration.getVic2Path() + "/gfx/flags" };
+	const std::vector<std::string> availableFlagFolders = { "flags", theConfiguration().getVic2Path() + "/gfx/flags" };
 	for (auto availableFlagFolder: availableFlagFolders)
 	{
 		Utils::GetAllFilesInFolder(availableFlagFolder, availableFlags);
@@ -291,7 +291,7 @@ void V2Flags::mapTrivialTags()
 
 void V2Flags::output() const
 {
-	LOG(LogLevel::Debug) << "Creating flags";
+	WORKER_LOG(LogLevel::Debug) << "Creating flags";
 	createOutputFolders();
 	copyFlags();
 	createCustomFlags();
@@ -301,14 +301,14 @@ void V2Flags::output() const
 
 void V2Flags::createOutputFolders() const
 {
-	if (!Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/gfx"))
+	if (!Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/gfx"))
 	{
-		LOG(LogLevel::Error) << "Could not create output/" << theConfiguration.getOutputName() << "/gfx";
+		WORKER_LOG(LogLevel::Error) << "Could not create output/" << theConfiguration().getOutputName() << "/gfx";
 		exit(-1);
 	}
-	if (!Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/gfx/flags"))
+	if (!Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/gfx/flags"))
 	{
-		LOG(LogLevel::Error) << "Could not create output/" << theConfiguration.getOutputName() << "/gfx/flags";
+		WORKER_LOG(LogLevel::Error) << "Could not create output/" << theConfiguration().getOutputName() << "/gfx/flags";
 		exit(-1);
 	}
 }
@@ -316,7 +316,7 @@ void V2Flags::createOutputFolders() const
 
 void V2Flags::copyFlags() const
 {
-	const std::vector<std::string> availableFlagFolders = { "flags", theConfiguration.getVic2Path() + "/gfx/flags" };
+	const std::vector<std::string> availableFlagFolders = { "flags", theConfiguration().getVic2Path() + "/gfx/flags" };
 	for (auto tagMapping: tagMap)
 	{
 		const std::string& V2Tag = tagMapping.first;
@@ -332,7 +332,7 @@ void V2Flags::copyFlags() const
 				flagFileFound = Utils::DoesFileExist(sourceFlagPath);
 				if (flagFileFound)
 				{
-					std::string destFlagPath = "output/" + theConfiguration.getOutputName() + "/gfx/flags/" + V2Tag + suffix;
+					std::string destFlagPath = "output/" + theConfiguration().getOutputName() + "/gfx/flags/" + V2Tag + suffix;
 					Utils::TryCopyFile(sourceFlagPath, destFlagPath);
 				}
 			}
@@ -345,8 +345,8 @@ void V2Flags::createCustomFlags() const
 {
 	std::string baseFlagFolder = "flags";
 
-	LOG(LogLevel::Info) << "Parsing EU4 flag colours";
-	std::string colorFileStr = theConfiguration.getEU4Path() + "/common/custom_country_colors/00_custom_country_colors.txt";
+	WORKER_LOG(LogLevel::Info) << "Parsing EU4 flag colours";
+	std::string colorFileStr = theConfiguration().getEU4Path() + "/common/custom_country_colors/00_custom_country_colors.txt";
 	std::ifstream colorFile(colorFileStr);
 	if (colorFile.fail())
 	{
@@ -373,7 +373,7 @@ void V2Flags::createCustomFlags() const
 
 		if (r > colourcount || g > colourcount || b > colourcount)
 		{
-			LOG(LogLevel::Error) << V2Tag << "'s flag has some missing colours.";
+			WORKER_LOG(LogLevel::Error) << V2Tag << "'s flag has some missing colours.";
 			continue;
 		}
 
@@ -395,7 +395,7 @@ void V2Flags::createCustomFlags() const
 			flagFileFound = (Utils::DoesFileExist(sourceFlagPath) && Utils::DoesFileExist(sourceEmblemPath));
 			if (flagFileFound)
 			{
-				std::string destFlagPath = "output/" + theConfiguration.getOutputName() + "/gfx/flags/" + V2Tag + suffix;
+				std::string destFlagPath = "output/" + theConfiguration().getOutputName() + "/gfx/flags/" + V2Tag + suffix;
 
 				std::optional<commonItems::Color> rColor = flagColorMapper.getFlagColorByIndex(r);
 				std::optional<commonItems::Color> gColor = flagColorMapper.getFlagColorByIndex(g);
@@ -404,21 +404,21 @@ void V2Flags::createCustomFlags() const
 				if (!gColor) gColor = commonItems::Color();
 				if (!bColor) bColor = commonItems::Color();
 
-				LOG(LogLevel::Debug) << "Exporting flag: " << destFlagPath << " using rgb: " << r << " " << g << " " << b;
+				WORKER_LOG(LogLevel::Debug) << "Exporting flag: " << destFlagPath << " using rgb: " << r << " " << g << " " << b;
 				CreateCustomFlag(*rColor, *gColor, *bColor, sourceEmblemPath, sourceFlagPath, destFlagPath);
 			}
 			else
 			{
 				if (!Utils::DoesFileExist(sourceFlagPath))
 				{
-					LOG(LogLevel::Error) << "Could not find " << sourceFlagPath;
+					WORKER_LOG(LogLevel::Error) << "Could not find " << sourceFlagPath;
 					std::string err = "Could not find " + sourceFlagPath;
 					std::runtime_error exception(err);
 					throw exception;
 				}
 				else
 				{
-					LOG(LogLevel::Error) << "Could not find " << sourceEmblemPath;
+					WORKER_LOG(LogLevel::Error) << "Could not find " << sourceEmblemPath;
 					std::string err = "Could not find " + sourceEmblemPath;
 					std::runtime_error exception(err);
 					throw exception;
@@ -458,26 +458,26 @@ void V2Flags::createColonialFlags() const
 				auto overlordFlag = tagMap.find(overlord);
 				if (overlordFlag == tagMap.end())
 				{
-					LOG(LogLevel::Error) << "No flag exists for overlord " << overlord << ". Cannot create colony flag";
+					WORKER_LOG(LogLevel::Error) << "No flag exists for overlord " << overlord << ". Cannot create colony flag";
 					exit(-1);
 				}
 				std::string overlordFlagPath = folderPath + '/' + overlordFlag->second + ".tga";
 				flagFileFound = (Utils::DoesFileExist(sourceFlagPath) && Utils::DoesFileExist(overlordFlagPath));
 				if (flagFileFound)
 				{
-					std::string destFlagPath = "output/" + theConfiguration.getOutputName() + "/gfx/flags/" + V2Tag + suffix;
+					std::string destFlagPath = "output/" + theConfiguration().getOutputName() + "/gfx/flags/" + V2Tag + suffix;
 					CreateColonialFlag(overlordFlagPath, sourceFlagPath, destFlagPath);
 				}
 				else
 				{
 					if (!Utils::DoesFileExist(sourceFlagPath))
 					{
-						LOG(LogLevel::Error) << "Could not find " << sourceFlagPath;
+						WORKER_LOG(LogLevel::Error) << "Could not find " << sourceFlagPath;
 						exit(-1);
 					}
 					else
 					{
-						LOG(LogLevel::Error) << "Could not find " << overlordFlagPath;
+						WORKER_LOG(LogLevel::Error) << "Could not find " << overlordFlagPath;
 						exit(-1);
 					}
 				}
@@ -488,12 +488,12 @@ void V2Flags::createColonialFlags() const
 				flagFileFound = Utils::DoesFileExist(sourceFlagPath);
 				if (flagFileFound)
 				{
-					std::string destFlagPath = "output/" + theConfiguration.getOutputName() + "/gfx/flags/" + V2Tag + suffix;
+					std::string destFlagPath = "output/" + theConfiguration().getOutputName() + "/gfx/flags/" + V2Tag + suffix;
 					Utils::TryCopyFile(sourceFlagPath, destFlagPath);
 				}
 				else
 				{
-					LOG(LogLevel::Error) << "Could not find " << sourceFlagPath;
+					WORKER_LOG(LogLevel::Error) << "Could not find " << sourceFlagPath;
 				}
 			}
 		}
@@ -23,8 +23,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2LeaderTraits.h"
 #include "Object.h"
-#include "ParadoxParserUTF8.h"
-#include "Log.h"
+#include "../Parsing/LegacyObjects.h"
+#include "../Parsing/WorkerLog.h"
 
 
 
@@ -111,10 +111,10 @@ bool V2TraitConversion::matches(int fire, int shock, int manuever, int siege) co
 
 V2LeaderTraits::V2LeaderTraits()
 {
-	shared_ptr<Object> obj = parser_UTF8::doParseFile("leader_traits.txt");
+	shared_ptr<Object> obj = parsing::parseUTF8File("leader_traits.txt");
 	if (obj == NULL)
 	{
-		LOG(LogLevel::Error) << "Could not parse file leader_traits.txt";
+		WORKER_LOG(LogLevel::Error) << "Could not parse file leader_traits.txt";
 		exit(-1);
 	}
 
@@ -144,7 +144,7 @@ V2LeaderTraits::V2LeaderTraits()
 
 	if (backgrounds.size() == 0 || personalities.size() == 0)
 	{
-		LOG(LogLevel::Error) << "Trait conversion failed to initialize";
+		WORKER_LOG(LogLevel::Error) << "Trait conversion failed to initialize";
 		exit(1);
 	}
 }
@@ -22,7 +22,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 #include "V2Party.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 
 
 
@@ -35,7 +35,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party did not have a name";
+		WORKER_LOG(LogLevel::Error) << "Party did not have a name";
 		exit(-1);
 	}
 
@@ -46,7 +46,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have an ideology";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have an ideology";
 		exit(-1);
 	}
 
@@ -57,7 +57,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have a start date";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have a start date";
 		exit(-1);
 	}
 
@@ -68,7 +68,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have an end date";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have an end date";
 		exit(-1);
 	}
 
@@ -79,7 +79,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have an economic policy";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have an economic policy";
 		exit(-1);
 	}
 
@@ -90,7 +90,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have a trade policy";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have a trade policy";
 		exit(-1);
 	}
 
@@ -101,7 +101,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have a religious policy";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have a religious policy";
 		exit(-1);
 	}
 
@@ -112,7 +112,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have a citizenship policy";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have a citizenship policy";
 		exit(-1);
 	}
 
@@ -123,7 +123,7 @@ V2Party::V2Party(shared_ptr<Object> party_obj)
 	}
 	else
 	{
-		LOG(LogLevel::Error) << "Party " << name << " did not have a war policy";
+		WORKER_LOG(LogLevel::Error) << "Party " << name << " did not have a war policy";
 		exit(-1);
 	}
 }
@@ -204,6 +204,6 @@ V2Party::V2Party(const std::string& name, const std::string& ideology)
 	}
 	else
 	{
-		LOG(LogLevel::Warning) << "Unknown party ideology \"" << ideology << "\" for party \"" << name << '"';
+		WORKER_LOG(LogLevel::Warning) << "Unknown party ideology \"" << ideology << "\" for party \"" << name << '"';
 	}
 }
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "V2Province.h"
 #include "CardinalToOrdinal.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "Object.h"
 #include "OSCompatibilityLayer.h"
 #include "ParadoxParser8859_15.h"
@@ -33,6 +33,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 #include "V2Pop.h"
 #include "V2Country.h"
 #include "V2Factory.h"
+#include "Vic2StaticData.h"
 #include <algorithm>
 #include <fstream>
 #include <memory>
@@ -42,10 +43,10 @@ using namespace std;
 
 
 
-V2Province::V2Province(string _filename)
+V2Province::V2Province(const Vic2::ProvinceHistory& history)
 {
 	srcProvince = NULL;
-	filename = _filename;
+	filename = history.filename;
 	coastal = false;
 	num = 0;
 	name = "";
@@ -82,95 +83,19 @@ V2Province::V2Province(string _filename)
 
 	resettable = false;
 
-	int slash = filename.find_last_of("/");
-	int numDigits = filename.find_first_of("-") - slash - 2;
-	string temp = filename.substr(slash + 1, numDigits);
-	num = atoi(temp.c_str());
-
-	shared_ptr<Object> obj;
-	if (Utils::DoesFileExist(string("./blankMod/output/history/provinces") + _filename))
-	{
-		obj = parser_8859_15::doParseFile((string("./blankMod/output/history/provinces") + _filename).c_str());
-		if (obj == NULL)
-		{
-			LOG(LogLevel::Error) << "Could not parse ./blankMod/output/history/provinces" << _filename;
-			exit(-1);
-		}
-	}
-	else
-	{
-		obj = parser_8859_15::doParseFile((theConfiguration.getVic2Path() + "/history/provinces" + _filename).c_str());
-		if (obj == NULL)
-		{
-			LOG(LogLevel::Error) << "Could not parse " << theConfiguration.getVic2Path() << "/history/provinces" << _filename;
-			exit(-1);
-		}
-	}
-	vector<shared_ptr<Object>> leaves = obj->getLeaves();
-	for (vector<shared_ptr<Object>>::iterator itr = leaves.begin(); itr != leaves.end(); itr++)
-	{
-		if ((*itr)->getKey() == "owner")
-		{
-			owner = (*itr)->getLeaf();
-		}
-		else if ((*itr)->getKey() == "controller")
-		{
-			controller = (*itr)->getLeaf().c_str();
-		}
-		else if ((*itr)->getKey() == "add_core")
-		{
-			cores.push_back((*itr)->getLeaf());
-		}
-		else if ((*itr)->getKey() == "trade_goods")
-		{
-			rgoType = (*itr)->getLeaf();
-		}
-		else if ((*itr)->getKey() == "life_rating")
-		{
-			lifeRating = atoi((*itr)->getLeaf().c_str());
-		}
-		else if ((*itr)->getKey() == "terrain")
-		{
-			terrain = (*itr)->getLeaf();
-		}
-		else if ((*itr)->getKey() == "colonial")
-		{
-			colonial = atoi((*itr)->getLeaf().c_str());
-		}
-		else if ((*itr)->getKey() == "colony")
-		{
-			colonyLevel = atoi((*itr)->getLeaf().c_str());
-		}
-		else if ((*itr)->getKey() == "naval_base")
-		{
-			navalBaseLevel = atoi((*itr)->getLeaf().c_str());
-		}
-		else if ((*itr)->getKey() == "fort")
-		{
-			fortLevel = atoi((*itr)->getLeaf().c_str());
-		}
-		else if ((*itr)->getKey() == "railroad")
-		{
-			railLevel = atoi((*itr)->getLeaf().c_str());
-		}
-		else if ((*itr)->getKey() == "is_slave")
-		{
-			if ((*itr)->getLeaf() == "yes")
-			{
-				slaveState = true;
-			}
-		}
-		else if ((*itr)->getKey() == "state_building")
-		{
-		}
-		else if ((*itr)->getKey() == "party_loyalty")
-		{
-		}
-		else
-		{
-			//log("Unknown key - %s\n", (*itr)->getKey().c_str());
-		}
-	}
+	num = history.num;
+	owner = history.owner;
+	controller = history.controller;
+	cores = history.cores;
+	rgoType = history.rgoType;
+	lifeRating = history.lifeRating;
+	terrain = history.terrain;
+	colonial = history.colonial;
+	colonyLevel = history.colonyLevel;
+	navalBaseLevel = history.navalBaseLevel;
+	fortLevel = history.fortLevel;
+	railLevel = history.railLevel;
+	slaveState = history.slaveState;
 }
 
 
@@ -178,12 +103,12 @@ void V2Province::output() const
 {
 	int lastSlash = filename.find_last_of('/');
 	std::string path = filename.substr(0, lastSlash);
-	Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/history/provinces" + path);
+	Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/history/provinces" + path);
 
-	std::ofstream output("output/" + theConfiguration.getOutputName() + "/history/provinces" + filename);
+	std::ofstream output("output/" + theConfiguration().getOutputName() + "/history/provinces" + filename);
 	if (!output.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not create province history file output/" << theConfiguration.getOutputName() << "/history/provinces/" << filename << " - " << Utils::GetLastErrorString();
+		WORKER_LOG(LogLevel::Error) << "Could not create province history file output/" << theConfiguration().getOutputName() << "/history/provinces/" << filename << " - " << Utils::GetLastErrorString();
 		exit(-1);
 	}
 	if (owner != "")
@@ -241,7 +166,7 @@ void V2Province::output() const
 
 void V2Province::outputPops(FILE* output) const
 {
-	if (resettable && (theConfiguration.getResetProvinces() == "yes"))
+	if (resettable && (theConfiguration().getResetProvinces() == "yes"))
 	{
 		fprintf(output, "%d = {\n", num);
 		if (oldPops.size() > 0)
@@ -849,10 +774,10 @@ void V2Province::createPops(
 	double lifeRatingMod = (static_cast<double>(this->lifeRating) - 30.0) / 200.0;
 	double devpushMod = oldProvince->getDevDelta() / 100.0;
 	double weightMod = oldProvince->getModifierWeight() / 100.0;
-	double shapeMod = theConfiguration.getPopShapingFactor() / 100.0;
+	double shapeMod = theConfiguration().getPopShapingFactor() / 100.0;
 	double provinceDevModifier = 1 + (lifeRatingMod + devpushMod + weightMod) * shapeMod;
 
-	switch (theConfiguration.getPopShaping()) {
+	switch (theConfiguration().getPopShaping()) {
 	case Configuration::POPSHAPES::Vanilla:
 		newPopulation = oldPopulation;
 		break;
@@ -890,7 +815,7 @@ void V2Province::createPops(
 			*/
 		}
 
-		newPopulation = oldPopulation + static_cast<long>((newPopulation - oldPopulation) * (theConfiguration.getPopShapingFactor() / 100.0));
+		newPopulation = oldPopulation + static_cast<long>((newPopulation - oldPopulation) * (theConfiguration().getPopShapingFactor() / 100.0));
 		break;
 	}
 
@@ -904,7 +829,7 @@ void V2Province::createPops(
 		pts = getPopPoints_2(demographic, newPopulation, _owner, theEU4Countries);
 		break;
 	default:
-		LOG(LogLevel::Error) << "Invalid pop conversion algorithm specified; not generating pops.";
+		WORKER_LOG(LogLevel::Error) << "Invalid pop conversion algorithm specified; not generating pops.";
 	}
 
 	// Uncivs cannot have capitalists, clerks, or craftsmen, and get fewer bureaucrats
@@ -992,7 +917,7 @@ void V2Province::createPops(
 	V2Pop* farmersPop = new V2Pop("farmers", farmers, demographic.culture, demographic.religion);
 	pops.push_back(farmersPop);
 
-	/*LOG(LogLevel::Info) << "Name: " << this->getSrcProvince()->getName() << " demographics.upperRatio: " << demographic.upperRatio
+	/*WORKER_LOG(LogLevel::Info) << "Name: " << this->getSrcProvince()->getName() << " demographics.upperRatio: " << demographic.upperRatio
 		<< " demographics.middleRatio: " << demographic.middleRatio << " demographics.lowerRatio: " << demographic.lowerRatio
 		<< " newPopulation: " << newPopulation << " farmer: " << farmers	<< " total: " << newPopulation;*/
 }
@@ -36,6 +36,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 class V2Pop;
 class V2Factory;
 class V2Country;
+namespace Vic2
+{
+struct ProvinceHistory;
+}
 
 
 
@@ -55,7 +59,7 @@ struct V2Demographic
 class V2Province
 {
 	public:
-		V2Province(string _filename);
+		explicit V2Province(const Vic2::ProvinceHistory& history);
 		void output() const;
 		void outputPops(FILE*) const;
 		void convertFromOldProvince(
@@ -78,5 +78,5 @@ Vic2::TechSchoolsFile::TechSchoolsFile(std::unique_ptr<blockedTechSchools> suppl
 	});
 	registerKeyword(std::regex("folders"), commonItems::ignoreItem);
 
-	parseFile(theConfiguration.getVic2Path() + "/common/technology.txt");
+	parseFile(theConfiguration().getVic2Path() + "/common/technology.txt");
 }
\ No newline at end of file
@@ -10,9 +10,8 @@
 #include <cmath>
 #include <cfloat>
 #include <fstream>
-#include "ParadoxParser8859_15.h"
-#include "ParadoxParserUTF8.h"
-#include "Log.h"
+#include "../Parsing/LegacyObjects.h"
+#include "../Parsing/WorkerLog.h"
 #include "OSCompatibilityLayer.h"
 #include "../Configuration.h"
 #include "../EU4World/Continents.h"
@@ -31,6 +30,8 @@
 #include "../Mappers/GovernmentMapper.h"
 #include "../Mappers/ReligionMapper.h"
 #include "BlockedTechSchools.h"
+#include "LandConnections.h"
+#include "StateGrouping.h"
 #include "StateMapper.h"
 #include "V2Province.h"
 #include "V2State.h"
@@ -44,24 +45,30 @@
 #include "V2Flags.h"
 #include "V2LeaderTraits.h"
 #include "Vic2CultureUnionMapper.h"
+#include "../Parsing/FileCache.h"
 
 
 
-V2World::V2World(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper& ideaEffectMapper, const mappers::TechGroupsMapper& techGroupsMapper)
+V2World::V2World(const Vic2::StaticData& staticData)
 {
-	LOG(LogLevel::Info) << "Parsing Vicky2 data";
-	importProvinces();
-	importDefaultPops();
+	WORKER_LOG(LogLevel::Info) << "Parsing Vicky2 data";
+	importProvinces(staticData);
+	importDefaultPops(staticData);
 	//logPopsByCountry();
-	findCoastalProvinces();
+	findCoastalProvinces(staticData);
 	importPotentialCountries();
+}
+
+
+void V2World::convert(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper& ideaEffectMapper, const mappers::TechGroupsMapper& techGroupsMapper, const Vic2::StaticData& staticData)
+{
 	isRandomWorld = sourceWorld.isRandomWorld();
 
 	initializeProvinceMapper();
 	sourceWorld.checkAllProvincesMapped(*provinceMapper);
 	mappers::CountryMappings::createMappings(sourceWorld, potentialCountries, *provinceMapper);
 
-	LOG(LogLevel::Info) << "Converting world";
+	WORKER_LOG(LogLevel::Info) << "Converting world";
 	initializeCultureMappers(sourceWorld);
 	initializeReligionMapper(sourceWorld);
 	convertCountries(sourceWorld, ideaEffectMapper);
@@ -71,7 +78,7 @@ V2World::V2World(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper&
 	setupStates();
 	convertUncivReforms(sourceWorld, techGroupsMapper);
 	convertTechs(sourceWorld);
-	allocateFactories(sourceWorld);
+	allocateFactories(sourceWorld, staticData);
 	setupPops(sourceWorld);
 	addUnions();
 	convertArmies(sourceWorld);
@@ -81,165 +88,65 @@ V2World::V2World(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper&
 }
 
 
-void V2World::importProvinces()
+Vic2::StaticData V2World::importStaticData()
 {
-	LOG(LogLevel::Info) << "Importing provinces";
+	const auto provinceFilenames = Vic2::StaticData::discoverProvinceFilenames();
+	const auto popFilenames = Vic2::StaticData::discoverPopFilenames();
 
-	set<string> provinceFilenames = discoverProvinceFilenames();
-	for (auto provinceFilename : provinceFilenames)
-	{
-		V2Province* newProvince = new V2Province(provinceFilename);
-		provinces.insert(make_pair(newProvince->getNum(), newProvince));
-	}
-
-	if (Utils::DoesFileExist("./blankMod/output/localisation/text.csv"))
-	{
-		importProvinceLocalizations("./blankMod/output/localisation/text.csv");
-	}
-	else
-	{
-		importProvinceLocalizations((theConfiguration.getVic2Path() + "/localisation/text.csv"));
-	}
-
-        importProvinceClimates();
-        importProvinceTerrains();
+	const parsing::FileCache cache;
+	return cache.get<Vic2::StaticData>("vic2Data", Vic2::StaticData::getSourceFiles(provinceFilenames, popFilenames), [&provinceFilenames, &popFilenames]() {
+		return Vic2::StaticData(provinceFilenames, popFilenames);
+	});
 }
 
 
-std::set<std::string> V2World::discoverProvinceFilenames()
+void V2World::importProvinces(const Vic2::StaticData& staticData)
 {
-	std::set<std::string> provinceFilenames;
-	if (Utils::doesFolderExist("./blankMod/output/history/provinces"))
-	{
-		Utils::GetAllFilesInFolderRecursive("./blankMod/output/history/provinces", provinceFilenames);
-	}
-	if (provinceFilenames.empty())
-	{
-		Utils::GetAllFilesInFolderRecursive(theConfiguration.getVic2Path() + "/history/provinces", provinceFilenames);
-	}
-
-	return provinceFilenames;
-}
+	WORKER_LOG(LogLevel::Info) << "Importing provinces";
 
-void V2World::importProvinceClimates()
-{
-	string filename = theConfiguration.getVic2Path() + "/map/climate.txt";
-	if (!Utils::DoesFileExist(filename))
+	for (const auto& provinceHistory: staticData.getProvinceHistories())
 	{
-		LOG(LogLevel::Warning) << "Could not find file " << filename
-		                       << ", will not load climates.";
-		return;
+		V2Province* newProvince = new V2Province(provinceHistory);
+		provinces.insert(make_pair(newProvince->getNum(), newProvince));
 	}
 
-        auto climateObj = parser_8859_15::doParseFile(filename);
-	std::vector keywords = {"mild_climate", "temperate_climate",
-	                        "harsh_climate", "inhospitable_climate"};
-	for (const auto& key : keywords)
+	for (const auto& provinceName: staticData.getProvinceNames())
 	{
-		auto objs = climateObj->getValue(key);
-		if (objs.size() < 2)
-		{
-			LOG(LogLevel::Warning)
-			    << "Found " << objs.size() << " objects with key "
-			    << key << ", will not assign this climate.";
-			continue;
-		}
-		auto provList = objs[1];
-		for (int i = 0; i < provList->numTokens(); ++i)
+		auto province = provinces.find(provinceName.first);
+		if (province != provinces.end())
 		{
-			auto provNum = provList->tokenAsInt(i);
-			if (provNum == 0)
-			{
-				continue;
-			}
-			auto* prov = getProvince(provNum.value());
-			if (prov == NULL)
-			{
-				continue;
-			}
-			prov->setClimate(key);
+			province->second->setName(provinceName.second);
 		}
 	}
-}
 
-void V2World::importProvinceLocalizations(const string& file)
-{
-	ifstream read(file);
-
-	while (read.good() && !read.eof())
+	for (const auto& provinceClimate: staticData.getProvinceClimates())
 	{
-		string line;
-		getline(read, line);
-		if (isAProvinceLocalization(line))
+		auto* province = getProvince(provinceClimate.first);
+		if (province != NULL)
 		{
-			int position = line.find_first_of(';');
-			int num = stoi(line.substr(4, position - 4));
-			string name = line.substr(position + 1, line.find_first_of(';', position + 1) - position - 1);
-
-			auto provice = provinces.find(num);
-			if (provice != provinces.end())
-			{
-				provice->second->setName(name);
-			}
+			province->setClimate(provinceClimate.second);
 		}
 	}
 
-	read.close();
-}
-
-void V2World::importProvinceTerrains()
-{
-	string filename = "terrainData.txt";
-	if (!Utils::DoesFileExist(filename))
-	{
-		LOG(LogLevel::Warning) << "Could not find " << filename
-		                       << ", will not load terrain data.";
-		return;
-	}
-
-        auto terrainObj = parser_8859_15::doParseFile(filename);
-	if (terrainObj == NULL)
-	{
-		LOG(LogLevel::Warning) << "Could not parse " << filename
-		                       << ", will not load terrain data.";
-		return;
-	}
-
-	auto leaves = terrainObj->getLeaves();
-	for (auto leaf : leaves)
+	for (const auto& provinceTerrain: staticData.getProvinceTerrains())
 	{
-		std::string key = leaf->getKey();
-		int provNum = atoi(key.c_str());
-		auto* province = getProvince(provNum);
-		if (province == NULL)
-		{
-			continue;
-		}
+		auto* province = getProvince(provinceTerrain.first);
 		// Do not override terrain set in province files.
-		if (!province->getTerrain().empty())
+		if ((province != NULL) && province->getTerrain().empty())
 		{
-			continue;
+			province->setTerrain(provinceTerrain.second);
 		}
-		province->setTerrain(leaf->getLeaf());
 	}
 }
 
-bool V2World::isAProvinceLocalization(const string& line)
-{
-	return (line.substr(0, 4) == "PROV") && (isdigit(line[4]));
-}
-
 
-void V2World::importDefaultPops()
+void V2World::importDefaultPops(const Vic2::StaticData& staticData)
 {
-	LOG(LogLevel::Info) << "Importing historical pops.";
+	WORKER_LOG(LogLevel::Info) << "Importing historical pops.";
 
 	totalWorldPopulation = 0;
 
-	set<string> filenames;
-	Utils::GetAllFilesInFolder("./blankMod/output/history/pops/1836.1.1/", filenames);
-
-	LOG(LogLevel::Info) << "Parsing minority pops mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing minority pops mappings";
 
 	std::ifstream minPopFile("minorityPops.txt");
 	if (minPopFile.fail())
@@ -251,52 +158,45 @@ void V2World::importDefaultPops()
 	minPopFile.close();
 
 
-	for (auto filename : filenames)
+	for (const auto& popFile: staticData.getPopFiles())
 	{
-		importPopsFromFile(filename, minorityPopMapper);
+		importPopsFromFile(popFile, minorityPopMapper);
 	}
 
 
 }
 
 
-void V2World::importPopsFromFile(const string& filename, const mappers::MinorityPopMapper& minorityPopMapper)
+void V2World::importPopsFromFile(const Vic2::PopFile& popFile, const mappers::MinorityPopMapper& minorityPopMapper)
 {
 	list<int> popProvinces;
 
-	shared_ptr<Object> fileObj = parser_8859_15::doParseFile(("./blankMod/output/history/pops/1836.1.1/" + filename));
-	vector<shared_ptr<Object>> provinceObjs = fileObj->getLeaves();
-
-	for (auto provinceObj : provinceObjs)
+	for (const auto& provincePops: popFile.provincePops)
 	{
-		int provinceNum = stoi(provinceObj->getKey());
-		popProvinces.push_back(provinceNum);
+		popProvinces.push_back(provincePops.first);
 
-		importPopsFromProvince(provinceObj, minorityPopMapper);
+		importPopsFromProvince(provincePops.first, provincePops.second, minorityPopMapper);
 	}
 
-	popRegions.insert(make_pair(filename, popProvinces));
+	popRegions.insert(make_pair(popFile.name, popProvinces));
 }
 
 
-void V2World::importPopsFromProvince(shared_ptr<Object> provinceObj, const mappers::MinorityPopMapper& minorityPopMapper)
+void V2World::importPopsFromProvince(int provinceNum, const std::vector<Vic2::PopDetails>& pops, const mappers::MinorityPopMapper& minorityPopMapper)
 {
-	int provinceNum = stoi(provinceObj->getKey());
 	auto province = provinces.find(provinceNum);
 	if (province == provinces.end())
 	{
-		LOG(LogLevel::Warning) << "Could not find province " << provinceNum << " for original pops.";
+		WORKER_LOG(LogLevel::Warning) << "Could not find province " << provinceNum << " for original pops.";
 		return;
 	}
 
 	int provincePopulation = 0;
 	int provinceSlavePopulation = 0;
 
-	vector<shared_ptr<Object>> popObjs = provinceObj->getLeaves();
-
-	for (auto popObj: popObjs)
+	for (const auto& pop: pops)
 	{
-		V2Pop* newPop = new V2Pop(popObj);
+		V2Pop* newPop = new V2Pop(pop.type, pop.size, pop.culture, pop.religion);
 
 		province->second->addOldPop(newPop);
 		if (minorityPopMapper.matchMinorityPop(*newPop))
@@ -333,7 +233,7 @@ void V2World::logPopsByCountry() const
 
 void V2World::logPopsFromFile(string filename, map<string, map<string, long int>>& popsByCountry) const
 {
-	shared_ptr<Object> fileObj = parser_8859_15::doParseFile(("./blankMod/output/history/pops/1836.1.1/" + filename));
+	shared_ptr<Object> fileObj = parsing::parse8859File(("./blankMod/output/history/pops/1836.1.1/" + filename));
 
 	vector<shared_ptr<Object>> provinceObjs = fileObj->getLeaves();
 	for (auto provinceObj : provinceObjs)
@@ -349,7 +249,7 @@ void V2World::logPopsInProvince(shared_ptr<Object> provinceObj, map<string, map<
 	auto province = provinces.find(provinceNum);
 	if (province == provinces.end())
 	{
-		LOG(LogLevel::Warning) << "Could not find province " << provinceNum << " for original pops.";
+		WORKER_LOG(LogLevel::Warning) << "Could not find province " << provinceNum << " for original pops.";
 		return;
 	}
 
@@ -409,46 +309,23 @@ void V2World::outputLog(const map<string, map<string, long int>>& popsByCountry)
 
 		for (auto popsItr : countryItr.second)
 		{
-			LOG(LogLevel::Info) << "," << countryItr.first << "," << popsItr.first << "," << popsItr.second << "," << static_cast<double>(popsItr.second / total);
+			WORKER_LOG(LogLevel::Info) << "," << countryItr.first << "," << popsItr.first << "," << popsItr.second << "," << static_cast<double>(popsItr.second / total);
 		}
 
-		LOG(LogLevel::Info) << "," << countryItr.first << "," << "Total," << total << "," << static_cast<double>(total / total);
-	}
-}
-
-
-void V2World::findCoastalProvinces()
-{
-	LOG(LogLevel::Info) << "Finding coastal provinces.";
-	shared_ptr<Object> positionsObj = parser_8859_15::doParseFile((theConfiguration.getVic2Path() + "/map/positions.txt"));
-	if (positionsObj == nullptr)
-	{
-		LOG(LogLevel::Error) << "Could not parse file " << theConfiguration.getVic2Path() << "/map/positions.txt";
-		exit(-1);
-	}
-
-	vector<shared_ptr<Object>> provinceObjs = positionsObj->getLeaves();
-	for (auto provinceObj: provinceObjs)
-	{
-		determineIfProvinceIsCoastal(provinceObj);
+		WORKER_LOG(LogLevel::Info) << "," << countryItr.first << "," << "Total," << total << "," << static_cast<double>(total / total);
 	}
 }
 
 
-void V2World::determineIfProvinceIsCoastal(shared_ptr<Object> provinceObj)
+void V2World::findCoastalProvinces(const Vic2::StaticData& staticData)
 {
-	vector<shared_ptr<Object>> positionObj = provinceObj->getValue("building_position");
-	if (positionObj.size() > 0)
+	WORKER_LOG(LogLevel::Info) << "Finding coastal provinces.";
+	for (auto provinceNum: staticData.getCoastalProvinces())
 	{
-		vector<shared_ptr<Object>> navalBaseObj = positionObj[0]->getValue("naval_base");
-		if (navalBaseObj.size() > 0)
+		auto province = provinces.find(provinceNum);
+		if (province != provinces.end())
 		{
-			int provinceNum = stoi(provinceObj->getKey());
-			auto province = provinces.find(provinceNum);
-			if (province != provinces.end())
-			{
-				province->second->setCoastal(true);
-			}
+			province->second->setCoastal(true);
 		}
 	}
 }
@@ -456,7 +333,7 @@ void V2World::determineIfProvinceIsCoastal(shared_ptr<Object> provinceObj)
 
 void V2World::importPotentialCountries()
 {
-	LOG(LogLevel::Info) << "Getting potential countries";
+	WORKER_LOG(LogLevel::Info) << "Getting potential countries";
 	potentialCountries.clear();
 	dynamicCountries.clear();
 
@@ -464,7 +341,7 @@ void V2World::importPotentialCountries()
 	V2CountriesInput.open("./blankMod/output/common/countries.txt");
 	if (!V2CountriesInput.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not open countries.txt. The converter may be corrupted, try downloading it again.";
+		WORKER_LOG(LogLevel::Error) << "Could not open countries.txt. The converter may be corrupted, try downloading it again.";
 		exit(-1);
 	}
 
@@ -506,7 +383,7 @@ void V2World::importPotentialCountry(const string& line, bool dynamicCountry)
 
 void V2World::initializeCultureMappers(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Parsing culture mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing culture mappings";
 
 	std::ifstream cultureMapFile("cultureMap.txt");
 	cultureMapper = std::make_unique<mappers::CultureMapper>(cultureMapFile);
@@ -522,7 +399,7 @@ void V2World::initializeCultureMappers(const EU4::world& sourceWorld)
 
 void V2World::initializeReligionMapper(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Parsing religion mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing religion mappings";
 
 	std::ifstream mappingsFile("religionMap.txt");
 	religionMapper = std::make_unique<mappers::ReligionMapper>(mappingsFile);
@@ -534,16 +411,16 @@ void V2World::initializeReligionMapper(const EU4::world& sourceWorld)
 
 void V2World::initializeProvinceMapper()
 {
-	LOG(LogLevel::Info) << "Parsing province mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing province mappings";
 	std::ifstream mappingsFile("province_mappings.txt");
-	provinceMapper = std::make_unique<mappers::ProvinceMapper>(mappingsFile, theConfiguration);
+	provinceMapper = std::make_unique<mappers::ProvinceMapper>(mappingsFile, theConfiguration());
 	mappingsFile.close();
 }
 
 
 void V2World::convertCountries(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper& ideaEffectMapper)
 {
-	LOG(LogLevel::Info) << "Converting countries";
+	WORKER_LOG(LogLevel::Info) << "Converting countries";
 	initializeCountries(sourceWorld, ideaEffectMapper);
 	convertNationalValues(ideaEffectMapper);
 	convertPrestige();
@@ -557,7 +434,7 @@ void V2World::initializeCountries(const EU4::world& sourceWorld, const mappers::
 	Vic2::TechSchoolsFile theTechSchoolsFile(theBlockedTechSchoolsFile.takeBlockedTechSchools());
 	auto theTechSchools = theTechSchoolsFile.takeTechSchools();
 
-	LOG(LogLevel::Info) << "Parsing governments mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing governments mappings";
 
 	std::ifstream governmentMapFile("governmentMapping.txt");
 	if (governmentMapFile.fail())
@@ -573,7 +450,7 @@ void V2World::initializeCountries(const EU4::world& sourceWorld, const mappers::
 		const string& V2Tag = mappers::CountryMappings::getVic2Tag(sourceCountry.first);
 		if (V2Tag == "")
 		{
-			LOG(LogLevel::Error) << "EU4 tag " << sourceCountry.first << " is unmapped and cannot be converted.";
+			WORKER_LOG(LogLevel::Error) << "EU4 tag " << sourceCountry.first << " is unmapped and cannot be converted.";
 			exit(-1);
 		}
 
@@ -684,7 +561,7 @@ void V2World::convertNationalValues(const mappers::IdeaEffectMapper& ideaEffectM
 
 void V2World::convertPrestige()
 {
-	LOG(LogLevel::Debug) << "Setting prestige";
+	WORKER_LOG(LogLevel::Debug) << "Setting prestige";
 
 	double highestScore = 0.0;
 	for (auto country: countries)
@@ -758,14 +635,14 @@ struct MTo1ProvinceComp
 
 void V2World::convertProvinces(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Converting provinces";
+	WORKER_LOG(LogLevel::Info) << "Converting provinces";
 
 	for (auto Vic2Province : provinces)
 	{
 		auto EU4ProvinceNumbers = provinceMapper->getEU4ProvinceNumbers(Vic2Province.first);
 		if (EU4ProvinceNumbers.size() == 0)
 		{
-			LOG(LogLevel::Warning) << "No source for " << Vic2Province.second->getName() << " (province " << Vic2Province.first << ')';
+			WORKER_LOG(LogLevel::Warning) << "No source for " << Vic2Province.second->getName() << " (province " << Vic2Province.first << ')';
 			continue;
 		}
 		else if (*EU4ProvinceNumbers.begin() == 0)
@@ -773,7 +650,7 @@ void V2World::convertProvinces(const EU4::world& sourceWorld)
 			continue;
 		}
 		else if (
-			(theConfiguration.getResetProvinces() == "yes") &&
+			(theConfiguration().getResetProvinces() == "yes") &&
 			provinceMapper->isProvinceResettable(Vic2Province.first, "resettableRegion")
 		) {
 			Vic2Province.second->setResettable(true);
@@ -844,11 +721,11 @@ void V2World::convertProvinces(const EU4::world& sourceWorld)
 		const std::string& V2OwnerTag = mappers::CountryMappings::getVic2Tag(oldOwnerTag);
 		if (V2OwnerTag.empty())
 		{
-			LOG(LogLevel::Warning) << "Could not map provinces owned by " << oldOwnerTag;
+			WORKER_LOG(LogLevel::Warning) << "Could not map provinces owned by " << oldOwnerTag;
 		}
 		else if (V2ControllerTag.empty())
 		{
-			LOG(LogLevel::Warning) << "Could not map provinces controlled by " << V2ControllerTag;
+			WORKER_LOG(LogLevel::Warning) << "Could not map provinces controlled by " << V2ControllerTag;
 		}
 		else
 		{
@@ -931,55 +808,57 @@ std::vector<V2Demographic> V2World::determineDemographics(
 	double provPopRatio
 )
 {
+	const auto ownerSymbol = parsing::TagSymbol::find(oldOwnerTag).value_or(parsing::TagSymbol());
+
 	vector<V2Demographic> demographics;
-	for (auto popRatio: popRatios)
+	for (const auto& popRatio: popRatios)
 	{
 		std::optional<std::string> dstCulture;
 		dstCulture = cultureMapper->cultureMatch(
 			eu4Regions,
-			popRatio.getCulture(),
-			popRatio.getReligion(),
+			popRatio.getCultureSymbol(),
+			popRatio.getReligionSymbol(),
 			eProv->getNum(),
-			oldOwnerTag
+			ownerSymbol
 		);
 		if (!dstCulture)
 		{
-			LOG(LogLevel::Warning) << "Could not set culture for pops in Vic2 province " << destNum;
+			WORKER_LOG(LogLevel::Warning) << "Could not set culture for pops in Vic2 province " << destNum;
 			dstCulture = "no_culture";
 		}
 
-		std::optional<std::string> religion = religionMapper->getVic2Religion(popRatio.getReligion());
+		std::optional<std::string> religion = religionMapper->getVic2Religion(popRatio.getReligionSymbol());
 		if (!religion)
 		{
-			LOG(LogLevel::Warning) << "Could not set religion for pops in Vic2 province " << destNum;
+			WORKER_LOG(LogLevel::Warning) << "Could not set religion for pops in Vic2 province " << destNum;
 			religion = "";
 		}
 
 		std::optional<std::string> slaveCulture;
 		slaveCulture = slaveCultureMapper->cultureMatch(
 			eu4Regions,
-			popRatio.getCulture(),
-			popRatio.getReligion(),
+			popRatio.getCultureSymbol(),
+			popRatio.getReligionSymbol(),
 			eProv->getNum(),
-			oldOwnerTag
+			ownerSymbol
 		);
 		if (!slaveCulture)
 		{
 			auto thisContinent = EU4::continents::getEU4Continent(eProv->getNum());
 			if ((thisContinent) && ((thisContinent == "asia") || (thisContinent == "oceania")))
 			{
-				if (theConfiguration.getDebug())
+				if (theConfiguration().getDebug())
 				{
-					LOG(LogLevel::Warning) << "No mapping for slave culture in province "
+					WORKER_LOG(LogLevel::Warning) << "No mapping for slave culture in province "
 						<< destNum << " - using native culture (" << popRatio.getCulture() << ").";
 				}
 				slaveCulture = popRatio.getCulture();
 			}
 			else
 			{
-				if (theConfiguration.getDebug())
+				if (theConfiguration().getDebug())
 				{
-					LOG(LogLevel::Warning) << "No mapping for slave culture for pops in Vic2 province "
+					WORKER_LOG(LogLevel::Warning) << "No mapping for slave culture for pops in Vic2 province "
 						<< destNum << " - using african_minor.";
 				}
 				slaveCulture = "african_minor";
@@ -996,9 +875,9 @@ std::vector<V2Demographic> V2World::determineDemographics(
 		demographic.oldCountry = oldOwnerTag;
 		demographic.oldProvince = eProv;
 
-		if (theConfiguration.getDebug())
+		if (theConfiguration().getDebug())
 		{
-			LOG(LogLevel::Info) << "EU4 Province " << eProv->getNum() << ", "
+			WORKER_LOG(LogLevel::Info) << "EU4 Province " << eProv->getNum() << ", "
 				<< "Vic2 Province " << vProv->getNum() << ", "
 				<< "Culture: " << demographic.culture << ", "
 				<< "Religion: " << demographic.religion << ", "
@@ -1018,7 +897,7 @@ std::vector<V2Demographic> V2World::determineDemographics(
 
 void V2World::convertDiplomacy(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Converting diplomacy";
+	WORKER_LOG(LogLevel::Info) << "Converting diplomacy";
 
 	vector<EU4Agreement> agreements = sourceWorld.getDiplomaticAgreements();
 	for (vector<EU4Agreement>::iterator itr = agreements.begin(); itr != agreements.end(); ++itr)
@@ -1040,12 +919,12 @@ void V2World::convertDiplomacy(const EU4::world& sourceWorld)
 		map<string, V2Country*>::iterator country2 = countries.find(V2Tag2);
 		if (country1 == countries.end())
 		{
-			LOG(LogLevel::Warning) << "Vic2 country " << V2Tag1 << " used in diplomatic agreement doesn't exist";
+			WORKER_LOG(LogLevel::Warning) << "Vic2 country " << V2Tag1 << " used in diplomatic agreement doesn't exist";
 			continue;
 		}
 		if (country2 == countries.end())
 		{
-			LOG(LogLevel::Warning) << "Vic2 country " << V2Tag2 << " used in diplomatic agreement doesn't exist";
+			WORKER_LOG(LogLevel::Warning) << "Vic2 country " << V2Tag2 << " used in diplomatic agreement doesn't exist";
 			continue;
 		}
 		std::optional<V2Relations> r1 = country1->second->getRelations(V2Tag2);
@@ -1065,7 +944,7 @@ void V2World::convertDiplomacy(const EU4::world& sourceWorld)
 		{
 			country2->second->setColonyOverlord(country1->second);
 
-			if (country2->second->getSourceCountry()->getLibertyDesire() < theConfiguration.getLibertyThreshold())
+			if (country2->second->getSourceCountry()->getLibertyDesire() < theConfiguration().getLibertyThreshold())
 			{
 				country1->second->absorbVassal(country2->second);
 				for (vector<EU4Agreement>::iterator itr2 = agreements.begin(); itr2 != agreements.end(); ++itr2)
@@ -1135,52 +1014,37 @@ void V2World::convertDiplomacy(const EU4::world& sourceWorld)
 
 void V2World::setupColonies()
 {
-	LOG(LogLevel::Info) << "Setting colonies";
+	WORKER_LOG(LogLevel::Info) << "Setting colonies";
 
-	for (map<string, V2Country*>::iterator countryItr = countries.begin(); countryItr != countries.end(); countryItr++)
+	// find all land connections to capitals
+	vector<string> owners;
+	if (!provinces.empty())
 	{
-		// find all land connections to capitals
-		map<int, V2Province*>	openProvinces = provinces;
-		queue<int>					goodProvinces;
-
-		map<int, V2Province*>::iterator openItr = openProvinces.find(countryItr->second->getCapital());
-		if (openItr == openProvinces.end())
+		owners.resize(std::max(provinces.rbegin()->first + 1, 0));
+	}
+	for (auto province: provinces)
+	{
+		if (province.first >= 0)
 		{
-			continue;
+			owners[province.first] = province.second->getOwner();
 		}
-		if (openItr->second->getOwner() != countryItr->first) // if the capital is not owned, don't bother running
+	}
+	map<string, int> capitals;
+	for (auto country: countries)
+	{
+		capitals.insert(make_pair(country.first, country.second->getCapital()));
+	}
+	const auto landConnections = Vic2::findLandConnections(owners, capitals, mappers::adjacencyMapper::getVic2Adjacencies);
+	for (auto province: provinces)
+	{
+		if ((province.first >= 0) && landConnections[province.first])
 		{
-			continue;
+			province.second->setLandConnection(true);
 		}
-		openItr->second->setLandConnection(true);
-		goodProvinces.push(openItr->first);
-		openProvinces.erase(openItr);
-
-		do
-		{
-			int currentProvince = goodProvinces.front();
-			goodProvinces.pop();
-			auto adjacencies = mappers::adjacencyMapper::getVic2Adjacencies(currentProvince);
-			if (adjacencies)
-			{
-				for (auto adjacency: *adjacencies)
-				{
-					auto openItr = openProvinces.find(adjacency);
-					if (openItr == openProvinces.end())
-					{
-						continue;
-					}
-					if (openItr->second->getOwner() != countryItr->first)
-					{
-						continue;
-					}
-					openItr->second->setLandConnection(true);
-					goodProvinces.push(openItr->first);
-					openProvinces.erase(openItr);
-				}
-			}
-		} while (goodProvinces.size() > 0);
+	}
 
+	for (map<string, V2Country*>::iterator countryItr = countries.begin(); countryItr != countries.end(); countryItr++)
+	{
 		// find all provinces on the same continent as the owner's capital
 		std::optional<std::string> capitalContinent;
 		map<int, V2Province*>::iterator capital = provinces.find(countryItr->second->getCapital());
@@ -1223,60 +1087,56 @@ void V2World::setupColonies()
 	}
 }
 
-static int stateId = 0;
 void V2World::setupStates()
 {
-	LOG(LogLevel::Info) << "Creating states";
-	list<V2Province*> unassignedProvs;
-	for (map<int, V2Province*>::iterator itr = provinces.begin(); itr != provinces.end(); ++itr)
-	{
-		unassignedProvs.push_back(itr->second);
-	}
-	LOG(LogLevel::Debug) << "Unassigned Provs:\t" << unassignedProvs.size();
+	WORKER_LOG(LogLevel::Info) << "Creating states";
 
 	Vic2::stateMapperFile theStateMapperFile;
 	std::unique_ptr<Vic2::stateMapper> theStateMapper = theStateMapperFile.takeStateMapper();
 
-	list<V2Province*>::iterator iter;
-	while (unassignedProvs.size() > 0)
+	vector<V2Province*> provincesByNumber;
+	for (auto province: provinces)
 	{
-		iter = unassignedProvs.begin();
-		int		provId = (*iter)->getNum();
-		string	owner = (*iter)->getOwner();
-
-		if (owner == "")
+		if (province.first < 0)
 		{
-			unassignedProvs.erase(iter);
 			continue;
 		}
+		if (static_cast<size_t>(province.first) >= provincesByNumber.size())
+		{
+			provincesByNumber.resize(province.first + 1, nullptr);
+		}
+		provincesByNumber[province.first] = province.second;
+	}
+	WORKER_LOG(LogLevel::Debug) << "Unassigned Provs:\t" << provinces.size();
 
-		V2State* newState = new V2State(stateId, *iter);
-		stateId++;
-		auto neighbors = theStateMapper->getAllProvincesInState(provId);
-
-		bool colonial = (*iter)->isColonial();
-		newState->setColonial(colonial);
-		iter = unassignedProvs.erase(iter);
+	vector<string> owners(provincesByNumber.size());
+	vector<bool> colonial(provincesByNumber.size(), false);
+	for (size_t i = 0; i < provincesByNumber.size(); i++)
+	{
+		if (provincesByNumber[i] != nullptr)
+		{
+			owners[i] = provincesByNumber[i]->getOwner();
+			colonial[i] = provincesByNumber[i]->isColonial();
+		}
+	}
+	const auto newStates = Vic2::groupProvincesIntoStates(owners, colonial, [&theStateMapper](int province) {
+		return theStateMapper->getAllProvincesInState(province);
+	});
 
-		for (auto i = neighbors.begin(); i != neighbors.end(); i++)
+	int stateId = 0;
+	for (const auto& stateProvinces: newStates)
+	{
+		V2Province* firstProvince = provincesByNumber[stateProvinces.front()];
+		V2State* newState = new V2State(stateId, firstProvince);
+		stateId++;
+		newState->setColonial(firstProvince->isColonial());
+		for (size_t i = 1; i < stateProvinces.size(); i++)
 		{
-			for (iter = unassignedProvs.begin(); iter != unassignedProvs.end(); iter++)
-			{
-				if ((*iter)->getNum() == *i)
-				{
-					if ((*iter)->getOwner() == owner)
-					{
-						if ((*iter)->isColonial() == colonial)
-						{
-							newState->addProvince(*iter);
-							iter = unassignedProvs.erase(iter);
-						}
-					}
-				}
-			}
+			newState->addProvince(provincesByNumber[stateProvinces[i]]);
 		}
 		newState->colloectNavalBase();
-		map<string, V2Country*>::iterator iter2 = countries.find(owner);
+
+		map<string, V2Country*>::iterator iter2 = countries.find(firstProvince->getOwner());
 		if (iter2 != countries.end())
 		{
 			iter2->second->addState(newState);
@@ -1286,7 +1146,7 @@ void V2World::setupStates()
 
 void V2World::convertUncivReforms(const EU4::world& sourceWorld, const mappers::TechGroupsMapper& techGroupsMapper)
 {
-	LOG(LogLevel::Info) << "Setting unciv reforms";
+	WORKER_LOG(LogLevel::Info) << "Setting unciv reforms";
 
 	// tech group
 
@@ -1297,7 +1157,7 @@ void V2World::convertUncivReforms(const EU4::world& sourceWorld, const mappers::
 	auto version18 = EU4::Version("1.18.0");
 	if (sourceWorld.getVersion() >= version18)
 	{
-		LOG(LogLevel::Info) << "New tech group conversion method";
+		WORKER_LOG(LogLevel::Info) << "New tech group conversion method";
 		techGroupAlgorithm  = newer;
 
 		// Find global max tech and institutions embraced
@@ -1339,7 +1199,7 @@ void V2World::convertUncivReforms(const EU4::world& sourceWorld, const mappers::
 	}
 	else
 	{
-		LOG(LogLevel::Info) << "Old tech group conversion method";
+		WORKER_LOG(LogLevel::Info) << "Old tech group conversion method";
 		techGroupAlgorithm = older;
 	}
 
@@ -1370,7 +1230,7 @@ void V2World::convertUncivReforms(const EU4::world& sourceWorld, const mappers::
 
 void V2World::convertTechs(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Converting techs";
+	WORKER_LOG(LogLevel::Info) << "Converting techs";
 	helpers::TechValues techValues(countries);
 
 	for (auto countryItr: countries)
@@ -1388,13 +1248,13 @@ void V2World::convertTechs(const EU4::world& sourceWorld)
 }
 
 
-void V2World::allocateFactories(const EU4::world& sourceWorld)
+void V2World::allocateFactories(const EU4::world& sourceWorld, const Vic2::StaticData& staticData)
 {
 	// Construct factory factory
-	LOG(LogLevel::Info) << "Determining factory allocation rules.";
-	V2FactoryFactory factoryBuilder;
+	WORKER_LOG(LogLevel::Info) << "Determining factory allocation rules.";
+	V2FactoryFactory factoryBuilder(staticData);
 
-	LOG(LogLevel::Info) << "Allocating starting factories";
+	WORKER_LOG(LogLevel::Info) << "Allocating starting factories";
 
 	// determine average production tech
 	auto sourceCountries = sourceWorld.getCountries();
@@ -1444,7 +1304,7 @@ void V2World::allocateFactories(const EU4::world& sourceWorld)
 	}
 	if (weightedCountries.size() < 1)
 	{
-		LOG(LogLevel::Warning) << "No countries are able to accept factories";
+		WORKER_LOG(LogLevel::Warning) << "No countries are able to accept factories";
 		return;
 	}
 	sort(weightedCountries.begin(), weightedCountries.end());
@@ -1466,7 +1326,7 @@ void V2World::allocateFactories(const EU4::world& sourceWorld)
 
 	if (totalIndWeight == 0)
 	{
-		LOG(LogLevel::Warning) << "The world is a backwater! No factories for anyone!";
+		WORKER_LOG(LogLevel::Warning) << "The world is a backwater! No factories for anyone!";
 		return;
 	} 
 
@@ -1478,7 +1338,7 @@ void V2World::allocateFactories(const EU4::world& sourceWorld)
 		weightedCountries.pop_front();
 		if (weightedCountries.size() == 0)
 		{
-			LOG(LogLevel::Warning) << "These are all primitives! No factories for anyone!";
+			WORKER_LOG(LogLevel::Warning) << "These are all primitives! No factories for anyone!";
 			return;
 		}
 	}
@@ -1530,7 +1390,7 @@ void V2World::allocateFactories(const EU4::world& sourceWorld)
 
 void V2World::setupPops(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Creating pops";
+	WORKER_LOG(LogLevel::Info) << "Creating pops";
 
 	long		my_totalWorldPopulation = static_cast<long>(0.55 * totalWorldPopulation);
 	double	popWeightRatio = my_totalWorldPopulation / sourceWorld.getTotalProvinceWeights();
@@ -1541,12 +1401,12 @@ void V2World::setupPops(const EU4::world& sourceWorld)
 	auto version12 = EU4::Version("1.12.0");
 	if (sourceWorld.getVersion() >= version12)
 	{
-		LOG(LogLevel::Info) << "Using pop conversion algorithm for EU4 versions after 1.12.";
+		WORKER_LOG(LogLevel::Info) << "Using pop conversion algorithm for EU4 versions after 1.12.";
 		popAlgorithm = 2;
 	}
 	else
 	{
-		LOG(LogLevel::Info) << "Using pop conversion algorithm for EU4 versions prior to 1.12.";
+		WORKER_LOG(LogLevel::Info) << "Using pop conversion algorithm for EU4 versions prior to 1.12.";
 		popAlgorithm = 1;
 	}
 
@@ -1555,17 +1415,17 @@ void V2World::setupPops(const EU4::world& sourceWorld)
 		itr->second->setupPops(popWeightRatio, popAlgorithm, sourceWorld.getCountries(), *provinceMapper);
 	}
 
-	if (theConfiguration.getPopShaping() != Configuration::POPSHAPES::Vanilla)
+	if (theConfiguration().getPopShaping() != Configuration::POPSHAPES::Vanilla)
 	{
-		LOG(LogLevel::Info) << "Total world population: " << my_totalWorldPopulation;
+		WORKER_LOG(LogLevel::Info) << "Total world population: " << my_totalWorldPopulation;
 	}
 	else
 	{
-		LOG(LogLevel::Info) << "Total world population: " << totalWorldPopulation;
+		WORKER_LOG(LogLevel::Info) << "Total world population: " << totalWorldPopulation;
 	}
-	LOG(LogLevel::Info) << "Total world weight sum: " << sourceWorld.getTotalProvinceWeights();
-	LOG(LogLevel::Info) << my_totalWorldPopulation << " / " << sourceWorld.getTotalProvinceWeights();
-	LOG(LogLevel::Info) << "Population per weight point is: " << popWeightRatio;
+	WORKER_LOG(LogLevel::Info) << "Total world weight sum: " << sourceWorld.getTotalProvinceWeights();
+	WORKER_LOG(LogLevel::Info) << my_totalWorldPopulation << " / " << sourceWorld.getTotalProvinceWeights();
+	WORKER_LOG(LogLevel::Info) << "Population per weight point is: " << popWeightRatio;
 
 	long newTotalPopulation = 0;
 	// Heading
@@ -1705,7 +1565,7 @@ void V2World::setupPops(const EU4::world& sourceWorld)
 		////	V2 POPs
 		//output_file << itr->second->getTotalPopulation() << endl;
 	}
-	LOG(LogLevel::Info) << "New total world population: " << newTotalPopulation;
+	WORKER_LOG(LogLevel::Info) << "New total world population: " << newTotalPopulation;
 
 	//output_file.close();
 }
@@ -1713,7 +1573,7 @@ void V2World::setupPops(const EU4::world& sourceWorld)
 
 void V2World::addUnions()
 {
-	LOG(LogLevel::Info) << "Adding unions";
+	WORKER_LOG(LogLevel::Info) << "Adding unions";
 
 	Vic2::CultureUnionMapperFile theVic2CultureUnionMapperFile;
 	auto theVic2CultureUnionMapper = theVic2CultureUnionMapperFile.takeCultureUnionMapper();
@@ -1728,7 +1588,7 @@ void V2World::addUnions()
 			{
 				vector<string> unionCores = theVic2CultureUnionMapper->getCoreForCulture(culture);
 				vector<string> nationalCores = theVic2NationalsMapper->getCoreForCulture(culture);
-				switch (theConfiguration.getCoreHandling())
+				switch (theConfiguration().getCoreHandling())
 				{
 				case Configuration::COREHANDLES::DropNational:
 					for (auto core : unionCores)
@@ -1739,7 +1599,7 @@ void V2World::addUnions()
 				case Configuration::COREHANDLES::DropUnions:
 					for (auto core : nationalCores)
 					{
-						LOG(LogLevel::Debug) << provItr->second->getName() << ": " << core;
+						WORKER_LOG(LogLevel::Debug) << provItr->second->getName() << ": " << core;
 						provItr->second->addCore(core);
 					}
 					break;
@@ -1762,7 +1622,7 @@ void V2World::addUnions()
 //#define TEST_V2_PROVINCES
 void V2World::convertArmies(const EU4::world& sourceWorld)
 {
-	LOG(LogLevel::Info) << "Converting armies and navies";
+	WORKER_LOG(LogLevel::Info) << "Converting armies and navies";
 
 	// hack for naval bases.  not ALL naval bases are in port provinces, and if you spawn a navy at a naval base in
 	// a non-port province, Vicky crashes....
@@ -1778,19 +1638,19 @@ void V2World::convertArmies(const EU4::world& sourceWorld)
 		s.close();
 	}
 
-	LOG(LogLevel::Debug) << "Parsing regiment costs";
+	WORKER_LOG(LogLevel::Debug) << "Parsing regiment costs";
 	// get cost per regiment values
 	double cost_per_regiment[static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories)] = { 0.0 };
-	shared_ptr<Object>	obj2 = parser_8859_15::doParseFile("regiment_costs.txt");
+	shared_ptr<Object>	obj2 = parsing::parse8859File("regiment_costs.txt");
 	if (obj2 == nullptr)
 	{
-		LOG(LogLevel::Error) << "Could not parse file regiment_costs.txt";
+		WORKER_LOG(LogLevel::Error) << "Could not parse file regiment_costs.txt";
 		exit(-1);
 	}
 	vector<shared_ptr<Object>> objTop = obj2->getLeaves();
 	if (objTop.size() == 0 || objTop[0]->getLeaves().size() == 0)
 	{
-		LOG(LogLevel::Error) << "regment_costs.txt failed to parse";
+		WORKER_LOG(LogLevel::Error) << "regment_costs.txt failed to parse";
 		exit(1);
 	}
 	for (int i = 0; i < static_cast<int>(EU4::REGIMENTCATEGORY::num_reg_categories); ++i)
@@ -1803,7 +1663,7 @@ void V2World::convertArmies(const EU4::world& sourceWorld)
 	}
 
 	// convert armies
-	LOG(LogLevel::Debug) << "Converting country armies";
+	WORKER_LOG(LogLevel::Debug) << "Converting country armies";
 	for (map<string, V2Country*>::iterator itr = countries.begin(); itr != countries.end(); ++itr)
 	{
 		itr->second->convertArmies(leaderIDMap, cost_per_regiment, provinces, port_whitelist, *provinceMapper);
@@ -1812,25 +1672,25 @@ void V2World::convertArmies(const EU4::world& sourceWorld)
 
 void V2World::output(unsigned int potentialGPs) const
 {
-	LOG(LogLevel::Info) << "Outputting mod";
+	WORKER_LOG(LogLevel::Info) << "Outputting mod";
 	Utils::copyFolder("blankMod/output", "output/output");
-	Utils::renameFolder("output/output", "output/" + theConfiguration.getOutputName());
+	Utils::renameFolder("output/output", "output/" + theConfiguration().getOutputName());
 	createModFile();
 
 	// Record converter version
 
-	LOG(LogLevel::Debug) << "Writing version";
+	WORKER_LOG(LogLevel::Debug) << "Writing version";
 	ofstream versionFile;
 
 	try
 	{
-		versionFile.open("output/" + theConfiguration.getOutputName() + "/eu4tov2_version.txt");
+		versionFile.open("output/" + theConfiguration().getOutputName() + "/eu4tov2_version.txt");
 		versionFile << "# 1.0K-prerelease \"Kurland\", built on " << __TIMESTAMP__ << ".\n";
 		versionFile.close();
 	}
 	catch (const std::exception&)
 	{
-		LOG(LogLevel::Error) << "Error writing version file! Is the output folder writeable?";
+		WORKER_LOG(LogLevel::Error) << "Error writing version file! Is the output folder writeable?";
 	}
 
 	// Update bookmark starting dates
@@ -1840,12 +1700,12 @@ void V2World::output(unsigned int potentialGPs) const
 
 	ostringstream incomingDefines, incomingBookmarks;
 
-	ifstream defines_lua("output/" + theConfiguration.getOutputName() + "/common/defines.lua");
+	ifstream defines_lua("output/" + theConfiguration().getOutputName() + "/common/defines.lua");
 	incomingDefines << defines_lua.rdbuf();
 	defines_lua.close();
 	string strDefines = incomingDefines.str();
 	size_t pos1 = strDefines.find(startDate);
-	strDefines.replace(pos1, startDate.length(), theConfiguration.getLastEU4Date().toString());
+	strDefines.replace(pos1, startDate.length(), theConfiguration().getLastEU4Date().toString());
 
 	if (potentialGPs < 8)
 	{
@@ -1855,33 +1715,33 @@ void V2World::output(unsigned int potentialGPs) const
 
 	}
 
-	ofstream out_defines_lua("output/" + theConfiguration.getOutputName() + "/common/defines.lua");
+	ofstream out_defines_lua("output/" + theConfiguration().getOutputName() + "/common/defines.lua");
 	out_defines_lua << strDefines;
 	out_defines_lua.close();
 
-	ifstream bookmarks_txt("output/" + theConfiguration.getOutputName() + "/common/bookmarks.txt");
+	ifstream bookmarks_txt("output/" + theConfiguration().getOutputName() + "/common/bookmarks.txt");
 	incomingBookmarks << bookmarks_txt.rdbuf();
 	bookmarks_txt.close();
 	string strBookmarks = incomingBookmarks.str();
 	size_t pos2 = strBookmarks.find(startDate);
-	strBookmarks.replace(pos2, startDate.length(), theConfiguration.getLastEU4Date().toString());
-	ofstream out_bookmarks_txt("output/" + theConfiguration.getOutputName() + "/common/bookmarks.txt");
+	strBookmarks.replace(pos2, startDate.length(), theConfiguration().getLastEU4Date().toString());
+	ofstream out_bookmarks_txt("output/" + theConfiguration().getOutputName() + "/common/bookmarks.txt");
 	out_bookmarks_txt << strBookmarks;
 	out_bookmarks_txt.close();
 
 	// Create common\countries path.
-	string countriesPath = "output/" + theConfiguration.getOutputName() + "/common/countries";
+	string countriesPath = "output/" + theConfiguration().getOutputName() + "/common/countries";
 	if (!Utils::TryCreateFolder(countriesPath))
 	{
 		return;
 	}
 
 	// Output common\countries.txt
-	LOG(LogLevel::Debug) << "Writing countries file";
+	WORKER_LOG(LogLevel::Debug) << "Writing countries file";
 	FILE* allCountriesFile;
-	if (fopen_s(&allCountriesFile, ("output/" + theConfiguration.getOutputName() + "/common/countries.txt").c_str(), "w") != 0)
+	if (fopen_s(&allCountriesFile, ("output/" + theConfiguration().getOutputName() + "/common/countries.txt").c_str(), "w") != 0)
 	{
-		LOG(LogLevel::Error) << "Could not create countries file";
+		WORKER_LOG(LogLevel::Error) << "Could not create countries file";
 		exit(-1);
 	}
 	for (map<string, V2Country*>::const_iterator i = countries.begin(); i != countries.end(); i++)
@@ -1894,7 +1754,7 @@ void V2World::output(unsigned int potentialGPs) const
 		}
 	}
 	fprintf(allCountriesFile, "\n");
-	if ((theConfiguration.getVic2Gametype() == "HOD") || (theConfiguration.getVic2Gametype() == "HoD_NNM"))
+	if ((theConfiguration().getVic2Gametype() == "HOD") || (theConfiguration().getVic2Gametype() == "HoD_NNM"))
 	{
 		fprintf(allCountriesFile, "##HoD Dominions\n");
 		fprintf(allCountriesFile, "dynamic_tags = yes # any tags after this is considered dynamic dominions\n");
@@ -1911,18 +1771,18 @@ void V2World::output(unsigned int potentialGPs) const
 	flags.output();
 
 	// Create localisations for all new countries. We don't actually know the names yet so we just use the tags as the names.
-	LOG(LogLevel::Debug) << "Writing localisation text";
-	string localisationPath = "output/" + theConfiguration.getOutputName() + "/localisation";
+	WORKER_LOG(LogLevel::Debug) << "Writing localisation text";
+	string localisationPath = "output/" + theConfiguration().getOutputName() + "/localisation";
 	if (!Utils::TryCreateFolder(localisationPath))
 	{
 		return;
 	}
-	string source = theConfiguration.getVic2Path() + "/localisation/text.csv";
+	string source = theConfiguration().getVic2Path() + "/localisation/text.csv";
 	string dest = localisationPath + "/text.csv";
 
 	if (isRandomWorld)
 	{
-		LOG(LogLevel::Debug) << "It's a random world";
+		WORKER_LOG(LogLevel::Debug) << "It's a random world";
 		// we need to strip out the existing country names from the localisation file
 		ifstream sourceFile(source);
 		ofstream targetFile(dest);
@@ -1951,7 +1811,7 @@ void V2World::output(unsigned int potentialGPs) const
 	}
 	else
 	{
-		LOG(LogLevel::Debug) << "It's not a random world";
+		WORKER_LOG(LogLevel::Debug) << "It's not a random world";
 	}
 
 	std::ofstream localisationFile(localisationPath + "/0_Names.csv", std::ofstream::app);
@@ -1960,8 +1820,8 @@ void V2World::output(unsigned int potentialGPs) const
 		throw(std::runtime_error("Could not update localisation text file"));
 	}
 
-	Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/history/countries");
-	Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/history/units");
+	Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/history/countries");
+	Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/history/units");
 	for (auto country: countries)
 	{
 		if (country.second->isNewCountry())
@@ -1971,13 +1831,13 @@ void V2World::output(unsigned int potentialGPs) const
 	}
 	localisationFile.close();
 
-	LOG(LogLevel::Debug) << "Writing provinces";
-	Utils::TryCreateFolder("output/" + theConfiguration.getOutputName() + "/history/provinces");
+	WORKER_LOG(LogLevel::Debug) << "Writing provinces";
+	Utils::TryCreateFolder("output/" + theConfiguration().getOutputName() + "/history/provinces");
 	for (auto province: provinces)
 	{
 		province.second->output();
 	}
-	LOG(LogLevel::Debug) << "Writing countries";
+	WORKER_LOG(LogLevel::Debug) << "Writing countries";
 	for (map<string, V2Country*>::const_iterator itr = countries.begin(); itr != countries.end(); itr++)
 	{
 		itr->second->output();
@@ -1988,10 +1848,10 @@ void V2World::output(unsigned int potentialGPs) const
 
 	// verify countries got written
 	ifstream V2CountriesInput;
-	V2CountriesInput.open(("output/" + theConfiguration.getOutputName() + "/common/countries.txt").c_str());
+	V2CountriesInput.open(("output/" + theConfiguration().getOutputName() + "/common/countries.txt").c_str());
 	if (!V2CountriesInput.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not open countries.txt";
+		WORKER_LOG(LogLevel::Error) << "Could not open countries.txt";
 		exit(1);
 	}
 
@@ -2015,15 +1875,15 @@ void V2World::output(unsigned int potentialGPs) const
 		int size = line.find_last_of('\"') - start - 1;
 		countryFileName = line.substr(start + 1, size);
 
-		if (Utils::DoesFileExist("output/" + theConfiguration.getOutputName() + "/common/countries/" + countryFileName))
+		if (Utils::DoesFileExist("output/" + theConfiguration().getOutputName() + "/common/countries/" + countryFileName))
 		{
 		}
-		else if (Utils::DoesFileExist(theConfiguration.getVic2Path() + "/common/countries/" + countryFileName))
+		else if (Utils::DoesFileExist(theConfiguration().getVic2Path() + "/common/countries/" + countryFileName))
 		{
 		}
 		else
 		{
-			LOG(LogLevel::Warning) << "common/countries/" << countryFileName << " does not exists. This will likely crash Victoria 2.";
+			WORKER_LOG(LogLevel::Warning) << "common/countries/" << countryFileName << " does not exists. This will likely crash Victoria 2.";
 			continue;
 		}
 	}
@@ -2032,16 +1892,16 @@ void V2World::output(unsigned int potentialGPs) const
 
 void V2World::createModFile() const
 {
-	ofstream modFile("output/" + theConfiguration.getOutputName() + ".mod");
+	ofstream modFile("output/" + theConfiguration().getOutputName() + ".mod");
 	if (!modFile.is_open())
 	{
-		LOG(LogLevel::Error) << "Could not create " << theConfiguration.getOutputName() << ".mod";
+		WORKER_LOG(LogLevel::Error) << "Could not create " << theConfiguration().getOutputName() << ".mod";
 		exit(-1);
 	}
 
-	modFile << "name = \"Converted - " << theConfiguration.getOutputName() << "\"\n";
-	modFile << "path = \"mod/" << theConfiguration.getOutputName() << "\"\n";
-	modFile << "user_dir = \"" << theConfiguration.getOutputName() << "\"\n";
+	modFile << "name = \"Converted - " << theConfiguration().getOutputName() << "\"\n";
+	modFile << "path = \"mod/" << theConfiguration().getOutputName() << "\"\n";
+	modFile << "user_dir = \"" << theConfiguration().getOutputName() << "\"\n";
 	modFile << "replace = \"history/provinces\"\n";
 	modFile << "replace = \"history/countries\"\n";
 	modFile << "replace = \"history/diplomacy\"\n";
@@ -2062,13 +1922,13 @@ void V2World::createModFile() const
 
 void V2World::outputPops() const
 {
-	LOG(LogLevel::Debug) << "Writing pops";
+	WORKER_LOG(LogLevel::Debug) << "Writing pops";
 	for (auto popRegion : popRegions)
 	{
 		FILE* popsFile;
-		if (fopen_s(&popsFile, ("output/" + theConfiguration.getOutputName() + "/history/pops/1836.1.1/" + popRegion.first).c_str(), "w") != 0)
+		if (fopen_s(&popsFile, ("output/" + theConfiguration().getOutputName() + "/history/pops/1836.1.1/" + popRegion.first).c_str(), "w") != 0)
 		{
-			LOG(LogLevel::Error) << "Could not create pops file output/" << theConfiguration.getOutputName() << "/history/pops/1836.1.1/" << popRegion.first;
+			WORKER_LOG(LogLevel::Error) << "Could not create pops file output/" << theConfiguration().getOutputName() << "/history/pops/1836.1.1/" << popRegion.first;
 			exit(-1);
 		}
 
@@ -2081,7 +1941,7 @@ void V2World::outputPops() const
 			}
 			else
 			{
-				LOG(LogLevel::Error) << "Could not find province " << provinceNumber << " while outputing pops!";
+				WORKER_LOG(LogLevel::Error) << "Could not find province " << provinceNumber << " while outputing pops!";
 			}
 		}
 	}
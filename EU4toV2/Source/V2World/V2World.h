@@ -8,6 +8,7 @@
 #include "V2Factory.h"
 #include "V2Party.h"
 #include "V2Province.h"
+#include "Vic2StaticData.h"
 #include "../EU4World/Army/EU4Army.h"
 #include "../EU4World/Provinces/EU4Province.h"
 #include "../EU4World/Provinces/PopRatio.h"
@@ -32,22 +33,25 @@ class V2LeaderTraits;
 class V2World
 {
 	public:
-		V2World(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper& ideaEffectMapper, const mappers::TechGroupsMapper& techGroupsMapper);
+		// imports the Vic2 provinces, pops and countries, none of which depend on the save
+		explicit V2World(const Vic2::StaticData& staticData);
+
+		// converts the save onto them and writes the mod
+		void convert(const EU4::world& sourceWorld, const mappers::IdeaEffectMapper& ideaEffectMapper, const mappers::TechGroupsMapper& techGroupsMapper, const Vic2::StaticData& staticData);
+
 		V2Province* getProvince(int provNum) const;
 		V2Country* getCountry(string tag) const;
 		double getDuration() const { return difftime(std::time(0), begin); }
 
+		// the Vic2 install and blankMod data is the same for every save, so a batch reads it once
+		static Vic2::StaticData importStaticData();
+
 	private:
-		void importProvinces();
-		set<string> discoverProvinceFilenames();
-		void importProvinceClimates();
-		void importProvinceLocalizations(const string& file);
-		void importProvinceTerrains();
-		bool isAProvinceLocalization(const string& line);
+		void importProvinces(const Vic2::StaticData& staticData);
 
-		void importDefaultPops();
-		void importPopsFromFile(const string& filename, const mappers::MinorityPopMapper& minorityPopMapper);
-		void importPopsFromProvince(shared_ptr<Object> provinceObj, const mappers::MinorityPopMapper& minorityPopMapper);
+		void importDefaultPops(const Vic2::StaticData& staticData);
+		void importPopsFromFile(const Vic2::PopFile& popFile, const mappers::MinorityPopMapper& minorityPopMapper);
+		void importPopsFromProvince(int provinceNum, const std::vector<Vic2::PopDetails>& pops, const mappers::MinorityPopMapper& minorityPopMapper);
 
 		void logPopsByCountry() const;
 		void logPopsFromFile(string filename, map<string, map<string, long int>>& popsByCountry) const;
@@ -56,8 +60,7 @@ class V2World
 		void logPop(shared_ptr<Object> pop, map<string, map<string, long int>>::iterator countryPopItr) const;
 		void outputLog(const map<string, map<string, long int>>& popsByCountry) const;
 
-		void findCoastalProvinces();
-		void determineIfProvinceIsCoastal(shared_ptr<Object> provinceObj);
+		void findCoastalProvinces(const Vic2::StaticData& staticData);
 
 		void importPotentialCountries();
 		void importPotentialCountry(const string& line, bool dynamicCountry);
@@ -90,7 +93,7 @@ class V2World
 		void setupStates();
 		void convertUncivReforms(const EU4::world& sourceWorld, const mappers::TechGroupsMapper& techGroupsMapper);
 		void convertTechs(const EU4::world& sourceWorld);
-		void allocateFactories(const EU4::world& sourceWorld);
+		void allocateFactories(const EU4::world& sourceWorld, const Vic2::StaticData& staticData);
 		void setupPops(const EU4::world& sourceWorld);
 		void addUnions();
 		void convertArmies(const EU4::world& sourceWorld);
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include "Vic2CultureUnionMapper.h"
 #include "Vic2CultureUnion.h"
-#include "Log.h"
+#include "../Parsing/WorkerLog.h"
 #include "ParserHelpers.h"
 
 
@@ -64,8 +64,8 @@ Vic2::CultureUnionMapperFile::CultureUnionMapperFile()
 		theNationalsMapper = std::make_unique<Vic2::CultureUnionMapper>(theStream);
 	});
 
-	LOG(LogLevel::Info) << "Parsing union mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing union mappings";
 	parseFile("unions.txt");
-	LOG(LogLevel::Info) << "Parsing national mappings";
+	WORKER_LOG(LogLevel::Info) << "Parsing national mappings";
 	parseFile("nationals.txt");
 }
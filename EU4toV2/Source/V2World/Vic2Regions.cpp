@@ -29,10 +29,6 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 
-Vic2::regions* Vic2::regions::instance = nullptr;
-
-
-
 Vic2::regions::regions()
 {
 	registerKeyword(std::regex("\\w\\w\\w_\\d+"), [this](const std::string& regionName, std::istream& theStream)
@@ -57,7 +53,7 @@ Vic2::regions::regions()
 	}
 	else
 	{
-		parseFile(theConfiguration.getVic2Path() + "/map/region.txt");
+		parseFile(theConfiguration().getVic2Path() + "/map/region.txt");
 	}
 }
 
@@ -48,15 +48,13 @@ namespace Vic2
 				return getInstance()->GetProvincesInRegion(region);
 			}
 
+			static void load() { getInstance(); } // ahead of first use
+
 		private:
-			static regions* instance;
 			static regions* getInstance()
 			{
-				if (instance == nullptr)
-				{
-					instance = new regions();
-				}
-
+				// blankMod's regions, the same for every conversion
+				static regions* instance = new regions;
 				return instance;
 			}
 			regions();
@@ -0,0 +1,532 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#include "Vic2StaticData.h"
+#include "../Parsing/WorkerLog.h"
+#include "Object.h"
+#include "OSCompatibilityLayer.h"
+#include "../Parsing/LegacyObjects.h"
+#include "../Configuration.h"
+#include <fstream>
+
+
+
+namespace
+{
+
+const std::string blankModProvincesFolder = "./blankMod/output/history/provinces";
+const std::string blankModPopsFolder = "./blankMod/output/history/pops/1836.1.1/";
+const std::string blankModLocalisationFile = "./blankMod/output/localisation/text.csv";
+const std::string terrainDataFile = "terrainData.txt";
+const std::string startingFactoriesFile = "starting_factories.txt";
+
+const std::vector<std::string> techFiles = {
+	"/technologies/army_tech.txt",
+	"/technologies/commerce_tech.txt",
+	"/technologies/culture_tech.txt",
+	"/technologies/industry_tech.txt",
+	"/technologies/navy_tech.txt"
+};
+
+const std::vector<std::string> inventionFiles = {
+	"/inventions/army_inventions.txt",
+	"/inventions/commerce_inventions.txt",
+	"/inventions/culture_inventions.txt",
+	"/inventions/industry_inventions.txt",
+	"/inventions/navy_inventions.txt"
+};
+
+
+std::shared_ptr<Object> parseRequiredFile(const std::string& filename)
+{
+	std::shared_ptr<Object> obj = parsing::parse8859File(filename);
+	if (obj == nullptr)
+	{
+		WORKER_LOG(LogLevel::Error) << "Could not parse file " << filename;
+		exit(-1);
+	}
+	return obj;
+}
+
+
+bool isAProvinceLocalization(const std::string& line)
+{
+	return (line.substr(0, 4) == "PROV") && (isdigit(line[4]));
+}
+
+}
+
+
+
+std::set<std::string> Vic2::StaticData::discoverProvinceFilenames()
+{
+	std::set<std::string> provinceFilenames;
+	if (Utils::doesFolderExist(blankModProvincesFolder))
+	{
+		Utils::GetAllFilesInFolderRecursive(blankModProvincesFolder, provinceFilenames);
+	}
+	if (provinceFilenames.empty())
+	{
+		Utils::GetAllFilesInFolderRecursive(theConfiguration().getVic2Path() + "/history/provinces", provinceFilenames);
+	}
+
+	return provinceFilenames;
+}
+
+
+std::set<std::string> Vic2::StaticData::discoverPopFilenames()
+{
+	std::set<std::string> popFilenames;
+	Utils::GetAllFilesInFolder(blankModPopsFolder, popFilenames);
+	return popFilenames;
+}
+
+
+std::vector<std::string> Vic2::StaticData::getSourceFiles(const std::set<std::string>& provinceFilenames, const std::set<std::string>& popFilenames)
+{
+	const auto& vic2Path = theConfiguration().getVic2Path();
+
+	std::vector<std::string> files;
+	for (const auto& provinceFilename: provinceFilenames)
+	{
+		files.push_back(blankModProvincesFolder + provinceFilename);
+		files.push_back(vic2Path + "/history/provinces" + provinceFilename);
+	}
+	files.push_back(blankModLocalisationFile);
+	files.push_back(vic2Path + "/localisation/text.csv");
+	files.push_back(vic2Path + "/map/climate.txt");
+	files.push_back(terrainDataFile);
+	for (const auto& popFilename: popFilenames)
+	{
+		files.push_back(blankModPopsFolder + popFilename);
+	}
+	files.push_back(vic2Path + "/map/positions.txt");
+	for (const auto& techFile: techFiles)
+	{
+		files.push_back(vic2Path + techFile);
+	}
+	for (const auto& inventionFile: inventionFiles)
+	{
+		files.push_back(vic2Path + inventionFile);
+	}
+	files.push_back(vic2Path + "/common/production_types.txt");
+	files.push_back(startingFactoriesFile);
+	return files;
+}
+
+
+Vic2::StaticData::StaticData(const std::set<std::string>& provinceFilenames, const std::set<std::string>& popFilenames)
+{
+	for (const auto& provinceFilename: provinceFilenames)
+	{
+		readProvinceHistory(provinceFilename);
+	}
+	readProvinceNames();
+	readProvinceClimates();
+	readProvinceTerrains();
+	for (const auto& popFilename: popFilenames)
+	{
+		readPopFile(popFilename);
+	}
+	readCoastalProvinces();
+	readFactoryTypes();
+	readStartingFactories();
+}
+
+
+void Vic2::StaticData::readProvinceHistory(const std::string& filename)
+{
+	ProvinceHistory history;
+	history.filename = filename;
+
+	int slash = filename.find_last_of("/");
+	int numDigits = filename.find_first_of("-") - slash - 2;
+	history.num = atoi(filename.substr(slash + 1, numDigits).c_str());
+
+	std::shared_ptr<Object> obj;
+	if (Utils::DoesFileExist(blankModProvincesFolder + filename))
+	{
+		obj = parseRequiredFile(blankModProvincesFolder + filename);
+	}
+	else
+	{
+		obj = parseRequiredFile(theConfiguration().getVic2Path() + "/history/provinces" + filename);
+	}
+	for (auto leaf: obj->getLeaves())
+	{
+		const auto key = leaf->getKey();
+		if (key == "owner")
+		{
+			history.owner = leaf->getLeaf();
+		}
+		else if (key == "controller")
+		{
+			history.controller = leaf->getLeaf();
+		}
+		else if (key == "add_core")
+		{
+			history.cores.push_back(leaf->getLeaf());
+		}
+		else if (key == "trade_goods")
+		{
+			history.rgoType = leaf->getLeaf();
+		}
+		else if (key == "life_rating")
+		{
+			history.lifeRating = atoi(leaf->getLeaf().c_str());
+		}
+		else if (key == "terrain")
+		{
+			history.terrain = leaf->getLeaf();
+		}
+		else if (key == "colonial")
+		{
+			history.colonial = atoi(leaf->getLeaf().c_str());
+		}
+		else if (key == "colony")
+		{
+			history.colonyLevel = atoi(leaf->getLeaf().c_str());
+		}
+		else if (key == "naval_base")
+		{
+			history.navalBaseLevel = atoi(leaf->getLeaf().c_str());
+		}
+		else if (key == "fort")
+		{
+			history.fortLevel = atoi(leaf->getLeaf().c_str());
+		}
+		else if (key == "railroad")
+		{
+			history.railLevel = atoi(leaf->getLeaf().c_str());
+		}
+		else if ((key == "is_slave") && (leaf->getLeaf() == "yes"))
+		{
+			history.slaveState = true;
+		}
+	}
+
+	provinceHistories.push_back(std::move(history));
+}
+
+
+void Vic2::StaticData::readProvinceNames()
+{
+	std::ifstream read;
+	if (Utils::DoesFileExist(blankModLocalisationFile))
+	{
+		read.open(blankModLocalisationFile);
+	}
+	else
+	{
+		read.open(theConfiguration().getVic2Path() + "/localisation/text.csv");
+	}
+
+	while (read.good() && !read.eof())
+	{
+		std::string line;
+		getline(read, line);
+		if (isAProvinceLocalization(line))
+		{
+			int position = line.find_first_of(';');
+			int num = stoi(line.substr(4, position - 4));
+			provinceNames[num] = line.substr(position + 1, line.find_first_of(';', position + 1) - position - 1);
+		}
+	}
+}
+
+
+void Vic2::StaticData::readProvinceClimates()
+{
+	std::string filename = theConfiguration().getVic2Path() + "/map/climate.txt";
+	if (!Utils::DoesFileExist(filename))
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not find file " << filename << ", will not load climates.";
+		return;
+	}
+
+	auto climateObj = parsing::parse8859File(filename);
+	std::vector keywords = { "mild_climate", "temperate_climate", "harsh_climate", "inhospitable_climate" };
+	for (const auto& key: keywords)
+	{
+		auto objs = climateObj->getValue(key);
+		if (objs.size() < 2)
+		{
+			WORKER_LOG(LogLevel::Warning) << "Found " << objs.size() << " objects with key " << key << ", will not assign this climate.";
+			continue;
+		}
+		auto provList = objs[1];
+		for (int i = 0; i < provList->numTokens(); ++i)
+		{
+			auto provNum = provList->tokenAsInt(i);
+			if (provNum == 0)
+			{
+				continue;
+			}
+			provinceClimates[provNum.value()] = key;
+		}
+	}
+}
+
+
+void Vic2::StaticData::readProvinceTerrains()
+{
+	if (!Utils::DoesFileExist(terrainDataFile))
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not find " << terrainDataFile << ", will not load terrain data.";
+		return;
+	}
+
+	auto terrainObj = parsing::parse8859File(terrainDataFile);
+	if (terrainObj == nullptr)
+	{
+		WORKER_LOG(LogLevel::Warning) << "Could not parse " << terrainDataFile << ", will not load terrain data.";
+		return;
+	}
+
+	for (auto leaf: terrainObj->getLeaves())
+	{
+		// the first terrain given for a province is the one it gets
+		provinceTerrains.insert(std::make_pair(atoi(leaf->getKey().c_str()), leaf->getLeaf()));
+	}
+}
+
+
+void Vic2::StaticData::readPopFile(const std::string& filename)
+{
+	PopFile popFile;
+	popFile.name = filename;
+
+	std::shared_ptr<Object> fileObj = parsing::parse8859File(blankModPopsFolder + filename);
+	for (auto provinceObj: fileObj->getLeaves())
+	{
+		std::vector<PopDetails> pops;
+		for (auto popObj: provinceObj->getLeaves())
+		{
+			PopDetails pop;
+			pop.type = popObj->getKey();
+			pop.size = popObj->safeGetInt("size");
+			pop.culture = popObj->safeGetString("culture");
+			pop.religion = popObj->safeGetString("religion");
+			pops.push_back(std::move(pop));
+		}
+		popFile.provincePops.push_back(std::make_pair(stoi(provinceObj->getKey()), std::move(pops)));
+	}
+
+	popFiles.push_back(std::move(popFile));
+}
+
+
+void Vic2::StaticData::readCoastalProvinces()
+{
+	auto positionsObj = parseRequiredFile(theConfiguration().getVic2Path() + "/map/positions.txt");
+	for (auto provinceObj: positionsObj->getLeaves())
+	{
+		auto positionObj = provinceObj->getValue("building_position");
+		if ((positionObj.size() > 0) && (positionObj[0]->getValue("naval_base").size() > 0))
+		{
+			coastalProvinces.insert(stoi(provinceObj->getKey()));
+		}
+	}
+}
+
+
+void Vic2::StaticData::readFactoryTypes()
+{
+	std::map<std::string, std::string> factoryTechReqs;
+	for (const auto& techFile: techFiles)
+	{
+		auto obj = parseRequiredFile(theConfiguration().getVic2Path() + techFile);
+		for (auto techObj: obj->getLeaves())
+		{
+			for (auto building: techObj->getValue("activate_building"))
+			{
+				factoryTechReqs.insert(make_pair(building->getLeaf(), techObj->getKey()));
+			}
+		}
+	}
+
+	std::map<std::string, std::string> factoryInventionReqs;
+	for (const auto& inventionFile: inventionFiles)
+	{
+		auto obj = parseRequiredFile(theConfiguration().getVic2Path() + inventionFile);
+		for (auto invObj: obj->getLeaves())
+		{
+			auto effect = invObj->getValue("effect");
+			if (effect.size() == 0)
+			{
+				continue;
+			}
+			for (auto building: effect[0]->getValue("activate_building"))
+			{
+				factoryInventionReqs.insert(make_pair(building->getLeaf(), invObj->getKey()));
+			}
+		}
+	}
+
+	auto obj = parseRequiredFile(theConfiguration().getVic2Path() + "/common/production_types.txt");
+	for (auto factoryObj: obj->getLeaves())
+	{
+		V2FactoryType factoryType(factoryObj);
+		auto reqitr = factoryTechReqs.find(factoryType.name);
+		if (reqitr != factoryTechReqs.end())
+		{
+			factoryType.requireTech = reqitr->second;
+		}
+		reqitr = factoryInventionReqs.find(factoryType.name);
+		if (reqitr != factoryInventionReqs.end())
+		{
+			factoryType.requiredInvention = reqitr->second;
+		}
+		factoryTypes.push_back(std::move(factoryType));
+	}
+}
+
+
+void Vic2::StaticData::readStartingFactories()
+{
+	auto obj = parseRequiredFile(startingFactoriesFile);
+	auto top = obj->getValue("starting_factories");
+	if (top.size() != 1)
+	{
+		WORKER_LOG(LogLevel::Error) << "Error: Could not load starting factory list!";
+		exit(-1);
+	}
+	for (auto factory: top[0]->getLeaves())
+	{
+		startingFactories.push_back(std::make_pair(factory->getKey(), atoi(factory->getLeaf().c_str())));
+	}
+}
+
+
+Vic2::StaticData::StaticData(parsing::SnapshotReader& snapshot)
+{
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		ProvinceHistory history;
+		snapshot.read(history.filename);
+		snapshot.read(history.num);
+		snapshot.read(history.owner);
+		snapshot.read(history.controller);
+		snapshot.read(history.cores);
+		snapshot.read(history.rgoType);
+		snapshot.read(history.lifeRating);
+		snapshot.read(history.terrain);
+		snapshot.read(history.colonial);
+		snapshot.read(history.colonyLevel);
+		snapshot.read(history.navalBaseLevel);
+		snapshot.read(history.fortLevel);
+		snapshot.read(history.railLevel);
+		snapshot.read(history.slaveState);
+		provinceHistories.push_back(std::move(history));
+	}
+	snapshot.read(provinceNames);
+	snapshot.read(provinceClimates);
+	snapshot.read(provinceTerrains);
+	for (auto fileCount = snapshot.readCount(); fileCount > 0; fileCount--)
+	{
+		PopFile popFile;
+		snapshot.read(popFile.name);
+		for (auto provinceCount = snapshot.readCount(); provinceCount > 0; provinceCount--)
+		{
+			const auto province = snapshot.read<int>();
+			std::vector<PopDetails> pops;
+			for (auto popCount = snapshot.readCount(); popCount > 0; popCount--)
+			{
+				PopDetails pop;
+				snapshot.read(pop.type);
+				snapshot.read(pop.size);
+				snapshot.read(pop.culture);
+				snapshot.read(pop.religion);
+				pops.push_back(std::move(pop));
+			}
+			popFile.provincePops.push_back(std::make_pair(province, std::move(pops)));
+		}
+		popFiles.push_back(std::move(popFile));
+	}
+	snapshot.read(coastalProvinces);
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		factoryTypes.emplace_back(snapshot);
+	}
+	for (auto count = snapshot.readCount(); count > 0; count--)
+	{
+		auto name = snapshot.read<std::string>();
+		startingFactories.push_back(std::make_pair(std::move(name), snapshot.read<int>()));
+	}
+}
+
+
+void Vic2::StaticData::writeSnapshot(parsing::SnapshotWriter& snapshot) const
+{
+	snapshot.writeCount(provinceHistories.size());
+	for (const auto& history: provinceHistories)
+	{
+		snapshot.write(history.filename);
+		snapshot.write(history.num);
+		snapshot.write(history.owner);
+		snapshot.write(history.controller);
+		snapshot.write(history.cores);
+		snapshot.write(history.rgoType);
+		snapshot.write(history.lifeRating);
+		snapshot.write(history.terrain);
+		snapshot.write(history.colonial);
+		snapshot.write(history.colonyLevel);
+		snapshot.write(history.navalBaseLevel);
+		snapshot.write(history.fortLevel);
+		snapshot.write(history.railLevel);
+		snapshot.write(history.slaveState);
+	}
+	snapshot.write(provinceNames);
+	snapshot.write(provinceClimates);
+	snapshot.write(provinceTerrains);
+	snapshot.writeCount(popFiles.size());
+	for (const auto& popFile: popFiles)
+	{
+		snapshot.write(popFile.name);
+		snapshot.writeCount(popFile.provincePops.size());
+		for (const auto& provincePops: popFile.provincePops)
+		{
+			snapshot.write(provincePops.first);
+			snapshot.writeCount(provincePops.second.size());
+			for (const auto& pop: provincePops.second)
+			{
+				snapshot.write(pop.type);
+				snapshot.write(pop.size);
+				snapshot.write(pop.culture);
+				snapshot.write(pop.religion);
+			}
+		}
+	}
+	snapshot.write(coastalProvinces);
+	snapshot.writeCount(factoryTypes.size());
+	for (const auto& factoryType: factoryTypes)
+	{
+		factoryType.writeSnapshot(snapshot);
+	}
+	snapshot.writeCount(startingFactories.size());
+	for (const auto& startingFactory: startingFactories)
+	{
+		snapshot.write(startingFactory.first);
+		snapshot.write(startingFactory.second);
+	}
+}
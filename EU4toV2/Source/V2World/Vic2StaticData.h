@@ -0,0 +1,130 @@
+/*Copyright (c) 2019 The Paradox Game Converters Project
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+
+#ifndef VIC2_STATIC_DATA_H_
+#define VIC2_STATIC_DATA_H_
+
+
+
+#include "V2Factory.h"
+#include "../Parsing/Snapshot.h"
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+namespace Vic2
+{
+
+// a province's history file, as provinces start out from it
+struct ProvinceHistory
+{
+	std::string filename; // under history/provinces, with its folder in front
+	int num = 0;
+	std::string owner;
+	std::string controller;
+	std::vector<std::string> cores;
+	std::string rgoType;
+	int lifeRating = 0;
+	std::string terrain;
+	int colonial = 0;
+	int colonyLevel = 0;
+	int navalBaseLevel = 0;
+	int fortLevel = 0;
+	int railLevel = 0;
+	bool slaveState = false;
+};
+
+
+struct PopDetails
+{
+	std::string type;
+	int size = 0;
+	std::string culture;
+	std::string religion;
+};
+
+
+// the pops a blankMod pops file gives each province, in the order the file has them
+struct PopFile
+{
+	std::string name;
+	std::vector<std::pair<int, std::vector<PopDetails>>> provincePops;
+};
+
+
+// Everything the converter reads from the Vic2 install and blankMod that is the same from one
+// conversion to the next: province history, names, climates and terrain, the starting pops, the
+// coastal provinces and the factory types with their starting counts. It's parsed once and then
+// read back from a single cache file until any of the files it came from changes.
+class StaticData
+{
+	public:
+		// the province history files, named from inside history/provinces; blankMod's replace Vic2's
+		static std::set<std::string> discoverProvinceFilenames();
+		static std::set<std::string> discoverPopFilenames();
+		// every file StaticData can be read from, found or not, for the cache to watch
+		static std::vector<std::string> getSourceFiles(const std::set<std::string>& provinceFilenames, const std::set<std::string>& popFilenames);
+
+		StaticData(const std::set<std::string>& provinceFilenames, const std::set<std::string>& popFilenames);
+		explicit StaticData(parsing::SnapshotReader& snapshot);
+
+		void writeSnapshot(parsing::SnapshotWriter& snapshot) const;
+
+		const std::vector<ProvinceHistory>& getProvinceHistories() const { return provinceHistories; }
+		const std::map<int, std::string>& getProvinceNames() const { return provinceNames; }
+		const std::map<int, std::string>& getProvinceClimates() const { return provinceClimates; }
+		const std::map<int, std::string>& getProvinceTerrains() const { return provinceTerrains; }
+		const std::vector<PopFile>& getPopFiles() const { return popFiles; }
+		const std::set<int>& getCoastalProvinces() const { return coastalProvinces; }
+		const std::vector<V2FactoryType>& getFactoryTypes() const { return factoryTypes; }
+		const std::vector<std::pair<std::string, int>>& getStartingFactories() const { return startingFactories; }
+
+	private:
+		void readProvinceHistory(const std::string& filename);
+		void readProvinceNames();
+		void readProvinceClimates();
+		void readProvinceTerrains();
+		void readPopFile(const std::string& filename);
+		void readCoastalProvinces();
+		void readFactoryTypes();
+		void readStartingFactories();
+
+		std::vector<ProvinceHistory> provinceHistories;
+		std::map<int, std::string> provinceNames;
+		std::map<int, std::string> provinceClimates;
+		std::map<int, std::string> provinceTerrains;
+		std::vector<PopFile> popFiles;
+		std::set<int> coastalProvinces;
+		std::vector<V2FactoryType> factoryTypes;
+		std::vector<std::pair<std::string, int>> startingFactories;
+};
+
+}
+
+
+
+#endif // VIC2_STATIC_DATA_H_
@@ -30,6 +30,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 
 std::string getSaveFileName(const int argc, const char * argv[]);
+size_t getParallelJobs(const int argc, const char * argv[]);
 int main(const int argc, const char * argv[])
 {
 	try
@@ -38,6 +39,18 @@ int main(const int argc, const char * argv[])
 		LOG(LogLevel::Info) << "Built " << __TIMESTAMP__;
 		LOG(LogLevel::Debug) << "Current directory is " << Utils::getCurrentDirectory();
 
+		if ((argc >= 3) && (std::string(argv[1]) == "--batch"))
+		{
+			LOG(LogLevel::Info) << "Using batch file " << argv[2];
+			const auto jobs = readBatchFile(argv[2]);
+			return (ConvertEU4ToVic2Batch(jobs, getParallelJobs(argc, argv)) == 0) ? 0 : -1;
+		}
+		if ((argc >= 3) && (std::string(argv[1]) == "--daemon"))
+		{
+			RunEU4ToVic2Daemon(argv[2], getParallelJobs(argc, argv));
+			return 0;
+		}
+
 		std::string EU4SaveFileName;
 		if (argc >= 2)
 		{
@@ -59,4 +72,17 @@ int main(const int argc, const char * argv[])
 		LOG(LogLevel::Error) << e.what();
 		return -1;
 	}
-}
\ No newline at end of file
+}
+
+
+// "--jobs N" after the batch file or socket path
+size_t getParallelJobs(const int argc, const char * argv[])
+{
+	if ((argc >= 5) && (std::string(argv[3]) == "--jobs"))
+	{
+		const auto parallelJobs = std::stoul(argv[4]);
+		LOG(LogLevel::Info) << "Running up to " << parallelJobs << " conversions at once";
+		return parallelJobs;
+	}
+	return 1;
+}